@@ -0,0 +1,188 @@
+#include "../include/contact_index.h"
+#include "../include/contact_directory.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// 联系人搜索 + JSON 输出：索引对象复制路径 vs 只读通讯录零拷贝路径
+// 10万联系人，200个姓名前缀；同时统计每次查询的堆分配次数
+
+namespace {
+
+std::atomic<size_t> allocation_count(0);
+
+} // namespace
+
+// 统计堆分配次数
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+const int CONTACT_COUNT = 100000;
+const int ROUNDS = 5;
+
+const char* SURNAMES[] = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴"};
+const char* GIVEN[] = {"伟", "芳", "娜", "敏", "静", "磊", "洋", "勇", "艳", "杰",
+                       "涛", "明", "超", "秀", "霞", "平", "刚", "桂", "华", "丽"};
+const char* DEPARTMENTS[] = {"计算机学院", "机械学院", "外国语学院", "商学院"};
+
+using Clock = std::chrono::steady_clock;
+
+// 原搜索接口：前缀树结果逐个复制为 Contact 后用 ostringstream 拼接
+std::string searchViaIndex(const ContactIndex& index, const std::string& prefix) {
+    std::vector<Contact> contacts;
+    for (const auto& contactPtr : index.searchByName(prefix)) {
+        contacts.push_back(*contactPtr);
+    }
+
+    std::ostringstream json;
+    json << "{\"success\": true,\"data\": [";
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        json << "{\"id\": " << contacts[i].id << ","
+             << "\"name\": \"" << contacts[i].name << "\","
+             << "\"phone\": \"" << contacts[i].phone << "\","
+             << "\"email\": \"" << contacts[i].email << "\"";
+        if (!contacts[i].department.empty()) {
+            json << ",\"department\": \"" << contacts[i].department << "\"";
+        }
+        if (!contacts[i].student_id.empty()) {
+            json << ",\"student_id\": \"" << contacts[i].student_id << "\"";
+        }
+        json << "}";
+        if (i < contacts.size() - 1) json << ",";
+    }
+    json << "],\"total\": " << contacts.size() << "}";
+    return json.str();
+}
+
+// 新搜索接口：通讯录返回行号，JSON 直接从映射区写出
+std::string searchViaDirectory(const ContactDirectory& directory, const std::string& prefix) {
+    std::vector<uint32_t> rows = directory.searchByNamePrefix(prefix);
+    std::string body = "{\"success\": true,\"data\": ";
+    body.reserve(body.size() + rows.size() * 160);
+    directory.appendJsonArray(rows, body);
+    body += ",\"total\": " + std::to_string(rows.size()) + "}";
+    return body;
+}
+
+struct RunResult {
+    double micros_per_query;
+    double allocations_per_query;
+    size_t bytes;
+};
+
+template<typename Search>
+RunResult measure(const std::vector<std::string>& prefixes, Search search) {
+    RunResult result;
+    result.bytes = 0;
+    size_t allocations_before = allocation_count.load();
+    auto start = Clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (const auto& prefix : prefixes) {
+            result.bytes += search(prefix).size();
+        }
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    double queries = static_cast<double>(ROUNDS * prefixes.size());
+    result.micros_per_query = elapsed / queries;
+    result.allocations_per_query = (allocation_count.load() - allocations_before) / queries;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "bench_contacts.dir";
+
+    std::cout << "=== 联系人搜索输出路径对比测试 ===\n\n";
+    std::cout << "联系人数量: " << CONTACT_COUNT << "\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> surname(0, 9);
+    std::uniform_int_distribution<int> given(0, 19);
+    std::vector<std::shared_ptr<Contact>> contacts;
+    for (int id = 1; id <= CONTACT_COUNT; id++) {
+        std::string name = std::string(SURNAMES[surname(gen)]) + GIVEN[given(gen)] + GIVEN[given(gen)];
+        Contact contact(id, name, "2021" + std::to_string(id),
+                        "138" + std::to_string(10000000 + id), "user" + std::to_string(id) + "@czu.edu.cn");
+        contact.department = DEPARTMENTS[id % 4];
+        contacts.push_back(std::make_shared<Contact>(contact));
+    }
+
+    ContactIndex index;
+    index.bulkLoad(contacts, 1);
+    auto build_start = Clock::now();
+    if (!ContactDirectory::build(path, contacts, 1)) {
+        std::cerr << "通讯录生成失败: " << path << std::endl;
+        return 1;
+    }
+    ContactDirectory directory;
+    if (!directory.open(path)) {
+        std::cerr << "通讯录映射失败: " << path << std::endl;
+        return 1;
+    }
+    double build_ms = std::chrono::duration<double, std::milli>(Clock::now() - build_start).count();
+
+    // 姓 + 名首字，每个前缀约命中 500 人
+    std::vector<std::string> prefixes;
+    for (const char* surname_text : SURNAMES) {
+        for (const char* given_text : GIVEN) {
+            prefixes.push_back(std::string(surname_text) + given_text);
+        }
+    }
+
+    // 两条路径的命中集合必须一致
+    bool consistent = true;
+    for (const auto& prefix : prefixes) {
+        std::vector<int> expected;
+        for (const auto& contactPtr : index.searchByName(prefix)) expected.push_back(contactPtr->id);
+        std::vector<int> actual;
+        for (uint32_t row : directory.searchByNamePrefix(prefix)) actual.push_back(directory.id(row));
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        consistent = consistent && expected == actual;
+    }
+
+    RunResult via_index = measure(prefixes, [&index](const std::string& prefix) {
+        return searchViaIndex(index, prefix);
+    });
+    RunResult via_directory = measure(prefixes, [&directory](const std::string& prefix) {
+        return searchViaDirectory(directory, prefix);
+    });
+
+    std::cout << "通讯录生成 + 映射: " << std::fixed << std::setprecision(1) << build_ms << " ms\n\n";
+    std::cout << "   路径          每次查询(us)   每次堆分配(次)   输出(KB)\n";
+    std::cout << "   索引 + 复制" << std::setw(14) << via_index.micros_per_query
+              << std::setw(17) << via_index.allocations_per_query
+              << std::setw(11) << via_index.bytes / 1024 << "\n";
+    std::cout << "   通讯录     " << std::setw(14) << via_directory.micros_per_query
+              << std::setw(17) << via_directory.allocations_per_query
+              << std::setw(11) << via_directory.bytes / 1024 << "\n";
+    std::cout << "\n   加速比: " << std::setprecision(2)
+              << via_index.micros_per_query / via_directory.micros_per_query << "x\n";
+    std::cout << "   命中集合一致性: " << (consistent ? "通过" : "失败") << "\n";
+
+    std::remove(path.c_str());
+    std::cout << "\n=== 联系人搜索输出路径对比测试完成 ===\n";
+    return consistent ? 0 : 1;
+}
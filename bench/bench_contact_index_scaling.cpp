@@ -0,0 +1,150 @@
+#include "../include/contact_index.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <string>
+
+// 姓名前缀搜索的读线程扩展性：全局互斥锁 vs 版本化快照
+// 10万联系人，读线程 1~16 个，另有一个写线程持续增删联系人
+
+namespace {
+
+const int CONTACT_COUNT = 100000;
+const std::chrono::milliseconds RUN_TIME(500);
+
+const char* SURNAMES[] = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴"};
+const char* GIVEN[] = {"伟", "芳", "娜", "敏", "静", "磊", "洋", "勇", "艳", "杰",
+                       "涛", "明", "超", "秀", "霞", "平", "刚", "桂", "华", "丽"};
+
+Contact makeContact(int id, std::mt19937& gen) {
+    std::uniform_int_distribution<int> surname(0, 9);
+    std::uniform_int_distribution<int> given(0, 19);
+    std::string name = std::string(SURNAMES[surname(gen)]) + GIVEN[given(gen)] + GIVEN[given(gen)];
+    return Contact(id, name, "2021" + std::to_string(id),
+                   "138" + std::to_string(id), "user" + std::to_string(id) + "@czu.edu.cn");
+}
+
+std::vector<std::string> makePrefixes() {
+    // 姓 + 名首字，每个前缀约命中 500 人
+    std::vector<std::string> prefixes;
+    for (const char* surname : SURNAMES) {
+        for (const char* given : GIVEN) {
+            prefixes.push_back(std::string(surname) + given);
+        }
+    }
+    return prefixes;
+}
+
+// 基线：单个索引 + 全局互斥锁
+class LockedContactIndex {
+public:
+    void addContact(const Contact& contact) {
+        auto contactPtr = std::make_shared<Contact>(contact);
+        std::lock_guard<std::mutex> lock(mutex);
+        index.addContact(contactPtr);
+    }
+    void removeContact(const Contact& contact) {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.removeContact(contact);
+    }
+    size_t search(const std::string& prefix) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.searchByName(prefix).size();
+    }
+
+private:
+    ContactIndex index;
+    std::mutex mutex;
+};
+
+class SnapshotContactIndex {
+public:
+    void addContact(const Contact& contact) { index.addContact(contact); }
+    void removeContact(const Contact& contact) { index.removeContact(contact); }
+    size_t search(const std::string& prefix) {
+        return index.snapshot()->searchByName(prefix).size();
+    }
+
+private:
+    VersionedContactIndex index;
+};
+
+template<typename Index>
+double measureThroughput(Index& index, int reader_count, const std::vector<std::string>& prefixes) {
+    std::atomic<bool> running(true);
+    std::atomic<size_t> total_searches(0);
+    std::atomic<size_t> total_results(0);  // 防止编译器优化掉查找
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < reader_count; t++) {
+        readers.emplace_back([&, t]() {
+            size_t searches = 0;
+            size_t sink = 0;
+            size_t cursor = static_cast<size_t>(t) * 7;
+            while (running.load(std::memory_order_relaxed)) {
+                sink += index.search(prefixes[cursor++ % prefixes.size()]);
+                searches++;
+            }
+            total_searches += searches;
+            total_results += sink;
+        });
+    }
+
+    // 写线程：每毫秒增删一个联系人，模拟后台编辑
+    std::thread writer([&]() {
+        std::mt19937 gen(7);
+        int next_id = CONTACT_COUNT + 1;
+        while (running.load(std::memory_order_relaxed)) {
+            Contact contact = makeContact(next_id++, gen);
+            index.addContact(contact);
+            index.removeContact(contact);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::this_thread::sleep_for(RUN_TIME);
+    running = false;
+    for (auto& reader : readers) reader.join();
+    writer.join();
+
+    return total_searches.load() / std::chrono::duration<double>(RUN_TIME).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 联系人前缀搜索并发扩展性测试 ===\n\n";
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "联系人数量: " << CONTACT_COUNT << "\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    LockedContactIndex locked;
+    SnapshotContactIndex snapshot;
+    for (int id = 1; id <= CONTACT_COUNT; id++) {
+        Contact contact = makeContact(id, gen);
+        locked.addContact(contact);
+        snapshot.addContact(contact);
+    }
+    auto prefixes = makePrefixes();
+
+    std::cout << "   读线程     全局锁(次/秒)     快照(次/秒)     快照扩展比\n";
+    double snapshot_single = 0;
+    for (int threads : {1, 2, 4, 8, 16}) {
+        double locked_qps = measureThroughput(locked, threads, prefixes);
+        double snapshot_qps = measureThroughput(snapshot, threads, prefixes);
+        if (threads == 1) snapshot_single = snapshot_qps;
+
+        std::cout << "   " << std::setw(6) << threads
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(18) << locked_qps
+                  << std::setw(16) << snapshot_qps
+                  << std::setw(14) << std::setprecision(2)
+                  << (snapshot_single > 0 ? snapshot_qps / snapshot_single : 0.0) << "x\n";
+    }
+
+    std::cout << "\n=== 联系人前缀搜索并发扩展性测试完成 ===\n";
+    return 0;
+}
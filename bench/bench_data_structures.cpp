@@ -0,0 +1,552 @@
+#include "bench_harness.h"
+#include "../include/trie.h"
+#include "../include/hash_table.h"
+#include "../include/segment_tree.h"
+#include "../include/lru_cache.h"
+#include "../include/doubly_linked_list.h"
+#include "../include/stack.h"
+#include "../include/array_stack.h"
+#include "../include/priority_queue.h"
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 核心数据结构基准：每个结构与朴素基线（线性扫描等）在多个规模下对比，结果可输出为 JSON 跟踪回归
+//   ./bench_data_structures --benchmark_out=result.json
+//   ./bench_data_structures --benchmark_filter=Trie --benchmark_min_time=0.05
+// README 的性能要求：Trie 检索、线段树冲突检测比线性搜索快 10 倍以上，汇总中标出未达标的规模
+
+namespace {
+
+const std::vector<int64_t> CONTACT_SIZES = {1000, 10000, 100000};
+const std::vector<int64_t> RESERVATION_SIZES = {100, 1000, 10000};
+const std::vector<int64_t> CONTAINER_SIZES = {100, 1000, 10000};
+const int QUERY_COUNT = 1024;           // 预先生成的查询数（2 的幂，循环使用）
+const int VENUE_COUNT = 20;
+const int WEEK_MINUTES = 7 * 24 * 60;
+const double README_SPEEDUP = 10.0;
+
+const char* SURNAMES[] = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴"};
+const char* GIVEN[] = {"伟", "芳", "娜", "敏", "静", "磊", "洋", "勇", "艳", "杰",
+                       "涛", "明", "超", "秀", "霞", "平", "刚", "桂", "华", "丽"};
+
+// ---- 联系人数据（Trie / HashTable 共用，每个规模只生成一次） ----
+
+struct ContactFixture {
+    std::vector<std::shared_ptr<Contact>> contacts;
+    std::vector<std::string> name_prefixes;         // 姓 + 名的第一个字
+    std::vector<std::string> student_id_prefixes;   // 学号去掉最后两位
+    std::vector<int> ids;                           // 随机的已有 ID
+    Trie trie;
+    HashTable table;
+    std::unordered_map<int, std::shared_ptr<Contact>> std_map;
+};
+
+const ContactFixture& contactFixture(int64_t count) {
+    static std::map<int64_t, std::unique_ptr<ContactFixture>> cache;
+    auto& slot = cache[count];
+    if (slot) return *slot;
+
+    slot.reset(new ContactFixture());
+    ContactFixture& f = *slot;
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> surname(0, 9);
+    std::uniform_int_distribution<int> given(0, 19);
+    for (int i = 1; i <= count; i++) {
+        std::string name = std::string(SURNAMES[surname(gen)]) + GIVEN[given(gen)] + GIVEN[given(gen)];
+        auto contact = std::make_shared<Contact>(i, name, "2021" + std::to_string(100000 + i),
+                                                 "138" + std::to_string(10000000 + i),
+                                                 "user" + std::to_string(i) + "@czu.edu.cn", "计算机学院");
+        f.contacts.push_back(contact);
+        f.trie.insertContact(contact);
+        f.table.insert(contact);
+        f.std_map[i] = contact;
+    }
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(count) - 1);
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        const Contact& contact = *f.contacts[pick(gen)];
+        f.name_prefixes.push_back(contact.name.substr(0, 6));   // 两个汉字
+        f.student_id_prefixes.push_back(contact.student_id.substr(0, contact.student_id.size() - 2));
+        f.ids.push_back(contact.id);
+    }
+    return f;
+}
+
+void triePrefixSearch(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        auto result = f.trie.searchByNamePrefix(f.name_prefixes[i++ & (QUERY_COUNT - 1)]);
+        bench::doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void linearPrefixSearch(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& prefix = f.name_prefixes[i++ & (QUERY_COUNT - 1)];
+        std::vector<std::shared_ptr<Contact>> result;
+        for (const auto& contact : f.contacts) {
+            if (contact->name.compare(0, prefix.size(), prefix) == 0) result.push_back(contact);
+        }
+        bench::doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void trieStudentIdSearch(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        auto result = f.trie.searchByStudentIdPrefix(f.student_id_prefixes[i++ & (QUERY_COUNT - 1)]);
+        bench::doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void linearStudentIdSearch(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& prefix = f.student_id_prefixes[i++ & (QUERY_COUNT - 1)];
+        std::vector<std::shared_ptr<Contact>> result;
+        for (const auto& contact : f.contacts) {
+            if (contact->student_id.compare(0, prefix.size(), prefix) == 0) result.push_back(contact);
+        }
+        bench::doNotOptimize(result);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void hashTableFind(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        auto contact = f.table.find(f.ids[i++ & (QUERY_COUNT - 1)]);
+        bench::doNotOptimize(contact);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void stdUnorderedMapFind(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        // 与 HashTable::find 一样返回 shared_ptr 副本
+        auto it = f.std_map.find(f.ids[i++ & (QUERY_COUNT - 1)]);
+        std::shared_ptr<Contact> contact = it != f.std_map.end() ? it->second : nullptr;
+        bench::doNotOptimize(contact);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void linearFindById(bench::State& state) {
+    const ContactFixture& f = contactFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        int id = f.ids[i++ & (QUERY_COUNT - 1)];
+        std::shared_ptr<Contact> found;
+        for (const auto& contact : f.contacts) {
+            if (contact->id == id) {
+                found = contact;
+                break;
+            }
+        }
+        bench::doNotOptimize(found);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// ---- 时间段冲突（SegmentTree / VenueConflictDetector） ----
+
+struct Interval {
+    int start;
+    int end;        // 闭区间
+};
+
+// 单个资源上 count 个 30 分钟的预约，时间轴长度为 count * 60 分钟，约一半的查询有冲突
+struct TimelineFixture {
+    std::unique_ptr<SegmentTree> tree;
+    std::vector<Interval> intervals;
+    std::vector<Interval> queries;
+};
+
+const TimelineFixture& timelineFixture(int64_t count) {
+    static std::map<int64_t, std::unique_ptr<TimelineFixture>> cache;
+    auto& slot = cache[count];
+    if (slot) return *slot;
+
+    slot.reset(new TimelineFixture());
+    TimelineFixture& f = *slot;
+    int minutes = static_cast<int>(count) * 60;
+    f.tree.reset(new SegmentTree(minutes));
+    std::mt19937 gen(20240601);
+    std::uniform_int_distribution<int> start(0, minutes - 30);
+    for (int64_t i = 0; i < count; i++) {
+        Interval interval{start(gen), 0};
+        interval.end = interval.start + 29;
+        f.intervals.push_back(interval);
+        f.tree->addInterval(interval.start, interval.end);
+    }
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        Interval query{start(gen), 0};
+        query.end = query.start + 29;
+        f.queries.push_back(query);
+    }
+    return f;
+}
+
+void segmentTreeConflict(bench::State& state) {
+    const TimelineFixture& f = timelineFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const Interval& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        bool conflict = f.tree->isConflict(query.start, query.end);
+        bench::doNotOptimize(conflict);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 暴力遍历：逐个比较已有预约，找到第一个重叠即返回
+void linearIntervalConflict(bench::State& state) {
+    const TimelineFixture& f = timelineFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const Interval& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        bool conflict = false;
+        for (const auto& interval : f.intervals) {
+            if (interval.start <= query.end && query.start <= interval.end) {
+                conflict = true;
+                break;
+            }
+        }
+        bench::doNotOptimize(conflict);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void segmentTreeOccupancy(bench::State& state) {
+    const TimelineFixture& f = timelineFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const Interval& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        int peak = f.tree->queryOccupancy(query.start, query.end);
+        bench::doNotOptimize(peak);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 暴力求区间内峰值占用：收集重叠的预约后扫描各起点
+void linearIntervalOccupancy(bench::State& state) {
+    const TimelineFixture& f = timelineFixture(state.arg());
+    size_t i = 0;
+    std::vector<Interval> overlapping;
+    for (auto _ : state) {
+        const Interval& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        overlapping.clear();
+        for (const auto& interval : f.intervals) {
+            if (interval.start <= query.end && query.start <= interval.end) overlapping.push_back(interval);
+        }
+        int peak = 0;
+        for (const auto& candidate : overlapping) {
+            int at = std::max(candidate.start, query.start);
+            int depth = 0;
+            for (const auto& other : overlapping) {
+                if (other.start <= at && at <= other.end) depth++;
+            }
+            peak = std::max(peak, depth);
+        }
+        bench::doNotOptimize(peak);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+struct VenueActivity {
+    std::string venue;
+    int start;
+    int end;
+};
+
+// 20 个场地、一周时间轴上的 count 个活动（与已有活动冲突的被拒绝，不计入）
+struct VenueFixture {
+    VenueConflictDetector detector{WEEK_MINUTES};
+    std::vector<VenueActivity> activities;
+    std::vector<VenueActivity> queries;
+};
+
+VenueFixture& venueFixture(int64_t count) {
+    static std::map<int64_t, std::unique_ptr<VenueFixture>> cache;
+    auto& slot = cache[count];
+    if (slot) return *slot;
+
+    slot.reset(new VenueFixture());
+    VenueFixture& f = *slot;
+    std::mt19937 gen(20240601);
+    std::uniform_int_distribution<int> venue(0, VENUE_COUNT - 1);
+    std::uniform_int_distribution<int> start(0, WEEK_MINUTES - 121);
+    std::uniform_int_distribution<int> length(30, 120);
+    for (int64_t i = 0; i < count; i++) {
+        VenueActivity activity{"场地" + std::to_string(venue(gen)), start(gen), 0};
+        activity.end = activity.start + length(gen) - 1;
+        if (f.detector.addActivity(activity.venue, activity.start, activity.end, static_cast<int>(i))) {
+            f.activities.push_back(activity);
+        }
+    }
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        VenueActivity query{"场地" + std::to_string(venue(gen)), start(gen), 0};
+        query.end = query.start + length(gen) - 1;
+        f.queries.push_back(query);
+    }
+    return f;
+}
+
+void venueDetectorCheck(bench::State& state) {
+    VenueFixture& f = venueFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const VenueActivity& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        bool conflict = f.detector.checkConflict(query.venue, query.start, query.end);
+        bench::doNotOptimize(conflict);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void linearVenueCheck(bench::State& state) {
+    const VenueFixture& f = venueFixture(state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        const VenueActivity& query = f.queries[i++ & (QUERY_COUNT - 1)];
+        bool conflict = false;
+        for (const auto& activity : f.activities) {
+            if (activity.venue == query.venue && activity.start <= query.end && query.start <= activity.end) {
+                conflict = true;
+                break;
+            }
+        }
+        bench::doNotOptimize(conflict);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// ---- 容器（LRUCache / DoublyLinkedList / Stack / PriorityQueue） ----
+
+std::vector<int> randomValues(size_t count, int bound) {
+    std::mt19937 gen(20240601);
+    std::uniform_int_distribution<int> value(0, bound - 1);
+    std::vector<int> values(count);
+    for (auto& v : values) v = value(gen);
+    return values;
+}
+
+// 容量为 N 的缓存装满后，随机访问已有的键
+void lruCacheGetHit(bench::State& state) {
+    int capacity = static_cast<int>(state.arg());
+    LRUCache<int, int> cache(capacity);
+    for (int key = 0; key < capacity; key++) cache.put(key, key);
+    std::vector<int> keys = randomValues(QUERY_COUNT, capacity);
+    size_t i = 0;
+    for (auto _ : state) {
+        auto value = cache.get(keys[i++ & (QUERY_COUNT - 1)]);
+        bench::doNotOptimize(value);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 朴素 LRU：链表按使用顺序排列，查找时从头线性扫描，命中后移到表头
+void linearLruGetHit(bench::State& state) {
+    int capacity = static_cast<int>(state.arg());
+    std::list<std::pair<int, int>> entries;
+    for (int key = 0; key < capacity; key++) entries.emplace_front(key, key);
+    std::vector<int> keys = randomValues(QUERY_COUNT, capacity);
+    size_t i = 0;
+    for (auto _ : state) {
+        int key = keys[i++ & (QUERY_COUNT - 1)];
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [key](const std::pair<int, int>& entry) { return entry.first == key; });
+        entries.splice(entries.begin(), entries, it);
+        bench::doNotOptimize(entries.front().second);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 队列用法：保持 N 个元素，每次尾部入队、头部出队
+void doublyLinkedListQueue(bench::State& state) {
+    DoublyLinkedList<int> list;
+    for (int64_t i = 0; i < state.arg(); i++) list.pushBack(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        list.pushBack(next++);
+        list.popFront();
+        bench::doNotOptimize(list.front());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void stdListQueue(bench::State& state) {
+    std::list<int> list;
+    for (int64_t i = 0; i < state.arg(); i++) list.push_back(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        list.push_back(next++);
+        list.pop_front();
+        bench::doNotOptimize(list.front());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 朴素实现：数组头部删除需要整体前移
+void vectorEraseFrontQueue(bench::State& state) {
+    std::vector<int> values;
+    for (int64_t i = 0; i < state.arg(); i++) values.push_back(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        values.push_back(next++);
+        values.erase(values.begin());
+        bench::doNotOptimize(values.front());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 栈深保持 N，每次入栈一个再出栈
+void stackPushPop(bench::State& state) {
+    Stack<int> stack;
+    for (int64_t i = 0; i < state.arg(); i++) stack.push(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        stack.push(next++);
+        stack.pop();
+        bench::doNotOptimize(stack.top());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void arrayStackPushPop(bench::State& state) {
+    ArrayStack<int> stack;
+    for (int64_t i = 0; i < state.arg(); i++) stack.push(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        stack.push(next++);
+        stack.pop();
+        bench::doNotOptimize(stack.top());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 朴素实现：栈顶放在数组头部
+void vectorFrontPushPop(bench::State& state) {
+    std::vector<int> values;
+    for (int64_t i = 0; i < state.arg(); i++) values.push_back(static_cast<int>(i));
+    int next = 0;
+    for (auto _ : state) {
+        values.insert(values.begin(), next++);
+        values.erase(values.begin());
+        bench::doNotOptimize(values.front());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 队列保持 N 个元素，每次插入一个随机优先级再弹出队首
+void priorityQueuePushPop(bench::State& state) {
+    std::vector<int> values = randomValues(state.arg() + QUERY_COUNT, 1000000);
+    PriorityQueue<int> queue;
+    queue.reserve(state.arg() + 1);
+    for (int64_t i = 0; i < state.arg(); i++) queue.push(values[i]);
+    size_t i = 0;
+    for (auto _ : state) {
+        queue.push(values[state.arg() + (i++ & (QUERY_COUNT - 1))]);
+        int top = queue.pop();
+        bench::doNotOptimize(top);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void stdPriorityQueuePushPop(bench::State& state) {
+    std::vector<int> values = randomValues(state.arg() + QUERY_COUNT, 1000000);
+    std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+    for (int64_t i = 0; i < state.arg(); i++) queue.push(values[i]);
+    size_t i = 0;
+    for (auto _ : state) {
+        queue.push(values[state.arg() + (i++ & (QUERY_COUNT - 1))]);
+        int top = queue.top();
+        queue.pop();
+        bench::doNotOptimize(top);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// 朴素实现：无序数组，出队时线性查找最小值
+void linearMinPushPop(bench::State& state) {
+    std::vector<int> values = randomValues(state.arg() + QUERY_COUNT, 1000000);
+    std::vector<int> queue(values.begin(), values.begin() + state.arg());
+    size_t i = 0;
+    for (auto _ : state) {
+        queue.push_back(values[state.arg() + (i++ & (QUERY_COUNT - 1))]);
+        auto min = std::min_element(queue.begin(), queue.end());
+        int top = *min;
+        *min = queue.back();
+        queue.pop_back();
+        bench::doNotOptimize(top);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Suite suite("核心数据结构性能基准", argc, argv);
+
+    suite.add("Trie_NamePrefix", CONTACT_SIZES, triePrefixSearch);
+    suite.add("Linear_NamePrefix", CONTACT_SIZES, linearPrefixSearch);
+    suite.compare("Trie_NamePrefix", "Linear_NamePrefix", README_SPEEDUP);
+    suite.add("Trie_StudentIdPrefix", CONTACT_SIZES, trieStudentIdSearch);
+    suite.add("Linear_StudentIdPrefix", CONTACT_SIZES, linearStudentIdSearch);
+    suite.compare("Trie_StudentIdPrefix", "Linear_StudentIdPrefix", README_SPEEDUP);
+
+    suite.add("HashTable_Find", CONTACT_SIZES, hashTableFind);
+    suite.add("StdUnorderedMap_Find", CONTACT_SIZES, stdUnorderedMapFind);
+    suite.add("Linear_FindById", CONTACT_SIZES, linearFindById);
+    suite.compare("HashTable_Find", "Linear_FindById");
+    suite.compare("HashTable_Find", "StdUnorderedMap_Find");
+
+    suite.add("SegmentTree_Conflict", RESERVATION_SIZES, segmentTreeConflict);
+    suite.add("Linear_IntervalConflict", RESERVATION_SIZES, linearIntervalConflict);
+    suite.compare("SegmentTree_Conflict", "Linear_IntervalConflict", README_SPEEDUP);
+    suite.add("SegmentTree_Occupancy", RESERVATION_SIZES, segmentTreeOccupancy);
+    suite.add("Linear_IntervalOccupancy", RESERVATION_SIZES, linearIntervalOccupancy);
+    suite.compare("SegmentTree_Occupancy", "Linear_IntervalOccupancy", README_SPEEDUP);
+
+    suite.add("VenueDetector_Check", RESERVATION_SIZES, venueDetectorCheck);
+    suite.add("Linear_VenueCheck", RESERVATION_SIZES, linearVenueCheck);
+    suite.compare("VenueDetector_Check", "Linear_VenueCheck", README_SPEEDUP);
+
+    suite.add("LRUCache_GetHit", CONTAINER_SIZES, lruCacheGetHit);
+    suite.add("Linear_LRUGetHit", CONTAINER_SIZES, linearLruGetHit);
+    suite.compare("LRUCache_GetHit", "Linear_LRUGetHit");
+
+    suite.add("DoublyLinkedList_Queue", CONTAINER_SIZES, doublyLinkedListQueue);
+    suite.add("StdList_Queue", CONTAINER_SIZES, stdListQueue);
+    suite.add("VectorEraseFront_Queue", CONTAINER_SIZES, vectorEraseFrontQueue);
+    suite.compare("DoublyLinkedList_Queue", "VectorEraseFront_Queue");
+    suite.compare("DoublyLinkedList_Queue", "StdList_Queue");
+
+    suite.add("Stack_PushPop", CONTAINER_SIZES, stackPushPop);
+    suite.add("ArrayStack_PushPop", CONTAINER_SIZES, arrayStackPushPop);
+    suite.add("VectorFront_PushPop", CONTAINER_SIZES, vectorFrontPushPop);
+    suite.compare("Stack_PushPop", "VectorFront_PushPop");
+    suite.compare("ArrayStack_PushPop", "VectorFront_PushPop");
+
+    suite.add("PriorityQueue_PushPop", CONTAINER_SIZES, priorityQueuePushPop);
+    suite.add("StdPriorityQueue_PushPop", CONTAINER_SIZES, stdPriorityQueuePushPop);
+    suite.add("LinearMin_PushPop", CONTAINER_SIZES, linearMinPushPop);
+    suite.compare("PriorityQueue_PushPop", "LinearMin_PushPop");
+    suite.compare("PriorityQueue_PushPop", "StdPriorityQueue_PushPop");
+
+    return suite.run();
+}
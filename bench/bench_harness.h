@@ -0,0 +1,362 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// 仿 Google Benchmark 的最小基准框架（单头文件，无外部依赖）
+// 用法与 Google Benchmark 一致：
+//     void benchFoo(bench::State& state) {
+//         准备数据 (state.arg() 为规模参数) ...
+//         for (auto _ : state) { 被测操作; bench::doNotOptimize(结果); }
+//         state.setItemsProcessed(state.iterations());
+//     }
+//     suite.add("Foo", {1000, 10000}, benchFoo);
+// 命令行参数沿用 Google Benchmark 的名字：--benchmark_filter、--benchmark_min_time、
+// --benchmark_repetitions、--benchmark_out、--benchmark_format=json；
+// JSON 输出与其格式兼容，可以直接用 compare.py 等工具对比两次运行。
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// 阻止编译器把结果当作无用计算删掉
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+inline double processCpuSeconds() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+class State {
+public:
+    State(int64_t arg, int64_t iterations)
+        : argument(arg), max_iterations(iterations), remaining(iterations), items(0),
+          real_seconds(0), cpu_seconds(0), running(false) {}
+
+    int64_t arg() const { return argument; }
+    int64_t iterations() const { return max_iterations; }
+
+    // 准备工作不计时（每次循环内调用开销较大，只用于少量需要重建数据的基准）
+    void pauseTiming() {
+        real_seconds += std::chrono::duration<double>(Clock::now() - real_start).count();
+        cpu_seconds += processCpuSeconds() - cpu_start;
+        running = false;
+    }
+    void resumeTiming() {
+        running = true;
+        cpu_start = processCpuSeconds();
+        real_start = Clock::now();
+    }
+
+    void setItemsProcessed(int64_t count) { items = count; }
+
+    // for (auto _ : state) 循环
+    struct Iterator {
+        struct __attribute__((unused)) Value {};     // 循环变量 _ 不会触发未使用警告
+        State* state;
+        int64_t left;
+        Value operator*() const { return Value(); }
+        Iterator& operator++() { left--; return *this; }
+        bool operator!=(const Iterator&) {
+            if (left > 0) return true;
+            state->finish();
+            return false;
+        }
+    };
+    Iterator begin() {
+        resumeTiming();
+        return Iterator{this, remaining};
+    }
+    Iterator end() { return Iterator{this, 0}; }
+
+    double realSeconds() const { return real_seconds; }
+    double cpuSeconds() const { return cpu_seconds; }
+    int64_t itemsProcessed() const { return items; }
+
+private:
+    void finish() {
+        if (running) pauseTiming();
+    }
+
+    int64_t argument;
+    int64_t max_iterations;
+    int64_t remaining;
+    int64_t items;
+    double real_seconds;
+    double cpu_seconds;
+    bool running;
+    Clock::time_point real_start;
+    double cpu_start = 0;
+};
+
+class Suite {
+public:
+    using Function = std::function<void(State&)>;
+
+    Suite(const std::string& title, int argc, char** argv)
+        : title(title), filter(".*"), min_time(0.2), repetitions(3), json(false), executable(argv[0]) {
+        for (int i = 1; i < argc; i++) {
+            std::string flag = argv[i];
+            std::string value = flag.substr(flag.find('=') + 1);
+            if (flag.rfind("--benchmark_filter=", 0) == 0) filter = value;
+            else if (flag.rfind("--benchmark_min_time=", 0) == 0) min_time = std::atof(value.c_str());
+            else if (flag.rfind("--benchmark_repetitions=", 0) == 0) repetitions = std::max(1, std::atoi(value.c_str()));
+            else if (flag.rfind("--benchmark_out=", 0) == 0) out_path = value;
+            else if (flag.rfind("--benchmark_format=", 0) == 0) json = value == "json";
+            else std::cerr << "忽略未知参数: " << flag << "\n";
+        }
+    }
+
+    void add(const std::string& name, const std::vector<int64_t>& args, Function function) {
+        for (int64_t arg : args) {
+            cases.push_back({name, arg, function});
+        }
+    }
+
+    // 登记实现与朴素基线的对照，汇总时按相同规模参数给出加速比；target > 0 时标出未达标的规模
+    void compare(const std::string& name, const std::string& baseline, double target = 0) {
+        comparisons.push_back({name, baseline, target});
+    }
+
+    // 先全部运行，再统一输出（控制台表格；指定 --benchmark_out 时另写 JSON 文件）
+    int run() {
+        std::regex pattern(filter);
+        for (const auto& c : cases) {
+            std::string full_name = c.name + "/" + std::to_string(c.arg);
+            if (!std::regex_search(full_name, pattern)) continue;
+            results.push_back(measure(c, full_name));
+        }
+
+        if (json) {
+            writeJson(std::cout);
+        } else {
+            printConsole();
+        }
+        if (!out_path.empty()) {
+            std::ofstream file(out_path);
+            if (!file) {
+                std::cerr << "无法写入结果文件: " << out_path << "\n";
+                return 1;
+            }
+            writeJson(file);
+        }
+        return 0;
+    }
+
+private:
+    struct Case {
+        std::string name;
+        int64_t arg;
+        Function function;
+    };
+
+    struct Comparison {
+        std::string name;
+        std::string baseline;
+        double target;
+    };
+
+    struct Result {
+        std::string family;
+        std::string name;
+        int64_t arg;
+        int64_t iterations;
+        double real_ns;         // 每次迭代，各轮中位数
+        double cpu_ns;
+        double stddev_ns;       // 各轮之间的标准差
+        double items_per_second;
+    };
+
+    struct Run {
+        double real_seconds;
+        double cpu_seconds;
+        int64_t items;
+    };
+
+    static Run runOnce(const Case& c, int64_t iterations) {
+        State state(c.arg, iterations);
+        c.function(state);
+        return {state.realSeconds(), state.cpuSeconds(), state.itemsProcessed()};
+    }
+
+    // 与 Google Benchmark 相同的迭代次数估计：从 1 次开始放大，直到单轮耗时达到 min_time
+    Result measure(const Case& c, const std::string& full_name) const {
+        int64_t iterations = 1;
+        Run run = runOnce(c, iterations);
+        while (run.real_seconds < min_time && iterations < 1000000000) {
+            double factor = run.real_seconds > 0 ? min_time * 1.4 / run.real_seconds : 10.0;
+            factor = std::min(10.0, std::max(2.0, factor));
+            iterations = static_cast<int64_t>(iterations * factor);
+            run = runOnce(c, iterations);
+        }
+
+        std::vector<Run> runs = {run};
+        while (static_cast<int>(runs.size()) < repetitions) {
+            runs.push_back(runOnce(c, iterations));
+        }
+
+        std::vector<double> real;
+        std::vector<double> cpu;
+        double items_rate = 0;
+        for (const auto& r : runs) {
+            real.push_back(r.real_seconds * 1e9 / iterations);
+            cpu.push_back(r.cpu_seconds * 1e9 / iterations);
+            if (r.items > 0 && r.real_seconds > 0) items_rate += r.items / r.real_seconds;
+        }
+        double mean = 0;
+        for (double v : real) mean += v;
+        mean /= real.size();
+        double variance = 0;
+        for (double v : real) variance += (v - mean) * (v - mean);
+        double stddev = real.size() > 1 ? std::sqrt(variance / (real.size() - 1)) : 0;
+
+        return {c.name, full_name, c.arg, iterations, median(real), median(cpu), stddev,
+                items_rate / runs.size()};
+    }
+
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+    }
+
+    const Result* find(const std::string& family, int64_t arg) const {
+        for (const auto& r : results) {
+            if (r.family == family && r.arg == arg) return &r;
+        }
+        return nullptr;
+    }
+
+    static std::string formatNanos(double ns) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(ns < 100 ? 2 : ns < 10000 ? 1 : 0) << ns;
+        return out.str();
+    }
+
+    void printConsole() const {
+        std::cout << "=== " << title << " ===\n\n";
+        std::cout << "每项取 " << repetitions << " 轮中位数, 单轮不少于 " << min_time << " 秒\n\n";
+        // 汉字按 3 字节、2 列宽计算补齐
+        std::cout << std::left << std::setw(42) << "基准" << std::right << std::setw(16) << "时间(ns)"
+                  << std::setw(14) << "CPU(ns)" << std::setw(16) << "迭代次数" << "  吞吐\n";
+        for (const auto& r : results) {
+            std::cout << std::left << std::setw(40) << r.name << std::right << std::setw(14) << formatNanos(r.real_ns)
+                      << std::setw(14) << formatNanos(r.cpu_ns) << std::setw(12) << r.iterations;
+            if (r.items_per_second > 0) {
+                std::cout << "  " << std::fixed << std::setprecision(2) << r.items_per_second / 1e6 << " M/s";
+            }
+            std::cout << "\n";
+        }
+
+        bool header = false;
+        for (const auto& c : comparisons) {
+            for (const auto& r : results) {
+                if (r.family != c.name) continue;
+                const Result* base = find(c.baseline, r.arg);
+                if (!base) continue;
+                if (!header) {
+                    std::cout << "\n=== 相对朴素基线的加速比 ===\n";
+                    header = true;
+                }
+                double speedup = base->real_ns / r.real_ns;
+                std::cout << "  " << r.name << " 对比 " << c.baseline << ": " << std::fixed << std::setprecision(1)
+                          << speedup << "x" << (c.target > 0 && speedup < c.target ? "  (未达到目标)" : "") << "\n";
+            }
+        }
+    }
+
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    void writeJson(std::ostream& out) const {
+        char date[64];
+        time_t now = time(nullptr);
+        struct tm local;
+        localtime_r(&now, &local);
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &local);
+        char host[256] = {0};
+        gethostname(host, sizeof(host) - 1);
+
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"host_name\": \"" << escape(host) << "\",\n"
+            << "    \"executable\": \"" << escape(executable) << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+            << "    \"library_build_type\": \"release\"\n"
+#else
+            << "    \"library_build_type\": \"debug\"\n"
+#endif
+            << "  },\n  \"benchmarks\": [";
+        out << std::setprecision(10);
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << (i ? "," : "") << "\n    {\n"
+                << "      \"name\": \"" << escape(r.name) << "\",\n"
+                << "      \"run_name\": \"" << escape(r.name) << "\",\n"
+                << "      \"run_type\": \"iteration\",\n"
+                << "      \"repetitions\": " << repetitions << ",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"real_time\": " << r.real_ns << ",\n"
+                << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+                << "      \"time_unit\": \"ns\",\n"
+                << "      \"real_time_stddev\": " << r.stddev_ns;
+            if (r.items_per_second > 0) {
+                out << ",\n      \"items_per_second\": " << r.items_per_second;
+            }
+            for (const auto& c : comparisons) {
+                const Result* base = c.name == r.family ? find(c.baseline, r.arg) : nullptr;
+                if (base) {
+                    out << ",\n      \"speedup_vs_" << escape(c.baseline) << "\": " << base->real_ns / r.real_ns;
+                }
+            }
+            out << "\n    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    std::string title;
+    std::string filter;
+    double min_time;
+    int repetitions;
+    bool json;
+    std::string out_path;
+    std::string executable;
+    std::vector<Case> cases;
+    std::vector<Comparison> comparisons;
+    std::vector<Result> results;
+};
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_H
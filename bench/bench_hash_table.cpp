@@ -0,0 +1,123 @@
+#include "../include/hash_table.h"
+#include "chained_hash_table.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <string>
+
+// 开放寻址（Robin Hood）HashTable 与原链地址法实现的性能对比
+// 覆盖插入、命中查找、未命中查找、删除四种操作，规模 1k / 10k / 100k
+
+struct BenchResult {
+    double insert_ns;
+    double find_hit_ns;
+    double find_miss_ns;
+    double remove_ns;
+};
+
+template<typename Clock = std::chrono::steady_clock>
+double nanosPerOp(typename Clock::time_point start, typename Clock::time_point end, size_t ops) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+template<typename Table>
+BenchResult runBenchmark(const std::vector<std::shared_ptr<Contact>>& contacts,
+                         const std::vector<int>& lookup_order,
+                         const std::vector<int>& missing_keys) {
+    using Clock = std::chrono::steady_clock;
+    BenchResult result;
+    Table table;
+    size_t sink = 0;  // 防止编译器优化掉查找
+
+    auto start = Clock::now();
+    for (const auto& contact : contacts) {
+        table.insert(contact);
+    }
+    auto end = Clock::now();
+    result.insert_ns = nanosPerOp(start, end, contacts.size());
+
+    start = Clock::now();
+    for (int key : lookup_order) {
+        if (table.find(key) != nullptr) sink++;
+    }
+    end = Clock::now();
+    result.find_hit_ns = nanosPerOp(start, end, lookup_order.size());
+
+    start = Clock::now();
+    for (int key : missing_keys) {
+        if (table.find(key) != nullptr) sink++;
+    }
+    end = Clock::now();
+    result.find_miss_ns = nanosPerOp(start, end, missing_keys.size());
+
+    start = Clock::now();
+    for (int key : lookup_order) {
+        if (table.remove(key)) sink++;
+    }
+    end = Clock::now();
+    result.remove_ns = nanosPerOp(start, end, lookup_order.size());
+
+    if (sink != lookup_order.size() * 2) {
+        std::cerr << "结果校验失败: " << sink << std::endl;
+    }
+    return result;
+}
+
+void benchmarkSize(size_t count, std::mt19937& gen) {
+    // 稀疏随机ID，避免连续ID让两种散列都落在理想分布上
+    std::vector<int> ids;
+    ids.reserve(count * 2);
+    std::uniform_int_distribution<int> dis(1, 1 << 30);
+    while (ids.size() < count * 2) {
+        ids.push_back(dis(gen));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    std::shuffle(ids.begin(), ids.end(), gen);
+
+    std::vector<int> present(ids.begin(), ids.begin() + count);
+    std::vector<int> missing(ids.begin() + count, ids.begin() + std::min(ids.size(), count * 2));
+
+    std::vector<std::shared_ptr<Contact>> contacts;
+    contacts.reserve(count);
+    for (int id : present) {
+        contacts.push_back(std::make_shared<Contact>(
+            id, "用户" + std::to_string(id), "2021" + std::to_string(id),
+            "138" + std::to_string(id), "user" + std::to_string(id) + "@czu.edu.cn"));
+    }
+
+    std::vector<int> lookup_order = present;
+    std::shuffle(lookup_order.begin(), lookup_order.end(), gen);
+
+    BenchResult chained = runBenchmark<ChainedHashTable>(contacts, lookup_order, missing);
+    BenchResult robin = runBenchmark<HashTable>(contacts, lookup_order, missing);
+
+    auto row = [](const char* name, double before, double after) {
+        std::cout << "   " << std::left << std::setw(10) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << before
+                  << std::setw(12) << after
+                  << std::setw(10) << std::setprecision(2) << (after > 0 ? before / after : 0.0) << "x\n";
+    };
+
+    std::cout << "规模 " << count << "（单位: ns/op）\n";
+    std::cout << "   操作          链地址法   开放寻址     加速比\n";
+    row("插入", chained.insert_ns, robin.insert_ns);
+    row("命中查找", chained.find_hit_ns, robin.find_hit_ns);
+    row("未命中查找", chained.find_miss_ns, robin.find_miss_ns);
+    row("删除", chained.remove_ns, robin.remove_ns);
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "=== 哈希表基准测试: 链地址法 vs Robin Hood 开放寻址 ===\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    for (size_t count : {1000, 10000, 100000}) {
+        benchmarkSize(count, gen);
+    }
+
+    std::cout << "=== 哈希表基准测试完成 ===\n";
+    return 0;
+}
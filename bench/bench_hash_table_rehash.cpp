@@ -0,0 +1,92 @@
+#include "../include/hash_table.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <string>
+
+// 一次性扩容 vs 渐进式扩容：逐条插入的延迟分布（均值 / p50 / p99 / p99.9 / 最大值）
+// 模拟批量导入联系人，扩容触发点会在一次性模式下产生明显的延迟尖峰
+
+struct LatencyStats {
+    double mean_ns;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
+LatencyStats measureInsertLatency(const std::vector<std::shared_ptr<Contact>>& contacts, bool incremental) {
+    using Clock = std::chrono::steady_clock;
+
+    HashTable table;
+    table.setIncrementalResize(incremental);
+
+    std::vector<double> samples;
+    samples.reserve(contacts.size());
+
+    for (const auto& contact : contacts) {
+        auto start = Clock::now();
+        table.insert(contact);
+        auto end = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    double total = 0;
+    for (double sample : samples) total += sample;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * (samples.size() - 1));
+        return samples[index];
+    };
+
+    LatencyStats stats;
+    stats.mean_ns = total / samples.size();
+    stats.p50_ns = percentile(0.50);
+    stats.p99_ns = percentile(0.99);
+    stats.p999_ns = percentile(0.999);
+    stats.max_ns = samples.back();
+    return stats;
+}
+
+void printStats(const char* name, const LatencyStats& stats) {
+    std::cout << "   " << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << stats.mean_ns
+              << std::setw(10) << stats.p50_ns
+              << std::setw(10) << stats.p99_ns
+              << std::setw(12) << stats.p999_ns
+              << std::setw(14) << stats.max_ns << "\n";
+}
+
+int main() {
+    std::cout << "=== 哈希表扩容延迟分布测试 ===\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+
+    for (size_t count : {100000, 1000000}) {
+        std::vector<std::shared_ptr<Contact>> contacts;
+        contacts.reserve(count);
+        for (size_t i = 1; i <= count; i++) {
+            int id = static_cast<int>(i);
+            contacts.push_back(std::make_shared<Contact>(
+                id, "用户" + std::to_string(id), "",
+                "138" + std::to_string(id), "user" + std::to_string(id) + "@czu.edu.cn"));
+        }
+        std::shuffle(contacts.begin(), contacts.end(), gen);
+
+        LatencyStats stop_the_world = measureInsertLatency(contacts, false);
+        LatencyStats incremental = measureInsertLatency(contacts, true);
+
+        std::cout << "插入 " << count << " 个联系人（单位: ns）\n";
+        std::cout << "   模式              均值       p50       p99       p99.9        最大值\n";
+        printStats("一次性扩容", stop_the_world);
+        printStats("渐进式扩容", incremental);
+        std::cout << "   最大延迟降低: " << std::setprecision(1)
+                  << (incremental.max_ns > 0 ? stop_the_world.max_ns / incremental.max_ns : 0.0) << "x\n\n";
+    }
+
+    std::cout << "=== 哈希表扩容延迟分布测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "../include/logger.h"
+#include "../include/conflict_detector.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// 日志对调用方的开销：原来的 std::cout << ... << std::endl（每行一次 write 系统调用）
+// 对比异步日志（调用方只格式化并入队）、运行期过滤、编译期删除，以及多线程同时写日志
+// 测量期间 stdout/stderr 重定向到 /dev/null，只计调用方耗时；写出线程的吞吐单独列出
+
+namespace {
+
+const int OPERATIONS = 200000;
+const int BATCH = 4096;             // 每批不超过环形缓冲区一半，批间等待写出，避免丢弃
+const int THREADS = 4;
+const int HOT_PATH_OPERATIONS = 50000;
+const int ROUNDS = 3;
+
+const char* RESOURCES[] = {"报告厅", "体育馆", "实验室", "大礼堂", "会议室A", "会议室B"};
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name;
+    double nanos_per_op;
+};
+
+// 把 stdout/stderr 指向 /dev/null，析构时恢复
+class SilenceOutput {
+public:
+    SilenceOutput() {
+        std::cout.flush();
+        saved_out = dup(STDOUT_FILENO);
+        saved_err = dup(STDERR_FILENO);
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        close(null_fd);
+    }
+    ~SilenceOutput() {
+        Logger::instance().flush();
+        std::cout.flush();
+        dup2(saved_out, STDOUT_FILENO);
+        dup2(saved_err, STDERR_FILENO);
+        close(saved_out);
+        close(saved_err);
+    }
+
+private:
+    int saved_out;
+    int saved_err;
+};
+
+// 分批执行，只计每批内的耗时；批间等待写出线程清空缓冲区（不计时）
+template <typename Operation>
+double measureBatched(int operations, Operation operation) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        double elapsed = 0;
+        for (int done = 0; done < operations; done += BATCH) {
+            int count = std::min(BATCH, operations - done);
+            auto start = Clock::now();
+            operation(done, count);
+            elapsed += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            Logger::instance().flush();
+        }
+        elapsed /= operations;
+        if (round == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+std::string slotStart(int index) {
+    char buffer[16];
+    int minute = (index % 360) * 4;
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d", minute / 60, minute % 60);
+    return buffer;
+}
+
+std::string slotEnd(int index) {
+    char buffer[16];
+    int minute = (index % 360) * 4 + 3;
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d", minute / 60, minute % 60);
+    return buffer;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> pick(0, 5);
+    std::vector<int> resources(OPERATIONS);
+    for (auto& resource : resources) {
+        resource = pick(gen);
+    }
+
+    std::vector<Result> results;
+    double throughput_ms = 0;
+    double hot_path_info = 0;
+    double hot_path_debug = 0;
+    {
+        SilenceOutput silence;
+
+        results.push_back({"std::cout << ... << std::endl (原方式)", measureBatched(OPERATIONS, [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                std::cout << "预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]" << std::endl;
+            }
+        })});
+        results.push_back({"LOG_INFO 异步写出", measureBatched(OPERATIONS, [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                LOG_INFO("预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]");
+            }
+        })});
+        results.push_back({"LOG_INFO 结构化字段", measureBatched(OPERATIONS, [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                LOG_INFO("预约成功" << logField("resource", RESOURCES[resources[i]]) << logField("id", i));
+            }
+        })});
+
+        Logger::instance().setLevel(LOG_LEVEL_WARN);
+        results.push_back({"LOG_INFO 运行期过滤 (级别 WARN)", measureBatched(OPERATIONS, [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                LOG_INFO("预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]");
+            }
+        })});
+        Logger::instance().setLevel(LOG_LEVEL_INFO);
+
+        results.push_back({"LOG_DEBUG 编译期删除", measureBatched(OPERATIONS, [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                LOG_DEBUG("预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]");
+                asm volatile("" : : "r"(i) : "memory");
+            }
+        })});
+
+        double contended = measureBatched(OPERATIONS, [&](int first, int count) {
+            std::vector<std::thread> workers;
+            for (int t = 0; t < THREADS; t++) {
+                workers.emplace_back([&resources, first, count, t]() {
+                    for (int i = first + t; i < first + count; i += THREADS) {
+                        LOG_INFO("预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]");
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+        });
+        results.push_back({std::to_string(THREADS) + " 线程同时 LOG_INFO (含创建线程)", contended});
+
+        // 写出线程吞吐：连续提交后等待全部写完
+        auto start = Clock::now();
+        for (int done = 0; done < OPERATIONS; done += BATCH) {
+            for (int i = done; i < std::min(OPERATIONS, done + BATCH); i++) {
+                LOG_INFO("预约成功:  活动" << i << " @ " << RESOURCES[resources[i]] << " [ID: " << i << "]");
+            }
+            Logger::instance().flush();
+        }
+        throughput_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // 真实热路径：预约后立即取消；按当前构建的 LOG_COMPILE_LEVEL，成功日志为 DEBUG
+        ConflictDetector detector;
+        detector.initialize(std::vector<std::string>(std::begin(RESOURCES), std::end(RESOURCES)));
+        auto hotPath = [&](int first, int count) {
+            for (int i = first; i < first + count; i++) {
+                int id = detector.addReservation(RESOURCES[resources[i % OPERATIONS]], "活动",
+                                                 slotStart(i), slotEnd(i), 5, "");
+                detector.removeReservation(id);
+            }
+        };
+        hot_path_info = measureBatched(HOT_PATH_OPERATIONS, hotPath);
+        Logger::instance().setLevel(LOG_LEVEL_DEBUG);
+        hot_path_debug = measureBatched(HOT_PATH_OPERATIONS, hotPath);
+        Logger::instance().setLevel(LOG_LEVEL_INFO);
+    }
+
+    std::cout << "=== 日志开销测试 ===\n\n";
+    std::cout << "每项 " << OPERATIONS << " 条, 每批 " << BATCH << " 条, 取 " << ROUNDS << " 轮最好成绩 (仅调用方耗时)\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(44) << result.name << std::right << std::setw(10)
+                  << result.nanos_per_op << " ns/条\n";
+    }
+    std::cout << "\n写出线程吞吐: " << OPERATIONS << " 条 " << throughput_ms << " ms ("
+              << OPERATIONS / throughput_ms * 1000 << " 条/秒)\n";
+    std::cout << "丢弃日志: " << Logger::instance().droppedCount() << " 条\n";
+    std::cout << "\n预约 + 取消 (每次 " << HOT_PATH_OPERATIONS << " 对, LOG_COMPILE_LEVEL=" << LOG_COMPILE_LEVEL << "):\n";
+    std::cout << "  运行期级别 INFO:  " << std::setw(10) << hot_path_info / 1000 << " 微秒/对\n";
+    std::cout << "  运行期级别 DEBUG: " << std::setw(10) << hot_path_debug / 1000 << " 微秒/对\n";
+    return 0;
+}
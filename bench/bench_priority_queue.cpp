@@ -0,0 +1,177 @@
+#include "../include/priority_queue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <queue>
+#include <string>
+#include <vector>
+
+// d 叉堆分叉数对比：2 / 4 / 8 叉，以 std::priority_queue 为参照
+// 1. 整数入队后全部出队
+// 2. 入队、改优先级、出队混合（候补队列的典型操作）
+// 3. 大元素（与候补请求大小相当的结构体）入队出队
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t ELEMENT_COUNT = 1000000;
+const size_t MIXED_OPERATIONS = 2000000;
+const size_t REQUEST_COUNT = 200000;
+
+volatile long long sink = 0;  // 防止结果被优化掉
+
+struct Request {
+    int priority;
+    uint64_t sequence;
+    std::string resource;
+    std::string activity;
+};
+
+struct RequestOrder {
+    bool operator()(const Request& a, const Request& b) const {
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return a.sequence < b.sequence;
+    }
+};
+
+// std::priority_queue 的比较器方向相反
+struct RequestOrderReversed {
+    bool operator()(const Request& a, const Request& b) const {
+        return RequestOrder()(b, a);
+    }
+};
+
+template<typename Body>
+double millis(Body body) {
+    auto start = Clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template<size_t Arity>
+double pushPopInts(const std::vector<int>& values) {
+    return millis([&values]() {
+        PriorityQueue<int, std::less<int>, Arity> queue;
+        queue.reserve(values.size());
+        for (int value : values) queue.push(value);
+        while (!queue.isEmpty()) sink = sink + queue.pop();
+    });
+}
+
+double pushPopIntsStd(const std::vector<int>& values) {
+    return millis([&values]() {
+        std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+        for (int value : values) queue.push(value);
+        while (!queue.empty()) {
+            sink = sink + queue.top();
+            queue.pop();
+        }
+    });
+}
+
+// 操作序列：0 入队，1 提高优先级，2 出队
+template<size_t Arity>
+double mixedWorkload(const std::vector<int>& operations, const std::vector<int>& values) {
+    return millis([&]() {
+        using Queue = PriorityQueue<int, std::less<int>, Arity>;
+        Queue queue;
+        std::vector<typename Queue::Handle> handles;
+        for (size_t i = 0; i < operations.size(); i++) {
+            if (operations[i] == 0 || queue.isEmpty()) {
+                handles.push_back(queue.push(values[i]));
+            } else if (operations[i] == 1) {
+                typename Queue::Handle handle = handles[values[i] % handles.size()];
+                if (queue.contains(handle)) {
+                    queue.decreaseKey(handle, queue.get(handle) / 2);
+                }
+            } else {
+                sink = sink + queue.pop();
+            }
+        }
+    });
+}
+
+template<size_t Arity>
+double pushPopRequests(const std::vector<Request>& requests) {
+    return millis([&requests]() {
+        PriorityQueue<Request, RequestOrder, Arity> queue;
+        queue.reserve(requests.size());
+        for (const auto& request : requests) queue.push(request);
+        while (!queue.isEmpty()) sink = sink + queue.pop().priority;
+    });
+}
+
+double pushPopRequestsStd(const std::vector<Request>& requests) {
+    return millis([&requests]() {
+        std::priority_queue<Request, std::vector<Request>, RequestOrderReversed> queue;
+        for (const auto& request : requests) queue.push(request);
+        while (!queue.empty()) {
+            sink = sink + queue.top().priority;
+            queue.pop();
+        }
+    });
+}
+
+struct Row {
+    const char* label;
+    double ints;
+    double mixed;
+    double requests;
+};
+
+} // namespace
+
+int main() {
+    std::cout << "=== 优先队列分叉数对比测试 ===\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> number(0, 100000000);
+    std::uniform_int_distribution<int> operation(0, 9);
+    std::uniform_int_distribution<int> priority(1, 10);
+
+    std::vector<int> values(ELEMENT_COUNT);
+    for (auto& value : values) value = number(gen);
+
+    // 入队 50%，改优先级 20%，出队 30%
+    std::vector<int> operations(MIXED_OPERATIONS);
+    std::vector<int> operands(MIXED_OPERATIONS);
+    for (size_t i = 0; i < MIXED_OPERATIONS; i++) {
+        int roll = operation(gen);
+        operations[i] = roll < 5 ? 0 : (roll < 7 ? 1 : 2);
+        operands[i] = number(gen);
+    }
+
+    std::vector<Request> requests(REQUEST_COUNT);
+    for (size_t i = 0; i < REQUEST_COUNT; i++) {
+        requests[i].priority = priority(gen);
+        requests[i].sequence = i;
+        requests[i].resource = "教学楼A-" + std::to_string(i % 40);
+        requests[i].activity = "社团活动排练与场地布置-" + std::to_string(i);
+    }
+
+    // 先收集全部结果再统一输出
+    std::vector<Row> rows;
+    rows.push_back({"2 叉", pushPopInts<2>(values), mixedWorkload<2>(operations, operands), pushPopRequests<2>(requests)});
+    rows.push_back({"4 叉", pushPopInts<4>(values), mixedWorkload<4>(operations, operands), pushPopRequests<4>(requests)});
+    rows.push_back({"8 叉", pushPopInts<8>(values), mixedWorkload<8>(operations, operands), pushPopRequests<8>(requests)});
+    double std_ints = pushPopIntsStd(values);
+    double std_requests = pushPopRequestsStd(requests);
+
+    std::cout << "整数: " << ELEMENT_COUNT << " 个，混合操作: " << MIXED_OPERATIONS
+              << " 次，候补请求: " << REQUEST_COUNT << " 个\n\n";
+    std::cout << "   实现              整数入队出队(ms)   混合操作(ms)   候补请求(ms)\n";
+    for (const auto& row : rows) {
+        std::cout << "   PriorityQueue " << row.label << std::fixed << std::setprecision(1)
+                  << std::setw(17) << row.ints
+                  << std::setw(15) << row.mixed
+                  << std::setw(15) << row.requests << "\n";
+    }
+    std::cout << "   std::priority_queue" << std::setw(14) << std_ints
+              << std::setw(15) << "-"
+              << std::setw(15) << std_requests << "\n";
+
+    std::cout << "\n=== 优先队列分叉数对比测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include "../include/schedule_optimizer.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// 学期排课优化对比：按优先级逐个预约（原有做法）vs 全局优化
+// 合成实例：5 个工作日，每个请求限定某天内的时间窗口和 1-4 个可选场地，
+// 请求总时长约为场地可用时长的 1.3 倍（必然有请求无法安排）
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int DAYS = 5;
+const int DAY_START = 8 * 60;
+const int DAY_END = 22 * 60;
+const size_t INSTANCE_SIZES[] = {1000, 5000, 10000};
+const int BUDGETS_MS[] = {50, 500};
+
+struct Instance {
+    std::vector<std::string> resources;
+    std::vector<ScheduleRequest> requests;
+};
+
+Instance makeInstance(size_t request_count, std::mt19937& gen) {
+    std::uniform_int_distribution<int> duration_steps(1, 6);     // 30-180 分钟
+    std::uniform_int_distribution<int> priority(1, 10);
+    std::uniform_int_distribution<int> day(0, DAYS - 1);
+    std::uniform_int_distribution<int> slack(0, 8);              // 窗口比时长多 0-240 分钟
+    std::uniform_int_distribution<int> choices(1, 4);
+
+    Instance instance;
+    long long total_minutes = 0;
+    std::vector<int> durations(request_count);
+    for (auto& duration : durations) {
+        duration = duration_steps(gen) * 30;
+        total_minutes += duration;
+    }
+    size_t resource_count = std::max<size_t>(2, total_minutes / (1.3 * DAYS * (DAY_END - DAY_START)));
+    for (size_t i = 0; i < resource_count; i++) {
+        instance.resources.push_back("教室" + std::to_string(i + 1));
+    }
+    std::uniform_int_distribution<size_t> resource(0, resource_count - 1);
+
+    for (size_t i = 0; i < request_count; i++) {
+        ScheduleRequest request;
+        request.id = static_cast<int>(i + 1);
+        request.priority = priority(gen);
+        request.duration_minutes = durations[i];
+        int window = request.duration_minutes + slack(gen) * 30;
+        std::uniform_int_distribution<int> start(DAY_START, DAY_END - window);
+        request.window_start = day(gen) * 1440 + start(gen) / 30 * 30;
+        request.window_end = request.window_start + window;
+        int allowed = choices(gen);
+        for (int c = 0; c < allowed; c++) {
+            request.allowed_resources.push_back(instance.resources[resource(gen)]);
+        }
+        instance.requests.push_back(request);
+    }
+    return instance;
+}
+
+// 原有做法：按优先级从高到低，在第一个可用场地的最早空闲时间预约
+long long priorityFirstFit(const Instance& instance) {
+    std::vector<const ScheduleRequest*> order;
+    for (const auto& request : instance.requests) order.push_back(&request);
+    std::stable_sort(order.begin(), order.end(), [](const ScheduleRequest* a, const ScheduleRequest* b) {
+        return a->priority > b->priority;
+    });
+
+    std::map<std::string, std::map<int, int>> booked;  // 场地 -> (开始 -> 结束)
+    long long total = 0;
+    for (const ScheduleRequest* request : order) {
+        bool placed = false;
+        for (const auto& name : request->allowed_resources) {
+            auto& line = booked[name];
+            for (int start = request->window_start; start + request->duration_minutes <= request->window_end; start += 30) {
+                int end = start + request->duration_minutes;
+                auto next = line.lower_bound(end);
+                bool free = next == line.begin() || std::prev(next)->second <= start;
+                if (free) {
+                    line[start] = end;
+                    total += request->priority;
+                    placed = true;
+                    break;
+                }
+            }
+            if (placed) break;
+        }
+    }
+    return total;
+}
+
+// 校验：不重叠、在窗口内、使用允许的场地
+bool validate(const Instance& instance, const ScheduleResult& result) {
+    std::map<std::string, std::vector<std::pair<int, int>>> lines;
+    long long total = 0;
+    for (const auto& assignment : result.assignments) {
+        const ScheduleRequest* request = &instance.requests[assignment.request_index];
+        if (assignment.start_minutes < request->window_start || assignment.end_minutes > request->window_end ||
+            assignment.end_minutes - assignment.start_minutes != request->duration_minutes ||
+            std::find(request->allowed_resources.begin(), request->allowed_resources.end(),
+                      assignment.resource_name) == request->allowed_resources.end()) {
+            return false;
+        }
+        lines[assignment.resource_name].emplace_back(assignment.start_minutes, assignment.end_minutes);
+        total += request->priority;
+    }
+    for (auto& entry : lines) {
+        std::sort(entry.second.begin(), entry.second.end());
+        for (size_t i = 1; i < entry.second.size(); i++) {
+            if (entry.second[i].first < entry.second[i - 1].second) return false;
+        }
+    }
+    return total == result.total_priority;
+}
+
+struct Row {
+    size_t requests;
+    size_t resources;
+    long long upper_bound;
+    long long baseline;
+    double baseline_ms;
+    std::vector<ScheduleResult> optimized;
+    bool valid;
+};
+
+} // namespace
+
+int main() {
+    std::cout << "=== 学期排课优化对比测试 ===\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+
+    // 先收集全部结果再统一输出
+    std::vector<Row> rows;
+    for (size_t size : INSTANCE_SIZES) {
+        Instance instance = makeInstance(size, gen);
+        ScheduleOptimizer optimizer(instance.resources);
+
+        Row row;
+        row.requests = size;
+        row.resources = instance.resources.size();
+        auto start = Clock::now();
+        row.baseline = priorityFirstFit(instance);
+        row.baseline_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        row.valid = true;
+        for (int budget : BUDGETS_MS) {
+            OptimizerOptions options;
+            options.time_budget_ms = budget;
+            ScheduleResult result = optimizer.optimize(instance.requests, options);
+            row.valid = row.valid && validate(instance, result);
+            row.upper_bound = result.requested_priority;
+            row.optimized.push_back(result);
+        }
+        rows.push_back(row);
+    }
+
+    std::cout << "优先级合计（占全部请求优先级之和的比例）\n";
+    std::cout << "   请求数   场地数   逐个预约           优化 " << BUDGETS_MS[0] << "ms"
+              << "          优化 " << BUDGETS_MS[1] << "ms\n";
+    for (const auto& row : rows) {
+        std::cout << std::setw(9) << row.requests << std::setw(9) << row.resources;
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(10) << row.baseline << " (" << std::setw(4)
+                  << 100.0 * row.baseline / row.upper_bound << "%)";
+        for (const auto& result : row.optimized) {
+            std::cout << std::setw(10) << result.total_priority << " (" << std::setw(4)
+                      << 100.0 * result.total_priority / row.upper_bound << "%)";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "\n耗时与搜索轮数\n";
+    std::cout << "   请求数   逐个预约(ms)   优化耗时(ms) / 挤出轮数\n";
+    for (const auto& row : rows) {
+        std::cout << std::setw(9) << row.requests << std::setw(14) << row.baseline_ms << "   ";
+        for (const auto& result : row.optimized) {
+            std::cout << std::setw(10) << result.elapsed_ms << " / " << std::setw(7) << result.iterations;
+        }
+        std::cout << "   校验: " << (row.valid ? "通过" : "失败") << "\n";
+    }
+
+    std::cout << "\n=== 学期排课优化对比测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include "../include/contact_index.h"
+#include "../include/conflict_detector.h"
+#include "../include/index_snapshot.h"
+#include "../include/parallel_for.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <string>
+
+// 冷启动耗时：从 SQLite 读出后重建索引 vs 映射快照文件恢复
+// 10万联系人 + 若干资源预约；恢复后逐项比对查询结果
+
+namespace {
+
+const int CONTACT_COUNT = 100000;
+const int RESERVATION_COUNT = 2000;
+const int ROUNDS = 3;
+
+const char* SURNAMES[] = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴"};
+const char* GIVEN[] = {"伟", "芳", "娜", "敏", "静", "磊", "洋", "勇", "艳", "杰",
+                       "涛", "明", "超", "秀", "霞", "平", "刚", "桂", "华", "丽"};
+const char* RESOURCES[] = {"报告厅", "体育馆", "实验室", "大礼堂", "会议室A", "会议室B"};
+
+using Clock = std::chrono::steady_clock;
+
+double millisSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 用单个事务批量写入测试数据（逐条自动提交太慢）
+bool populateDatabase(const std::string& path) {
+    SQLiteManager schema(path);
+    if (!schema.init()) return false;
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open(path.c_str(), &db) != SQLITE_OK) return false;
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> surname(0, 9);
+    std::uniform_int_distribution<int> given(0, 19);
+
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(db, "INSERT INTO contacts (name, student_id, phone, email, department) VALUES (?, ?, ?, ?, '计算机学院');",
+                       -1, &stmt, nullptr);
+    for (int i = 1; i <= CONTACT_COUNT; i++) {
+        std::string name = std::string(SURNAMES[surname(gen)]) + GIVEN[given(gen)] + GIVEN[given(gen)];
+        std::string student_id = "2021" + std::to_string(i);
+        std::string phone = "138" + std::to_string(10000000 + i);
+        std::string email = "user" + std::to_string(i) + "@czu.edu.cn";
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, student_id.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 4, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+    return true;
+}
+
+void populateReservations(ConflictDetector& detector) {
+    std::vector<std::string> resources(std::begin(RESOURCES), std::end(RESOURCES));
+    detector.initialize(resources);
+    for (int i = 0; i < RESERVATION_COUNT; i++) {
+        // 各资源按4分钟一档依次排开，互不冲突
+        int minute = static_cast<int>(i / resources.size()) * 4;
+        char start[16];
+        char end[16];
+        std::snprintf(start, sizeof(start), "%02d:%02d", minute / 60, minute % 60);
+        std::snprintf(end, sizeof(end), "%02d:%02d", (minute + 3) / 60, (minute + 3) % 60);
+        detector.addReservation(resources[i % resources.size()], "活动" + std::to_string(i),
+                                start, end, 1 + i % 10, "138" + std::to_string(i));
+    }
+}
+
+// 重建路径：流式读取全部联系人后并行构建
+double rebuildStartup(const std::string& db_path, ContactIndex& index) {
+    auto start = Clock::now();
+    SQLiteManager db(db_path);
+    db.init();
+    std::vector<std::shared_ptr<Contact>> contacts;
+    contacts.reserve(CONTACT_COUNT);
+    db.forEachContact([&contacts](Contact&& contact) {
+        contacts.push_back(std::make_shared<Contact>(std::move(contact)));
+    });
+    index.bulkLoad(contacts, defaultBuildThreads());
+    return millisSince(start);
+}
+
+struct RestoreResult {
+    double open_ms;        // 映射 + 校验和
+    double contacts_ms;    // 联系人记录解码
+    double indexes_ms;     // 索引恢复
+    double total_ms;
+    bool success;
+};
+
+// 快照路径：映射文件、比对变更序号、恢复索引
+RestoreResult snapshotStartup(const std::string& snapshot_path, const std::string& db_path,
+                              ContactIndex& index, ConflictDetector& detector) {
+    RestoreResult result;
+    auto start = Clock::now();
+
+    IndexSnapshotFile snapshot;
+    bool opened = snapshot.open(snapshot_path);
+    SQLiteManager db(db_path);
+    db.init();
+    bool fresh = opened && static_cast<uint64_t>(db.getChangeSequence()) == snapshot.contactsSequence();
+    result.open_ms = millisSince(start);
+
+    auto contacts_start = Clock::now();
+    std::vector<std::shared_ptr<Contact>> contacts;
+    bool decoded = fresh && ContactIndex::readSnapshotContacts(snapshot, contacts);
+    result.contacts_ms = millisSince(contacts_start);
+
+    auto indexes_start = Clock::now();
+    result.success = decoded && index.restoreSnapshot(snapshot, contacts) &&
+                     detector.restoreSnapshot(snapshot);
+    result.indexes_ms = millisSince(indexes_start);
+
+    result.total_ms = millisSince(start);
+    return result;
+}
+
+// 逐项比对重建索引与快照恢复索引的查询结果
+bool verifyEquivalent(const ContactIndex& rebuilt, const ContactIndex& restored,
+                      const ConflictDetector& original, const ConflictDetector& recovered) {
+    if (rebuilt.primaryIndexSize() != restored.primaryIndexSize()) return false;
+
+    for (int id = 1; id <= CONTACT_COUNT; id++) {
+        auto expected = rebuilt.findById(id);
+        auto actual = restored.findById(id);
+        if (!expected || !actual || expected->name != actual->name) return false;
+
+        auto by_phone = restored.findByPhone(expected->phone);
+        auto by_email = restored.findByEmail(expected->email);
+        auto by_student = restored.findByStudentId(expected->student_id);
+        if (!by_phone || by_phone->id != id || !by_email || by_email->id != id ||
+            !by_student || by_student->id != id) {
+            return false;
+        }
+    }
+
+    for (const char* surname : SURNAMES) {
+        for (const char* given : GIVEN) {
+            std::string prefix = std::string(surname) + given;
+            if (rebuilt.searchByName(prefix).size() != restored.searchByName(prefix).size()) {
+                return false;
+            }
+        }
+    }
+
+    if (original.getTotalReservations() != recovered.getTotalReservations()) return false;
+    for (const char* resource : RESOURCES) {
+        if (original.getResourceUtilization(resource) != recovered.getResourceUtilization(resource)) {
+            return false;
+        }
+    }
+    return original.detectAllConflicts().size() == recovered.detectAllConflicts().size();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string db_path = argc > 1 ? argv[1] : "bench_snapshot.db";
+    std::string snapshot_path = db_path + ".snapshot";
+    std::remove(db_path.c_str());
+    std::remove(snapshot_path.c_str());
+
+    std::cout << "=== 快照冷启动耗时测试 ===\n\n";
+    std::cout << "生成测试数据: " << CONTACT_COUNT << " 个联系人, " << RESERVATION_COUNT << " 个预约\n\n";
+    if (!populateDatabase(db_path)) {
+        std::cerr << "测试数据库创建失败: " << db_path << std::endl;
+        return 1;
+    }
+
+    // 先全部运行再统一输出，避免与数据库初始化日志交错
+    ContactIndex rebuilt;
+    ConflictDetector original;
+    populateReservations(original);
+    double first_rebuild_ms = rebuildStartup(db_path, rebuilt);
+
+    auto write_start = Clock::now();
+    IndexSnapshotWriter writer;
+    rebuilt.writeSnapshot(writer);
+    original.writeSnapshot(writer);
+    SQLiteManager db(db_path);
+    db.init();
+    bool written = writer.writeToFile(snapshot_path, db.getChangeSequence(), 0);
+    double write_ms = millisSince(write_start);
+
+    std::vector<double> rebuild_ms;
+    std::vector<RestoreResult> restores;
+    bool equivalent = written;
+    for (int round = 0; round < ROUNDS; round++) {
+        ContactIndex index;
+        rebuild_ms.push_back(rebuildStartup(db_path, index));
+
+        ContactIndex restored;
+        ConflictDetector recovered;
+        restores.push_back(snapshotStartup(snapshot_path, db_path, restored, recovered));
+        equivalent = equivalent && restores.back().success &&
+                     verifyEquivalent(rebuilt, restored, original, recovered);
+    }
+
+    // 损坏文件必须被拒绝并回退
+    bool corruption_detected = false;
+    if (FILE* file = std::fopen(snapshot_path.c_str(), "r+b")) {
+        std::fseek(file, -16, SEEK_END);
+        std::fputc('X', file);
+        std::fclose(file);
+        IndexSnapshotFile damaged;
+        corruption_detected = !damaged.open(snapshot_path);
+    }
+
+    std::cout << "\n快照写入: " << std::fixed << std::setprecision(1) << write_ms << " ms"
+              << "  (首次重建 " << first_rebuild_ms << " ms)\n\n";
+    std::cout << "   轮次     重建(ms)   快照合计(ms)   映射校验(ms)   记录解码(ms)   索引恢复(ms)    加速比\n";
+    for (int round = 0; round < ROUNDS; round++) {
+        const RestoreResult& restore = restores[round];
+        std::cout << "   " << std::setw(4) << round + 1
+                  << std::setw(13) << rebuild_ms[round]
+                  << std::setw(15) << restore.total_ms
+                  << std::setw(15) << restore.open_ms
+                  << std::setw(15) << restore.contacts_ms
+                  << std::setw(15) << restore.indexes_ms
+                  << std::setw(10) << std::setprecision(1)
+                  << (restore.total_ms > 0 ? rebuild_ms[round] / restore.total_ms : 0.0) << "x\n";
+    }
+    std::cout << "\n恢复结果一致性: " << (equivalent ? "通过" : "失败") << "\n";
+    std::cout << "损坏文件检测: " << (corruption_detected ? "通过" : "失败") << "\n";
+
+    std::remove(db_path.c_str());
+    std::remove(snapshot_path.c_str());
+    std::cout << "\n=== 快照冷启动耗时测试完成 ===\n";
+    return (equivalent && corruption_detected) ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include "../include/stack.h"
+#include "../include/array_stack.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// 链式栈 Stack<T> 与连续存储栈 ArrayStack<T> 对比
+// 1. 入栈/出栈吞吐（int 与撤销单元大小的 std::string）
+// 2. 拷贝整个栈的耗时（8 / 1000 / 100000 个元素）
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t THROUGHPUT_COUNT = 1000000;
+const size_t COPY_SIZES[] = {8, 1000, 100000};
+
+volatile size_t sink = 0;  // 防止结果被优化掉
+
+// 每轮入栈 depth 个再全部出栈，返回每次操作的纳秒数
+template<typename StackType, typename T>
+double pushPopNanos(const std::vector<T>& values, size_t depth) {
+    size_t operations = 0;
+    auto start = Clock::now();
+    StackType stack;
+    for (size_t offset = 0; offset < values.size(); offset += depth) {
+        size_t end = std::min(values.size(), offset + depth);
+        for (size_t i = offset; i < end; i++) {
+            stack.push(values[i]);
+        }
+        while (!stack.empty()) {
+            sink = sink + sizeof(stack.top());
+            stack.pop();
+        }
+        operations += (end - offset) * 2;
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / operations;
+}
+
+// 拷贝一个 size 个元素的栈，返回每次拷贝的微秒数
+template<typename StackType, typename T>
+double copyMicros(const std::vector<T>& values, size_t size) {
+    StackType source;
+    for (size_t i = 0; i < size; i++) {
+        source.push(values[i % values.size()]);
+    }
+    size_t repeats = std::max<size_t>(1, 2000000 / (size + 1));
+    auto start = Clock::now();
+    for (size_t i = 0; i < repeats; i++) {
+        StackType copied(source);
+        sink = sink + copied.size();
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return elapsed / repeats;
+}
+
+struct Row {
+    std::string label;
+    double linked;
+    double array;
+};
+
+void printRows(const char* title, const char* unit, const std::vector<Row>& rows) {
+    std::cout << title << "\n";
+    std::cout << "   场景                   Stack(" << unit << ")   ArrayStack(" << unit << ")   加速比\n";
+    for (const auto& row : rows) {
+        std::cout << "   " << std::left << std::setw(22) << row.label << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << row.linked
+                  << std::setw(17) << row.array
+                  << std::setprecision(2) << std::setw(10) << row.linked / row.array << "x\n";
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 栈实现对比测试 ===\n\n";
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> number(0, 1000000);
+    std::uniform_int_distribution<int> length(24, 96);  // 与单条操作记录的编码长度相当
+
+    std::vector<int> ints(THROUGHPUT_COUNT);
+    for (auto& value : ints) value = number(gen);
+    std::vector<std::string> strings(THROUGHPUT_COUNT / 10);
+    for (auto& value : strings) value.assign(length(gen), static_cast<char>('a' + number(gen) % 26));
+
+    // 先收集全部结果再统一输出
+    std::vector<Row> throughput;
+    for (size_t depth : {8, 1000}) {
+        throughput.push_back({"int, 深度 " + std::to_string(depth),
+                              pushPopNanos<Stack<int>>(ints, depth),
+                              pushPopNanos<ArrayStack<int>>(ints, depth)});
+    }
+    for (size_t depth : {8, 1000}) {
+        throughput.push_back({"string, 深度 " + std::to_string(depth),
+                              pushPopNanos<Stack<std::string>>(strings, depth),
+                              pushPopNanos<ArrayStack<std::string>>(strings, depth)});
+    }
+
+    std::vector<Row> copies;
+    for (size_t size : COPY_SIZES) {
+        copies.push_back({"int, " + std::to_string(size) + " 个",
+                          copyMicros<Stack<int>>(ints, size),
+                          copyMicros<ArrayStack<int>>(ints, size)});
+    }
+    for (size_t size : COPY_SIZES) {
+        copies.push_back({"string, " + std::to_string(size) + " 个",
+                          copyMicros<Stack<std::string>>(strings, size),
+                          copyMicros<ArrayStack<std::string>>(strings, size)});
+    }
+
+    printRows("入栈 + 出栈（每次操作）", "ns", throughput);
+    printRows("拷贝整个栈（每次拷贝）", "us", copies);
+
+    std::cout << "=== 栈实现对比测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "../include/contact_index.h"
+#include "../include/activity_manager.h"
+#include "../include/parallel_for.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdio>
+#include <string>
+
+// 启动索引构建耗时：串行加载 vs 流式读取 + 并行构建
+// 10万联系人 + 10万活动，从 SQLite 读出后构建姓名树、主索引、电话/邮箱索引和地点索引
+
+namespace {
+
+const int CONTACT_COUNT = 100000;
+const int ACTIVITY_COUNT = 100000;
+
+const char* SURNAMES[] = {"张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴"};
+const char* GIVEN[] = {"伟", "芳", "娜", "敏", "静", "磊", "洋", "勇", "艳", "杰",
+                       "涛", "明", "超", "秀", "霞", "平", "刚", "桂", "华", "丽"};
+const char* LOCATIONS[] = {"会议室A", "会议室B", "培训室1", "培训室2", "大礼堂", "小礼堂", "展览厅"};
+
+using Clock = std::chrono::steady_clock;
+
+double millisSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 用单个事务批量写入测试数据（逐条自动提交太慢）
+bool populateDatabase(const std::string& path) {
+    SQLiteManager schema(path);
+    if (!schema.init()) return false;
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open(path.c_str(), &db) != SQLITE_OK) return false;
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+    std::mt19937 gen(20240601);  // 固定种子，结果可复现
+    std::uniform_int_distribution<int> surname(0, 9);
+    std::uniform_int_distribution<int> given(0, 19);
+
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(db, "INSERT INTO contacts (name, student_id, phone, email, department) VALUES (?, ?, ?, ?, '计算机学院');",
+                       -1, &stmt, nullptr);
+    for (int i = 1; i <= CONTACT_COUNT; i++) {
+        std::string name = std::string(SURNAMES[surname(gen)]) + GIVEN[given(gen)] + GIVEN[given(gen)];
+        std::string student_id = "2021" + std::to_string(i);
+        std::string phone = "138" + std::to_string(10000000 + i);
+        std::string email = "user" + std::to_string(i) + "@czu.edu.cn";
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, student_id.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 4, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "INSERT INTO activities (name, location, start_time, end_time) VALUES (?, ?, ?, ?);",
+                       -1, &stmt, nullptr);
+    for (int i = 1; i <= ACTIVITY_COUNT; i++) {
+        std::string name = "活动" + std::to_string(i);
+        int day = 1 + i % 28;
+        int hour = 8 + i % 12;
+        char start[32];
+        char end[32];
+        std::snprintf(start, sizeof(start), "2024-06-%02d %02d:00", day, hour);
+        std::snprintf(end, sizeof(end), "2024-06-%02d %02d:50", day, hour);
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, LOCATIONS[i % 7], -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 3, start, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 4, end, -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+    return true;
+}
+
+struct StartupResult {
+    double contacts_ms;
+    double activities_ms;
+    double total_ms;
+    size_t indexed_contacts;
+    size_t locations;
+};
+
+// 原启动路径：整表读入后逐条插入
+StartupResult serialStartup(const std::string& path) {
+    StartupResult result;
+    auto start = Clock::now();
+
+    SQLiteManager db(path);
+    db.init();
+
+    auto contacts_start = Clock::now();
+    ContactIndex index;
+    for (const auto& contact : db.getAllContacts()) {
+        index.addContact(std::make_shared<Contact>(contact));
+    }
+    result.contacts_ms = millisSince(contacts_start);
+
+    auto activities_start = Clock::now();
+    auto locations = ActivityManager::buildLocationIndex(db.getAllActivities(), 1);
+    result.activities_ms = millisSince(activities_start);
+
+    result.total_ms = millisSince(start);
+    result.indexed_contacts = index.primaryIndexSize();
+    result.locations = locations.size();
+    return result;
+}
+
+// 新启动路径：联系人与活动各用一个连接流式读取，索引分片并行构建
+StartupResult parallelStartup(const std::string& path, unsigned threads) {
+    StartupResult result;
+    auto start = Clock::now();
+    ContactIndex index;
+    std::map<std::string, std::vector<int>> locations;
+
+    std::thread activity_loader([&]() {
+        auto activities_start = Clock::now();
+        SQLiteManager db(path);
+        db.init();
+        std::vector<Activity> activities;
+        activities.reserve(ACTIVITY_COUNT);
+        db.forEachActivity([&activities](Activity&& activity) {
+            activities.push_back(std::move(activity));
+        });
+        locations = ActivityManager::buildLocationIndex(activities, threads);
+        result.activities_ms = millisSince(activities_start);
+    });
+
+    auto contacts_start = Clock::now();
+    SQLiteManager db(path);
+    db.init();
+    std::vector<std::shared_ptr<Contact>> contacts;
+    contacts.reserve(CONTACT_COUNT);
+    db.forEachContact([&contacts](Contact&& contact) {
+        contacts.push_back(std::make_shared<Contact>(std::move(contact)));
+    });
+    index.bulkLoad(contacts, threads);
+    result.contacts_ms = millisSince(contacts_start);
+
+    activity_loader.join();
+    result.total_ms = millisSince(start);
+    result.indexed_contacts = index.primaryIndexSize();
+    result.locations = locations.size();
+    return result;
+}
+
+void printResult(const std::string& name, const StartupResult& result) {
+    std::cout << "   " << std::left << std::setw(16) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << result.contacts_ms
+              << std::setw(12) << result.activities_ms
+              << std::setw(12) << result.total_ms
+              << "    (联系人 " << result.indexed_contacts << ", 地点 " << result.locations << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "bench_startup.db";
+    std::remove(path.c_str());
+
+    std::cout << "=== 启动索引构建耗时测试 ===\n\n";
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "生成测试数据: " << CONTACT_COUNT << " 个联系人, " << ACTIVITY_COUNT << " 个活动\n\n";
+    if (!populateDatabase(path)) {
+        std::cerr << "测试数据库创建失败: " << path << std::endl;
+        return 1;
+    }
+
+    // 先全部运行再统一输出，避免与数据库初始化日志交错
+    std::vector<std::pair<std::string, StartupResult>> results;
+    results.emplace_back("串行", serialStartup(path));
+    for (unsigned threads : {2u, 4u, 8u}) {
+        results.emplace_back("并行 " + std::to_string(threads) + " 线程", parallelStartup(path, threads));
+    }
+    results.emplace_back("并行 默认线程", parallelStartup(path, defaultBuildThreads()));
+
+    std::cout << "\n   模式               联系人(ms)    活动(ms)   就绪(ms)\n";
+    for (const auto& entry : results) {
+        printResult(entry.first, entry.second);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "\n=== 启动索引构建耗时测试完成 ===\n";
+    return 0;
+}
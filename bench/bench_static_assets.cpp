@@ -0,0 +1,157 @@
+#include "../include/static_asset_store.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+
+// 首页静态文件输出：原 ifstream + ostringstream 逐次读取 vs 常驻内存的静态资源（sendfile / 预压缩）
+// 响应写入 /dev/null，只比较用户态读取、拷贝和拼装的开销
+
+namespace {
+
+const int ROUNDS = 5;
+const int REQUESTS_PER_ROUND = 2000;
+
+using Clock = std::chrono::steady_clock;
+
+double microsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// 原实现：每次打开文件，读入 ostringstream，再拷贝进响应字符串
+size_t legacyServe(int out_fd, const std::string& path) {
+    std::ifstream file(path);
+    std::ostringstream content;
+    content << file.rdbuf();
+    std::string body = content.str();
+
+    std::ostringstream oss;
+    oss << "HTTP/1.1 200 OK\r\n"
+        << "Content-Type: text/html\r\n"
+        << "Content-Length: " << body.length() << "\r\n\r\n"
+        << body;
+    std::string response = oss.str();
+    return static_cast<size_t>(write(out_fd, response.data(), response.size()));
+}
+
+std::string buildHead(const StaticReply& reply) {
+    std::ostringstream head;
+    head << "HTTP/1.1 " << reply.status_code << " " << reply.status_text << "\r\n";
+    for (const auto& header : reply.headers) {
+        head << header.first << ": " << header.second << "\r\n";
+    }
+    head << "Content-Length: " << (reply.body ? reply.body->size() : 0) << "\r\n\r\n";
+    return head.str();
+}
+
+// 新实现：与服务器的 sendStaticFile 相同，原文走 sendfile，压缩版本走 writev
+size_t storeServe(int out_fd, StaticAssetStore& store, const std::string& relative_path,
+                  const std::map<std::string, std::string>& headers) {
+    auto asset = store.find(relative_path);
+    StaticReply reply = StaticAssetStore::reply(asset, headers);
+    std::string head = buildHead(reply);
+
+    if (!reply.body) {
+        return static_cast<size_t>(write(out_fd, head.data(), head.size()));
+    }
+    if (reply.from_file) {
+        size_t total = static_cast<size_t>(write(out_fd, head.data(), head.size()));
+        off_t offset = 0;
+        while (offset < asset->size) {
+            ssize_t sent = sendfile(out_fd, asset->fd, &offset, static_cast<size_t>(asset->size - offset));
+            if (sent <= 0) break;
+            total += static_cast<size_t>(sent);
+        }
+        return total;
+    }
+    struct iovec parts[2];
+    parts[0].iov_base = const_cast<char*>(head.data());
+    parts[0].iov_len = head.size();
+    parts[1].iov_base = const_cast<char*>(reply.body->data());
+    parts[1].iov_len = reply.body->size();
+    return static_cast<size_t>(writev(out_fd, parts, 2));
+}
+
+struct Result {
+    std::string name;
+    double micros_per_request;
+    size_t bytes_per_request;
+};
+
+template <typename Serve>
+Result measure(const std::string& name, Serve serve) {
+    double best = 0;
+    size_t bytes = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        auto start = Clock::now();
+        size_t total = 0;
+        for (int i = 0; i < REQUESTS_PER_ROUND; i++) {
+            total += serve();
+        }
+        double elapsed = microsSince(start) / REQUESTS_PER_ROUND;
+        if (round == 0 || elapsed < best) best = elapsed;
+        bytes = total / REQUESTS_PER_ROUND;
+    }
+    return {name, best, bytes};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string root = argc > 1 ? argv[1] : "frontend";
+    std::string page = argc > 2 ? argv[2] : "/v8.1.html";
+
+    int out_fd = open("/dev/null", O_WRONLY);
+    if (out_fd < 0) {
+        std::cerr << "无法打开 /dev/null" << std::endl;
+        return 1;
+    }
+
+    StaticAssetStore store(root);
+    auto load_start = Clock::now();
+    auto asset = store.find(page);
+    double load_ms = microsSince(load_start) / 1000.0;
+    if (!asset) {
+        std::cerr << "静态文件不存在: " << root << page << std::endl;
+        return 1;
+    }
+
+    std::map<std::string, std::string> plain;
+    std::map<std::string, std::string> gzip = {{"Accept-Encoding", "gzip, deflate"}};
+    std::map<std::string, std::string> brotli = {{"Accept-Encoding", "gzip, deflate, br"}};
+    std::map<std::string, std::string> revalidate = {{"If-None-Match", asset->etag}};
+
+    // 先全部运行再统一输出
+    std::vector<Result> results;
+    std::string path = root + page;
+    results.push_back(measure("原实现 (ifstream)", [&]() { return legacyServe(out_fd, path); }));
+    results.push_back(measure("资源缓存 + sendfile", [&]() { return storeServe(out_fd, store, page, plain); }));
+    results.push_back(measure("资源缓存 + gzip", [&]() { return storeServe(out_fd, store, page, gzip); }));
+    results.push_back(measure("资源缓存 + brotli", [&]() { return storeServe(out_fd, store, page, brotli); }));
+    results.push_back(measure("条件请求 304", [&]() { return storeServe(out_fd, store, page, revalidate); }));
+    close(out_fd);
+
+    std::cout << "=== 静态文件输出测试 ===\n\n";
+    std::cout << "文件: " << path << " (" << asset->body.size() << " 字节, gzip "
+              << asset->gzip_body.size() << " 字节, brotli " << asset->brotli_body.size() << " 字节)\n";
+    std::cout << "首次加载并预压缩: " << std::fixed << std::setprecision(2) << load_ms << " ms\n";
+    std::cout << "每轮 " << REQUESTS_PER_ROUND << " 次请求, 取 " << ROUNDS << " 轮最好成绩\n\n";
+
+    std::cout << std::left << std::setw(28) << "方式" << std::right << std::setw(14) << "微秒/请求"
+              << std::setw(14) << "字节/请求" << std::setw(10) << "加速比" << "\n";
+    double baseline = results[0].micros_per_request;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(28) << result.name << std::right << std::setw(14)
+                  << std::setprecision(2) << result.micros_per_request << std::setw(14) << result.bytes_per_request
+                  << std::setw(9) << std::setprecision(1) << baseline / result.micros_per_request << "x\n";
+    }
+    return 0;
+}
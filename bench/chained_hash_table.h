@@ -0,0 +1,145 @@
+#ifndef CHAINED_HASH_TABLE_H
+#define CHAINED_HASH_TABLE_H
+
+// 基准对照：原链地址法哈希表（每次插入 new 一个节点，按 % table_size 取桶）
+// 仅供 bench/ 下的性能对比使用，保留原实现的插入、查找、删除与扩容行为，
+// 并与 HashTable 一样维护学号二级索引，保证对比只反映表结构本身的差异
+
+#include "../include/sqlite_manager.h"
+#include "../include/string_index.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+class ChainedHashTable {
+public:
+    ChainedHashTable(size_t initial_capacity = 16)
+        : table_size(std::max(initial_capacity, size_t(16))), element_count(0) {
+        table.resize(table_size, nullptr);
+    }
+
+    ~ChainedHashTable() {
+        clear();
+    }
+
+    ChainedHashTable(const ChainedHashTable&) = delete;
+    ChainedHashTable& operator=(const ChainedHashTable&) = delete;
+
+    bool insert(std::shared_ptr<Contact> contact) {
+        if (!contact) return false;
+        if (loadFactor() > 0.75) {
+            resize();
+        }
+
+        size_t index = getIndex(contact->id);
+        for (HashNode* current = table[index]; current != nullptr; current = current->next) {
+            if (current->contact->id == contact->id) {
+                student_id_index.removeIfMatches(current->contact->student_id, current->contact->id);
+                current->contact = contact;
+                if (!contact->student_id.empty()) student_id_index.insert(contact->student_id, contact->id);
+                return true;
+            }
+        }
+
+        HashNode* newNode = new HashNode(contact);
+        newNode->next = table[index];
+        table[index] = newNode;
+        element_count++;
+        if (!contact->student_id.empty() && !student_id_index.contains(contact->student_id)) {
+            student_id_index.insert(contact->student_id, contact->id);
+        }
+        return true;
+    }
+
+    std::shared_ptr<Contact> find(int key) {
+        for (HashNode* current = table[getIndex(key)]; current != nullptr; current = current->next) {
+            if (current->contact->id == key) {
+                return current->contact;
+            }
+        }
+        return nullptr;
+    }
+
+    bool remove(int key) {
+        size_t index = getIndex(key);
+        HashNode* current = table[index];
+        HashNode* prev = nullptr;
+
+        while (current != nullptr) {
+            if (current->contact->id == key) {
+                if (prev == nullptr) {
+                    table[index] = current->next;
+                } else {
+                    prev->next = current->next;
+                }
+                student_id_index.removeIfMatches(current->contact->student_id, key);
+                delete current;
+                element_count--;
+                return true;
+            }
+            prev = current;
+            current = current->next;
+        }
+        return false;
+    }
+
+    size_t size() const { return element_count; }
+
+    double loadFactor() const {
+        return table_size > 0 ? static_cast<double>(element_count) / table_size : 0.0;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < table_size; i++) {
+            HashNode* current = table[i];
+            while (current != nullptr) {
+                HashNode* next = current->next;
+                delete current;
+                current = next;
+            }
+            table[i] = nullptr;
+        }
+        element_count = 0;
+        student_id_index.clear();
+    }
+
+private:
+    struct HashNode {
+        std::shared_ptr<Contact> contact;
+        HashNode* next;
+
+        HashNode(std::shared_ptr<Contact> c) : contact(c), next(nullptr) {}
+    };
+
+    std::vector<HashNode*> table;
+    size_t table_size;
+    size_t element_count;
+    StringIndex student_id_index;
+
+    size_t getIndex(int key) const {
+        return static_cast<size_t>(key * 2654435761U) % table_size;
+    }
+
+    void resize() {
+        size_t old_size = table_size;
+        std::vector<HashNode*> old_table = std::move(table);
+
+        table_size = old_size * 2;
+        table.assign(table_size, nullptr);
+
+        for (size_t i = 0; i < old_size; i++) {
+            HashNode* current = old_table[i];
+            while (current != nullptr) {
+                HashNode* next = current->next;
+                size_t index = getIndex(current->contact->id);
+                HashNode* newNode = new HashNode(current->contact);
+                newNode->next = table[index];
+                table[index] = newNode;
+                delete current;
+                current = next;
+            }
+        }
+    }
+};
+
+#endif // CHAINED_HASH_TABLE_H
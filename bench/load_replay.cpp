@@ -0,0 +1,545 @@
+#include "../include/http_server_auth.h"
+#include "../include/logger.h"
+#include "workload.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+
+// 负载重放：按开环到达率（泊松或匀速）向 AuthenticatedHttpServer 发送录制的请求序列，统计延迟分位数
+// 用法: campus_load_replay <workload.http> [--rate R] [--duration S] [--warmup S] [--connections N]
+//           [--arrival poisson|uniform] [--timeout S] [--seed N] [--label NAME] [--out FILE] [--baseline FILE]
+//           [--connect PORT | --port P --workdir DIR --frontend DIR]
+// 默认在进程内启动服务器（与被测构建使用同一套编译选项）；--connect 改为压测已在运行的服务器
+// 到达时刻按计划生成，不等上一个请求完成；延迟从计划发出时刻算起，排队等待空闲连接的时间也计入，
+// 避免服务器变慢时压测端跟着降速而低估尾延迟
+// 第 i 个到达发送序列中第 i % 请求数 个请求，属于第 i / 请求数 个会话，因此各接口的比例与序列文件一致
+
+#ifndef CAMPUS_BUILD_DESCRIPTION
+#define CAMPUS_BUILD_DESCRIPTION "unknown"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int DEFAULT_SEED = 20240601;      // 固定种子，到达序列可复现
+const char* OVERALL = "全部";
+const size_t NAME_WIDTH = 36;           // 接口名一栏的显示宽度
+
+struct Options {
+    std::string workload_path;
+    double rate = 200;                  // 请求/秒
+    double duration = 10;               // 计入统计的时长（秒）
+    double warmup = 2;                  // 预热时长（秒），其间的请求不计入统计
+    int connections = 64;               // 最大并发连接数
+    bool poisson = true;
+    double timeout = 5;                 // 单个请求超时（秒）
+    unsigned seed = DEFAULT_SEED;
+    std::string label;
+    std::string out_path;
+    std::string baseline_path;
+    int connect_port = 0;               // 非 0 时压测外部服务器
+    int port = 18090;
+    std::string workdir = "load-run";
+    std::string frontend;
+};
+
+// 单个接口的统计
+struct RouteStats {
+    std::string name;
+    std::vector<uint32_t> latencies_us;
+    long errors = 0;                    // 连接失败、超时、5xx
+
+    uint32_t percentile(double p) const {
+        if (latencies_us.empty()) return 0;
+        size_t rank = static_cast<size_t>(p / 100.0 * latencies_us.size());
+        return latencies_us[std::min(rank, latencies_us.size() - 1)];
+    }
+    double mean() const {
+        if (latencies_us.empty()) return 0;
+        double sum = 0;
+        for (uint32_t latency : latencies_us) sum += latency;
+        return sum / latencies_us.size();
+    }
+};
+
+struct Arrival {
+    Clock::time_point scheduled;
+    long index;
+};
+
+struct Connection {
+    Clock::time_point scheduled;
+    size_t route;
+    bool measured;
+    bool connected = false;
+    std::string request;
+    size_t sent = 0;
+    std::string response;
+};
+
+class LoadReplay {
+public:
+    LoadReplay(const Options& options, const std::vector<workload::RecordedRequest>& requests, int port)
+        : options(options), requests(requests), port(port), gen(options.seed) {
+        for (const auto& request : requests) {
+            std::string name = request.label();
+            auto it = std::find(route_names.begin(), route_names.end(), name);
+            route_of_request.push_back(it - route_names.begin());
+            if (it == route_names.end()) route_names.push_back(name);
+        }
+        stats.resize(route_names.size() + 1);
+        stats[0].name = OVERALL;
+        for (size_t i = 0; i < route_names.size(); i++) {
+            stats[i + 1].name = route_names[i];
+        }
+    }
+
+    // 开始前先登录一次，保证最初的受保护请求带有效令牌；之后由序列中的登录请求刷新
+    bool login() {
+        for (const auto& request : requests) {
+            if (request.target.find("/auth/login") == std::string::npos) continue;
+            std::string response;
+            workload::roundTrip(port, workload::render(request, values), response);
+            values["token"] = workload::extractToken(response);
+            return !values["token"].empty();
+        }
+        return true;
+    }
+
+    void run() {
+        epoll_fd = epoll_create1(0);
+        std::exponential_distribution<double> poisson_gap(options.rate);
+        auto gap = [&]() {
+            double seconds = options.poisson ? poisson_gap(gen) : 1.0 / options.rate;
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        };
+
+        start = Clock::now();
+        measure_from = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.warmup));
+        Clock::time_point stop_arrivals = measure_from +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+        auto timeout = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.timeout));
+
+        Clock::time_point next_arrival = start;
+        long issued = 0;
+        std::deque<Arrival> backlog;        // 已到达但还没有空闲连接的请求
+        std::vector<epoll_event> events(256);
+        Clock::time_point last_sweep = start;
+
+        while (true) {
+            Clock::time_point now = Clock::now();
+            while (next_arrival <= now && next_arrival < stop_arrivals) {
+                backlog.push_back({next_arrival, issued++});
+                next_arrival += gap();
+            }
+            while (!backlog.empty() && static_cast<int>(open.size()) < options.connections) {
+                begin(backlog.front());
+                backlog.pop_front();
+            }
+            max_backlog = std::max(max_backlog, backlog.size());
+            if (next_arrival >= stop_arrivals && backlog.empty() && open.empty()) break;
+
+            int wait_ms = 10;
+            if (next_arrival < stop_arrivals) {
+                auto until = std::chrono::duration_cast<std::chrono::milliseconds>(next_arrival - now).count();
+                wait_ms = static_cast<int>(std::max<long long>(0, std::min<long long>(wait_ms, until)));
+            }
+            int ready = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), wait_ms);
+            for (int i = 0; i < ready; i++) {
+                handle(events[i].data.fd, events[i].events);
+            }
+
+            now = Clock::now();
+            if (now - last_sweep > std::chrono::milliseconds(100)) {
+                last_sweep = now;
+                std::vector<int> expired;
+                for (const auto& entry : open) {
+                    if (now - entry.second.scheduled > timeout) expired.push_back(entry.first);
+                }
+                for (int fd : expired) {
+                    timeouts += open.at(fd).measured;
+                    finish(fd, 0);
+                }
+            }
+        }
+        close(epoll_fd);
+    }
+
+    void report(std::ostream& out) {
+        for (auto& route : stats) {
+            std::sort(route.latencies_us.begin(), route.latencies_us.end());
+        }
+        double seconds = options.duration;
+        const RouteStats& overall = stats[0];
+
+        out << "\n=== 负载重放 ===\n";
+        out << "请求序列: " << options.workload_path << " (" << requests.size() << " 个请求/会话)\n";
+        out << "构建: " << CAMPUS_BUILD_DESCRIPTION;
+        if (!options.label.empty()) out << "  标签: " << options.label;
+        out << "\n服务器: " << (options.connect_port ? "外部 localhost:" + std::to_string(port) : "进程内") << "\n";
+        out << std::fixed << std::setprecision(1);
+        out << "到达: " << (options.poisson ? "泊松" : "匀速") << " " << options.rate << " 请求/秒, 统计 "
+            << options.duration << " 秒 (预热 " << options.warmup << " 秒), 最大并发连接 " << options.connections << "\n";
+        out << "完成 " << overall.latencies_us.size() << " 个请求 (" << overall.latencies_us.size() / seconds
+            << " 请求/秒), 错误 " << overall.errors << " (超时 " << timeouts << ", 连接失败 " << connect_failures
+            << "), 最多排队 " << max_backlog << "\n\n";
+
+        out << "延迟 (微秒，从计划发出时刻算起):\n";
+        out << padRight("接口", NAME_WIDTH) << padLeft("次数", 8) << padLeft("p50", 9) << padLeft("p90", 9)
+            << padLeft("p99", 9) << padLeft("p99.9", 9) << padLeft("最大", 9) << padLeft("错误", 7) << "\n";
+        for (const auto& route : stats) {
+            out << padRight(route.name, NAME_WIDTH) << std::setw(8) << route.latencies_us.size()
+                << std::setw(9) << route.percentile(50) << std::setw(9) << route.percentile(90)
+                << std::setw(9) << route.percentile(99) << std::setw(9) << route.percentile(99.9)
+                << std::setw(9) << (route.latencies_us.empty() ? 0 : route.latencies_us.back())
+                << std::setw(7) << route.errors << "\n";
+        }
+        out << "\n状态码:";
+        for (const auto& status : statuses) {
+            out << " " << (status.first ? std::to_string(status.first) : "无响应") << "×" << status.second;
+        }
+        out << "\n";
+    }
+
+    // 每个接口一行，键的顺序固定，便于不同构建的结果直接 diff 或用 --baseline 对比
+    void writeJson(std::ostream& out) const {
+        const RouteStats& overall = stats[0];
+        out << "{\n";
+        out << "  \"label\": \"" << options.label << "\",\n";
+        out << "  \"build\": \"" << CAMPUS_BUILD_DESCRIPTION << "\",\n";
+        out << "  \"config\": {\"workload\": \"" << options.workload_path << "\", \"arrival\": \""
+            << (options.poisson ? "poisson" : "uniform") << "\", \"rate\": " << options.rate
+            << ", \"duration_s\": " << options.duration << ", \"warmup_s\": " << options.warmup
+            << ", \"connections\": " << options.connections << ", \"seed\": " << options.seed
+            << ", \"external_server\": " << (options.connect_port ? "true" : "false") << "},\n";
+        out << "  \"completed\": " << overall.latencies_us.size() << ",\n";
+        out << "  \"achieved_rate\": " << overall.latencies_us.size() / options.duration << ",\n";
+        out << "  \"timeouts\": " << timeouts << ",\n";
+        out << "  \"connect_failures\": " << connect_failures << ",\n";
+        out << "  \"statuses\": {";
+        bool first = true;
+        for (const auto& status : statuses) {
+            out << (first ? "" : ", ") << "\"" << status.first << "\": " << status.second;
+            first = false;
+        }
+        out << "},\n";
+        out << "  \"routes\": [\n";
+        for (size_t i = 0; i < stats.size(); i++) {
+            const RouteStats& route = stats[i];
+            out << "    {\"name\": \"" << route.name << "\", \"count\": " << route.latencies_us.size()
+                << ", \"errors\": " << route.errors << ", \"mean_us\": " << static_cast<long>(route.mean())
+                << ", \"p50_us\": " << route.percentile(50) << ", \"p90_us\": " << route.percentile(90)
+                << ", \"p99_us\": " << route.percentile(99) << ", \"p999_us\": " << route.percentile(99.9)
+                << ", \"max_us\": " << (route.latencies_us.empty() ? 0 : route.latencies_us.back()) << "}"
+                << (i + 1 < stats.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // 与之前保存的 JSON 结果逐接口对比分位数
+    bool compareWith(const std::string& path, std::ostream& out) const {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::string line, baseline_label;
+        std::map<std::string, std::map<std::string, double>> baseline;
+        while (std::getline(file, line)) {
+            if (line.find("\"label\": ") != std::string::npos) {
+                baseline_label = stringField(line, "label");
+            }
+            if (line.find("{\"name\": ") == std::string::npos) continue;
+            auto& fields = baseline[stringField(line, "name")];
+            for (const char* key : {"p50_us", "p90_us", "p99_us", "p999_us"}) {
+                fields[key] = numberField(line, key);
+            }
+        }
+
+        out << "\n对比基线 " << path << (baseline_label.empty() ? "" : " (" + baseline_label + ")")
+            << "，变化为 (本次 - 基线) / 基线:\n";
+        out << padRight("接口", NAME_WIDTH) << padLeft("p50", 12) << padLeft("p90", 12) << padLeft("p99", 12)
+            << padLeft("p99.9", 12) << "\n";
+        out << std::showpos << std::fixed << std::setprecision(1);
+        for (const auto& route : stats) {
+            auto it = baseline.find(route.name);
+            if (it == baseline.end()) continue;
+            out << padRight(route.name, NAME_WIDTH);
+            double current[] = {static_cast<double>(route.percentile(50)), static_cast<double>(route.percentile(90)),
+                                static_cast<double>(route.percentile(99)), static_cast<double>(route.percentile(99.9))};
+            const char* keys[] = {"p50_us", "p90_us", "p99_us", "p999_us"};
+            for (int k = 0; k < 4; k++) {
+                double before = it->second.at(keys[k]);
+                double change = before > 0 ? (current[k] - before) / before * 100 : 0;
+                out << std::setw(11) << change << "%";
+            }
+            out << "\n";
+        }
+        out << std::noshowpos;
+        return true;
+    }
+
+    long failures() const { return stats[0].errors; }
+
+private:
+    const Options& options;
+    const std::vector<workload::RecordedRequest>& requests;
+    int port;
+    std::mt19937 gen;
+    workload::Values values;
+
+    std::vector<std::string> route_names;
+    std::vector<size_t> route_of_request;       // 请求序号 -> route_names 下标
+    std::vector<RouteStats> stats;              // [0] 为全部请求，之后按 route_names 顺序
+    std::map<int, long> statuses;               // 计入统计的请求按状态码计数，0 表示无响应
+    long timeouts = 0;
+    long connect_failures = 0;
+    size_t max_backlog = 0;
+
+    int epoll_fd = -1;
+    std::unordered_map<int, Connection> open;
+    Clock::time_point start, measure_from;
+
+    // 按终端显示宽度（中文占两列）补齐，setw 按字节计数会错位
+    static size_t displayWidth(const std::string& text) {
+        size_t width = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if ((c & 0xC0) == 0x80) continue;
+            width += c >= 0xE0 ? 2 : 1;
+        }
+        return width;
+    }
+
+    static std::string padRight(const std::string& text, size_t width) {
+        size_t used = displayWidth(text);
+        return text + std::string(used < width ? width - used : 1, ' ');
+    }
+
+    static std::string padLeft(const std::string& text, size_t width) {
+        size_t used = displayWidth(text);
+        return std::string(used < width ? width - used : 1, ' ') + text;
+    }
+
+    static std::string stringField(const std::string& line, const std::string& key) {
+        size_t pos = line.find("\"" + key + "\": \"");
+        if (pos == std::string::npos) return "";
+        pos += key.size() + 5;
+        return line.substr(pos, line.find('"', pos) - pos);
+    }
+
+    static double numberField(const std::string& line, const std::string& key) {
+        size_t pos = line.find("\"" + key + "\": ");
+        if (pos == std::string::npos) return 0;
+        return std::atof(line.c_str() + pos + key.size() + 4);
+    }
+
+    void begin(const Arrival& arrival) {
+        size_t index = static_cast<size_t>(arrival.index % static_cast<long>(requests.size()));
+        workload::setSession(values, arrival.index / static_cast<long>(requests.size()));
+
+        Connection connection;
+        connection.scheduled = arrival.scheduled;
+        connection.route = route_of_request[index];
+        connection.measured = arrival.scheduled >= measure_from;
+        connection.request = workload::render(requests[index], values);
+
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 && errno != EINPROGRESS)) {
+            if (fd >= 0) close(fd);
+            record(connection, 0);
+            connect_failures += connection.measured;
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLOUT;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        open.emplace(fd, std::move(connection));
+    }
+
+    void handle(int fd, uint32_t ready) {
+        auto it = open.find(fd);
+        if (it == open.end()) return;
+        Connection& connection = it->second;
+
+        if (!connection.connected && (ready & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0) {
+                connect_failures += connection.measured;
+                finish(fd, 0);
+                return;
+            }
+            connection.connected = true;
+        }
+
+        if (connection.sent < connection.request.size() && (ready & EPOLLOUT)) {
+            ssize_t n = send(fd, connection.request.data() + connection.sent,
+                             connection.request.size() - connection.sent, MSG_NOSIGNAL);
+            if (n < 0 && errno != EAGAIN) {
+                finish(fd, 0);
+                return;
+            }
+            if (n > 0) connection.sent += static_cast<size_t>(n);
+            if (connection.sent == connection.request.size()) {
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.fd = fd;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+            }
+            return;
+        }
+
+        if (ready & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            char buffer[16384];
+            while (true) {
+                ssize_t n = read(fd, buffer, sizeof(buffer));
+                if (n > 0) {
+                    connection.response.append(buffer, static_cast<size_t>(n));
+                } else if (n == 0) {
+                    // 服务器处理完一个请求就关闭连接
+                    finish(fd, workload::statusOf(connection.response));
+                    return;
+                } else {
+                    if (errno != EAGAIN) finish(fd, workload::statusOf(connection.response));
+                    return;
+                }
+            }
+        }
+    }
+
+    void finish(int fd, int status) {
+        auto it = open.find(fd);
+        if (it == open.end()) return;
+        if (status == 200) {
+            std::string token = workload::extractToken(it->second.response);
+            if (!token.empty()) values["token"] = token;
+        }
+        record(it->second, status);
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        open.erase(it);
+    }
+
+    void record(const Connection& connection, int status) {
+        if (!connection.measured) return;
+        statuses[status]++;
+        bool failed = status == 0 || status >= 500;
+        RouteStats* targets[] = {&stats[0], &stats[connection.route + 1]};
+        for (RouteStats* route : targets) {
+            if (failed) {
+                route->errors++;
+            } else {
+                auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - connection.scheduled);
+                route->latencies_us.push_back(static_cast<uint32_t>(latency.count()));
+            }
+        }
+    }
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    if (argc < 2) return false;
+    options.workload_path = argv[1];
+    for (int i = 2; i < argc; i++) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (flag == "--rate") options.rate = std::atof(value.c_str());
+        else if (flag == "--duration") options.duration = std::atof(value.c_str());
+        else if (flag == "--warmup") options.warmup = std::atof(value.c_str());
+        else if (flag == "--connections") options.connections = std::atoi(value.c_str());
+        else if (flag == "--arrival") options.poisson = value != "uniform";
+        else if (flag == "--timeout") options.timeout = std::atof(value.c_str());
+        else if (flag == "--seed") options.seed = static_cast<unsigned>(std::stoul(value));
+        else if (flag == "--label") options.label = value;
+        else if (flag == "--out") options.out_path = value;
+        else if (flag == "--baseline") options.baseline_path = value;
+        else if (flag == "--connect") options.connect_port = std::atoi(value.c_str());
+        else if (flag == "--port") options.port = std::atoi(value.c_str());
+        else if (flag == "--workdir") options.workdir = value;
+        else if (flag == "--frontend") options.frontend = value;
+        else return false;
+    }
+    return options.rate > 0 && options.duration > 0 && options.connections > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: " << argv[0] << " <workload.http> [--rate R] [--duration S] [--warmup S] [--connections N]\n"
+                  << "        [--arrival poisson|uniform] [--timeout S] [--seed N] [--label NAME] [--out FILE] [--baseline FILE]\n"
+                  << "        [--connect PORT | --port P --workdir DIR --frontend DIR]" << std::endl;
+        return 2;
+    }
+
+    // 工作目录切换前把相对路径转成绝对路径
+    namespace fs = std::filesystem;
+    options.workload_path = fs::absolute(options.workload_path).string();
+    if (!options.out_path.empty()) options.out_path = fs::absolute(options.out_path).string();
+    if (!options.baseline_path.empty()) options.baseline_path = fs::absolute(options.baseline_path).string();
+
+    std::vector<workload::RecordedRequest> requests = workload::load(options.workload_path);
+    if (requests.empty()) {
+        std::cerr << "无法读取请求序列: " << options.workload_path << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<AuthenticatedHttpServer> server;
+    int port = options.connect_port;
+    if (!port) {
+        if (!workload::prepareWorkdir(options.workdir, options.frontend)) {
+            std::cerr << "无法进入工作目录: " << options.workdir << std::endl;
+            return 1;
+        }
+        Logger::instance().setLevel(LOG_LEVEL_WARN);
+        port = options.port;
+        server.reset(new AuthenticatedHttpServer(port));
+        if (!server->initialize() || !server->start()) {
+            std::cerr << "服务器启动失败" << std::endl;
+            return 1;
+        }
+    }
+    if (!workload::waitForServer(port, 2000)) {
+        std::cerr << "无法连接 localhost:" << port << std::endl;
+        return 1;
+    }
+
+    LoadReplay replay(options, requests, port);
+    if (!replay.login()) {
+        std::cerr << "登录失败，请检查请求序列中的账号" << std::endl;
+        return 1;
+    }
+    replay.run();
+    if (server) server->stop();
+
+    replay.report(std::cout);
+    if (!options.baseline_path.empty() && !replay.compareWith(options.baseline_path, std::cout)) {
+        std::cerr << "无法读取基线: " << options.baseline_path << std::endl;
+    }
+    if (!options.out_path.empty()) {
+        std::ofstream out(options.out_path);
+        replay.writeJson(out);
+        std::cout << "\n结果已写入 " << options.out_path << std::endl;
+    }
+    return replay.failures() > 0 ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+#ifndef BENCH_WORKLOAD_H
+#define BENCH_WORKLOAD_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// 录制的 HTTP 请求序列（bench/workloads/*.http），供 PGO 训练和负载重放共用
+// 格式：请求之间用 ### 分隔，每个请求依次为请求行、请求头、空行、请求体；# 开头的行为注释
+// 占位符：{{token}} 最近一次登录返回的令牌，{{n}} 会话序号，{{day}} 01-28，{{hour}} 08-21
+
+namespace workload {
+
+struct RecordedRequest {
+    std::string method;
+    std::string target;                         // 路径和查询串
+    std::vector<std::string> headers;
+    std::string body;
+
+    // 统计分组用的名字："GET /api/contacts/search"
+    std::string label() const {
+        return method + " " + target.substr(0, target.find('?'));
+    }
+};
+
+using Values = std::map<std::string, std::string>;
+
+inline std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+inline std::vector<RecordedRequest> load(const std::string& path) {
+    std::ifstream file(path);
+    std::vector<RecordedRequest> requests;
+    if (!file) return requests;
+
+    std::vector<std::vector<std::string>> blocks(1);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.compare(0, 3, "###") == 0) {
+            blocks.emplace_back();
+        } else if (line.empty() || line[0] != '#') {
+            blocks.back().push_back(line);
+        }
+    }
+
+    for (const auto& block : blocks) {
+        size_t i = 0;
+        while (i < block.size() && trim(block[i]).empty()) i++;
+        if (i == block.size()) continue;
+
+        RecordedRequest request;
+        std::istringstream request_line(block[i++]);
+        request_line >> request.method >> request.target;
+        for (; i < block.size() && !trim(block[i]).empty(); i++) {
+            request.headers.push_back(block[i]);
+        }
+        std::string body;
+        for (; i < block.size(); i++) {
+            body += block[i] + "\n";
+        }
+        request.body = trim(body);
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+inline std::string substitute(std::string text, const Values& values) {
+    for (const auto& value : values) {
+        std::string from = "{{" + value.first + "}}";
+        for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + value.second.size())) {
+            text.replace(pos, from.size(), value.second);
+        }
+    }
+    return text;
+}
+
+// 第 n 个会话的占位符取值；{{token}} 不在这里设置，由调用方从登录响应中取得
+inline void setSession(Values& values, long n) {
+    auto twoDigits = [](long value) { return (value < 10 ? "0" : "") + std::to_string(value); };
+    values["n"] = std::to_string(n);
+    values["day"] = twoDigits(1 + n % 28);
+    values["hour"] = twoDigits(8 + n % 14);
+}
+
+// 生成完整的 HTTP/1.1 请求（服务器每个连接只处理一个请求，因此带 Connection: close）
+inline std::string render(const RecordedRequest& request, const Values& values) {
+    std::string body = substitute(request.body, values);
+    std::string raw = request.method + " " + substitute(request.target, values) + " HTTP/1.1\r\nHost: localhost\r\n";
+    for (const auto& header : request.headers) {
+        raw += substitute(header, values) + "\r\n";
+    }
+    if (!body.empty()) {
+        raw += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    return raw + "Connection: close\r\n\r\n" + body;
+}
+
+// 响应状态码，不是合法的 HTTP 响应返回 0
+inline int statusOf(const std::string& response) {
+    if (response.compare(0, 9, "HTTP/1.1 ") != 0) return 0;
+    return std::atoi(response.c_str() + 9);
+}
+
+// 登录响应中的 "token"，没有则返回空串
+inline std::string extractToken(const std::string& response) {
+    size_t key = response.find("\"token\"");
+    if (key == std::string::npos) return "";
+    size_t colon = response.find(':', key);
+    size_t begin = colon == std::string::npos ? colon : response.find('"', colon);
+    if (begin == std::string::npos) return "";
+    size_t end = response.find('"', begin + 1);
+    if (end == std::string::npos) return "";
+    return response.substr(begin + 1, end - begin - 1);
+}
+
+// 阻塞连接 localhost:port，失败返回 -1
+inline int connectLocal(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// 同步发送一个请求并读到对端关闭，返回状态码，失败返回 0
+inline int roundTrip(int port, const std::string& raw, std::string& response) {
+    response.clear();
+    int fd = connectLocal(port);
+    if (fd < 0) return 0;
+    size_t sent = 0;
+    while (sent < raw.size()) {
+        ssize_t n = send(fd, raw.data() + sent, raw.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        sent += static_cast<size_t>(n);
+    }
+    char buffer[8192];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    close(fd);
+    return statusOf(response);
+}
+
+// 等服务器开始监听（监听套接字在服务线程里创建），最多等 timeout_ms
+inline bool waitForServer(int port, int timeout_ms) {
+    for (int waited = 0; waited < timeout_ms; waited += 10) {
+        int fd = connectLocal(port);
+        if (fd >= 0) {
+            close(fd);
+            return true;
+        }
+        usleep(10000);
+    }
+    return false;
+}
+
+// 进程内启动服务器前的准备：服务器使用相对路径 data/ 和 frontend/，
+// 因此切换到 workdir 并清空其中的 data/，每次运行从同一状态开始
+inline bool prepareWorkdir(const std::string& workdir, const std::string& frontend) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::string frontend_path = frontend.empty() ? "" : fs::absolute(frontend).string();
+    fs::create_directories(workdir, ec);
+    fs::current_path(workdir, ec);
+    if (ec) return false;
+    fs::remove_all("data", ec);
+    fs::create_directory("data", ec);
+    if (!frontend_path.empty() && !fs::exists("frontend")) {
+        fs::create_directory_symlink(frontend_path, "frontend", ec);
+    }
+    return true;
+}
+
+} // namespace workload
+
+#endif // BENCH_WORKLOAD_H
@@ -3,18 +3,36 @@
 
 #include "data_manager.h"
 #include "segment_tree.h"
+#include "index_snapshot.h"
+#include "operation_log.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <atomic>
+#include <cstdint>
 
 class ActivityManager {
 private: 
     DataManager* data_manager;                          // 改为指针（由外部注入）
+    std::unique_ptr<DataManager> owned_data_manager;    // 旧构造函数自行创建的实例，随本对象释放
+    OperationLog* operation_log;                        // 操作日志（由外部注入，可为空）
     std::unique_ptr<SegmentTree> conflict_detector;     // 冲突检测器
     std::map<std::string, std::vector<int>> location_activities;  // 地点-活动映射
     
     bool conflict_detection_enabled;                     // 是否启用冲突检测
+    std::atomic<uint64_t> generation;                    // 活动表代数，每次修改后加一
+    
+    // 按日期的占用索引，供空闲时段推荐使用：首次推荐时从全表构建，之后随增删改维护
+    // 跨天的活动在开始和结束日期各记一段，截到当天范围内
+    struct DayBooking {
+        int id;
+        std::string location;
+        int start_minutes;
+        int end_minutes;
+    };
+    std::map<std::string, std::vector<DayBooking>> day_bookings;
+    bool day_index_built;
 
 public:
     //接收外部注入的DataManager
@@ -32,7 +50,9 @@ public:
     
     // 初始化
     bool initialize();
+    bool initializeFromSnapshot(const IndexSnapshotFile& snapshot);       // 从快照恢复地点索引，失败时回退重建
     bool isReady() const;
+    uint64_t getGeneration() const;                                       // 缓存的活动数据据此判断是否过期
     
     // 基本活动操作
     bool addActivity(const std::string& name, const std::string& location, 
@@ -40,6 +60,11 @@ public:
     bool addActivity(const Activity& activity);
     bool removeActivity(int id);
     bool updateActivity(const Activity& activity);
+    bool restoreActivity(const Activity& activity);                       // 按原ID恢复已删除的活动
+    
+    // 撤销/重做
+    void setOperationLog(OperationLog* log);                              // 成功的修改写入操作日志
+    bool replayOperation(const OperationRecord& record, bool inverse);    // 重放活动操作（inverse 为逆操作）
     
     // 高级查询功能
     std::vector<Activity> findByLocation(const std::string& location);     // 按地点查找
@@ -55,6 +80,8 @@ public:
     // 资源调度
     std::vector<std::string> getAvailableLocations(const std::string& start_time, const std::string& end_time);
     std::vector<Activity> getUpcomingActivities(int days = 7);           // 获取即将到来的活动
+    // 同一天内离期望时间最近的可行安排（any_location 为 true 时也考虑其他地点），按距离排序
+    std::vector<Activity> suggestAlternatives(const Activity& activity, size_t limit = 3, bool any_location = false);
     
     // 数据分析  
     int getTotalCount();
@@ -68,11 +95,20 @@ public:
     // 工具方法
     void printScheduleSummary();                                          // 打印日程摘要
     void printConflictReport();                                          // 打印冲突报告
+    void writeSnapshot(IndexSnapshotWriter& writer) const;                // 写入地点索引快照段
+    
+    // 批量构建地点索引：按分片并行统计后按分片顺序合并（thread_count 为0时使用硬件线程数）
+    static std::map<std::string, std::vector<int>> buildLocationIndex(const std::vector<Activity>& activities,
+                                                                      unsigned thread_count = 0);
     
 private:
     // 内部辅助方法
     void updateLocationIndex(const Activity& activity);                   // 更新地点索引
     void removeFromLocationIndex(const Activity& activity);               // 从地点索引移除
+    bool restoreLocationIndex(const IndexSnapshotFile& snapshot);         // 从快照恢复地点索引
+    void buildDayIndex();                                                 // 从全表构建按日期的占用索引
+    void addToDayIndex(const Activity& activity);
+    void removeFromDayIndex(const Activity& activity);
     bool validateActivity(const Activity& activity);                      // 活动验证
     Activity createActivity(const std::string& name, const std::string& location,
                            const std::string& start_time, const std::string& end_time);
@@ -0,0 +1,290 @@
+#ifndef ARRAY_STACK_H
+#define ARRAY_STACK_H
+
+#include <iostream>
+#include <stdexcept>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+// 连续存储的栈（接口与 Stack<T> 相同）
+// 元素数不超过 InlineCapacity 时存放在对象内部的缓冲区，不分配堆内存；
+// 超出后按两倍扩容到堆上。入栈支持移动与原地构造
+template<typename T, size_t InlineCapacity = 8>
+class ArrayStack {
+private:
+    static constexpr size_t INLINE_SLOTS = InlineCapacity > 0 ? InlineCapacity : 1;
+
+    alignas(T) unsigned char inlineBuffer[INLINE_SLOTS * sizeof(T)];  // 内联缓冲区
+    T* elements;        // 当前存储（内联缓冲区或堆）
+    size_t stackSize;   // 栈中的元素数量
+    size_t stackCapacity;   // 当前存储可容纳的元素数量
+
+public:
+    // 构造和析构
+    ArrayStack();                                       // 默认构造函数
+    ~ArrayStack();                                      // 析构函数
+    ArrayStack(const ArrayStack& other);                // 拷贝构造函数（一次遍历，最多一次分配）
+    ArrayStack& operator=(const ArrayStack& other);     // 拷贝赋值运算符
+    ArrayStack(ArrayStack&& other) noexcept;            // 移动构造函数
+    ArrayStack& operator=(ArrayStack&& other) noexcept; // 移动赋值运算符
+
+    // 栈的基本操作
+    void push(const T& value);      // 入栈（拷贝）
+    void push(T&& value);           // 入栈（移动）
+    template<typename... Args>
+    T& emplace(Args&&... args);     // 原地构造入栈，返回新栈顶
+    void pop();                     // 出栈
+    T& top();                       // 获取栈顶元素（非const）
+    const T& top() const;           // 获取栈顶元素（const）
+
+    // 工具函数
+    bool empty() const;             // 检查栈是否为空
+    size_t size() const;            // 获取栈的大小
+    void clear();                   // 清空栈（保留已分配的容量）
+    void reserve(size_t capacity);  // 预留容量
+    size_t capacity() const;        // 当前容量
+    bool isInline() const;          // 是否仍使用内联缓冲区
+
+    // 调试扩展
+    void print() const;             // 打印整个栈（从栈顶到栈底）
+
+private:
+    T* inlineData();
+    void releaseStorage();                      // 析构全部元素并释放堆存储
+    void moveFrom(ArrayStack& other);           // 接管 other 的元素（调用前本对象须为空且使用内联缓冲区）
+    template<typename... Args>
+    void growAndEmplace(Args&&... args);        // 扩容后在栈顶构造新元素
+};
+
+// 默认构造函数
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>::ArrayStack()
+    : elements(inlineData()), stackSize(0), stackCapacity(INLINE_SLOTS) {}
+
+// 析构函数
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>::~ArrayStack() {
+    releaseStorage();
+}
+
+// 拷贝构造函数：按栈底到栈顶顺序一次复制
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>::ArrayStack(const ArrayStack& other)
+    : elements(inlineData()), stackSize(0), stackCapacity(INLINE_SLOTS) {
+    reserve(other.stackSize);
+    for (size_t i = 0; i < other.stackSize; i++) {
+        new (elements + i) T(other.elements[i]);
+        stackSize++;
+    }
+}
+
+// 拷贝赋值运算符
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>& ArrayStack<T, InlineCapacity>::operator=(const ArrayStack& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.stackSize);
+        for (size_t i = 0; i < other.stackSize; i++) {
+            new (elements + i) T(other.elements[i]);
+            stackSize++;
+        }
+    }
+    return *this;
+}
+
+// 移动构造函数
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>::ArrayStack(ArrayStack&& other) noexcept
+    : elements(inlineData()), stackSize(0), stackCapacity(INLINE_SLOTS) {
+    moveFrom(other);
+}
+
+// 移动赋值运算符
+template<typename T, size_t InlineCapacity>
+ArrayStack<T, InlineCapacity>& ArrayStack<T, InlineCapacity>::operator=(ArrayStack&& other) noexcept {
+    if (this != &other) {
+        releaseStorage();
+        elements = inlineData();
+        stackCapacity = INLINE_SLOTS;
+        moveFrom(other);
+    }
+    return *this;
+}
+
+// 入栈（拷贝）
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::push(const T& value) {
+    emplace(value);
+}
+
+// 入栈（移动）
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::push(T&& value) {
+    emplace(std::move(value));
+}
+
+// 原地构造入栈
+template<typename T, size_t InlineCapacity>
+template<typename... Args>
+T& ArrayStack<T, InlineCapacity>::emplace(Args&&... args) {
+    if (stackSize == stackCapacity) {
+        growAndEmplace(std::forward<Args>(args)...);
+    } else {
+        new (elements + stackSize) T(std::forward<Args>(args)...);
+    }
+    stackSize++;
+    return elements[stackSize - 1];
+}
+
+// 出栈
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::pop() {
+    if (empty()) {
+        throw std::underflow_error("Stack is empty. Cannot pop.");
+    }
+    stackSize--;
+    elements[stackSize].~T();
+}
+
+// 获取栈顶元素（非const）
+template<typename T, size_t InlineCapacity>
+T& ArrayStack<T, InlineCapacity>::top() {
+    if (empty()) {
+        throw std::underflow_error("Stack is empty. No top element.");
+    }
+    return elements[stackSize - 1];
+}
+
+// 获取栈顶元素（const）
+template<typename T, size_t InlineCapacity>
+const T& ArrayStack<T, InlineCapacity>::top() const {
+    if (empty()) {
+        throw std::underflow_error("Stack is empty. No top element.");
+    }
+    return elements[stackSize - 1];
+}
+
+// 检查栈是否为空
+template<typename T, size_t InlineCapacity>
+bool ArrayStack<T, InlineCapacity>::empty() const {
+    return stackSize == 0;
+}
+
+// 获取栈的大小
+template<typename T, size_t InlineCapacity>
+size_t ArrayStack<T, InlineCapacity>::size() const {
+    return stackSize;
+}
+
+// 清空栈
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::clear() {
+    while (stackSize > 0) {
+        stackSize--;
+        elements[stackSize].~T();
+    }
+}
+
+// 预留容量
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::reserve(size_t capacity) {
+    if (capacity <= stackCapacity) return;
+
+    T* storage = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (size_t i = 0; i < stackSize; i++) {
+        new (storage + i) T(std::move_if_noexcept(elements[i]));
+        elements[i].~T();
+    }
+    if (!isInline()) {
+        ::operator delete(elements);
+    }
+    elements = storage;
+    stackCapacity = capacity;
+}
+
+// 当前容量
+template<typename T, size_t InlineCapacity>
+size_t ArrayStack<T, InlineCapacity>::capacity() const {
+    return stackCapacity;
+}
+
+// 是否使用内联缓冲区
+template<typename T, size_t InlineCapacity>
+bool ArrayStack<T, InlineCapacity>::isInline() const {
+    return elements == reinterpret_cast<const T*>(inlineBuffer);
+}
+
+// 打印整个栈（加上空栈提示）
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::print() const {
+    if (empty()) {
+        std::cout << "栈内容（从栈顶到栈底）: 空栈\n";
+        return;
+    }
+    std::cout << "栈内容（从栈顶到栈底）: ";
+    for (size_t i = stackSize; i > 0; i--) {
+        std::cout << elements[i - 1] << " ";
+    }
+    std::cout << "\n";
+}
+
+// 内联缓冲区起始地址
+template<typename T, size_t InlineCapacity>
+T* ArrayStack<T, InlineCapacity>::inlineData() {
+    return reinterpret_cast<T*>(inlineBuffer);
+}
+
+// 析构全部元素并释放堆存储
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::releaseStorage() {
+    clear();
+    if (!isInline()) {
+        ::operator delete(elements);
+    }
+}
+
+// 接管另一个栈的元素：堆存储直接转移指针，内联存储逐个移动
+template<typename T, size_t InlineCapacity>
+void ArrayStack<T, InlineCapacity>::moveFrom(ArrayStack& other) {
+    if (other.isInline()) {
+        for (size_t i = 0; i < other.stackSize; i++) {
+            new (elements + i) T(std::move(other.elements[i]));
+            other.elements[i].~T();
+        }
+        stackSize = other.stackSize;
+    } else {
+        elements = other.elements;
+        stackSize = other.stackSize;
+        stackCapacity = other.stackCapacity;
+        other.elements = other.inlineData();
+        other.stackCapacity = INLINE_SLOTS;
+    }
+    other.stackSize = 0;
+}
+
+// 扩容：先在新存储中构造新元素（参数可能引用旧存储中的元素），再迁移旧元素
+template<typename T, size_t InlineCapacity>
+template<typename... Args>
+void ArrayStack<T, InlineCapacity>::growAndEmplace(Args&&... args) {
+    size_t capacity = stackCapacity * 2;
+    T* storage = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    try {
+        new (storage + stackSize) T(std::forward<Args>(args)...);
+    } catch (...) {
+        ::operator delete(storage);
+        throw;
+    }
+
+    for (size_t i = 0; i < stackSize; i++) {
+        new (storage + i) T(std::move_if_noexcept(elements[i]));
+        elements[i].~T();
+    }
+    if (!isInline()) {
+        ::operator delete(elements);
+    }
+    elements = storage;
+    stackCapacity = capacity;
+}
+
+#endif // ARRAY_STACK_H
@@ -3,11 +3,18 @@
 
 #include "segment_tree.h"
 #include "sqlite_manager.h"
+#include "index_snapshot.h"
+#include "operation_log.h"
+#include "priority_queue.h"
+#include "schedule_optimizer.h"
+#include "slot_suggester.h"
+#include "recurrence.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
 #include <set>
+#include <atomic>
 
 // 时间段结构
 struct TimeSlot {
@@ -18,6 +25,7 @@ struct TimeSlot {
     
     TimeSlot() : start_minutes(0), end_minutes(0) {}  // 默认构造函数
     TimeSlot(const std::string& start, const std::string& end);
+    static TimeSlot fromMinutes(int start, int end);    // 由分钟数构造，不再解析字符串
     bool overlaps(const TimeSlot& other) const;
     std::string toString() const;
 };
@@ -30,10 +38,11 @@ struct Reservation {
     TimeSlot time_slot;          // 时间段
     int priority;                // 优先级（1-10，10为最高）
     std::string contact_info;    // 联系信息
+    int demand;                  // 占用的容量单位（场地数、座位数），默认1
     
-    Reservation() : id(0), time_slot("", ""), priority(5) {}  // 默认构造函数
+    Reservation() : id(0), time_slot("", ""), priority(5), demand(1) {}  // 默认构造函数
     Reservation(int id, const std:: string& resource, const std::string& activity,
-               const TimeSlot& slot, int priority = 5, const std::string& contact = "");
+               const TimeSlot& slot, int priority = 5, const std::string& contact = "", int demand = 1);
 };
 
 // 冲突信息结构
@@ -46,14 +55,89 @@ struct ConflictInfo {
     ConflictInfo(const std::string& resource, const TimeSlot& period);
 };
 
+// 候补队列中的预约请求
+struct WaitlistEntry {
+    int ticket;                  // 候补编号
+    uint64_t sequence;           // 入队顺序，同优先级先到先得
+    Reservation reservation;
+};
+
+// 候补出队顺序：优先级高的在前，同优先级按入队顺序
+struct WaitlistOrder {
+    bool operator()(const WaitlistEntry& a, const WaitlistEntry& b) const {
+        if (a.reservation.priority != b.reservation.priority) {
+            return a.reservation.priority > b.reservation.priority;
+        }
+        return a.sequence < b.sequence;
+    }
+};
+
+// 批量准入结果：成功时 reservation_id 有效，未准入且进入候补时 waitlist_ticket 有效
+struct AdmissionResult {
+    int reservation_id;
+    int waitlist_ticket;
+    
+    AdmissionResult() : reservation_id(-1), waitlist_ticket(-1) {}
+};
+
+// 多资源原子预约结果：success 为 false 时没有任何一项生效
+struct BundleResult {
+    bool success;
+    std::vector<int> reservation_ids;        // 与请求顺序对应
+    int failed_index;                        // 第一个放不下的请求，成功时为 -1
+    std::vector<Reservation> conflicts;      // 与失败请求冲突的已有预约
+    
+    BundleResult() : success(false), failed_index(-1) {}
+};
+
+// 重复预约系列：同一资源、同一时间段按重复规则出现
+// 只保存规则，各次发生在查询时按窗口展开
+struct RecurringSeries {
+    int id;
+    std::string resource_name;
+    std::string activity_name;
+    TimeSlot time_slot;          // 每次发生的时间段（"HH:MM"）
+    int priority;
+    std::string contact_info;
+    int demand;
+    RecurrenceRule rule;
+    
+    RecurringSeries() : id(0), priority(5), demand(1) {}
+};
+
+// 按需展开的一次发生（或与系列冲突的单次预约）
+struct SeriesOccurrence {
+    int series_id;               // 单次预约为 0
+    std::string date;            // "YYYY-MM-DD"；不带日期的单次预约为空（每天都占用）
+    Reservation reservation;     // 时间段带日期
+};
+
 class ConflictDetector {
 private: 
-    std::map<std::string, std::unique_ptr<SegmentTree>> resource_trees;  // 每个资源一个线段树
+    std::map<std::string, std::unique_ptr<SegmentTree>> resource_trees;  // 每个资源一个线段树（各时刻单次预约的占用量）
+    // 单次预约加上各系列时段的需求（系列不区分日期，按每天都发生计），供间隙索引和排课使用
+    std::map<std::string, std::unique_ptr<SegmentTree>> occupancy_trees;
+    std::map<std::string, int> resource_capacity;                        // 资源容量，未设置时为1
+    SlotSuggester gap_index;                                             // 每个资源的空闲间隙索引（按 occupancy_trees）
+    std::map<std::string, std::string> resource_groups;                  // 资源 -> 可互换的资源组
     std::map<int, Reservation> reservations;                             // 预约ID映射
     std:: set<std::string> available_resources;                          // 可用资源列表
     
+    using Waitlist = PriorityQueue<WaitlistEntry, WaitlistOrder>;
+    std::map<std::string, Waitlist> waitlists;                           // 每个资源一个候补队列
+    std::map<int, std::pair<std::string, Waitlist::Handle>> waitlist_tickets;  // 候补编号 -> (资源, 句柄)
+    int next_waitlist_ticket;
+    uint64_t next_waitlist_sequence;
+    
+    std::map<int, RecurringSeries> series;                               // 系列ID映射
+    std::map<std::string, std::multimap<int, int>> series_by_resource;   // 资源 -> (开始分钟 -> 系列ID)
+    int next_series_id;
+    
     int next_reservation_id;
+    
+    std::atomic<uint64_t> generation;  // 资源与预约数据的代数，每次修改后加一
     bool auto_resolve_enabled;    // 是否启用自动解决冲突
+    OperationLog* operation_log;  // 操作日志（由外部注入，可为空）
 
 public:
     ConflictDetector();
@@ -65,20 +149,63 @@ public:
     
     // 初始化
     bool initialize(const std::vector<std::string>& resources);
-    void addResource(const std:: string& resource_name);
+    void addResource(const std:: string& resource_name, int capacity = 1);
+    bool setResourceCapacity(const std::string& resource_name, int capacity);  // 低于现有峰值占用时拒绝
+    int getResourceCapacity(const std::string& resource_name) const;
     void removeResource(const std::string& resource_name);
+    void setResourceGroup(const std::string& resource_name, const std::string& group);  // 同组资源可互相替代
+    std::vector<std::string> getEquivalentResources(const std::string& resource_name) const;
     std::vector<std::string> getAvailableResources() const;
+    uint64_t getGeneration() const;                                    // 缓存的调度数据据此判断是否过期
     
     // 预约管理
     int addReservation(const std::string& resource, const std::string& activity,
                       const std::string& start_time, const std::string& end_time,
-                      int priority = 5, const std::string& contact = "");
+                      int priority = 5, const std::string& contact = "", int demand = 1);
     int addReservation(const Reservation& reservation);
     bool removeReservation(int reservation_id);
     bool updateReservation(int reservation_id, const Reservation& new_reservation);
     
+    // 多资源原子预约：全部可容纳时一起生效（一个撤销单元），任何一项放不下则都不生效。
+    // 原子性来自逐项暂存、失败时全部撤回，不做按优先级的自动解决冲突；与其他方法一样不加锁，只在服务器线程中调用
+    BundleResult reserveAll(const std::vector<Reservation>& bundle);
+    
+    // 按优先级准入：一批请求按优先级从高到低（同优先级开始早的在前）依次预约，
+    // 结果与请求顺序对应；waitlist_rejected 为 true 时未准入的请求进入候补
+    std::vector<AdmissionResult> admitReservations(const std::vector<Reservation>& requests,
+                                                   bool waitlist_rejected = true);
+    
+    // 候补队列（资源有预约被取消时按优先级自动补位）
+    int addToWaitlist(const Reservation& reservation);                 // 返回候补编号，资源不存在时返回-1
+    bool cancelWaitlist(int ticket);
+    bool updateWaitlistPriority(int ticket, int priority);
+    int promoteWaitlist(const std::string& resource);                  // 为可容纳的候补请求预约，返回补位数量
+    std::vector<WaitlistEntry> getWaitlist(const std::string& resource) const;  // 按出队顺序
+    int getWaitlistSize() const;
+    
+    // 重复预约：整个系列一次性做冲突检查，成功返回系列ID，失败返回-1
+    int addRecurringReservation(const std::string& resource, const std::string& activity,
+                                const std::string& start_time, const std::string& end_time,
+                                const RecurrenceRule& rule, int priority = 5, const std::string& contact = "",
+                                int demand = 1);
+    int addRecurringReservation(const RecurringSeries& recurring);
+    bool removeRecurringReservation(int series_id);
+    bool addSeriesException(int series_id, const std::string& date);  // 取消系列中的某一次
+    std::vector<SeriesOccurrence> findSeriesConflicts(const RecurringSeries& recurring) const;
+    // [from_date, to_date] 内的系列发生与带日期的单次预约，按日期和开始时间排序
+    std::vector<SeriesOccurrence> getOccurrences(const std::string& from_date, const std::string& to_date,
+                                                 const std::string& resource = "") const;
+    std::vector<RecurringSeries> getAllSeries() const;
+    static const int MAX_SERIES_DAYS;                                  // 系列最长跨度（天）
+    
+    // 撤销/重做
+    void setOperationLog(OperationLog* log);                            // 成功的修改写入操作日志
+    bool replayOperation(const OperationRecord& record, bool inverse);  // 重放预约操作（inverse 为逆操作）
+    
     // 冲突检测
-    bool hasConflict(const std::string& resource, const TimeSlot& time_slot) const;
+    // 容量不足即冲突；重复预约按时段中的日期核对当天的发生，不带日期时与任何一天冲突都算
+    bool hasConflict(const std::string& resource, const TimeSlot& time_slot, int demand = 1) const;
+    int getPeakOccupancy(const std::string& resource, const TimeSlot& time_slot) const;
     std::vector<ConflictInfo> detectAllConflicts() const;
     std::vector<Reservation> findConflictingReservations(const std::string& resource, 
                                                         const TimeSlot& time_slot) const;
@@ -90,10 +217,24 @@ public:
                                                  int duration_minutes = 60) const;
     std::string findBestResource(const TimeSlot& time_slot, int min_priority = 1) const;
     
+    // 离期望时间最近的 limit 个可行时间段（across_equivalent 为 true 时包括同组资源）
+    std::vector<SlotSuggestion> suggestSlots(const std::string& resource, const TimeSlot& preferred_slot,
+                                             size_t limit = DEFAULT_SUGGESTIONS,
+                                             bool across_equivalent = false) const;
+    static const size_t DEFAULT_SUGGESTIONS;
+    
+    // 学期排课：对一批请求做全局优化（已有预约不动），apply 为 true 时按结果预约
+    ScheduleResult planReservations(const std::vector<ScheduleRequest>& requests,
+                                    const OptimizerOptions& options = OptimizerOptions(),
+                                    bool apply = true);
+    
     // 冲突解决
     void enableAutoResolve(bool enable = true);
     std::vector<std::string> generateResolutionSuggestions(const ConflictInfo& conflict) const;
-    bool resolveConflictByPriority(const std::string& resource, const TimeSlot& time_slot);
+    // 取消优先级更低的冲突预约，直到容量足够放下 incoming_demand；放不下时不取消任何预约
+    bool resolveConflictByPriority(const std::string& resource, const TimeSlot& time_slot,
+                                   int incoming_priority = 11,   // 默认可取消任意优先级的冲突预约
+                                   int incoming_demand = 1);
     bool resolveConflictByRescheduling(int low_priority_reservation_id);
     
     // 查询和统计
@@ -111,13 +252,26 @@ public:
     std::map<std::string, int> getResourceUsageStats() const;
     int getTotalReservations() const;
     
+    // 快照（预约只保存在内存中，快照同时承担持久化）
+    void writeSnapshot(IndexSnapshotWriter& writer) const;
+    bool restoreSnapshot(const IndexSnapshotFile& snapshot);           // 恢复资源与预约，重建线段树
+    
 private:
     // 内部辅助方法
     int parseTimeToMinutes(const std::string& time_str) const;
-    std::string minutesToTimeString(int minutes) const;
     void updateResourceTree(const std::string& resource, const Reservation& reservation, bool add = true);
+    void updateSeriesOccupancy(const RecurringSeries& recurring, bool add);
+    bool exceedsCapacity(const std::string& resource, const TimeSlot& time_slot, int demand) const;  // 只看单次预约
     std::vector<TimeSlot> findFreeSlots(const std::string& resource, int duration_minutes = 60) const;
     bool isValidTimeFormat(const std::string& time_str) const;
+    bool eraseReservation(int reservation_id);                         // 只取消预约，不触发候补补位
+    int enqueueWaitlist(WaitlistEntry entry);
+    // 单次预约与系列；pending 为尚未写入预约表、但已占用线段树的同批预约
+    std::vector<SeriesOccurrence> seriesConflictsFor(const Reservation& reservation,
+                                                     const std::vector<Reservation>& pending = {}) const;
+    void refreshGapIndex(const std::string& resource, int start_minutes, int end_minutes);     // 按容量重算占满的区间
+    bool eraseSeries(int series_id);
+    void indexSeries(const RecurringSeries& recurring);
 };
 
 #endif // CONFLICT_DETECTOR_H
\ No newline at end of file
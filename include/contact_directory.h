@@ -0,0 +1,83 @@
+#ifndef CONTACT_DIRECTORY_H
+#define CONTACT_DIRECTORY_H
+
+#include "index_snapshot.h"
+#include "sqlite_manager.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// 只读联系人通讯录（列式存储 + 字符串池，mmap 加载）
+// 复用快照文件格式，包含四个段：
+//   IDS        int32[行数]，按ID升序，行号即下标
+//   FIELDS     StringRef[5][行数]，依次为姓名、学号、电话、邮箱、院系
+//   NAME_ORDER uint32[行数]，按姓名字节序（同名按ID）排列的行号
+//   POOL       去重后的字符串字节
+// 查询结果是32位行号，字段以指向映射区的 string_view 返回，JSON 直接从映射区写出
+class ContactDirectory {
+public:
+    // 字段列
+    enum Field : uint32_t {
+        FIELD_NAME = 0,
+        FIELD_STUDENT_ID,
+        FIELD_PHONE,
+        FIELD_EMAIL,
+        FIELD_DEPARTMENT,
+        FIELD_COUNT
+    };
+
+    // 字符串引用（相对字符串池起点）
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    ContactDirectory();
+
+    // 禁用拷贝
+    ContactDirectory(const ContactDirectory&) = delete;
+    ContactDirectory& operator=(const ContactDirectory&) = delete;
+
+    // 由联系人列表生成通讯录文件；source_version 记录生成时的索引版本
+    static bool build(const std::string& path,
+                      const std::vector<std::shared_ptr<Contact>>& contacts,
+                      uint64_t source_version);
+
+    bool open(const std::string& path);         // 映射并校验各列，失败返回false
+    bool isOpen() const;
+    uint64_t sourceVersion() const;             // 生成时的索引版本
+    uint32_t size() const;                      // 行数
+
+    // 查询（返回行号）
+    std::vector<uint32_t> searchByNamePrefix(std::string_view prefix) const;  // 姓名前缀搜索，按姓名排序
+    bool findRow(int id, uint32_t& row) const;                                // ID二分查找
+
+    // 按行读取字段（指向映射区，通讯录存活期间有效）
+    int id(uint32_t row) const;
+    std::string_view field(uint32_t row, Field which) const;
+    std::string_view name(uint32_t row) const { return field(row, FIELD_NAME); }
+    std::string_view studentId(uint32_t row) const { return field(row, FIELD_STUDENT_ID); }
+    std::string_view phone(uint32_t row) const { return field(row, FIELD_PHONE); }
+    std::string_view email(uint32_t row) const { return field(row, FIELD_EMAIL); }
+    std::string_view department(uint32_t row) const { return field(row, FIELD_DEPARTMENT); }
+
+    // JSON 序列化：直接追加到 out，不创建中间对象
+    void appendJson(uint32_t row, std::string& out) const;
+    void appendJsonArray(const std::vector<uint32_t>& rows, std::string& out) const;
+
+private:
+    IndexSnapshotFile file;
+    const char* ids;                            // int32[row_count]
+    const char* refs;                           // StringRef[FIELD_COUNT][row_count]
+    const char* name_order;                     // uint32[row_count]
+    const char* pool;
+    uint32_t row_count;
+    uint32_t pool_size;
+
+    uint32_t rowAt(uint32_t position) const;    // 姓名序第 position 位的行号
+    static void appendEscaped(std::string_view value, std::string& out);
+};
+
+#endif // CONTACT_DIRECTORY_H
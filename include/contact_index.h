@@ -0,0 +1,109 @@
+#ifndef CONTACT_INDEX_H
+#define CONTACT_INDEX_H
+
+#include "trie.h"
+#include "hash_table.h"
+#include "string_index.h"
+#include "index_snapshot.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+// 联系人索引集合：姓名前缀树 + ID主索引（含学号索引）+ 电话/邮箱精确索引
+// 单个实例不是线程安全的，并发访问通过 VersionedContactIndex 发布的快照进行
+class ContactIndex {
+public:
+    ContactIndex();
+
+    // 禁用拷贝
+    ContactIndex(const ContactIndex&) = delete;
+    ContactIndex& operator=(const ContactIndex&) = delete;
+
+    // 写操作（联系人对象在各版本间共享，写入后不得再修改）
+    void addContact(const std::shared_ptr<Contact>& contact);   // 加入所有索引
+    void removeContact(const Contact& contact);                 // 从所有索引移除
+    void reserve(size_t expected_count);                        // 预留容量
+    void clear();                                               // 清空所有索引
+    
+    // 清空后批量构建：姓名树按分片并行构建后合并，主索引与电话/邮箱索引各自并发加载
+    // thread_count 为0时使用硬件线程数，为1时退化为串行插入
+    void bulkLoad(const std::vector<std::shared_ptr<Contact>>& contacts, unsigned thread_count = 0);
+
+    // 快照：联系人记录段 + 各索引按原布局保存
+    void writeSnapshot(IndexSnapshotWriter& writer) const;
+    static bool readSnapshotContacts(const IndexSnapshotFile& file,
+                                     std::vector<std::shared_ptr<Contact>>& contacts);  // 解码联系人记录段
+    bool restoreSnapshot(const IndexSnapshotFile& file,
+                         const std::vector<std::shared_ptr<Contact>>& contacts);        // 失败时索引被清空
+
+    // 只读查询
+    std::vector<std::shared_ptr<Contact>> searchByName(const std::string& name_prefix) const;  // 姓名前缀搜索
+    std::shared_ptr<Contact> findById(int id) const;                        // ID查找
+    std::shared_ptr<Contact> findByPhone(const std::string& phone) const;   // 电话查找
+    std::shared_ptr<Contact> findByEmail(const std::string& email) const;   // 邮箱查找
+    std::shared_ptr<Contact> findByStudentId(const std::string& student_id) const;  // 学号查找
+    int phoneOwner(const std::string& phone) const;             // 电话所属联系人ID，不存在返回-1
+    int emailOwner(const std::string& email) const;             // 邮箱所属联系人ID，不存在返回-1
+    std::vector<std::shared_ptr<Contact>> getAllContacts() const;   // 主索引中的全部联系人
+
+    // 统计
+    size_t nameIndexSize() const;                               // 姓名索引记录数
+    size_t primaryIndexSize() const;                            // 主索引记录数
+    size_t phoneIndexSize() const;                              // 电话索引记录数
+    size_t emailIndexSize() const;                              // 邮箱索引记录数
+
+private:
+    Trie name_index;                                // 姓名前缀搜索索引
+    HashTable primary_index;                        // ID -> 联系人主索引（含学号二级索引）
+    StringIndex phone_lookup;                       // 电话 -> ID 精确查找索引
+    StringIndex email_lookup;                       // 邮箱 -> ID 精确查找索引
+};
+
+// 读多写少的版本化联系人索引（left-right 双副本）
+// 读者通过 snapshot() 取得当前已发布版本的引用计数快照，查询全程无锁；
+// 写者串行执行：先修改备用副本并原子发布，再等待旧版本上的读者全部释放快照，
+// 最后把同一修改重放到旧版本上，使其成为下一次写入的备用副本
+class VersionedContactIndex {
+public:
+    using Mutation = std::function<void(ContactIndex&)>;
+
+    VersionedContactIndex();
+
+    // 禁用拷贝
+    VersionedContactIndex(const VersionedContactIndex&) = delete;
+    VersionedContactIndex& operator=(const VersionedContactIndex&) = delete;
+
+    // 读者：获取当前版本快照（持有期间该版本不会被修改）
+    std::shared_ptr<const ContactIndex> snapshot() const;
+
+    // 写者：修改会依次作用于两个副本，必须是确定性的
+    void apply(const Mutation& mutation);
+    void addContact(const Contact& contact);                    // 加入联系人
+    void removeContact(const Contact& contact);                 // 移除联系人
+    void replaceContact(const Contact& old_contact, const Contact& new_contact);  // 更新联系人
+    void rebuild(const std::vector<Contact>& contacts);         // 从全量数据重建
+    void rebuild(const std::vector<std::shared_ptr<Contact>>& contacts, unsigned thread_count = 0);  // 并行批量重建
+    bool restoreSnapshot(const IndexSnapshotFile& file);        // 从快照恢复两个副本，失败时索引为空
+
+    size_t version() const;                                     // 已发布的版本号
+
+private:
+    std::unique_ptr<ContactIndex> active;           // 已发布的副本
+    std::unique_ptr<ContactIndex> standby;          // 备用副本（仅写者访问）
+
+    // 指向 active 的发布句柄（仅通过 atomic_load/atomic_exchange 访问）；
+    // 最后一个引用释放时把 released 标记置位，写者据此判断旧版本已无读者
+    std::shared_ptr<const ContactIndex> published;
+    std::shared_ptr<std::atomic<bool>> published_released;
+
+    std::atomic<size_t> published_version;          // 已发布的版本号
+    mutable std::mutex write_mutex;                 // 串行化写者
+
+    void publish(ContactIndex* index);                              // 为副本创建发布句柄并发布
+    static void waitForReaders(const std::atomic<bool>& released);  // 等待旧版本读者退出
+};
+
+#endif // CONTACT_INDEX_H
@@ -2,19 +2,41 @@
 #define CONTACT_MANAGER_H
 
 #include "data_manager.h"
-#include "trie.h"
-#include "hash_table.h"
+#include "contact_index.h"
+#include "contact_directory.h"
+#include "operation_log.h"
+#include "lru_cache.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 class ContactManager {
 private: 
     DataManager* data_manager;                      //改为指针（由外部注入）
-    std::unique_ptr<Trie> name_index;              // 姓名前缀搜索索引
-    std:: unique_ptr<HashTable> phone_index;        // 电话号码快速查找索引
+    std::unique_ptr<DataManager> owned_data_manager; // 旧构造函数自行创建的实例，随本对象释放
+    OperationLog* operation_log;                    // 操作日志（由外部注入，可为空）
     
-    bool indices_built;                             // 索引是否已构建
+    // 姓名/ID/学号/电话/邮箱索引：查询读取不可变快照，写入发布新版本
+    std::unique_ptr<VersionedContactIndex> indices;
+    std::mutex write_mutex;                         // 串行化写操作（查重 + 落库 + 更新索引）
+    
+    std::atomic<bool> indices_built;                // 索引是否已构建
+    
+    // 只读通讯录（搜索接口零拷贝输出用），索引版本变化后需重新生成
+    std::shared_ptr<const ContactDirectory> directory;  // 仅通过 atomic_load/atomic_store 访问
+    std::mutex directory_mutex;                     // 串行化通讯录重新生成
+    
+    // 姓名前缀搜索结果缓存（紧凑的ID列表，按字节预算淘汰），联系人修改时只清除其姓名的各个前缀
+    using IdList = std::shared_ptr<const std::vector<int>>;
+    std::unique_ptr<LRUCache<std::string, IdList>> prefix_cache;
+    std::mutex prefix_cache_mutex;                  // 未命中后的写回与失效互斥，避免写回旧版本的结果
+    uint64_t prefix_epoch;                          // 每次失效加一（受 prefix_cache_mutex 保护），计算期间发生过失效的结果不写回
+    
+    static const size_t PREFIX_CACHE_BYTES;         // 前缀缓存的字节预算
+    static const size_t PREFIX_CACHE_SHARDS;
+    static const size_t PREFIX_FILTER_LIMIT;        // 较短前缀的结果不超过此数时直接过滤，不再查 Trie
 
 public:
     //接收外部注入的DataManager
@@ -32,18 +54,27 @@ public:
     
     // 初始化
     bool initialize();
+    bool initializeFromSnapshot(const IndexSnapshotFile& snapshot);       // 从快照恢复索引，失败时回退重建
     bool isReady() const;
+    uint64_t getGeneration() const;                                       // 联系人数据代数（即已发布的索引版本）
     
     // 基本联系人操作
     bool addContact(const std::string& name, const std:: string& phone, const std::string& email);
     bool addContact(const Contact& contact);
     bool removeContact(int id);
     bool updateContact(const Contact& contact);
+    bool restoreContact(const Contact& contact);                          // 按原ID恢复已删除的联系人
+    
+    // 撤销/重做
+    void setOperationLog(OperationLog* log);                              // 成功的修改写入操作日志
+    bool replayOperation(const OperationRecord& record, bool inverse);    // 重放联系人操作（inverse 为逆操作）
     
     // 高级查询功能
     std::vector<Contact> searchByName(const std::string& name_prefix);      // 前缀搜索
+    std::vector<int> searchIdsByName(const std::string& name_prefix);       // 前缀搜索（只返回ID，结果带缓存）
     Contact* findByPhone(const std::string& phone);                        // 电话查找
     Contact* findByEmail(const std::string& email);                        // 邮箱查找
+    Contact* findByStudentId(const std::string& student_id);               // 学号查找
     Contact* findById(int id);                                             // ID查找
     std::vector<Contact> getAllContacts();                                 // 获取所有联系人
     
@@ -52,6 +83,7 @@ public:
     std::vector<std::string> getPopularNames(int limit = 5);              // 热门姓名统计
     bool hasDuplicatePhone(const std::string& phone);                     // 检查电话重复
     bool hasDuplicateEmail(const std::string& email);                     // 检查邮箱重复
+    bool hasDuplicateStudentId(const std::string& student_id);            // 检查学号重复
     
     // 批量操作
     bool importContacts(const std::vector<Contact>& contacts);            // 批量导入
@@ -59,14 +91,21 @@ public:
     
     // 索引管理
     bool rebuildIndices();                                                 // 重建索引
+    void writeSnapshot(IndexSnapshotWriter& writer);                      // 写入索引快照段
     void printIndexStats();                                               // 打印索引统计
+    size_t getPrefixCacheSize() const;                                    // 前缀缓存当前条目数
+    
+    // 只读通讯录
+    bool refreshDirectory(const std::string& path);                       // 索引有变化时重新生成并映射
+    std::shared_ptr<const ContactDirectory> currentDirectory() const;     // 与索引一致的通讯录，过期返回nullptr
     
 private:
     // 内部辅助方法
-    void updateIndices(const Contact& contact);                           // 更新索引
-    void removeFromIndices(const Contact& contact);                       // 从索引中移除
+    Contact* copyIndexedContact(const std::shared_ptr<Contact>& contact); // 复制索引中的联系人
     bool validateContact(const Contact& contact);                         // 联系人验证
     Contact createContact(const std::string& name, const std::string& phone, const std::string& email);
+    void invalidatePrefixes(const std::string& name);                     // 清除 name 各个前缀的缓存结果
+    void clearPrefixCache();
 };
 
 #endif // CONTACT_MANAGER_H
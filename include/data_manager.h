@@ -0,0 +1,53 @@
+#ifndef DATA_MANAGER_H
+#define DATA_MANAGER_H
+
+#include "sqlite_manager.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+// 数据访问层：封装 SQLiteManager，负责建目录、按ID读写和定期备份
+class DataManager {
+private:
+    std::unique_ptr<SQLiteManager> db_manager;
+    std::string db_path;
+    std::string backup_dir;                         // 备份目录
+    int max_backups;                                // 最多保留的备份数，超出删除最旧的
+    bool ready;
+
+    void pruneBackups();
+
+public:
+    DataManager(const std::string& db_path, const std::string& backup_dir, int max_backups);
+    ~DataManager();
+
+    // 禁用拷贝
+    DataManager(const DataManager&) = delete;
+    DataManager& operator=(const DataManager&) = delete;
+
+    bool initialize();                              // 可重复调用，已打开时直接返回
+    bool isReady() const;
+
+    // 联系人
+    bool addContact(const Contact& contact, int& new_id);  // new_id 返回自动生成的ID
+    bool restoreContact(const Contact& contact);    // 按原ID恢复（撤销删除）
+    std::vector<Contact> getAllContacts();
+    Contact* getContact(int id);                    // 调用方负责 delete，不存在返回 nullptr
+    bool updateContact(const Contact& contact);
+    bool deleteContact(int id);
+    int getContactCount();
+
+    // 活动
+    bool addActivity(const Activity& activity);
+    bool restoreActivity(const Activity& activity);
+    std::vector<Activity> getAllActivities();
+    Activity* getActivity(int id);                  // 调用方负责 delete，不存在返回 nullptr
+    bool updateActivity(const Activity& activity);
+    bool deleteActivity(int id);
+    int getActivityCount();
+
+    // 备份到 backup_dir/<库名>_YYYYmmdd_HHMMSS.db
+    bool backupAllData();
+};
+
+#endif // DATA_MANAGER_H
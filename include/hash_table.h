@@ -2,68 +2,123 @@
 #define HASH_TABLE_H
 
 #include "sqlite_manager.h"
+#include "string_index.h"
 #include <vector>
 #include <memory>
 #include <functional>
+#include <cstdint>
 
+class SnapshotBuffer;
+class SnapshotView;
+
+// 开放寻址哈希表（Robin Hood 探测 + 后移删除）
+// 控制字节、键、值分列存储：探测只访问紧凑的控制字节与键数组，命中后才读取值
+// 可选渐进式扩容：扩容时保留旧表，每次写操作只迁移固定数量的槽位，避免单次插入的长停顿
 class HashTable {
-public:  
+public:
     // 构造函数和析构函数
     HashTable(size_t initial_capacity = 16);
     ~HashTable();
     
+    // 禁用拷贝
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
     // 主要操作
     bool insert(std::shared_ptr<Contact> contact);           // 插入联系人
-    std::shared_ptr<Contact> find(int key);                  // 按ID查找
-    std::shared_ptr<Contact> findByStudentId(const std:: string& student_id); // 按学号查找
+    std::shared_ptr<Contact> find(int key) const;            // 按ID查找
+    std::shared_ptr<Contact> findByStudentId(const std:: string& student_id) const; // 按学号查找
     bool remove(int key);                                    // 删除联系人
-    bool contains(int key);                                  // 检查是否存在
-    
+    bool contains(int key) const;                            // 检查是否存在
+
     // 去重功能
     bool isDuplicate(const Contact& contact);                // 检查重复
     std::vector<std::shared_ptr<Contact>> findDuplicates();  // 找出所有重复项
     size_t removeDuplicates();                              // 移除重复项
-    
+
     // 统计和工具函数
     size_t size() const;                                    // 获取元素数量
     size_t capacity() const;                                // 获取容量
     double loadFactor() const;                              // 获取负载因子
     void clear();                                           // 清空哈希表
+    void reserve(size_t expected_count);                    // 预留容量，批量加载时避免反复扩容
     
+    // 渐进式扩容
+    void setIncrementalResize(bool enable = true);          // 启用/禁用渐进式扩容
+    bool isIncrementalResizeEnabled() const;                // 是否启用渐进式扩容
+    bool isMigrating() const;                               // 是否正在迁移旧表
+
+    // 快照：槽位数组按原布局保存，值保存为联系人记录编号；恢复时无需重新散列
+    void writeSnapshot(SnapshotBuffer& out,
+                       const std::function<uint32_t(const Contact*)>& contact_ref) const;
+    bool restoreSnapshot(const SnapshotView& in, size_t& offset,
+                         const std::vector<std::shared_ptr<Contact>>& contacts);  // 失败时哈希表保持不变
+
     // 调试和统计
     void printStatistics() const;                           // 打印统计信息
     void printDistribution() const;                         // 打印分布情况
-    std::vector<std::shared_ptr<Contact>> getAllContacts(); // 获取所有联系人
-    
+    std::vector<std::shared_ptr<Contact>> getAllContacts() const; // 获取所有联系人
+
 private:
-    // 哈希表节点
-    struct HashNode {
-        std::shared_ptr<Contact> contact;
-        HashNode* next;
-        
-        HashNode(std::shared_ptr<Contact> c) : contact(c), next(nullptr) {}
+    // 控制字节：0 表示空槽，否则为（探测距离 + 1）
+    static constexpr uint8_t EMPTY_SLOT = 0;
+    static constexpr uint8_t MAX_DISTANCE = 255;
+
+    // 槽位数组：控制字节、键、值分列存储
+    // 内存按需清零（calloc/malloc），扩容时不会一次性触碰整块新内存；
+    // 值只在控制字节非空的槽位上构造
+    struct Table {
+        uint8_t* control;                   // 控制字节数组
+        int* keys;                          // 键数组（联系人ID）
+        std::shared_ptr<Contact>* values;   // 值数组
+        size_t size;                        // 容量（2的幂），0 表示未分配
+        unsigned shift;                     // 64 - log2(size)
+
+        Table() : control(nullptr), keys(nullptr), values(nullptr), size(0), shift(0) {}
     };
+
+    Table table;                            // 当前表
+    size_t element_count;                   // 元素数量（含旧表中未迁移的元素）
     
-    std::vector<HashNode*> table;           // 哈希表数组
-    size_t table_size;                      // 当前容量
-    size_t element_count;                   // 元素数量
-    
+    // 渐进式扩容期间的旧表（只读：迁移走或删除的槽位值置空，探测距离保留）
+    Table old_table;
+    size_t migrate_cursor;                  // 下一个待迁移的旧表槽位
+    bool incremental_resize;                // 是否启用渐进式扩容
+
+    StringIndex student_id_index;           // 学号 -> ID 二级索引
+    size_t shared_student_ids;              // 学号被多个联系人共用的次数
+
     static const double MAX_LOAD_FACTOR;    // 最大负载因子
     static const size_t MIN_CAPACITY;       // 最小容量
-    
+    static const size_t MIGRATE_STEP;       // 每次写操作迁移的槽位数
+
     // 内部辅助函数
-    size_t hashFunction(int key) const;                     // 主哈希函数
-    void resize();                                          // 动态扩容
-    void insertHelper(std::shared_ptr<Contact> contact, std::vector<HashNode*>& target_table);
-    
+    static size_t hashFunction(int key, unsigned shift);    // 主哈希函数（Fibonacci 散列，取高位）
+    static void allocateTable(Table& target, size_t capacity);  // 分配空表
+    static void releaseTable(Table& target);                // 析构存活的值并释放内存
+    void resize(size_t new_capacity);                       // 扩容并重新插入所有元素
+    bool insertHelper(int& key, std::shared_ptr<Contact>& contact);  // Robin Hood 插入，探测过长时返回false并留下待插元素
+
     // 冲突处理相关
-    size_t getIndex(int key) const;                         // 获取索引位置
-    HashNode* findNode(int key);                            // 查找节点
+    static size_t findSlot(const Table& target, int key);   // 查找键所在槽位，不存在返回target.size
+    void eraseSlot(size_t index);                           // 后移删除
+    void placeEntry(int key, std::shared_ptr<Contact> contact);  // 插入新表，必要时扩容新表
     
+    // 渐进式迁移
+    void beginMigration();                                  // 旧表转入迁移状态并分配2倍新表
+    void migrateStep(size_t max_slots);                     // 迁移至多max_slots个旧表槽位
+    void finishMigration();                                 // 一次性迁移剩余槽位
+    size_t findOldSlot(int key) const;                      // 在旧表中查找，不存在返回old_table.size
+    bool forEachContact(const std::function<bool(const std::shared_ptr<Contact>&)>& visitor) const;  // 遍历新旧两表
+
+    // 学号索引维护
+    void indexStudentId(const Contact& contact);            // 加入学号索引
+    void unindexStudentId(const Contact& contact);          // 从学号索引移除
+
     // 统计函数
-    size_t getChainLength(size_t index) const;              // 获取链长度
-    size_t getMaxChainLength() const;                       // 获取最大链长度
-    double getAverageChainLength() const;                   // 获取平均链长度
+    size_t getProbeLength(size_t index) const;              // 获取槽位探测距离
+    size_t getMaxProbeLength() const;                       // 获取最大探测距离
+    double getAverageProbeLength() const;                   // 获取平均探测距离
 };
 
-#endif // HASH_TABLE_H
\ No newline at end of file
+#endif // HASH_TABLE_H
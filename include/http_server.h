@@ -0,0 +1,73 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <string>
+#include <map>
+#include <functional>
+#include <thread>
+#include <atomic>
+
+// HTTP请求
+struct HttpRequest {
+    std::string method;                             // GET / POST / PUT / DELETE ...
+    std::string path;                               // 不含查询串
+    std::string query_string;                       // '?' 之后的部分
+    std::string body;
+    std::map<std::string, std::string> headers;
+};
+
+// HTTP响应
+struct HttpResponse {
+    int status_code;
+    std::string status_text;
+    std::map<std::string, std::string> headers;
+    std::string body;
+
+    HttpResponse(int code = 200, const std::string& text = "OK") : status_code(code), status_text(text) {}
+
+    void setJson(const std::string& json) {
+        headers["Content-Type"] = "application/json; charset=utf-8";
+        body = json;
+    }
+
+    // 设置错误状态码，响应体与 buildErrorResponse 格式一致
+    void setError(int code, const std::string& message) {
+        status_code = code;
+        status_text = reasonPhrase(code);
+        std::string escaped;
+        for (char c : message) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        setJson("{\"success\": false,\"error\": \"" + escaped + "\",\"code\": " + std::to_string(code) + "}");
+    }
+
+    void setCORS() {
+        headers["Access-Control-Allow-Origin"] = "*";
+        headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
+        headers["Access-Control-Allow-Headers"] = "Content-Type, Authorization";
+    }
+
+    static const char* reasonPhrase(int code) {
+        switch (code) {
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 304: return "Not Modified";
+            case 400: return "Bad Request";
+            case 401: return "Unauthorized";
+            case 403: return "Forbidden";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 409: return "Conflict";
+            case 413: return "Payload Too Large";
+            case 429: return "Too Many Requests";
+            case 500: return "Internal Server Error";
+            case 501: return "Not Implemented";
+            case 503: return "Service Unavailable";
+            default:  return code < 400 ? "OK" : "Error";
+        }
+    }
+};
+
+#endif // HTTP_SERVER_H
@@ -6,6 +6,12 @@
 #include "contact_manager.h"
 #include "activity_manager.h"
 #include "conflict_detector.h"
+#include "operation_log.h"
+#include "lru_cache.h"
+#include "response_cache.h"
+#include "static_asset_store.h"
+#include "radix_router.h"
+#include "metrics.h"
 #include <memory>
 #include <mutex>
 #include <chrono>
@@ -15,6 +21,7 @@ struct AuthenticatedRequest : public HttpRequest {
     bool is_authenticated = false;
     std::unique_ptr<User> current_user = nullptr;
     std::string auth_token;
+    RouteParams params;                         // 路径参数，值指向原请求的 path，只在处理期间有效
     
     AuthenticatedRequest() = default;
     AuthenticatedRequest(const HttpRequest& base_request) : HttpRequest(base_request) {}
@@ -87,14 +94,50 @@ private:
     std::unique_ptr<ContactManager> contact_manager;
     std::unique_ptr<ActivityManager> activity_manager;
     std::unique_ptr<ConflictDetector> conflict_detector;
+    std::unique_ptr<OperationLog> operation_log;
     
     int port;
     std::atomic<bool> running;
+    std::atomic<int> listen_fd;                 // 监听套接字，stop() 时关闭以唤醒 accept
     std::unique_ptr<std::thread> server_thread;
     
-    // 路由映射
-    std::map<std::string, std::function<HttpResponse(const AuthenticatedRequest&)>> protected_routes;
-    std::map<std::string, std::function<HttpResponse(const HttpRequest&)>> public_routes;
+    // 索引快照
+    std::string snapshot_path;
+    std::chrono::steady_clock::time_point last_snapshot_time;
+    static const int SNAPSHOT_INTERVAL_SECONDS; // 定期快照间隔
+    
+    // 只读通讯录
+    std::string directory_path;
+    std::chrono::steady_clock::time_point last_directory_refresh;
+    static const int DIRECTORY_REFRESH_SECONDS; // 通讯录过期后的最短重新生成间隔
+    
+    // 联系人搜索响应缓存：键为 "通讯录版本\n搜索词"，联系人修改后版本变化，旧项不再命中并逐渐被淘汰
+    std::unique_ptr<LRUCache<std::string, std::string>> search_cache;
+    static const size_t SEARCH_CACHE_CAPACITY;
+    static const size_t SEARCH_CACHE_SHARDS;
+    
+    // 热点 GET 接口的响应缓存（按各表代数判断过期，支持 ETag/If-None-Match）
+    std::unique_ptr<ResponseCache> response_cache;
+    
+    // 前端静态资源（常驻内存，预压缩，原文经 sendfile 发送）
+    std::unique_ptr<StaticAssetStore> static_assets;
+    
+    // 时间段建议
+    static const size_t SUGGESTION_LIMIT;       // 冲突响应中附带的替代安排数
+    static const size_t MAX_SUGGESTION_LIMIT;   // 建议接口单次最多返回数
+    
+    // 路由表：公开路由只设置 public_handler，受保护路由只设置 protected_handler
+    struct Route {
+        std::function<HttpResponse(const HttpRequest&)> public_handler;
+        std::function<HttpResponse(const AuthenticatedRequest&)> protected_handler;
+        Histogram* latency = nullptr;           // 该路由的处理耗时
+    };
+    RadixRouter<Route> router;
+    
+    // 请求指标（对象归全局注册表所有，进程内一直有效）
+    Histogram* static_latency;                  // 静态文件快速路径
+    Histogram* unmatched_latency;               // 未匹配任何路由（静态文件回退、404）
+    Counter* responses_by_class[5];             // 按状态码类别 1xx..5xx 计数
 
 public:
     AuthenticatedHttpServer(int server_port = 8080);
@@ -122,6 +165,12 @@ private:
     HttpResponse handleRequest(const HttpRequest& request);
     void setupRoutes();
     
+    // 索引快照：启动时加载（过期则重建），运行中定期保存，正常关闭时保存
+    bool initializeIndexes();
+    bool saveSnapshot();
+    void runMaintenance();                      // 请求间隙的后台维护（快照、通讯录）
+    bool replayOperation(const OperationRecord& record, bool inverse);  // 按操作类型分派给对应管理器
+    
     // 辅助方法（添加声明）
     HttpRequest parseHttpRequest(const std::string& raw_request);
     std::string buildHttpResponse(const HttpResponse& response);
@@ -143,19 +192,30 @@ private:
     // 资源调度API（管理员专用）
     HttpResponse handleGetSchedule(const AuthenticatedRequest& request);
     HttpResponse handleCheckConflict(const AuthenticatedRequest& request);
-    HttpResponse handleCreateReservation(const AuthenticatedRequest& request);
+    HttpResponse handleCreateReservation(const AuthenticatedRequest& request);  // 多资源原子预约
+    HttpResponse handleSuggestSlots(const AuthenticatedRequest& request);     // 最近的可行时间段
+    
+    // 撤销/重做API
+    HttpResponse handleUndo(const AuthenticatedRequest& request);
+    HttpResponse handleRedo(const AuthenticatedRequest& request);
     
     // 系统API
     HttpResponse handleGetStats(const AuthenticatedRequest& request);
+    HttpResponse handleGetMetrics(const AuthenticatedRequest& request);  // Prometheus 文本格式
     HttpResponse handleBackupData(const AuthenticatedRequest& request);
     
     // 静态文件服务
-    HttpResponse serveStaticFile(const std::string& path);
+    HttpResponse serveStaticFile(const HttpRequest& request, const std::string& relative_path);
+    bool sendStaticFile(int client_fd, const HttpRequest& request);   // 直接写套接字，非静态资源返回 false
+    void countResponse(int status_code);
+    
+    // 由响应缓存输出：数据未变时复用序列化结果，客户端 ETag 一致时返回 304
+    HttpResponse serveCached(const AuthenticatedRequest& request, const std::string& generation,
+                             const std::function<std::string()>& build);
     
     // 工具方法
     std::string buildJsonResponse(const std::map<std::string, std::string>& data);
     std::string buildErrorResponse(const std::string& error, int code = 400);
-    bool matchRoutePattern(const std::string& pattern, const std::string& path);
 };
 
 #endif // HTTP_SERVER_AUTH_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef INDEX_SNAPSHOT_H
+#define INDEX_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// 内存索引快照文件（只读 mmap 加载）
+// 文件布局：[SnapshotHeader][SnapshotSectionEntry × section_count][各段数据]
+// 段内只使用相对段起点的偏移，不保存指针；整数均按本机字节序（小端）写入
+// 头部记录数据库变更序号，加载时与数据库比对，不一致即视为过期
+
+// 段类型
+enum SnapshotSectionType : uint32_t {
+    SECTION_CONTACTS = 1,        // 联系人记录
+    SECTION_NAME_TRIE = 2,       // 姓名/学号前缀树
+    SECTION_PRIMARY_INDEX = 3,   // ID主索引（含学号索引）
+    SECTION_PHONE_INDEX = 4,     // 电话索引
+    SECTION_EMAIL_INDEX = 5,     // 邮箱索引
+    SECTION_LOCATIONS = 6,       // 活动地点索引
+    SECTION_RESERVATIONS = 7,    // 资源预约
+    SECTION_DIRECTORY_IDS = 8,   // 通讯录：按ID升序的ID列
+    SECTION_DIRECTORY_FIELDS = 9,      // 通讯录：各字段字符串引用列
+    SECTION_DIRECTORY_NAME_ORDER = 10, // 通讯录：按姓名排序的行号
+    SECTION_DIRECTORY_POOL = 11        // 通讯录：去重字符串池
+};
+
+struct SnapshotHeader {
+    char magic[8];               // "CARSSNAP"
+    uint32_t version;            // 格式版本
+    uint32_t section_count;      // 段数量
+    uint64_t contacts_seq;       // 联系人库变更序号
+    uint64_t activities_seq;     // 活动库变更序号
+    uint64_t payload_size;       // 头部之后的字节数
+    uint64_t checksum;           // 头部之后全部字节的校验和
+};
+
+struct SnapshotSectionEntry {
+    uint32_t type;               // 段类型
+    uint32_t reserved;
+    uint64_t offset;             // 相对文件起点
+    uint64_t size;               // 字节数
+};
+
+// 段数据构建缓冲区
+class SnapshotBuffer {
+public:
+    template<typename T>
+    size_t append(const T& value) {                     // 追加定长值，返回其偏移
+        return appendBytes(&value, sizeof(T));
+    }
+    size_t appendBytes(const void* data, size_t length);
+    size_t appendString(const std::string& value);      // 追加 [u32 长度][字节]
+    void appendBuffer(const SnapshotBuffer& other);     // 拼接另一个缓冲区
+
+    template<typename T>
+    void patch(size_t offset, const T& value) {         // 回填已写入的定长值
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    size_t size() const { return bytes.size(); }
+    const char* data() const { return bytes.data(); }
+
+private:
+    std::vector<char> bytes;
+};
+
+// 段数据只读视图（所有读取均做越界检查，不要求对齐）
+class SnapshotView {
+public:
+    SnapshotView() : base(nullptr), length(0) {}
+    SnapshotView(const char* data, size_t size) : base(data), length(size) {}
+
+    template<typename T>
+    bool read(size_t& offset, T& value) const {         // 读取定长值并前移偏移
+        if (offset > length || length - offset < sizeof(T)) return false;
+        std::memcpy(&value, base + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+    bool readBytes(size_t& offset, void* out, size_t count) const;  // 读取定长字节块
+    bool readString(size_t& offset, std::string& value) const;      // 读取 appendString 写入的字符串
+    bool stringAt(size_t offset, std::string& value) const;         // 按偏移读取字符串（不移动游标）
+
+    size_t size() const { return length; }
+    const char* data() const { return base; }          // 段起始地址（零拷贝访问用）
+
+private:
+    const char* base;
+    size_t length;
+};
+
+// 快照写入：收集各段后一次性写入临时文件，再原子替换目标文件
+class IndexSnapshotWriter {
+public:
+    void addSection(SnapshotSectionType type, SnapshotBuffer&& buffer);
+    bool writeToFile(const std::string& path, uint64_t contacts_seq, uint64_t activities_seq) const;
+
+private:
+    std::vector<std::pair<SnapshotSectionType, SnapshotBuffer>> sections;
+};
+
+// 快照读取：mmap 映射整个文件，校验魔数、版本、长度与校验和
+class IndexSnapshotFile {
+public:
+    IndexSnapshotFile();
+    ~IndexSnapshotFile();
+
+    // 禁用拷贝
+    IndexSnapshotFile(const IndexSnapshotFile&) = delete;
+    IndexSnapshotFile& operator=(const IndexSnapshotFile&) = delete;
+
+    bool open(const std::string& path);                 // 映射并校验，失败返回false
+    void close();
+    bool isOpen() const;
+
+    uint64_t contactsSequence() const;
+    uint64_t activitiesSequence() const;
+    bool section(SnapshotSectionType type, SnapshotView& view) const;  // 查找段
+
+    static const uint32_t FORMAT_VERSION;               // 当前格式版本
+    static uint64_t checksum(const char* data, size_t length);  // 64位校验和
+
+private:
+    const char* mapped;
+    size_t mapped_size;
+    SnapshotHeader header;
+    std::vector<SnapshotSectionEntry> entries;
+};
+
+#endif // INDEX_SNAPSHOT_H
@@ -0,0 +1,135 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// 日志级别
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF   4
+
+// 编译期最低级别：低于它的日志语句连同参数求值一起被编译器删除（-DLOG_COMPILE_LEVEL=0 打开调试日志）
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#endif
+
+// 结构化字段：LOG_INFO("预约成功" << logField("id", id)) 输出 "预约成功 id=5"
+template<typename T>
+struct LogField {
+    const char* key;
+    const T& value;
+};
+
+template<typename T>
+LogField<T> logField(const char* key, const T& value) {
+    return LogField<T>{key, value};
+}
+
+// 异步日志
+// 调用线程只在栈上格式化一行文本并放入无锁环形缓冲区（多生产者、单消费者），
+// 后台线程批量写出：WARN 及以上写 stderr，其余写 stdout。缓冲区满时丢弃新日志并计数，从不阻塞调用方。
+class Logger {
+public:
+    static const size_t CAPACITY = 8192;            // 环形缓冲区槽位数（2 的幂）
+    static const size_t TEXT_CAPACITY = 216;        // 单条日志正文上限（字节），超出截断
+
+    static Logger& instance();
+
+    bool enabled(int level) const { return level >= runtime_level.load(std::memory_order_relaxed); }
+    void setLevel(int level) { runtime_level.store(level, std::memory_order_relaxed); }
+    int getLevel() const { return runtime_level.load(std::memory_order_relaxed); }
+
+    void submit(int level, const char* file, const char* text, size_t length);
+    void flush();                                   // 等待此前提交的日志全部写出
+    uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    Logger();
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence;             // == 位置：可写；== 位置 + 1：可读
+        int64_t timestamp_ns;                       // 系统时间
+        const char* file;                           // __FILE__，输出时取文件名作组件名
+        uint32_t thread;
+        uint16_t length;
+        uint8_t level;
+        char text[TEXT_CAPACITY];
+    };
+
+    void writerLoop();
+    size_t drain();                                 // 写出当前可读的日志，返回条数
+
+    Slot* slots;
+    alignas(64) std::atomic<uint64_t> write_pos;
+    alignas(64) std::atomic<uint64_t> read_pos;     // 只由写出线程修改
+    std::atomic<uint64_t> dropped;
+    std::atomic<int> runtime_level;
+    std::atomic<bool> running;
+    std::thread writer;
+};
+
+// 一行日志：在调用方栈上拼接，commit 时整体提交
+class LogLine {
+public:
+    LogLine(int level, const char* file) : level(level), file(file), length(0) {}
+
+    LogLine& operator<<(std::string_view text) { append(text.data(), text.size()); return *this; }
+    LogLine& operator<<(const char* text) { return *this << std::string_view(text ? text : "(null)"); }
+    LogLine& operator<<(const std::string& text) { append(text.data(), text.size()); return *this; }
+    LogLine& operator<<(char c) { append(&c, 1); return *this; }
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(int value) { return appendSigned(value); }
+    LogLine& operator<<(long value) { return appendSigned(value); }
+    LogLine& operator<<(long long value) { return appendSigned(value); }
+    LogLine& operator<<(unsigned value) { return appendUnsigned(value); }
+    LogLine& operator<<(unsigned long value) { return appendUnsigned(value); }
+    LogLine& operator<<(unsigned long long value) { return appendUnsigned(value); }
+    LogLine& operator<<(double value);
+
+    template<typename T>
+    LogLine& operator<<(const LogField<T>& field) {
+        *this << ' ' << field.key << '=' << field.value;
+        return *this;
+    }
+
+    void commit() { Logger::instance().submit(level, file, buffer, length); }
+
+private:
+    void append(const char* data, size_t size);
+    LogLine& appendSigned(long long value);
+    LogLine& appendUnsigned(unsigned long long value);
+
+    int level;
+    const char* file;
+    size_t length;
+    char buffer[Logger::TEXT_CAPACITY];
+};
+
+#define LOG_ENABLED(level) ((level) >= LOG_COMPILE_LEVEL && Logger::instance().enabled(level))
+
+#define LOG_AT(level, expr)                         \
+    do {                                            \
+        if (LOG_ENABLED(level)) {                   \
+            LogLine log_line_(level, __FILE__);     \
+            log_line_ << expr;                      \
+            log_line_.commit();                     \
+        }                                           \
+    } while (0)
+
+#define LOG_DEBUG(expr) LOG_AT(LOG_LEVEL_DEBUG, expr)
+#define LOG_INFO(expr)  LOG_AT(LOG_LEVEL_INFO, expr)
+#define LOG_WARN(expr)  LOG_AT(LOG_LEVEL_WARN, expr)
+#define LOG_ERROR(expr) LOG_AT(LOG_LEVEL_ERROR, expr)
+
+#endif // LOGGER_H
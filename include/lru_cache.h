@@ -2,204 +2,377 @@
 #define LRU_CACHE_H
 
 #include <unordered_map>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <memory>
+#include <functional>
 #include <iostream>
+#include <cstdint>
 
-template<typename K, typename V>
+// 线程安全的分片 LRU 缓存
+// 键按哈希分到若干分片，每个分片有独立的互斥锁、LRU 链表和容量（总容量均分），
+// 不同分片上的访问互不阻塞；淘汰只在分片内按最近使用顺序进行。
+// 节点放在分片的槽位数组中按下标链接，淘汰和删除后槽位与哈希表节点都回收复用，
+// 预热之后 put 不再分配内存（值本身的分配除外）。
+// 给出 weigher 时容量按权重计（如字节数），插入时从最旧项开始淘汰直到放得下；
+// 单项权重超过分片容量时不缓存。
+template<typename K, typename V, typename Hash = std::hash<K>>
 class LRUCache {
-private:
-    // 双向链表节点
-    struct Node {
-        K key;
-        V value;
-        Node* prev;
-        Node* next;
-        
-        Node() : prev(nullptr), next(nullptr) {}
-        Node(K k, V v) : key(k), value(v), prev(nullptr), next(nullptr) {}
+public:
+    using Weigher = std::function<size_t(const K&, const V&)>;
+
+    // 命中/未命中/淘汰统计（各分片之和）
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t insertions;
+        uint64_t evictions;      // 因容量不足被挤出（不含 remove 和 clear）
+        size_t size;
+        size_t weight;           // 未设置 weigher 时等于 size
+        size_t capacity;
+
+        Stats() : hits(0), misses(0), insertions(0), evictions(0), size(0), weight(0), capacity(0) {}
+        double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
     };
-    
-    std::unordered_map<K, Node*> cache;  // 哈希表：key -> 节点指针
-    Node* head;                          // 虚拟头节点（最新）
-    Node* tail;                          // 虚拟尾节点（最旧）
-    size_t capacity;                     // 缓存容量
-    size_t currentSize;                  // 当前大小
-    
-    // 内部辅助函数
-    void addToHead(Node* node);          // 添加节点到头部
-    void removeNode(Node* node);         // 从链表中移除节点
-    void moveToHead(Node* node);         // 移动节点到头部  
-    Node* removeTail();                  // 移除尾部节点
 
-public:
-    LRUCache(size_t cap);
-    ~LRUCache();
-    
+    explicit LRUCache(size_t cap, size_t shard_count = 1, Weigher weigher = nullptr);
+    ~LRUCache() = default;
+
+    // 禁用拷贝
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
     // 主要接口
-    V get(const K& key);                 // 获取值
-    void put(const K& key, const V& value);  // 插入/更新值
-    bool contains(const K& key) const;   // 检查key是否存在
-    void remove(const K& key);           // 删除key
-    
+    std::optional<V> get(const K& key);  // 命中时返回副本并标记为最近使用
+    void put(const K& key, V value);     // 插入/更新值，分片已满时淘汰最久未用的
+    bool contains(const K& key) const;   // 检查key是否存在（不影响顺序和统计）
+    bool remove(const K& key);           // 删除key
+    size_t removeIf(const std::function<bool(const K&, const V&)>& predicate);  // 删除满足条件的项，返回数量
+
     // 工具函数
     size_t size() const;                 // 获取当前大小
     size_t getCapacity() const;          // 获取缓存容量
+    size_t getShardCount() const;
     bool empty() const;                  // 检查是否为空
-    void clear();                        // 清空缓存
+    void clear();                        // 清空缓存（统计保留）
     void printCache() const;             // 打印缓存状态（调试用）
-    
+
     // 统计信息
+    Stats getStats() const;
+    void resetStats();
     void printStats() const;             // 打印统计信息
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    // 槽位：entry 为空表示空闲槽位
+    struct Slot {
+        std::optional<std::pair<K, V>> entry;
+        uint32_t prev;                   // 更新的一侧
+        uint32_t next;                   // 更旧的一侧
+        size_t weight;
+    };
+
+    using Index = std::unordered_map<K, uint32_t, Hash>;
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        Index index;                                         // key -> 槽位下标
+        std::vector<Slot> slots;
+        std::vector<uint32_t> free_slots;
+        std::vector<typename Index::node_type> spare_nodes;  // 删除时取出的哈希表节点，插入时复用
+        uint32_t head = NIL;                                 // 最新
+        uint32_t tail = NIL;                                 // 最旧
+        size_t capacity = 0;
+        size_t weight = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t insertions = 0;
+        uint64_t evictions = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_count;
+    size_t capacity;                     // 缓存容量
+    Weigher weigher;                     // 为空时每项权重为1
+
+    // 内部辅助函数（调用方持有分片锁）
+    Shard& shardFor(const K& key) const;
+    static void unlink(Shard& shard, uint32_t slot);         // 从链表中移除槽位
+    static void pushFront(Shard& shard, uint32_t slot);      // 槽位放到链表头部
+    static void release(Shard& shard, typename Index::iterator it);  // 删除一项并回收槽位
+    size_t weigh(const K& key, const V& value) const;
 };
 
 // 实现部分
-template<typename K, typename V>
-LRUCache<K, V>:: LRUCache(size_t cap) : capacity(cap), currentSize(0) {
-    // 创建虚拟头尾节点
-    head = new Node();
-    tail = new Node();
-    
-    // 连接头尾节点
-    head->next = tail;
-    tail->prev = head;
-}
-
-template<typename K, typename V>
-LRUCache<K, V>:: ~LRUCache() {
-    clear();
-    delete head;
-    delete tail;
-}
-
-template<typename K, typename V>
-void LRUCache<K, V>::addToHead(Node* node) {
-    // 在head后面插入node
-    node->prev = head;
-    node->next = head->next;
-    
-    head->next->prev = node;
-    head->next = node;
-}
-
-template<typename K, typename V>
-void LRUCache<K, V>:: removeNode(Node* node) {
-    // 从双向链表中移除node
-    node->prev->next = node->next;
-    node->next->prev = node->prev;
-}
-
-template<typename K, typename V>
-void LRUCache<K, V>::moveToHead(Node* node) {
-    // 先从当前位置移除，再添加到头部
-    removeNode(node);
-    addToHead(node);
-}
-
-template<typename K, typename V>
-typename LRUCache<K, V>::Node* LRUCache<K, V>:: removeTail() {
-    // 移除尾部的前一个节点（最旧的数据）
-    Node* lastNode = tail->prev;
-    removeNode(lastNode);
-    return lastNode;
-}
-
-template<typename K, typename V>
-V LRUCache<K, V>::get(const K& key) {
-    auto it = cache.find(key);
-    if (it == cache.end()) {
-        // key不存在，返回默认构造的V
-        return V{};
+template<typename K, typename V, typename Hash>
+LRUCache<K, V, Hash>::LRUCache(size_t cap, size_t count, Weigher weigh_fn)
+    : shards(new Shard[count > 0 ? count : 1]), shard_count(count > 0 ? count : 1), capacity(cap),
+      weigher(std::move(weigh_fn)) {
+    // 总容量均分到各分片，余数给前面的分片；按权重计时无法预知项数，不预留
+    for (size_t i = 0; i < shard_count; i++) {
+        Shard& shard = shards[i];
+        shard.capacity = cap / shard_count + (i < cap % shard_count ? 1 : 0);
+        if (!weigher) {
+            shard.index.reserve(shard.capacity);
+            shard.slots.reserve(shard.capacity);
+        }
     }
-    
-    // key存在，移动到头部（标记为最近使用）
-    Node* node = it->second;
-    moveToHead(node);
-    
-    return node->value;
-}
-
-template<typename K, typename V>
-void LRUCache<K, V>::put(const K& key, const V& value) {
-    auto it = cache.find(key);
-    
-    if (it != cache.end()) {
-        // key已存在，更新value并移到头部
-        Node* node = it->second;
-        node->value = value;
-        moveToHead(node);
+}
+
+template<typename K, typename V, typename Hash>
+size_t LRUCache<K, V, Hash>::weigh(const K& key, const V& value) const {
+    return weigher ? weigher(key, value) : 1;
+}
+
+template<typename K, typename V, typename Hash>
+typename LRUCache<K, V, Hash>::Shard& LRUCache<K, V, Hash>::shardFor(const K& key) const {
+    // 再混合一次：std::hash 对整数是恒等映射，直接取模分布很差
+    uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+    return shards[(h >> 32) % shard_count];
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::unlink(Shard& shard, uint32_t slot) {
+    Slot& node = shard.slots[slot];
+    if (node.prev != NIL) shard.slots[node.prev].next = node.next; else shard.head = node.next;
+    if (node.next != NIL) shard.slots[node.next].prev = node.prev; else shard.tail = node.prev;
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::pushFront(Shard& shard, uint32_t slot) {
+    Slot& node = shard.slots[slot];
+    node.prev = NIL;
+    node.next = shard.head;
+    if (shard.head != NIL) shard.slots[shard.head].prev = slot; else shard.tail = slot;
+    shard.head = slot;
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::release(Shard& shard, typename Index::iterator it) {
+    uint32_t slot = it->second;
+    unlink(shard, slot);
+    shard.weight -= shard.slots[slot].weight;
+    shard.slots[slot].entry.reset();
+    shard.free_slots.push_back(slot);
+    shard.spare_nodes.push_back(shard.index.extract(it));
+}
+
+template<typename K, typename V, typename Hash>
+std::optional<V> LRUCache<K, V, Hash>::get(const K& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        shard.misses++;
+        return std::nullopt;
+    }
+
+    // 命中，移动到头部（标记为最近使用）
+    shard.hits++;
+    if (shard.head != it->second) {
+        unlink(shard, it->second);
+        pushFront(shard, it->second);
+    }
+    return shard.slots[it->second].entry->second;
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::put(const K& key, V value) {
+    size_t weight = weigh(key, value);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (weight > shard.capacity) {
+        // 放不下的项不缓存，同时丢弃旧值，避免读到过期数据
+        if (it != shard.index.end()) release(shard, it);
         return;
     }
-    
-    // key不存在，创建新节点
-    Node* newNode = new Node(key, value);
-    
-    if (currentSize >= capacity) {
-        // 缓存已满，移除最旧的节点
-        Node* tail_node = removeTail();
-        cache.erase(tail_node->key);
-        delete tail_node;
-        currentSize--;
+
+    if (it != shard.index.end()) {
+        // key已存在，更新value并移到头部
+        Slot& node = shard.slots[it->second];
+        shard.weight = shard.weight - node.weight + weight;
+        node.weight = weight;
+        node.entry->second = std::move(value);
+        if (shard.head != it->second) {
+            unlink(shard, it->second);
+            pushFront(shard, it->second);
+        }
+    } else {
+        uint32_t slot;
+        if (!weigher && shard.index.size() >= shard.capacity) {
+            // 按项数计且分片已满：直接复用最旧项的槽位和哈希表节点
+            slot = shard.tail;
+            unlink(shard, slot);
+            shard.weight -= shard.slots[slot].weight;
+            auto node = shard.index.extract(shard.slots[slot].entry->first);
+            node.key() = key;
+            shard.index.insert(std::move(node));
+            shard.evictions++;
+        } else {
+            if (!shard.free_slots.empty()) {
+                slot = shard.free_slots.back();
+                shard.free_slots.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(shard.slots.size());
+                shard.slots.push_back(Slot{std::nullopt, NIL, NIL, 0});
+            }
+            if (!shard.spare_nodes.empty()) {
+                auto node = std::move(shard.spare_nodes.back());
+                shard.spare_nodes.pop_back();
+                node.key() = key;
+                node.mapped() = slot;
+                shard.index.insert(std::move(node));
+            } else {
+                shard.index.emplace(key, slot);
+            }
+        }
+
+        shard.slots[slot].entry.emplace(key, std::move(value));
+        shard.slots[slot].weight = weight;
+        shard.weight += weight;
+        pushFront(shard, slot);
+        shard.insertions++;
     }
-    
-    // 添加新节点到头部
-    addToHead(newNode);
-    cache[key] = newNode;
-    currentSize++;
-}
-
-template<typename K, typename V>
-bool LRUCache<K, V>::contains(const K& key) const {
-    return cache.find(key) != cache.end();
-}
-
-template<typename K, typename V>
-void LRUCache<K, V>::remove(const K& key) {
-    auto it = cache.find(key);
-    if (it != cache. end()) {
-        Node* node = it->second;
-        removeNode(node);
-        cache.erase(it);
-        delete node;
-        currentSize--;
+
+    // 超出权重预算时从最旧项开始淘汰（新项在头部，且自身放得下，不会被淘汰）
+    while (shard.weight > shard.capacity) {
+        release(shard, shard.index.find(shard.slots[shard.tail].entry->first));
+        shard.evictions++;
     }
 }
 
-template<typename K, typename V>
-size_t LRUCache<K, V>::size() const {
-    return currentSize;
+template<typename K, typename V, typename Hash>
+bool LRUCache<K, V, Hash>::contains(const K& key) const {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.index.find(key) != shard.index.end();
+}
+
+template<typename K, typename V, typename Hash>
+bool LRUCache<K, V, Hash>::remove(const K& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) return false;
+    release(shard, it);
+    return true;
 }
 
-template<typename K, typename V>
-size_t LRUCache<K, V>::getCapacity() const {
+template<typename K, typename V, typename Hash>
+size_t LRUCache<K, V, Hash>::removeIf(const std::function<bool(const K&, const V&)>& predicate) {
+    size_t removed = 0;
+    for (size_t i = 0; i < shard_count; i++) {
+        Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.index.begin(); it != shard.index.end();) {
+            const auto& entry = *shard.slots[it->second].entry;
+            if (predicate(entry.first, entry.second)) {
+                auto next = std::next(it);
+                release(shard, it);
+                it = next;
+                removed++;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
+
+template<typename K, typename V, typename Hash>
+size_t LRUCache<K, V, Hash>::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count; i++) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].index.size();
+    }
+    return total;
+}
+
+template<typename K, typename V, typename Hash>
+size_t LRUCache<K, V, Hash>::getCapacity() const {
     return capacity;
 }
 
-template<typename K, typename V>
-bool LRUCache<K, V>::empty() const {
-    return currentSize == 0;
+template<typename K, typename V, typename Hash>
+size_t LRUCache<K, V, Hash>::getShardCount() const {
+    return shard_count;
+}
+
+template<typename K, typename V, typename Hash>
+bool LRUCache<K, V, Hash>::empty() const {
+    return size() == 0;
 }
 
-template<typename K, typename V>
-void LRUCache<K, V>::clear() {
-    while (currentSize > 0) {
-        Node* node = removeTail();
-        cache.erase(node->key);
-        delete node;
-        currentSize--;
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::clear() {
+    for (size_t i = 0; i < shard_count; i++) {
+        Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (shard.tail != NIL) {
+            release(shard, shard.index.find(shard.slots[shard.tail].entry->first));
+        }
     }
 }
 
-template<typename K, typename V>
-void LRUCache<K, V>::printCache() const {
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::printCache() const {
     std::cout << "=== LRU Cache 状态 ===\n";
-    std::cout << "容量: " << capacity << ", 当前大小: " << currentSize << "\n";
-    std::cout << "从新到旧:  ";
-    
-    Node* current = head->next;
-    while (current != tail) {
-        std::cout << "[" << current->key << ":" << current->value << "] ";
-        current = current->next;
+    std::cout << "容量: " << capacity << ", 分片: " << shard_count << ", 当前大小: " << size() << "\n";
+    for (size_t i = 0; i < shard_count; i++) {
+        const Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::cout << "分片 " << i << " 从新到旧:  ";
+        for (uint32_t slot = shard.head; slot != NIL; slot = shard.slots[slot].next) {
+            const auto& entry = *shard.slots[slot].entry;
+            std::cout << "[" << entry.first << ":" << entry.second << "] ";
+        }
+        std::cout << "\n";
     }
-    std::cout << "\n\n";
+    std::cout << "\n";
+}
+
+template<typename K, typename V, typename Hash>
+typename LRUCache<K, V, Hash>::Stats LRUCache<K, V, Hash>::getStats() const {
+    Stats stats;
+    stats.capacity = capacity;
+    for (size_t i = 0; i < shard_count; i++) {
+        const Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.insertions += shard.insertions;
+        stats.evictions += shard.evictions;
+        stats.size += shard.index.size();
+        stats.weight += shard.weight;
+    }
+    return stats;
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::resetStats() {
+    for (size_t i = 0; i < shard_count; i++) {
+        Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.hits = shard.misses = shard.insertions = shard.evictions = 0;
+    }
+}
+
+template<typename K, typename V, typename Hash>
+void LRUCache<K, V, Hash>::printStats() const {
+    Stats stats = getStats();
+    std::cout << "=== LRU Cache 统计 ===\n";
+    std::cout << "大小: " << stats.size;
+    if (weigher) std::cout << ", 权重: " << stats.weight;
+    std::cout << "/" << stats.capacity << " (" << shard_count << " 个分片)\n";
+    std::cout << "命中: " << stats.hits << ", 未命中: " << stats.misses
+              << ", 命中率: " << stats.hitRate() * 100 << "%\n";
+    std::cout << "插入: " << stats.insertions << ", 淘汰: " << stats.evictions << "\n";
 }
 
-#endif // LRU_CACHE_H
\ No newline at end of file
+#endif // LRU_CACHE_H
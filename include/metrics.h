@@ -0,0 +1,129 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 单调递增计数器
+class Counter {
+public:
+    Counter() : value(0) {}
+    void inc(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value;
+};
+
+// 可增可减的瞬时值
+class Gauge {
+public:
+    Gauge() : value(0) {}
+    void set(int64_t v) { value.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) { value.fetch_add(n, std::memory_order_relaxed); }
+    int64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value;
+};
+
+// 对数分桶的延迟直方图（HDR 风格，单位纳秒）
+// 每个 2 的幂区间再均分为 8 个子桶，相对误差不超过 12.5%；记录只做两次 relaxed 原子加，无锁无分配
+class Histogram {
+public:
+    static const int SUB_BUCKET_BITS = 3;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 40;                     // 2^40 ns ≈ 18 分钟，更大的值计入最后一个桶
+    static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    Histogram();
+
+    void record(uint64_t nanos) {
+        buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+        sum_nanos.fetch_add(nanos, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const;                                 // 各桶之和
+    uint64_t sumNanos() const { return sum_nanos.load(std::memory_order_relaxed); }
+    uint64_t bucketCount(int index) const { return buckets[index].load(std::memory_order_relaxed); }
+    uint64_t percentile(double fraction) const;             // 所在桶的中点，空直方图返回 0
+
+    static int bucketIndex(uint64_t nanos) {
+        if (nanos < static_cast<uint64_t>(SUB_BUCKETS)) return static_cast<int>(nanos);
+        int exponent = 63 - __builtin_clzll(nanos);
+        if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+        int sub = static_cast<int>((nanos >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+    static uint64_t bucketLowerBound(int index);
+
+private:
+    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> sum_nanos;
+};
+
+// 作用域计时：析构时把经过的时间记入直方图
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& target) : histogram(target), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// 指标注册表
+// 注册和导出时加锁；注册后返回的引用在进程内一直有效，调用方保存引用后记录不再经过注册表。
+// 同名同标签重复注册返回同一个对象。
+class MetricsRegistry {
+public:
+    static MetricsRegistry& global();
+
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    // Prometheus 文本格式（0.0.4）；直方图以秒为单位，按 4 倍递增的边界导出累计桶
+    std::string renderPrometheus() const;
+
+    // 构造一个标签 key="value"，值中的 \ " 换行会被转义
+    static std::string label(const std::string& key, const std::string& value);
+
+private:
+    enum MetricType {
+        METRIC_COUNTER,
+        METRIC_GAUGE,
+        METRIC_HISTOGRAM
+    };
+
+    struct Family {
+        MetricType type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;       // 标签 -> 指标
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Family& family(const std::string& name, const std::string& help, MetricType type);
+
+    std::map<std::string, Family> families;
+    mutable std::mutex mutex;
+};
+
+// 索引操作（前缀搜索、冲突检查等）的延迟直方图，各模块在首次调用时注册并保存引用
+Histogram& indexOperationLatency(const char* operation);
+
+#endif // METRICS_H
@@ -0,0 +1,103 @@
+#ifndef OPERATION_LOG_H
+#define OPERATION_LOG_H
+
+#include "array_stack.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
+
+// 可撤销的操作类型
+enum OperationType : uint8_t {
+    OP_CONTACT_ADD = 1,          // 新增联系人（after 为新值）
+    OP_CONTACT_REMOVE = 2,       // 删除联系人（before 为原值）
+    OP_CONTACT_UPDATE = 3,       // 修改联系人（before/after）
+    OP_ACTIVITY_ADD = 4,
+    OP_ACTIVITY_REMOVE = 5,
+    OP_ACTIVITY_UPDATE = 6,
+    OP_RESERVATION_ADD = 7,
+    OP_RESERVATION_REMOVE = 8,
+    OP_SERIES_ADD = 9,           // 重复预约系列
+    OP_SERIES_REMOVE = 10,
+    OP_SERIES_UPDATE = 11        // 系列增加例外日期
+};
+
+// 单条操作记录：目标ID + 修改前后的字段值（不保存完整对象）
+struct OperationRecord {
+    OperationType type;
+    int32_t target_id;
+    std::vector<std::string> before;    // 修改前字段（新增操作为空）
+    std::vector<std::string> after;     // 修改后字段（删除操作为空）
+
+    OperationRecord() : type(OP_CONTACT_ADD), target_id(0) {}
+    OperationRecord(OperationType op_type, int32_t id,
+                    const std::vector<std::string>& before_fields,
+                    const std::vector<std::string>& after_fields)
+        : type(op_type), target_id(id), before(before_fields), after(after_fields) {}
+};
+
+// 追加式操作日志 + 有界撤销/重做窗口
+// 每个撤销单元是一组操作记录的二进制编码：
+//   [u8 类型][i32 ID][u8 before字段数][u8 after字段数]{[u32 长度][字节]}...
+// 记录同时追加写入日志文件：[u32 长度][u8 动作(0执行/1撤销/2重做)][撤销单元]
+// 非线程安全，与各管理器一样只在服务器线程中使用
+class OperationLog {
+public:
+    // 重放回调：inverse 为 true 时执行记录的逆操作
+    using Replayer = std::function<bool(const OperationRecord& record, bool inverse)>;
+
+    // 作用域内的记录合并为一个撤销单元（如自动解决冲突时的取消 + 新增）
+    class Group {
+    public:
+        explicit Group(OperationLog* log);
+        ~Group();
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+    private:
+        OperationLog* log;
+    };
+
+    explicit OperationLog(const std::string& log_path = "", size_t undo_window = DEFAULT_UNDO_WINDOW);
+    ~OperationLog();
+
+    // 禁用拷贝
+    OperationLog(const OperationLog&) = delete;
+    OperationLog& operator=(const OperationLog&) = delete;
+
+    bool open();                                    // 打开日志文件（路径为空时只在内存中记录）
+    void record(const OperationRecord& record);     // 记录一次成功的修改，清空重做栈
+    void beginGroup();
+    void endGroup();
+
+    bool undo(const Replayer& replay);              // 撤销最近一个单元，失败时栈保持不变
+    bool redo(const Replayer& replay);              // 重做最近撤销的单元
+    bool isReplaying() const;                       // 撤销/重做期间不再记录新操作
+    size_t undoDepth() const;                       // 可撤销单元数
+    size_t redoDepth() const;                       // 可重做单元数
+
+    static void encode(const OperationRecord& record, std::string& out);
+    static bool decode(const std::string& data, size_t& offset, OperationRecord& record);
+
+    static const size_t DEFAULT_UNDO_WINDOW;        // 默认撤销窗口
+
+private:
+    std::string path;
+    FILE* file;
+    size_t window;
+
+    ArrayStack<std::string> undo_stack;             // 撤销单元（栈顶为最近一次）
+    ArrayStack<std::string> redo_stack;
+    size_t undo_available;                          // 窗口内可撤销的单元数（不超过 window）
+
+    std::string pending;                            // 正在合并的组
+    int group_depth;
+    bool replaying;
+
+    void commitUnit(const std::string& unit);
+    void appendToFile(uint8_t action, const std::string& unit);
+    bool replayUnit(const std::string& unit, bool inverse, const Replayer& replay);
+    void trimUndoStack();                           // 丢弃窗口之外的旧单元
+};
+
+#endif // OPERATION_LOG_H
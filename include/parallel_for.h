@@ -0,0 +1,39 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// 启动阶段批量构建索引用的简单分片并行工具
+
+// 默认构建线程数（硬件线程数，至少为1）
+inline unsigned defaultBuildThreads() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+// 把 [0, count) 均分为 shard_count 个连续分片，每个分片调用 fn(shard, begin, end)
+// 分片0在调用线程执行，其余分片各占一个线程；返回前等待全部完成
+template<typename Fn>
+void parallelForShards(size_t count, unsigned shard_count, Fn fn) {
+    shard_count = std::max(1u, shard_count);
+    size_t chunk = (count + shard_count - 1) / shard_count;
+
+    std::vector<std::thread> workers;
+    for (unsigned shard = 1; shard < shard_count; shard++) {
+        size_t begin = std::min(count, shard * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&fn, shard, begin, end]() {
+            fn(shard, begin, end);
+        });
+    }
+    fn(0u, size_t(0), std::min(count, chunk));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // PARALLEL_FOR_H
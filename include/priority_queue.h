@@ -2,19 +2,261 @@
 #define PRIORITY_QUEUE_H
 
 #include <vector>
-#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
 
+// d 叉堆优先队列
+// Compare 与 std::priority_queue 相反：compare(a, b) 为 true 表示 a 先出队，
+// 默认 std::less<T> 即最小堆（与原 int 最小堆一致）
+// push 返回句柄，可按句柄修改优先级或删除；句柄在元素出队/删除后失效并被复用
+// 元素只需可移动构造/移动赋值，支持仅可移动的类型
+template<typename T, typename Compare = std::less<T>, size_t Arity = 4>
 class PriorityQueue {
+    static_assert(Arity >= 2, "PriorityQueue 的分叉数至少为 2");
+
 public:
-    PriorityQueue();
-    void push(int value);  // 插入操作
-    int pop();  // 弹出最小值
-    bool isEmpty();  // 判断队列是否为空
+    using Handle = size_t;
+    static constexpr Handle INVALID_HANDLE = static_cast<Handle>(-1);
+
+    explicit PriorityQueue(const Compare& compare = Compare());
+
+    // 基本操作
+    Handle push(const T& value);                // 插入（拷贝）
+    Handle push(T&& value);                     // 插入（移动）
+    template<typename... Args>
+    Handle emplace(Args&&... args);             // 原地构造插入
+    T pop();                                    // 弹出队首元素
+    const T& top() const;                       // 查看队首元素
+    bool isEmpty() const;                       // 判断队列是否为空
+    size_t size() const;
+    void clear();
+    void reserve(size_t capacity);
+
+    // 按句柄操作
+    bool contains(Handle handle) const;         // 句柄是否仍在队列中
+    const T& get(Handle handle) const;
+    void update(Handle handle, T value);        // 修改元素，按需上浮或下沉
+    void decreaseKey(Handle handle, T value);   // 新值必须不晚于原值出队，只上浮
+    T erase(Handle handle);                     // 删除并返回指定元素
 
 private:
-    std::vector<int> heap;
-    void heapifyUp(int index);
-    void heapifyDown(int index);
+    struct Entry {
+        T value;
+        Handle handle;
+    };
+
+    std::vector<Entry> heap;
+    std::vector<size_t> positions;      // 句柄 -> 堆下标（NOT_IN_HEAP 表示空闲）
+    std::vector<Handle> free_handles;   // 可复用的句柄
+    Compare compare;
+
+    static constexpr size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+
+    Handle acquireHandle();
+    T removeAt(size_t index);
+    void place(size_t index, Entry&& entry);
+    void heapifyUp(size_t index);
+    void heapifyDown(size_t index);
 };
 
-#endif // PRIORITY_QUEUE_H
\ No newline at end of file
+template<typename T, typename Compare, size_t Arity>
+PriorityQueue<T, Compare, Arity>::PriorityQueue(const Compare& compare) : compare(compare) {}
+
+template<typename T, typename Compare, size_t Arity>
+typename PriorityQueue<T, Compare, Arity>::Handle PriorityQueue<T, Compare, Arity>::push(const T& value) {
+    return emplace(value);
+}
+
+template<typename T, typename Compare, size_t Arity>
+typename PriorityQueue<T, Compare, Arity>::Handle PriorityQueue<T, Compare, Arity>::push(T&& value) {
+    return emplace(std::move(value));
+}
+
+template<typename T, typename Compare, size_t Arity>
+template<typename... Args>
+typename PriorityQueue<T, Compare, Arity>::Handle PriorityQueue<T, Compare, Arity>::emplace(Args&&... args) {
+    Handle handle = acquireHandle();
+    try {
+        heap.push_back(Entry{T(std::forward<Args>(args)...), handle});
+    } catch (...) {
+        free_handles.push_back(handle);
+        throw;
+    }
+    positions[handle] = heap.size() - 1;
+    heapifyUp(heap.size() - 1);
+    return handle;
+}
+
+template<typename T, typename Compare, size_t Arity>
+T PriorityQueue<T, Compare, Arity>::pop() {
+    if (heap.empty()) {
+        throw std::underflow_error("PriorityQueue is empty. Cannot pop.");
+    }
+    return removeAt(0);
+}
+
+template<typename T, typename Compare, size_t Arity>
+const T& PriorityQueue<T, Compare, Arity>::top() const {
+    if (heap.empty()) {
+        throw std::underflow_error("PriorityQueue is empty. No top element.");
+    }
+    return heap[0].value;
+}
+
+template<typename T, typename Compare, size_t Arity>
+bool PriorityQueue<T, Compare, Arity>::isEmpty() const {
+    return heap.empty();
+}
+
+template<typename T, typename Compare, size_t Arity>
+size_t PriorityQueue<T, Compare, Arity>::size() const {
+    return heap.size();
+}
+
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::clear() {
+    heap.clear();
+    positions.clear();
+    free_handles.clear();
+}
+
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::reserve(size_t capacity) {
+    heap.reserve(capacity);
+    positions.reserve(capacity);
+}
+
+template<typename T, typename Compare, size_t Arity>
+bool PriorityQueue<T, Compare, Arity>::contains(Handle handle) const {
+    return handle < positions.size() && positions[handle] != NOT_IN_HEAP;
+}
+
+template<typename T, typename Compare, size_t Arity>
+const T& PriorityQueue<T, Compare, Arity>::get(Handle handle) const {
+    if (!contains(handle)) {
+        throw std::out_of_range("PriorityQueue handle is not in the queue.");
+    }
+    return heap[positions[handle]].value;
+}
+
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::update(Handle handle, T value) {
+    if (!contains(handle)) {
+        throw std::out_of_range("PriorityQueue handle is not in the queue.");
+    }
+    size_t index = positions[handle];
+    bool earlier = compare(value, heap[index].value);
+    heap[index].value = std::move(value);
+    if (earlier) {
+        heapifyUp(index);
+    } else {
+        heapifyDown(index);
+    }
+}
+
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::decreaseKey(Handle handle, T value) {
+    if (!contains(handle)) {
+        throw std::out_of_range("PriorityQueue handle is not in the queue.");
+    }
+    size_t index = positions[handle];
+    if (compare(heap[index].value, value)) {
+        throw std::invalid_argument("decreaseKey would move the element later.");
+    }
+    heap[index].value = std::move(value);
+    heapifyUp(index);
+}
+
+template<typename T, typename Compare, size_t Arity>
+T PriorityQueue<T, Compare, Arity>::erase(Handle handle) {
+    if (!contains(handle)) {
+        throw std::out_of_range("PriorityQueue handle is not in the queue.");
+    }
+    return removeAt(positions[handle]);
+}
+
+// 私有辅助方法
+
+template<typename T, typename Compare, size_t Arity>
+typename PriorityQueue<T, Compare, Arity>::Handle PriorityQueue<T, Compare, Arity>::acquireHandle() {
+    if (!free_handles.empty()) {
+        Handle handle = free_handles.back();
+        free_handles.pop_back();
+        return handle;
+    }
+    positions.push_back(NOT_IN_HEAP);
+    return positions.size() - 1;
+}
+
+// 用末尾元素填补空位，再按与原元素的先后关系上浮或下沉
+template<typename T, typename Compare, size_t Arity>
+T PriorityQueue<T, Compare, Arity>::removeAt(size_t index) {
+    Handle handle = heap[index].handle;
+    T result = std::move(heap[index].value);
+    positions[handle] = NOT_IN_HEAP;
+    free_handles.push_back(handle);
+
+    size_t last = heap.size() - 1;
+    if (index != last) {
+        bool earlier = compare(heap[last].value, result);
+        place(index, std::move(heap[last]));
+        heap.pop_back();
+        if (earlier) {
+            heapifyUp(index);
+        } else {
+            heapifyDown(index);
+        }
+    } else {
+        heap.pop_back();
+    }
+    return result;
+}
+
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::place(size_t index, Entry&& entry) {
+    heap[index] = std::move(entry);
+    positions[heap[index].handle] = index;
+}
+
+// 上浮：先把元素移出形成空位，父节点依次下移，最后一次写回
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::heapifyUp(size_t index) {
+    if (index == 0) return;
+    Entry moving = std::move(heap[index]);
+    while (index > 0) {
+        size_t parent = (index - 1) / Arity;
+        if (!compare(moving.value, heap[parent].value)) break;
+        place(index, std::move(heap[parent]));
+        index = parent;
+    }
+    place(index, std::move(moving));
+}
+
+// 下沉：每层在最多 Arity 个子节点中选出最先出队的一个
+template<typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::heapifyDown(size_t index) {
+    size_t count = heap.size();
+    if (index * Arity + 1 >= count) return;
+
+    Entry moving = std::move(heap[index]);
+    while (true) {
+        size_t first_child = index * Arity + 1;
+        if (first_child >= count) break;
+        size_t last_child = first_child + Arity < count ? first_child + Arity : count;
+
+        size_t best = first_child;
+        for (size_t child = first_child + 1; child < last_child; child++) {
+            if (compare(heap[child].value, heap[best].value)) {
+                best = child;
+            }
+        }
+        if (!compare(heap[best].value, moving.value)) break;
+        place(index, std::move(heap[best]));
+        index = best;
+    }
+    place(index, std::move(moving));
+}
+
+#endif // PRIORITY_QUEUE_H
@@ -0,0 +1,303 @@
+#ifndef RADIX_ROUTER_H
+#define RADIX_ROUTER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+// 支持的请求方法，作为各节点处理器数组的下标
+enum HttpMethod : uint8_t {
+    METHOD_GET,
+    METHOD_POST,
+    METHOD_PUT,
+    METHOD_DELETE,
+    METHOD_PATCH,
+    METHOD_HEAD,
+    METHOD_OPTIONS,
+    METHOD_COUNT            // 同时表示无法识别的方法
+};
+
+inline HttpMethod parseHttpMethod(std::string_view method) {
+    static const std::string_view NAMES[METHOD_COUNT] = {"GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "OPTIONS"};
+    for (uint8_t i = 0; i < METHOD_COUNT; i++) {
+        if (method == NAMES[i]) return static_cast<HttpMethod>(i);
+    }
+    return METHOD_COUNT;
+}
+
+// 匹配得到的路径参数，定长存放，匹配过程不分配内存
+// 名称指向路由表，值指向被匹配的路径，只在该路径存活期间有效
+struct RouteParams {
+    static constexpr size_t MAX_PARAMS = 4;
+
+    struct Param {
+        std::string_view name;
+        std::string_view value;
+        int64_t number;         // {name:int} 参数的数值
+    };
+
+    Param items[MAX_PARAMS];
+    size_t count = 0;
+
+    std::string_view get(std::string_view name) const {
+        for (size_t i = 0; i < count; i++) {
+            if (items[i].name == name) return items[i].value;
+        }
+        return {};
+    }
+
+    // 整数参数；不存在时返回 fallback
+    int64_t getInt(std::string_view name, int64_t fallback = -1) const {
+        for (size_t i = 0; i < count; i++) {
+            if (items[i].name == name) return items[i].number;
+        }
+        return fallback;
+    }
+};
+
+// 基数树路由
+// 静态路径按公共前缀压缩成边；参数段 "{name}" 匹配到下一个 '/' 为止，"{name:int}" 只匹配十进制数字。
+// 同一位置静态段优先于整数参数，整数参数优先于字符串参数，失败时回溯。
+// 每个节点持有按方法下标的处理器数组，匹配到路径后直接按方法取处理器。
+template<typename Handler>
+class RadixRouter {
+public:
+    enum MatchStatus {
+        MATCHED,
+        NOT_FOUND,
+        METHOD_NOT_ALLOWED      // 路径存在但没有该方法的处理器
+    };
+
+    RadixRouter();
+
+    // route 形如 "GET /api/contacts/{id:int}"；模式非法或与已有路由重复时返回 false
+    bool add(const std::string& route, Handler handler);
+    bool add(HttpMethod method, const std::string& pattern, Handler handler);
+
+    const Handler* match(HttpMethod method, std::string_view path, RouteParams& params,
+                         MatchStatus* status = nullptr) const;
+
+    size_t size() const { return handlers.size(); }
+    size_t nodeCount() const { return nodes.size(); }
+
+private:
+    enum ParamType : uint8_t {
+        PARAM_NONE,
+        PARAM_INT,
+        PARAM_STRING
+    };
+
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        std::string prefix;                         // 静态节点：边上的字节串
+        std::string first_bytes;                    // 静态子节点的首字节，与 children 一一对应
+        std::vector<uint32_t> children;
+        uint32_t int_child;                         // {name:int} 子节点
+        uint32_t string_child;                      // {name} 子节点
+        ParamType param_type;                       // 本节点是否为参数节点
+        std::string param_name;
+        std::array<int32_t, METHOD_COUNT> targets;  // 各方法对应 handlers 的下标，-1 表示无
+
+        Node() : int_child(NIL), string_child(NIL), param_type(PARAM_NONE) { targets.fill(-1); }
+    };
+
+    uint32_t insertStatic(uint32_t node, std::string_view text);
+    uint32_t insertParam(uint32_t node, std::string_view name, ParamType type);
+    const Handler* matchFrom(uint32_t node, HttpMethod method, std::string_view path, size_t pos,
+                             RouteParams& params, bool& method_mismatch) const;
+    const Handler* matchParam(uint32_t child, HttpMethod method, std::string_view path, size_t pos,
+                              size_t end, int64_t number, RouteParams& params, bool& method_mismatch) const;
+
+    std::vector<Node> nodes;            // nodes[0] 为根
+    std::vector<Handler> handlers;
+};
+
+template<typename Handler>
+RadixRouter<Handler>::RadixRouter() : nodes(1) {}
+
+template<typename Handler>
+bool RadixRouter<Handler>::add(const std::string& route, Handler handler) {
+    size_t space = route.find(' ');
+    if (space == std::string::npos) return false;
+    HttpMethod method = parseHttpMethod(std::string_view(route).substr(0, space));
+    return add(method, route.substr(space + 1), std::move(handler));
+}
+
+template<typename Handler>
+bool RadixRouter<Handler>::add(HttpMethod method, const std::string& pattern, Handler handler) {
+    if (method == METHOD_COUNT || pattern.empty() || pattern[0] != '/') return false;
+
+    uint32_t node = 0;
+    size_t param_count = 0;
+    size_t pos = 0;
+    while (pos < pattern.size()) {
+        size_t brace = pattern.find('{', pos);
+        if (brace == std::string::npos) brace = pattern.size();
+        if (brace > pos) {
+            node = insertStatic(node, std::string_view(pattern).substr(pos, brace - pos));
+            pos = brace;
+            continue;
+        }
+
+        // 参数必须占满整个路径段
+        size_t close = pattern.find('}', pos);
+        if (close == std::string::npos || pattern[pos - 1] != '/' ||
+            (close + 1 < pattern.size() && pattern[close + 1] != '/') ||
+            ++param_count > RouteParams::MAX_PARAMS) {
+            return false;
+        }
+        std::string_view spec = std::string_view(pattern).substr(pos + 1, close - pos - 1);
+        ParamType type = PARAM_STRING;
+        size_t colon = spec.find(':');
+        if (colon != std::string_view::npos) {
+            if (spec.substr(colon + 1) != "int") return false;
+            type = PARAM_INT;
+            spec = spec.substr(0, colon);
+        }
+        if (spec.empty()) return false;
+        node = insertParam(node, spec, type);
+        if (node == NIL) return false;      // 同一位置的同类参数名称不一致
+        pos = close + 1;
+    }
+
+    if (nodes[node].targets[method] >= 0) return false;
+    nodes[node].targets[method] = static_cast<int32_t>(handlers.size());
+    handlers.push_back(std::move(handler));
+    return true;
+}
+
+template<typename Handler>
+uint32_t RadixRouter<Handler>::insertStatic(uint32_t node, std::string_view text) {
+    while (!text.empty()) {
+        size_t slot = nodes[node].first_bytes.find(text[0]);
+        if (slot == std::string::npos) {
+            uint32_t child = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            nodes[child].prefix = std::string(text);
+            nodes[node].first_bytes.push_back(text[0]);
+            nodes[node].children.push_back(child);
+            return child;
+        }
+
+        uint32_t child = nodes[node].children[slot];
+        const std::string& prefix = nodes[child].prefix;
+        size_t common = 0;
+        while (common < prefix.size() && common < text.size() && prefix[common] == text[common]) {
+            common++;
+        }
+
+        if (common < prefix.size()) {
+            // 拆分边：原节点原地变为公共前缀，其余内容移到新的子节点（父节点中的下标不变）
+            uint32_t tail = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            Node& split = nodes[child];
+            Node& moved = nodes[tail];
+            moved = std::move(split);
+            moved.prefix = moved.prefix.substr(common);
+            split = Node();
+            split.prefix = std::string(text.substr(0, common));
+            split.first_bytes.push_back(moved.prefix[0]);
+            split.children.push_back(tail);
+        }
+        node = child;
+        text = text.substr(common);
+    }
+    return node;
+}
+
+template<typename Handler>
+uint32_t RadixRouter<Handler>::insertParam(uint32_t node, std::string_view name, ParamType type) {
+    uint32_t existing = type == PARAM_INT ? nodes[node].int_child : nodes[node].string_child;
+    if (existing != NIL) {
+        return nodes[existing].param_name == name ? existing : NIL;
+    }
+
+    uint32_t child = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes[child].param_type = type;
+    nodes[child].param_name = std::string(name);
+    if (type == PARAM_INT) {
+        nodes[node].int_child = child;
+    } else {
+        nodes[node].string_child = child;
+    }
+    return child;
+}
+
+template<typename Handler>
+const Handler* RadixRouter<Handler>::match(HttpMethod method, std::string_view path, RouteParams& params,
+                                           MatchStatus* status) const {
+    params.count = 0;
+    bool method_mismatch = false;
+    const Handler* handler = path.empty() ? nullptr : matchFrom(0, method, path, 0, params, method_mismatch);
+    if (status) {
+        *status = handler ? MATCHED : method_mismatch ? METHOD_NOT_ALLOWED : NOT_FOUND;
+    }
+    return handler;
+}
+
+template<typename Handler>
+const Handler* RadixRouter<Handler>::matchFrom(uint32_t index, HttpMethod method, std::string_view path,
+                                               size_t pos, RouteParams& params, bool& method_mismatch) const {
+    const Node& node = nodes[index];
+    if (pos == path.size()) {
+        int32_t target = method < METHOD_COUNT ? node.targets[method] : -1;
+        if (target >= 0) return &handlers[target];
+        for (int32_t other : node.targets) {
+            if (other >= 0) method_mismatch = true;
+        }
+        return nullptr;
+    }
+
+    size_t slot = node.first_bytes.find(path[pos]);
+    if (slot != std::string::npos) {
+        const Node& child = nodes[node.children[slot]];
+        if (path.compare(pos, child.prefix.size(), child.prefix) == 0) {
+            const Handler* found = matchFrom(node.children[slot], method, path, pos + child.prefix.size(),
+                                             params, method_mismatch);
+            if (found) return found;
+        }
+    }
+
+    if (node.int_child == NIL && node.string_child == NIL) return nullptr;
+    size_t end = path.find('/', pos);
+    if (end == std::string_view::npos) end = path.size();
+    if (end == pos) return nullptr;
+
+    if (node.int_child != NIL && end - pos <= 18) {
+        int64_t number = 0;
+        size_t i = pos;
+        while (i < end && path[i] >= '0' && path[i] <= '9') {
+            number = number * 10 + (path[i] - '0');
+            i++;
+        }
+        if (i == end) {
+            const Handler* found = matchParam(node.int_child, method, path, pos, end, number, params, method_mismatch);
+            if (found) return found;
+        }
+    }
+    if (node.string_child != NIL) {
+        return matchParam(node.string_child, method, path, pos, end, 0, params, method_mismatch);
+    }
+    return nullptr;
+}
+
+template<typename Handler>
+const Handler* RadixRouter<Handler>::matchParam(uint32_t child, HttpMethod method, std::string_view path,
+                                                size_t pos, size_t end, int64_t number, RouteParams& params,
+                                                bool& method_mismatch) const {
+    size_t saved = params.count;
+    RouteParams::Param& param = params.items[params.count++];
+    param.name = nodes[child].param_name;
+    param.value = path.substr(pos, end - pos);
+    param.number = number;
+
+    const Handler* found = matchFrom(child, method, path, end, params, method_mismatch);
+    if (!found) params.count = saved;
+    return found;
+}
+
+#endif // RADIX_ROUTER_H
@@ -0,0 +1,62 @@
+#ifndef RECURRENCE_H
+#define RECURRENCE_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <functional>
+#include <cstdint>
+
+// 日期按 1970-01-01 起的天数表示，便于比较和按天步进
+bool parseDate(const std::string& text, int& day);    // 接受 "YYYY-MM-DD" 或 "YYYYMMDD"
+std::string formatDate(int day);                      // 输出 "YYYY-MM-DD"
+int weekdayOf(int day);                               // 0 = 周一 ... 6 = 周日
+
+// 重复规则（RRULE 子集），文本格式为分号分隔的键值对：
+//   DTSTART=2025-02-25;FREQ=WEEKLY;INTERVAL=1;BYDAY=TU,TH;UNTIL=2025-06-17;COUNT=16;EXDATE=2025-04-01
+//   RDATE=2025-03-01,2025-03-08,2025-04-12            （自定义日期列表）
+// UNTIL 与 COUNT 至少有一个（COUNT 计入被 EXDATE 排除的日期，与 RFC 5545 一致）
+class RecurrenceRule {
+public:
+    enum Frequency : uint8_t {
+        DAILY = 0,
+        WEEKLY = 1,
+        CUSTOM = 2     // 只在 RDATE 列出的日期
+    };
+
+    RecurrenceRule();
+
+    static bool parse(const std::string& text, RecurrenceRule& rule, std::string* error = nullptr);
+    static RecurrenceRule daily(int start_day, int until_day, int interval = 1);
+    static RecurrenceRule weekly(int start_day, int until_day, uint8_t weekday_mask, int interval = 1);
+    static RecurrenceRule custom(const std::vector<int>& days);
+
+    std::string toString() const;       // 可被 parse 读回；COUNT 折算为 UNTIL
+
+    bool occursOn(int day) const;
+    int firstDay() const;
+    int lastDay() const;                // 最后一次可能发生的日期（含）
+    size_t occurrenceCount() const;     // 扣除例外后的总次数
+
+    // 按日期顺序访问 [from_day, to_day] 内的每次发生，fn 返回 false 时停止
+    void forEachOccurrence(int from_day, int to_day, const std::function<bool(int day)>& fn) const;
+
+    void addException(int day);         // 跳过某一天（如节假日）
+    const std::set<int>& exceptions() const;
+
+    Frequency frequency() const;
+
+private:
+    Frequency freq;
+    int interval;               // 每隔几天/几周
+    uint8_t weekday_mask;       // 第 i 位表示周 i（0 = 周一）
+    int start_day;
+    int end_day;
+    std::vector<int> dates;     // CUSTOM 的日期（有序、去重）
+    std::set<int> excluded;
+
+    bool matchesPattern(int day) const;     // 不考虑范围和例外的模式匹配
+    void applyCount(int count);             // 把 COUNT 折算为 end_day
+};
+
+#endif // RECURRENCE_H
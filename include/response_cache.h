@@ -0,0 +1,45 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include "lru_cache.h"
+#include <string>
+#include <memory>
+#include <functional>
+#include <atomic>
+
+// 序列化好的一次 GET 响应
+struct CachedResponse {
+    std::string generation;     // 生成时依赖数据的版本（各表代数拼接）
+    std::string etag;           // 弱校验器 W/"..."，由版本和响应体决定
+    std::string body;
+    std::string gzip_body;      // 预压缩的响应体，体积小或压缩无收益时为空
+};
+
+// 热点 GET 接口的响应缓存
+// 键由路由、查询串和角色组成；调用方给出当前数据版本，版本与缓存项不同时重新生成，
+// 因此写操作无需主动清除缓存，只要在修改路径上增加对应表的代数即可
+class ResponseCache {
+public:
+    explicit ResponseCache(size_t capacity = DEFAULT_CAPACITY, size_t shard_count = 4);
+
+    // 命中且版本一致时直接返回，否则调用 build 生成响应体并缓存
+    std::shared_ptr<const CachedResponse> fetch(const std::string& key, const std::string& generation,
+                                                const std::function<std::string()>& build);
+    void clear();
+    LRUCache<std::string, std::shared_ptr<const CachedResponse>>::Stats getStats() const;
+    void printStats() const;
+
+    static std::string makeKey(const std::string& route, const std::string& query, const std::string& role);
+    // If-None-Match 是否命中：支持 "*"、逗号分隔的多个值和 W/ 前缀（弱比较）
+    static bool matchesETag(const std::string& if_none_match, const std::string& etag);
+    static bool gzipCompress(const std::string& input, std::string& output);
+
+    static const size_t DEFAULT_CAPACITY;
+    static const size_t MIN_GZIP_BYTES;         // 小于此大小的响应体不预压缩
+
+private:
+    LRUCache<std::string, std::shared_ptr<const CachedResponse>> entries;
+    std::atomic<uint64_t> stale_hits;           // 命中但版本已过期、需要重新生成的次数
+};
+
+#endif // RESPONSE_CACHE_H
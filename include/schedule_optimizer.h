@@ -0,0 +1,72 @@
+#ifndef SCHEDULE_OPTIMIZER_H
+#define SCHEDULE_OPTIMIZER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// 待安排的预约请求：在允许的资源和时间窗口内安排一段连续时间
+struct ScheduleRequest {
+    int id;
+    int priority;                             // 优先级（1-10，10为最高）
+    int duration_minutes;
+    int window_start;                         // 最早开始（分钟）
+    int window_end;                           // 最晚结束（分钟）
+    std::vector<std::string> allowed_resources;
+    std::string activity_name;
+    std::string contact_info;
+
+    ScheduleRequest() : id(0), priority(5), duration_minutes(60), window_start(0), window_end(1440) {}
+};
+
+// 单个请求的安排结果
+struct ScheduleAssignment {
+    int request_id;
+    size_t request_index;                     // 在请求列表中的下标（请求ID不要求唯一）
+    std::string resource_name;
+    int start_minutes;
+    int end_minutes;
+};
+
+struct ScheduleResult {
+    std::vector<ScheduleAssignment> assignments;    // 按请求顺序
+    std::vector<int> unassigned;                    // 未能安排的请求ID
+    long long total_priority;                       // 已安排请求的优先级之和（优化目标）
+    long long requested_priority;                   // 全部请求的优先级之和（上界）
+    size_t iterations;                              // 各线程局部搜索轮数之和
+    double elapsed_ms;
+
+    ScheduleResult() : total_priority(0), requested_priority(0), iterations(0), elapsed_ms(0) {}
+};
+
+struct OptimizerOptions {
+    int time_budget_ms;      // 总时间预算
+    unsigned restarts;       // 并行重启数（每个一个线程），0 表示按硬件线程数
+    uint32_t seed;           // 随机种子，相同种子与预算下结果可复现（预算内收敛时）
+
+    OptimizerOptions() : time_budget_ms(200), restarts(0), seed(20240601) {}
+};
+
+// 全局调度优化：最大化被安排请求的优先级之和
+// 1. 贪心构造：按单位时长优先级从高到低，放入最贴合的空闲间隙（best-fit）
+// 2. 局部搜索：未安排的请求可挤出优先级之和更低的已安排请求，被挤出者再尝试重新安排
+// 3. 扰动：随机移除部分安排后重新构造，保留更优解
+// 各重启在独立线程中使用不同种子运行，共享同一截止时间，取最优结果
+class ScheduleOptimizer {
+public:
+    explicit ScheduleOptimizer(const std::vector<std::string>& resources);
+
+    // 已有预约占用的时间，优化时不可移动
+    void addBusyInterval(const std::string& resource, int start_minutes, int end_minutes);
+
+    ScheduleResult optimize(const std::vector<ScheduleRequest>& requests,
+                            const OptimizerOptions& options = OptimizerOptions()) const;
+
+private:
+    std::vector<std::string> resource_names;
+    std::map<std::string, int> resource_ids;
+    std::vector<std::vector<std::pair<int, int>>> busy;    // 每个资源的固定占用区间
+};
+
+#endif // SCHEDULE_OPTIMIZER_H
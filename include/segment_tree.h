@@ -5,22 +5,27 @@
 #include <string>
 #include <unordered_map>
 
+// 区间加 / 区间最大值线段树，区间均为闭区间 [start, end]
+// 每个位置的值是该时刻的占用量，容量判断只需一次最大值查询
 class SegmentTree {
 public:
     SegmentTree(int size);
     ~SegmentTree();
     
-    // 添加时间段（标记为占用）
-    void addInterval(int start, int end);
+    // 添加时间段（占用量增加 amount）
+    void addInterval(int start, int end, int amount = 1);
     
-    // 移除时间段（取消占用）
-    void removeInterval(int start, int end);
+    // 移除时间段（占用量减少 amount）
+    void removeInterval(int start, int end, int amount = 1);
     
     // 检查时间段是否冲突
-    bool isConflict(int start, int end);
+    bool isConflict(int start, int end) const;
     
-    // 查询区间内的占用次数
-    int queryOccupancy(int start, int end);
+    // 查询区间内的最大占用量
+    int queryOccupancy(int start, int end) const;
+    
+    // [start, end] 内占用量不低于 threshold 的极大区间（闭区间，按时间顺序）
+    std::vector<std::pair<int, int>> findRangesAtLeast(int start, int end, int threshold) const;
     
     // 工具函数
     void clear();
@@ -34,8 +39,10 @@ private:
     // 核心操作函数
     void build(int node, int start, int end);
     void updateRange(int node, int start, int end, int l, int r, int val);
-    int queryRange(int node, int start, int end, int l, int r);
+    int queryRange(int node, int start, int end, int l, int r) const;
     void pushDown(int node, int start, int end);
+    void collectRanges(int node, int start, int end, int l, int r, int threshold, int pending,
+                       std::vector<std::pair<int, int>>& ranges) const;
     
     // 辅助函数
     void printNode(int node, int start, int end, int depth) const;
@@ -45,6 +52,11 @@ private:
 class VenueConflictDetector {
 public: 
     VenueConflictDetector(int timeRange = 24 * 60);  // 默认24小时，按分钟计算
+    ~VenueConflictDetector();
+    
+    // 禁用拷贝（各场地的线段树由本对象持有）
+    VenueConflictDetector(const VenueConflictDetector&) = delete;
+    VenueConflictDetector& operator=(const VenueConflictDetector&) = delete;
     
     // 添加活动
     bool addActivity(const std::string& venue, int startTime, int endTime, int activityId);
@@ -0,0 +1,45 @@
+#ifndef SLOT_SUGGESTER_H
+#define SLOT_SUGGESTER_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+// 一个可用的候选时间段
+struct SlotSuggestion {
+    std::string resource_name;
+    int start_minutes;
+    int end_minutes;
+    int distance_minutes;    // 与期望开始时间的差距
+};
+
+// 空闲间隙索引：每个资源的占用区间按开始时间有序、互不重叠（相邻的合并），
+// 相邻占用之间即为空闲间隙
+// 查询时从期望时间所在的间隙向前、向后两个方向逐个走间隙，
+// 多个资源的游标用优先队列按距离合并，取最近的 k 个可行时间段
+class SlotSuggester {
+public:
+    explicit SlotSuggester(int horizon_start = 0, int horizon_end = 1440);
+
+    void addResource(const std::string& resource);
+    void removeResource(const std::string& resource);
+    void clear();
+
+    void addBusy(const std::string& resource, int start_minutes, int end_minutes);     // 与已有占用重叠时合并
+    void removeBusy(const std::string& resource, int start_minutes, int end_minutes);  // 释放 [start, end)
+
+    bool isFree(const std::string& resource, int start_minutes, int end_minutes) const;
+
+    // resources 按偏好排序（距离相同时靠前的资源优先）；每个间隙最多给出一个时间段
+    std::vector<SlotSuggestion> suggest(const std::vector<std::string>& resources,
+                                        int preferred_start, int duration_minutes, size_t limit) const;
+
+private:
+    using BusyLine = std::map<int, int>;    // 开始 -> 结束
+
+    int horizon_start;
+    int horizon_end;
+    std::map<std::string, BusyLine> lines;
+};
+
+#endif // SLOT_SUGGESTER_H
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <functional>
+#include <cstdint>
 #include <sqlite3.h>
 
 struct Contact {
@@ -32,16 +34,20 @@ struct Activity {
     std:: string location;
     std::string start_time;
     std::string end_time;
+    int max_participants;    // 人数上限，0 表示不限
     
     Activity(int id = 0, const std::string& name = "", const std::string& location = "",
-             const std::string& start_time = "", const std::string& end_time = "")
-        : id(id), name(name), location(location), start_time(start_time), end_time(end_time) {}
+             const std::string& start_time = "", const std::string& end_time = "", int max_participants = 0)
+        : id(id), name(name), location(location), start_time(start_time), end_time(end_time),
+          max_participants(max_participants) {}
 };
 
 class SQLiteManager {
 private:
     sqlite3* db;
     std::string db_path;
+    
+    int countRows(const char* sql, const char* statement);   // 执行 SELECT COUNT(*)
 
 public:
     SQLiteManager(const std::string& path = "data/database.db");
@@ -56,17 +62,29 @@ public:
     bool isOpen() const;
     
     // 联系人操作
-    bool addContact(const Contact& contact);
+    bool addContact(const Contact& contact, int& new_id);                  // new_id 返回自动生成的ID
+    bool restoreContact(const Contact& contact);                            // 按原ID重新插入（撤销删除用）
+    bool getContact(int id, Contact& contact);                              // 不存在返回 false
+    bool updateContact(const Contact& contact);                             // 按ID更新，不存在返回 false
+    int getContactCount();
     std::vector<Contact> getAllContacts();
+    bool forEachContact(const std::function<void(Contact&&)>& visitor);    // 逐行流式读取，不构造整表
     bool deleteContact(int id);
     
     // 活动操作
     bool addActivity(const Activity& activity);
+    bool restoreActivity(const Activity& activity);                         // 按原ID重新插入（撤销删除用）
+    bool getActivity(int id, Activity& activity);                           // 不存在返回 false
+    bool updateActivity(const Activity& activity);                          // 按ID更新，不存在返回 false
+    int getActivityCount();
     std::vector<Activity> getAllActivities();
+    bool forEachActivity(const std::function<void(Activity&&)>& visitor);  // 逐行流式读取，不构造整表
     bool deleteActivity(int id);
     
     // 工具
     const std::string& getDbPath() const; // 提供数据库路径访问器
+    int64_t getChangeSequence();          // 数据变更序号（每次增删改递增，失败返回-1）
+    bool backupTo(const std::string& path);  // 在线备份到另一个数据库文件
     void clearAll();
 };
 
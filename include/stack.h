@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 template<typename T>
 class Stack {
@@ -21,7 +22,7 @@ public:
     // 构造和析构
     Stack();                                // 默认构造函数
     ~Stack();                               // 析构函数
-    Stack(const Stack& other);              // 拷贝构造函数（实现深拷贝）
+    Stack(const Stack& other);              // 拷贝构造函数（实现深拷贝，一次遍历）
     Stack& operator=(const Stack& other);   // 拷贝赋值运算符
     Stack(Stack&& other) noexcept;          // 移动构造函数
     Stack& operator=(Stack&& other) noexcept; // 移动赋值运算符
@@ -62,21 +63,17 @@ Stack<T>::~Stack() {
 // 拷贝构造函数（深拷贝）
 template<typename T>
 Stack<T>::Stack(const Stack& other) : topNode(nullptr), stackSize(0) {
-    if (!other.empty()) {
-        Node* current = other.topNode;
-        Stack<T> tempStack;  // 创建临时栈用于反转
-        
-        // 逆序遍历原栈
-        while (current != nullptr) {
-            tempStack.push(current->data);
-            current = current->next;
-        }
-        
-        // 依次将临时栈的元素推入当前栈
-        while (!tempStack.empty()) {
-            this->push(tempStack.top());
-            tempStack.pop();
+    // 从栈顶开始顺序复制，每个新节点接到上一个节点之后（无需临时栈反转）
+    Node** tail = &topNode;
+    try {
+        for (Node* current = other.topNode; current != nullptr; current = current->next) {
+            *tail = new Node(current->data);
+            tail = &(*tail)->next;
+            stackSize++;
         }
+    } catch (...) {
+        clear();
+        throw;
     }
 }
 
@@ -84,24 +81,8 @@ Stack<T>::Stack(const Stack& other) : topNode(nullptr), stackSize(0) {
 template<typename T>
 Stack<T>& Stack<T>::operator=(const Stack& other) {
     if (this != &other) {
-        clear();  // 清空当前栈
-        
-        if (!other.empty()) {
-            Node* current = other.topNode;
-            Stack<T> tempStack;  // 创建临时栈用于反转
-            
-            // 逆序遍历原栈
-            while (current != nullptr) {
-                tempStack.push(current->data);
-                current = current->next;
-            }
-            
-            // 依次将临时栈的元素推入当前栈
-            while (!tempStack.empty()) {
-                this->push(tempStack.top());
-                tempStack.pop();
-            }
-        }
+        Stack<T> copy(other);       // 先完成复制，失败时当前栈保持不变
+        *this = std::move(copy);
     }
     return *this;
 }
@@ -0,0 +1,76 @@
+#ifndef STATIC_ASSET_STORE_H
+#define STATIC_ASSET_STORE_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ctime>
+#include <sys/types.h>
+
+// 一个已加载的静态文件：原文与预压缩版本常驻内存，文件描述符保持打开供 sendfile 使用
+struct StaticAsset {
+    std::string path;           // 磁盘路径
+    std::string content_type;
+    std::string body;
+    std::string gzip_body;      // 压缩无收益时为空
+    std::string brotli_body;    // 同上
+    std::string etag;           // W/"大小-修改时间"
+    std::string last_modified;  // HTTP 日期格式
+    std::string cache_control;
+    time_t mtime;
+    off_t size;
+    int fd;
+
+    StaticAsset() : mtime(0), size(0), fd(-1) {}
+    ~StaticAsset();
+
+    StaticAsset(const StaticAsset&) = delete;
+    StaticAsset& operator=(const StaticAsset&) = delete;
+};
+
+// 一次静态文件响应：状态码、响应头，以及要发送的响应体
+// 响应体指向缓存中的资源（不拷贝）；from_file 为真时可直接 sendfile(fd)
+struct StaticReply {
+    int status_code;
+    std::string status_text;
+    std::map<std::string, std::string> headers;
+    const std::string* body;    // 304 时为空
+    bool from_file;             // 未压缩原文，可用 asset->fd 零拷贝发送
+    std::shared_ptr<const StaticAsset> asset;   // 持有资源，发送完成前不被替换释放
+
+    StaticReply() : status_code(200), status_text("OK"), body(nullptr), from_file(false) {}
+};
+
+// 前端静态资源存储
+// 首次请求时读入并预计算 gzip/brotli 版本，之后只在文件修改时间变化时重新加载
+class StaticAssetStore {
+public:
+    explicit StaticAssetStore(const std::string& root = "frontend");
+
+    // relative_path 以 "/" 开头；越界路径（含 ".."）或文件不存在时返回空
+    std::shared_ptr<const StaticAsset> find(const std::string& relative_path);
+
+    // 按请求头处理 If-None-Match / If-Modified-Since 条件请求并协商编码（br > gzip > 原文）
+    static StaticReply reply(const std::shared_ptr<const StaticAsset>& asset,
+                             const std::map<std::string, std::string>& request_headers);
+
+    void clear();
+    size_t size() const;
+    size_t getMemoryUsage() const;              // 原文与压缩版本的总字节数
+
+    static std::string contentTypeFor(const std::string& path);
+    static std::string httpDate(time_t time);
+    static bool brotliCompress(const std::string& input, std::string& output);
+
+    static const size_t MIN_COMPRESS_BYTES;     // 小于此大小的文件不预压缩
+
+private:
+    std::shared_ptr<const StaticAsset> load(const std::string& path, time_t mtime, off_t size);
+
+    std::string root;
+    std::map<std::string, std::shared_ptr<const StaticAsset>> assets;   // 相对路径 -> 资源
+    mutable std::mutex mutex;
+};
+
+#endif // STATIC_ASSET_STORE_H
@@ -0,0 +1,67 @@
+#ifndef STRING_INDEX_H
+#define STRING_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class SnapshotBuffer;
+class SnapshotView;
+
+// 字符串 -> 联系人ID 的开放寻址索引（线性探测）
+// 用于电话、邮箱、学号等唯一字段的O(1)精确查找与去重
+class StringIndex {
+public:
+    StringIndex(size_t initial_capacity = 16);
+
+    // 主要操作
+    bool insert(const std::string& key, int id);     // 插入或覆盖映射
+    int find(const std::string& key) const;          // 查找ID，不存在返回-1
+    bool contains(const std::string& key) const;     // 检查是否存在
+    bool remove(const std::string& key);             // 删除映射
+    bool removeIfMatches(const std::string& key, int id);  // 仅当映射指向id时删除
+
+    // 工具函数
+    size_t size() const;                             // 获取元素数量
+    size_t capacity() const;                         // 获取容量
+    void reserve(size_t expected_count);             // 预留容量，避免批量插入时反复扩容
+    void clear();                                    // 清空索引
+
+    // 快照：按槽位原样保存（含墓碑），恢复时无需重新散列
+    void writeSnapshot(SnapshotBuffer& out) const;
+    bool restoreSnapshot(const SnapshotView& in, size_t& offset);   // 失败时索引保持不变
+
+private:
+    // 槽位状态
+    enum SlotState : uint8_t {
+        EMPTY = 0,
+        OCCUPIED = 1,
+        DELETED = 2      // 墓碑，保证探测链不断开
+    };
+
+    struct Slot {
+        std::string key;
+        uint64_t hash;
+        int id;
+        SlotState state;
+
+        Slot() : hash(0), id(-1), state(EMPTY) {}
+    };
+
+    std::vector<Slot> slots;     // 槽位数组（容量为2的幂）
+    size_t element_count;        // 有效元素数量
+    size_t tombstone_count;      // 墓碑数量
+
+    static const double MAX_LOAD_FACTOR;   // 最大负载因子（含墓碑）
+    static const size_t MIN_CAPACITY;      // 最小容量
+
+    // 内部辅助函数
+    static uint64_t hashKey(const std::string& key);       // FNV-1a 哈希
+    size_t findSlot(const std::string& key, uint64_t hash) const;  // 查找键所在槽位，不存在返回npos
+    void rehash(size_t new_capacity);                      // 重新分配并迁移
+
+    static const size_t npos = static_cast<size_t>(-1);
+};
+
+#endif // STRING_INDEX_H
@@ -6,6 +6,11 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <cstdint>
+
+class SnapshotBuffer;
+class SnapshotView;
 
 class Trie {
 public:
@@ -13,13 +18,21 @@ public:
     ~Trie();
     
     void insertContact(std::shared_ptr<Contact> contact);
-    std::vector<std:: shared_ptr<Contact>> searchByNamePrefix(const std::string& prefix);
-    std::vector<std:: shared_ptr<Contact>> searchByStudentIdPrefix(const std::string& prefix);
+    std::vector<std:: shared_ptr<Contact>> searchByNamePrefix(const std::string& prefix) const;
+    std::vector<std:: shared_ptr<Contact>> searchByStudentIdPrefix(const std::string& prefix) const;
     bool deleteContact(int contactId);
 
     void insert(const std::string& key);
-    bool search(const std::string& key);
-    bool startsWith(const std:: string& prefix);
+    bool search(const std::string& key) const;
+    bool startsWith(const std:: string& prefix) const;
+    
+    void merge(Trie& other);                 // 并入另一棵树（节点直接转移，other被清空）
+    
+    // 快照：节点按广度优先顺序扁平化，子节点以编号引用，联系人保存为记录编号
+    void writeSnapshot(SnapshotBuffer& out,
+                       const std::function<uint32_t(const Contact*)>& contact_ref) const;
+    bool restoreSnapshot(const SnapshotView& in, size_t& offset,
+                         const std::vector<std::shared_ptr<Contact>>& contacts);  // 失败时树保持不变
     
     void clear();
     size_t getContactCount() const;
@@ -44,6 +57,7 @@ private:
     
     void collectAllContacts(TrieNode* node, std::vector<std::shared_ptr<Contact>>& result) const;
     void deleteNode(TrieNode* node);
+    void mergeNode(TrieNode* target, TrieNode* source);
     std::vector<std:: shared_ptr<Contact>> removeDuplicates(const std::vector<std::shared_ptr<Contact>>& contacts) const;
 
     void insertString(const std::string& str, std::shared_ptr<Contact> contact = nullptr);
@@ -1,50 +1,121 @@
 #include "../include/activity_manager.h"
+#include "../include/parallel_for.h"
+#include "../include/slot_suggester.h"
+#include "../include/logger.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <chrono>
 #include <iomanip>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+// 操作日志只保存可变字段，ID 单独记录
+std::vector<std::string> activityFields(const Activity& activity) {
+    return {activity.name, activity.location, activity.start_time, activity.end_time,
+            std::to_string(activity.max_participants)};
+}
+
+bool activityFromFields(int id, const std::vector<std::string>& fields, Activity& activity) {
+    if (fields.size() != 4 && fields.size() != 5) return false;    // 旧日志没有人数上限
+    activity = Activity(id, fields[0], fields[1], fields[2], fields[3],
+                        fields.size() == 5 ? std::atoi(fields[4].c_str()) : 0);
+    return true;
+}
+
+// 预定义地点（实际项目中应该从配置或数据库读取）
+const char* const KNOWN_LOCATIONS[] = {
+    "会议室A", "会议室B", "培训室1", "培训室2", "大礼堂", "小礼堂", "展览厅"
+};
+
+// 拆分 "YYYY-MM-DD HH:MM"（或 "HH:MM"）为日期和当天分钟数，格式不对时返回 false
+bool splitDateTime(const std::string& text, std::string& date, int& minutes) {
+    size_t space = text.find(' ');
+    date = space == std::string::npos ? "" : text.substr(0, space);
+    size_t clock = space == std::string::npos ? 0 : space + 1;
+    size_t colon = text.find(':', clock);
+    if (colon == std::string::npos || colon == clock || colon + 1 >= text.size()) return false;
+
+    int hours = 0;
+    int mins = 0;
+    if (colon - clock > 2) return false;
+    for (size_t i = clock; i < colon; i++) {
+        if (!std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+        hours = hours * 10 + (text[i] - '0');
+    }
+    for (size_t i = colon + 1; i < text.size() && i < colon + 3; i++) {
+        if (!std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+        mins = mins * 10 + (text[i] - '0');
+    }
+    minutes = hours * 60 + mins;
+    return mins <= 59 && minutes <= 1440;
+}
+
+} // namespace
 
 // 新的构造函数：接收外部注入的DataManager
 ActivityManager::ActivityManager(DataManager* dm, const std::string& backup_dir)
-    : data_manager(dm), conflict_detection_enabled(true) {
+    : data_manager(dm), operation_log(nullptr), conflict_detection_enabled(true), generation(0),
+      day_index_built(false) {
     
     if (data_manager == nullptr) {
-        std::cerr << "错误: DataManager不能为nullptr!" << std::endl;
+        LOG_ERROR("DataManager不能为nullptr!");
     }
     conflict_detector.reset(new SegmentTree(1440)); // 一天1440分钟
 }
 
 ActivityManager::ActivityManager(const std::string& db_path, const std::string& backup_dir)
-    : conflict_detection_enabled(true) {
+    : operation_log(nullptr), conflict_detection_enabled(true), generation(0), day_index_built(false) {
     
     // 创建新的DataManager（旧方式，应该用新构造函数）
-    std::cerr << "警告: 使用已弃用的ActivityManager构造函数！建议改用依赖注入。" << std::endl;
-    data_manager = new DataManager(db_path, backup_dir, 100);
+    LOG_WARN("使用已弃用的ActivityManager构造函数！建议改用依赖注入。");
+    owned_data_manager.reset(new DataManager(db_path, backup_dir, 100));
+    data_manager = owned_data_manager.get();
     conflict_detector.reset(new SegmentTree(1440)); // 一天1440分钟
 }
 
 ActivityManager::~ActivityManager() {
-    // 注意: 不释放data_manager，因为是外部注入的
-    // 如果使用了旧构造函数，调用者需要自己管理生命周期
+    // 注意: 外部注入的data_manager不在这里释放；旧构造函数创建的由 owned_data_manager 释放
 }
 
 bool ActivityManager::initialize() {
-    std::cout << "初始化活动管理器..." << std::endl;
+    LOG_INFO("初始化活动管理器...");
     
     // 初始化数据管理器
     if (!data_manager->initialize()) {
-        std::cerr << "数据管理器初始化失败" << std::endl;
+        LOG_ERROR("数据管理器初始化失败");
         return false;
     }
     
     // 构建地点索引
     auto activities = data_manager->getAllActivities();
-    for (const auto& activity : activities) {
-        updateLocationIndex(activity);
+    location_activities = buildLocationIndex(activities);
+    day_index_built = false;
+    generation++;
+    
+    LOG_INFO("活动管理器初始化成功，加载了 " << activities.size() << " 个活动");
+    return true;
+}
+
+bool ActivityManager::initializeFromSnapshot(const IndexSnapshotFile& snapshot) {
+    LOG_INFO("从快照初始化活动管理器...");
+    
+    if (!data_manager->initialize()) {
+        LOG_ERROR("数据管理器初始化失败");
+        return false;
+    }
+    
+    generation++;
+    day_index_built = false;
+    if (restoreLocationIndex(snapshot)) {
+        LOG_INFO("地点索引已从快照恢复，共 " << location_activities.size() << " 个地点");
+        return true;
     }
     
-    std::cout << "活动管理器初始化成功，加载了 " << activities.size() << " 个活动" << std::endl;
+    LOG_WARN("地点索引快照无效，回退为重建");
+    location_activities = buildLocationIndex(data_manager->getAllActivities());
     return true;
 }
 
@@ -52,6 +123,10 @@ bool ActivityManager::isReady() const {
     return data_manager && data_manager->isReady();
 }
 
+uint64_t ActivityManager::getGeneration() const {
+    return generation.load();
+}
+
 // 基本操作
 
 bool ActivityManager::addActivity(const std::string& name, const std::string& location,
@@ -62,7 +137,7 @@ bool ActivityManager::addActivity(const std::string& name, const std::string& lo
 
 bool ActivityManager::addActivity(const Activity& activity) {
     if (!isReady()) {
-        std::cerr << "活动管理器未就绪" << std::endl;
+        LOG_WARN("活动管理器未就绪");
         return false;
     }
     
@@ -73,10 +148,10 @@ bool ActivityManager::addActivity(const Activity& activity) {
     // 冲突检测
     if (conflict_detection_enabled && hasTimeConflict(activity)) {
         auto conflicts = findConflictingActivities(activity);
-        std::cerr << "时间冲突，与以下活动冲突:" << std::endl;
+        LOG_WARN("时间冲突，与以下活动冲突:");
         for (const auto& conflict : conflicts) {
-            std::cerr << "  - " << conflict.name << " @ " << conflict.location 
-                     << " (" << conflict.start_time << " - " << conflict.end_time << ")" << std::endl;
+            LOG_WARN("  - " << conflict.name << " @ " << conflict.location 
+                     << " (" << conflict.start_time << " - " << conflict.end_time << ")");
         }
         return false;
     }
@@ -91,8 +166,12 @@ bool ActivityManager::addActivity(const Activity& activity) {
     if (! activities.empty()) {
         const Activity& newActivity = activities. back();
         updateLocationIndex(newActivity);
-        std::cout << "活动已添加: " << newActivity.name << " @ " << newActivity. location 
-                 << " (ID: " << newActivity.id << ")" << std::endl;
+        generation++;
+        if (operation_log) {
+            operation_log->record(OperationRecord(OP_ACTIVITY_ADD, newActivity.id, {}, activityFields(newActivity)));
+        }
+        LOG_DEBUG("活动已添加: " << newActivity.name << " @ " << newActivity. location 
+                  << " (ID: " << newActivity.id << ")");
     }
     
     return true;
@@ -104,7 +183,7 @@ bool ActivityManager:: removeActivity(int id) {
     // 先获取活动信息
     Activity* activity = data_manager->getActivity(id);
     if (!activity) {
-        std::cerr << "活动不存在: ID=" << id << std::endl;
+        LOG_WARN("活动不存在: ID=" << id);
         return false;
     }
     
@@ -118,26 +197,88 @@ bool ActivityManager:: removeActivity(int id) {
     
     // 从索引中移除
     removeFromLocationIndex(activityCopy);
+    generation++;
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_ACTIVITY_REMOVE, id, activityFields(activityCopy), {}));
+    }
     
-    std::cout << "活动已删除: " << activityCopy.name << std::endl;
+    LOG_DEBUG("活动已删除: " << activityCopy.name);
     return true;
 }
 
 bool ActivityManager::updateActivity(const Activity& activity) {
     if (!isReady() || !validateActivity(activity)) return false;
     
+    // 保留旧值：地点索引需要移除旧地点，撤销需要旧字段
+    Activity* existing = data_manager->getActivity(activity.id);
+    if (!existing) {
+        LOG_WARN("活动不存在: ID=" << activity.id);
+        return false;
+    }
+    Activity previous = *existing;
+    delete existing;
+    
     // 更新数据存储
     if (!data_manager->updateActivity(activity)) {
         return false;
     }
     
     // 更新索引
+    removeFromLocationIndex(previous);
     updateLocationIndex(activity);
+    generation++;
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_ACTIVITY_UPDATE, activity.id,
+                                              activityFields(previous), activityFields(activity)));
+    }
     
-    std::cout << "活动已更新: " << activity.name << std::endl;
+    LOG_DEBUG("活动已更新: " << activity.name);
     return true;
 }
 
+bool ActivityManager::restoreActivity(const Activity& activity) {
+    if (!isReady() || !validateActivity(activity)) return false;
+    
+    Activity* existing = data_manager->getActivity(activity.id);
+    if (existing) {
+        delete existing;
+        LOG_WARN("无法恢复活动，ID已被占用: " << activity.id);
+        return false;
+    }
+    
+    if (!data_manager->restoreActivity(activity)) {
+        return false;
+    }
+    updateLocationIndex(activity);
+    generation++;
+    
+    LOG_DEBUG("活动已恢复: " << activity.name << " (ID: " << activity.id << ")");
+    return true;
+}
+
+// 撤销/重做
+
+void ActivityManager::setOperationLog(OperationLog* log) {
+    operation_log = log;
+}
+
+bool ActivityManager::replayOperation(const OperationRecord& record, bool inverse) {
+    Activity activity;
+    switch (record.type) {
+        case OP_ACTIVITY_ADD:
+            if (inverse) return removeActivity(record.target_id);
+            return activityFromFields(record.target_id, record.after, activity) && restoreActivity(activity);
+        case OP_ACTIVITY_REMOVE:
+            if (!inverse) return removeActivity(record.target_id);
+            return activityFromFields(record.target_id, record.before, activity) && restoreActivity(activity);
+        case OP_ACTIVITY_UPDATE:
+            return activityFromFields(record.target_id, inverse ? record.before : record.after, activity) &&
+                   updateActivity(activity);
+        default:
+            return false;
+    }
+}
+
 // 高级查询
 
 std::vector<Activity> ActivityManager::findByLocation(const std::string& location) {
@@ -151,7 +292,7 @@ std::vector<Activity> ActivityManager::findByLocation(const std::string& locatio
         }
     }
     
-    std::cout << "在地点 '" << location << "' 找到 " << result.size() << " 个活动" << std:: endl;
+    LOG_DEBUG("在地点 '" << location << "' 找到 " << result.size() << " 个活动");
     return result;
 }
 
@@ -167,7 +308,7 @@ std::vector<Activity> ActivityManager::findByTimeRange(const std::string& start,
         }
     }
     
-    std::cout << "在时间段 " << start << " - " << end << " 找到 " << result.size() << " 个活动" << std::endl;
+    LOG_DEBUG("在时间段 " << start << " - " << end << " 找到 " << result.size() << " 个活动");
     return result;
 }
 
@@ -215,7 +356,7 @@ std::vector<Activity> ActivityManager::findConflictingActivities(const Activity&
 
 void ActivityManager::enableConflictDetection(bool enable) {
     conflict_detection_enabled = enable;
-    std::cout << "冲突检测已" << (enable ? "启用" :  "禁用") << std::endl;
+    LOG_INFO("冲突检测已" << (enable ? "启用" :  "禁用"));
 }
 
 // 资源调度
@@ -224,12 +365,7 @@ std::vector<std::string> ActivityManager:: getAvailableLocations(const std::stri
                                                                const std:: string& end_time) {
     std::vector<std::string> availableLocations;
     
-    // 预定义一些地点（实际项目中应该从配置或数据库读取）
-    std::vector<std::string> allLocations = {
-        "会议室A", "会议室B", "培训室1", "培训室2", "大礼堂", "小礼堂", "展览厅"
-    };
-    
-    for (const auto& location : allLocations) {
+    for (const char* location : KNOWN_LOCATIONS) {
         bool available = true;
         auto locationActivities = findByLocation(location);
         
@@ -245,17 +381,66 @@ std::vector<std::string> ActivityManager:: getAvailableLocations(const std::stri
         }
     }
     
-    std::cout << "时间段 " << start_time << " - " << end_time 
-             << " 可用地点: " << availableLocations.size() << " 个" << std::endl;
+    LOG_DEBUG("时间段 " << start_time << " - " << end_time 
+              << " 可用地点: " << availableLocations.size() << " 个");
     return availableLocations;
 }
 
+std::vector<Activity> ActivityManager::suggestAlternatives(const Activity& activity, size_t limit, bool any_location) {
+    std::vector<Activity> suggestions;
+    std::string date, end_date;
+    int start = 0;
+    int end = 0;
+    if (!isReady() || !splitDateTime(activity.start_time, date, start) ||
+        !splitDateTime(activity.end_time, end_date, end) || end_date != date || end <= start) {
+        return suggestions;
+    }
+    
+    std::vector<std::string> locations = {activity.location};
+    if (any_location) {
+        for (const char* location : KNOWN_LOCATIONS) {
+            if (location != activity.location) locations.push_back(location);
+        }
+    }
+    
+    // 只看同一天的占用
+    if (!day_index_built) {
+        buildDayIndex();
+    }
+    SlotSuggester suggester;
+    for (const auto& location : locations) {
+        suggester.addResource(location);
+    }
+    auto day = day_bookings.find(date);
+    if (day != day_bookings.end()) {
+        for (const auto& booking : day->second) {
+            if (activity.id > 0 && booking.id == activity.id) continue;
+            // 与 hasTimeConflict 一致，地点按包含关系匹配
+            for (const auto& location : locations) {
+                if (booking.location.find(location) != std::string::npos) {
+                    suggester.addBusy(location, booking.start_minutes, booking.end_minutes);
+                }
+            }
+        }
+    }
+    
+    std::string prefix = date.empty() ? "" : date + " ";
+    for (const auto& slot : suggester.suggest(locations, start, end - start, limit)) {
+        Activity suggestion = activity;
+        suggestion.location = slot.resource_name;
+        suggestion.start_time = prefix + minutesToTimeString(slot.start_minutes);
+        suggestion.end_time = prefix + minutesToTimeString(slot.end_minutes);
+        suggestions.push_back(suggestion);
+    }
+    return suggestions;
+}
+
 std::vector<Activity> ActivityManager::getUpcomingActivities(int days) {
     std::vector<Activity> upcoming;
     
     // 简化实现：返回所有活动（实际项目中需要日期比较）
     auto activities = getAllActivities();
-    std::cout << "📅 即将到来的活动: " << activities.size() << " 个" << std:: endl;
+    LOG_DEBUG("📅 即将到来的活动: " << activities.size() << " 个");
     return activities;
 }
 
@@ -316,7 +501,7 @@ bool ActivityManager:: importActivities(const std::vector<Activity>& activities)
     // 恢复冲突检测设置
     enableConflictDetection(originalConflictSetting);
     
-    std::cout << "活动导入完成: 成功 " << successCount << " 个, 失败 " << errorCount << " 个" << std:: endl;
+    LOG_INFO("活动导入完成: 成功 " << successCount << " 个, 失败 " << errorCount << " 个");
     return errorCount == 0;
 }
 
@@ -363,36 +548,150 @@ void ActivityManager::printConflictReport() {
     }
 }
 
+std::map<std::string, std::vector<int>> ActivityManager::buildLocationIndex(const std::vector<Activity>& activities,
+                                                                             unsigned thread_count) {
+    if (thread_count == 0) thread_count = defaultBuildThreads();
+    
+    // 每个分片写自己的局部映射，无需加锁
+    std::vector<std::map<std::string, std::vector<int>>> shards(thread_count);
+    parallelForShards(activities.size(), thread_count, [&](unsigned shard, size_t begin, size_t end) {
+        auto& local = shards[shard];
+        for (size_t i = begin; i < end; i++) {
+            if (activities[i].id <= 0) continue;
+            local[activities[i].location].push_back(activities[i].id);
+        }
+    });
+    
+    // 按分片顺序合并，各地点内的活动顺序与串行构建一致
+    std::map<std::string, std::vector<int>> merged = std::move(shards[0]);
+    for (size_t shard = 1; shard < shards.size(); shard++) {
+        for (auto& entry : shards[shard]) {
+            auto& ids = merged[entry.first];
+            ids.insert(ids.end(), entry.second.begin(), entry.second.end());
+        }
+    }
+    return merged;
+}
+
+void ActivityManager::writeSnapshot(IndexSnapshotWriter& writer) const {
+    // [u32 地点数]，每个地点：[地点名][u32 活动数][i32 活动ID...]
+    SnapshotBuffer buffer;
+    buffer.append(static_cast<uint32_t>(location_activities.size()));
+    for (const auto& entry : location_activities) {
+        buffer.appendString(entry.first);
+        buffer.append(static_cast<uint32_t>(entry.second.size()));
+        for (int id : entry.second) {
+            buffer.append(static_cast<int32_t>(id));
+        }
+    }
+    writer.addSection(SECTION_LOCATIONS, std::move(buffer));
+}
+
+bool ActivityManager::restoreLocationIndex(const IndexSnapshotFile& snapshot) {
+    SnapshotView view;
+    if (!snapshot.section(SECTION_LOCATIONS, view)) return false;
+    
+    size_t offset = 0;
+    uint32_t location_count = 0;
+    if (!view.read(offset, location_count)) return false;
+    
+    std::map<std::string, std::vector<int>> restored;
+    for (uint32_t i = 0; i < location_count; i++) {
+        std::string location;
+        uint32_t id_count = 0;
+        if (!view.readString(offset, location) || !view.read(offset, id_count) ||
+            id_count > view.size()) {
+            return false;
+        }
+        
+        auto& ids = restored[location];
+        ids.resize(id_count);
+        for (auto& id : ids) {
+            int32_t value = 0;
+            if (!view.read(offset, value)) return false;
+            id = value;
+        }
+    }
+    
+    location_activities.swap(restored);
+    return true;
+}
+
 // 私有辅助方法
 
 void ActivityManager::updateLocationIndex(const Activity& activity) {
     if (activity.id <= 0) return;
     location_activities[activity.location].push_back(activity. id);
+    if (day_index_built) addToDayIndex(activity);
 }
 
 void ActivityManager::removeFromLocationIndex(const Activity& activity) {
     auto& ids = location_activities[activity.location];
     ids.erase(std::remove(ids.begin(), ids.end(), activity.id), ids.end());
+    if (day_index_built) removeFromDayIndex(activity);
+}
+
+void ActivityManager::buildDayIndex() {
+    day_bookings.clear();
+    for (const auto& activity : data_manager->getAllActivities()) {
+        addToDayIndex(activity);
+    }
+    day_index_built = true;
+}
+
+void ActivityManager::addToDayIndex(const Activity& activity) {
+    std::string start_date, end_date;
+    int start = 0;
+    int end = 0;
+    if (!splitDateTime(activity.start_time, start_date, start) ||
+        !splitDateTime(activity.end_time, end_date, end)) {
+        return;
+    }
+    if (start_date == end_date) {
+        day_bookings[start_date].push_back({activity.id, activity.location, start, end});
+        return;
+    }
+    day_bookings[start_date].push_back({activity.id, activity.location, start, 1440});
+    day_bookings[end_date].push_back({activity.id, activity.location, 0, end});
+}
+
+void ActivityManager::removeFromDayIndex(const Activity& activity) {
+    std::string start_date, end_date;
+    int start = 0;
+    int end = 0;
+    if (!splitDateTime(activity.start_time, start_date, start) ||
+        !splitDateTime(activity.end_time, end_date, end)) {
+        return;
+    }
+    for (const auto& date : {start_date, end_date}) {
+        auto day = day_bookings.find(date);
+        if (day == day_bookings.end()) continue;
+        auto& bookings = day->second;
+        bookings.erase(std::remove_if(bookings.begin(), bookings.end(),
+                                      [&](const DayBooking& booking) { return booking.id == activity.id; }),
+                       bookings.end());
+        if (bookings.empty()) day_bookings.erase(day);
+    }
 }
 
 bool ActivityManager::validateActivity(const Activity& activity) {
     if (activity.name.empty()) {
-        std::cerr << "活动名称不能为空" << std::endl;
+        LOG_WARN("活动名称不能为空");
         return false;
     }
     
     if (activity.location.empty()) {
-        std::cerr << "活动地点不能为空" << std::endl;
+        LOG_WARN("活动地点不能为空");
         return false;
     }
     
     if (activity. start_time.empty() || activity.end_time.empty()) {
-        std::cerr << "活动时间不能为空" << std::endl;
+        LOG_WARN("活动时间不能为空");
         return false;
     }
     
     if (activity.start_time >= activity.end_time) {
-        std::cerr << "开始时间必须早于结束时间" << std::endl;
+        LOG_WARN("开始时间必须早于结束时间");
         return false;
     }
     
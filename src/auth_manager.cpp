@@ -1,5 +1,5 @@
 #include "../include/auth_manager.h"
-#include <iostream>
+#include "../include/logger.h"
 #include <sstream>
 #include <iomanip>
 #include <random>
@@ -18,25 +18,25 @@ AuthManager::AuthManager(const std:: string& db_path, const std::string& secret)
 AuthManager::~AuthManager() = default;
 
 bool AuthManager::initialize() {
-    std::cout << "初始化认证管理器..." << std::endl;
+    LOG_INFO("初始化认证管理器...");
     
     if (!db_manager->init()) {
-        std::cerr << "认证数据库初始化失败" << std::endl;
+        LOG_ERROR("认证数据库初始化失败");
         return false;
     }
     
     if (!initializeDatabase()) {
-        std::cerr << "用户表创建失败" << std::endl;
+        LOG_ERROR("用户表创建失败");
         return false;
     }
     
     // 创建默认管理员账户
     if (getUserByUsername("admin") == nullptr) {
         registerUser("admin", "admin123", "系统管理员", "admin@campus.edu", "系统管理", UserRole::ADMIN);
-        std::cout << "创建默认管理员账户:  admin/admin123" << std:: endl;
+        LOG_WARN("创建默认管理员账户:  admin/admin123");
     }
     
-    std::cout << "认证管理器初始化成功" << std:: endl;
+    LOG_INFO("认证管理器初始化成功");
     return true;
 }
 
@@ -65,14 +65,14 @@ bool AuthManager::initializeDatabase() {
     sqlite3* db;
     int rc = sqlite3_open(db_manager->getDbPath().c_str(), &db);
     if (rc != SQLITE_OK) {
-        std::cerr << "无法打开认证数据库: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("无法打开认证数据库: " << sqlite3_errmsg(db));
         return false;
     }
     
     char* errMsg;
     rc = sqlite3_exec(db, create_users_table, nullptr, nullptr, &errMsg);
     if (rc != SQLITE_OK) {
-        std::cerr << "创建用户表失败: " << errMsg << std::endl;
+        LOG_ERROR("创建用户表失败: " << errMsg);
         sqlite3_free(errMsg);
         sqlite3_close(db);
         return false;
@@ -88,13 +88,13 @@ bool AuthManager::registerUser(const std::string& username, const std::string& p
     
     // 检查用户名是否已存在
     if (getUserByUsername(username) != nullptr) {
-        std::cerr << "用户名已存在: " << username << std::endl;
+        LOG_WARN("用户名已存在: " << username);
         return false;
     }
     
     // 密码强度验证
     if (password.length() < 6) {
-        std::cerr << "密码长度至少6位" << std::endl;
+        LOG_WARN("密码长度至少6位");
         return false;
     }
     
@@ -129,7 +129,7 @@ bool AuthManager::registerUser(const std::string& username, const std::string& p
     sqlite3_close(db);
     
     if (success) {
-        std::cout << "用户注册成功: " << username << std::endl;
+        LOG_INFO("用户注册成功: " << username);
     }
     
     return success;
@@ -138,18 +138,18 @@ bool AuthManager::registerUser(const std::string& username, const std::string& p
 std::string AuthManager::authenticate(const std::string& username, const std::string& password) {
     User* user = getUserByUsername(username);
     if (!user) {
-        std::cerr << "用户不存在: " << username << std::endl;
+        LOG_WARN("用户不存在: " << username);
         return "";
     }
     
     if (!user->is_active) {
-        std::cerr << "用户账户已被禁用: " << username << std::endl;
+        LOG_WARN("用户账户已被禁用: " << username);
         delete user;
         return "";
     }
     
     if (!verifyPassword(password, user->password_hash)) {
-        std::cerr << "密码错误: " << username << std:: endl;
+        LOG_WARN("密码错误: " << username);
         delete user;
         return "";
     }
@@ -166,8 +166,8 @@ std::string AuthManager::authenticate(const std::string& username, const std::st
         active_tokens[token] = payload;
     }
     
-    std::cout << "用户登录成功: " << username << " (" << 
-                 (user->role == UserRole:: ADMIN ? "管理员" : "学生") << ")" << std::endl;
+    LOG_INFO("用户登录成功: " << username << " (" << 
+             (user->role == UserRole:: ADMIN ? "管理员" : "学生") << ")");
     
     delete user;
     return token;
@@ -416,7 +416,7 @@ bool AuthManager::parseJWT(const std::string& token, JWTPayload& payload) {
     }
     
     if (signature_valid != 0) {
-        std::cerr << "JWT签名验证失败！" << std::endl;
+        LOG_WARN("JWT签名验证失败！");
         return false;  // 签名不匹配
     }
     
@@ -1,9 +1,135 @@
 #include "../include/conflict_detector.h"
+#include "../include/metrics.h"
+#include "../include/logger.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstdlib>
+#include <cstdio>
+
+namespace {
+
+// 操作日志只保存可变字段，ID 单独记录
+std::vector<std::string> reservationFields(const Reservation& reservation) {
+    return {reservation.resource_name, reservation.activity_name,
+            reservation.time_slot.start_time, reservation.time_slot.end_time,
+            std::to_string(reservation.priority), reservation.contact_info, std::to_string(reservation.demand)};
+}
+
+bool reservationFromFields(int id, const std::vector<std::string>& fields, Reservation& reservation) {
+    if (fields.size() != 6 && fields.size() != 7) return false;    // 旧日志没有需求量
+    reservation = Reservation(id, fields[0], fields[1], TimeSlot(fields[2], fields[3]),
+                              std::atoi(fields[4].c_str()), fields[5],
+                              fields.size() == 7 ? std::atoi(fields[6].c_str()) : 1);
+    return true;
+}
+
+std::vector<std::string> seriesFields(const RecurringSeries& recurring) {
+    return {recurring.resource_name, recurring.activity_name,
+            recurring.time_slot.start_time, recurring.time_slot.end_time,
+            std::to_string(recurring.priority), recurring.contact_info, recurring.rule.toString(),
+            std::to_string(recurring.demand)};
+}
+
+bool seriesFromFields(int id, const std::vector<std::string>& fields, RecurringSeries& recurring) {
+    if (fields.size() != 7 && fields.size() != 8) return false;    // 快照中不含需求量
+    recurring.demand = fields.size() == 8 ? std::atoi(fields[7].c_str()) : 1;
+    recurring.id = id;
+    recurring.resource_name = fields[0];
+    recurring.activity_name = fields[1];
+    recurring.time_slot = TimeSlot(fields[2], fields[3]);
+    recurring.priority = std::atoi(fields[4].c_str());
+    recurring.contact_info = fields[5];
+    return RecurrenceRule::parse(fields[6], recurring.rule);
+}
+
+// 单次预约时间中的日期部分；"HH:MM" 格式的预约没有日期，视为每天都占用
+bool reservationDay(const Reservation& reservation, int& day) {
+    size_t space_pos = reservation.time_slot.start_time.find(' ');
+    return space_pos != std::string::npos &&
+           parseDate(reservation.time_slot.start_time.substr(0, space_pos), day);
+}
+
+// 展开系列在某一天的发生
+SeriesOccurrence makeOccurrence(const RecurringSeries& recurring, int day) {
+    std::string date = formatDate(day);
+    TimeSlot slot = recurring.time_slot;
+    slot.start_time = date + " " + slot.start_time;
+    slot.end_time = date + " " + slot.end_time;
+    return {recurring.id, date, Reservation(0, recurring.resource_name, recurring.activity_name, slot,
+                                            recurring.priority, recurring.contact_info, recurring.demand)};
+}
+
+// 一段占用：[start, end) 内占用 demand 个单位
+struct Load {
+    int start;
+    int end;
+    int demand;
+};
+
+// [from, to) 内各时刻占用量之和的最大值
+int peakLoad(const std::vector<Load>& loads, int from, int to) {
+    std::vector<std::pair<int, int>> events;
+    for (const auto& load : loads) {
+        int start = std::max(load.start, from);
+        int end = std::min(load.end, to);
+        if (start >= end) continue;
+        events.emplace_back(start, load.demand);
+        events.emplace_back(end, -load.demand);
+    }
+    std::sort(events.begin(), events.end());  // 同一时刻先结束再开始
+    
+    int current = 0;
+    int peak = 0;
+    for (const auto& event : events) {
+        current += event.second;
+        peak = std::max(peak, current);
+    }
+    return peak;
+}
+
+Load loadOf(const Reservation& reservation) {
+    return {reservation.time_slot.start_minutes, reservation.time_slot.end_minutes, reservation.demand};
+}
+
+void appendDemands(SnapshotBuffer& buffer, const std::vector<std::pair<int, int>>& demands) {
+    buffer.append(static_cast<uint32_t>(demands.size()));
+    for (const auto& entry : demands) {
+        buffer.append(static_cast<int32_t>(entry.first));
+        buffer.append(static_cast<int32_t>(entry.second));
+    }
+}
+
+bool readDemands(const SnapshotView& view, size_t& offset, std::map<int, int>& demands) {
+    uint32_t count = 0;
+    if (!view.read(offset, count)) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t id = 0;
+        int32_t demand = 0;
+        if (!view.read(offset, id) || !view.read(offset, demand)) return false;
+        demands[id] = demand;
+    }
+    return true;
+}
+
+// 批量准入顺序：优先级高的在前，同优先级开始早的在前，再按请求顺序
+struct AdmissionOrder {
+    const std::vector<Reservation>* requests;
+    
+    bool operator()(size_t a, size_t b) const {
+        const Reservation& left = (*requests)[a];
+        const Reservation& right = (*requests)[b];
+        if (left.priority != right.priority) return left.priority > right.priority;
+        if (left.time_slot.start_minutes != right.time_slot.start_minutes) {
+            return left.time_slot.start_minutes < right.time_slot.start_minutes;
+        }
+        return a < b;
+    }
+};
+
+} // namespace
 
 // TimeSlot 实现
 
@@ -42,6 +168,20 @@ TimeSlot::TimeSlot(const std:: string& start, const std::string& end)
     }
 }
 
+TimeSlot TimeSlot::fromMinutes(int start, int end) {
+    char start_text[16];    // 按 int 的取值范围留足，避免截断
+    char end_text[16];
+    std::snprintf(start_text, sizeof(start_text), "%02d:%02d", start / 60, start % 60);
+    std::snprintf(end_text, sizeof(end_text), "%02d:%02d", end / 60, end % 60);
+    
+    TimeSlot slot;
+    slot.start_time = start_text;
+    slot.end_time = end_text;
+    slot.start_minutes = start;
+    slot.end_minutes = end;
+    return slot;
+}
+
 bool TimeSlot:: overlaps(const TimeSlot& other) const {
     return !(end_minutes <= other.start_minutes || start_minutes >= other.end_minutes);
 }
@@ -53,9 +193,9 @@ std::string TimeSlot::toString() const {
 // Reservation 实现
 
 Reservation:: Reservation(int id, const std::string& resource, const std:: string& activity,
-                        const TimeSlot& slot, int priority, const std::string& contact)
+                        const TimeSlot& slot, int priority, const std::string& contact, int demand)
     : id(id), resource_name(resource), activity_name(activity), time_slot(slot),
-      priority(priority), contact_info(contact) {}
+      priority(priority), contact_info(contact), demand(demand) {}
 
 // ConflictInfo 实现
 
@@ -64,73 +204,180 @@ ConflictInfo::ConflictInfo(const std:: string& resource, const TimeSlot& period)
 
 // ConflictDetector 实现
 
-ConflictDetector::ConflictDetector() : next_reservation_id(1), auto_resolve_enabled(false) {}
+// 静态常量定义
+const size_t ConflictDetector::DEFAULT_SUGGESTIONS = 3;
+const int ConflictDetector::MAX_SERIES_DAYS = 731;
+
+ConflictDetector::ConflictDetector()
+    : next_waitlist_ticket(1), next_waitlist_sequence(0), next_series_id(1), next_reservation_id(1),
+      generation(0), auto_resolve_enabled(false), operation_log(nullptr) {}
 
 ConflictDetector:: ~ConflictDetector() = default;
 
 bool ConflictDetector::initialize(const std::vector<std:: string>& resources) {
-    std::cout << "初始化冲突检测器..." << std::endl;
+    LOG_INFO("初始化冲突检测器...");
     
     for (const auto& resource : resources) {
         addResource(resource);
     }
     
-    std::cout << "冲突检测器初始化完成，管理 " << resources.size() << " 个资源" << std::endl;
+    LOG_INFO("冲突检测器初始化完成，管理 " << resources.size() << " 个资源");
     return true;
 }
 
-void ConflictDetector::addResource(const std::string& resource_name) {
+void ConflictDetector::addResource(const std::string& resource_name, int capacity) {
     available_resources.insert(resource_name);
     resource_trees[resource_name].reset(new SegmentTree(1440)); // 一天1440分钟
+    occupancy_trees[resource_name].reset(new SegmentTree(1440));
+    resource_capacity[resource_name] = std::max(1, capacity);
+    gap_index.addResource(resource_name);
+    generation++;
     
-    std::cout << "添加资源:  " << resource_name << std::endl;
+    if (capacity > 1) {
+        LOG_DEBUG("添加资源:  " << resource_name << " (容量 " << capacity << ")");
+    } else {
+        LOG_DEBUG("添加资源:  " << resource_name);
+    }
+}
+
+bool ConflictDetector::setResourceCapacity(const std::string& resource_name, int capacity) {
+    auto it = resource_trees.find(resource_name);
+    if (it == resource_trees.end() || capacity < 1) {
+        LOG_WARN("无法设置资源容量: " << resource_name);
+        return false;
+    }
+    
+    int peak = it->second->queryOccupancy(0, 1439);
+    if (peak > capacity) {
+        LOG_WARN("资源 " << resource_name << " 现有峰值占用 " << peak << "，不能把容量降到 " << capacity);
+        return false;
+    }
+    
+    resource_capacity[resource_name] = capacity;
+    refreshGapIndex(resource_name, 0, 1440);
+    generation++;
+    LOG_DEBUG("资源容量: " << resource_name << " = " << capacity);
+    return true;
+}
+
+int ConflictDetector::getResourceCapacity(const std::string& resource_name) const {
+    auto it = resource_capacity.find(resource_name);
+    return it != resource_capacity.end() ? it->second : 1;
 }
 
 void ConflictDetector:: removeResource(const std::string& resource_name) {
     available_resources.erase(resource_name);
     resource_trees. erase(resource_name);
+    occupancy_trees.erase(resource_name);
+    resource_capacity.erase(resource_name);
+    gap_index.removeResource(resource_name);
+    resource_groups.erase(resource_name);
+    generation++;
+    
+    // 资源移除后其候补请求一并作废
+    for (auto it = waitlist_tickets.begin(); it != waitlist_tickets.end();) {
+        it = it->second.first == resource_name ? waitlist_tickets.erase(it) : std::next(it);
+    }
+    waitlists.erase(resource_name);
     
-    std::cout << "移除资源: " << resource_name << std::endl;
+    auto index_it = series_by_resource.find(resource_name);
+    if (index_it != series_by_resource.end()) {
+        for (const auto& entry : index_it->second) {
+            series.erase(entry.second);
+        }
+        series_by_resource.erase(index_it);
+    }
+    
+    LOG_DEBUG("移除资源: " << resource_name);
+}
+
+void ConflictDetector::setResourceGroup(const std::string& resource_name, const std::string& group) {
+    if (group.empty()) {
+        resource_groups.erase(resource_name);
+    } else {
+        resource_groups[resource_name] = group;
+    }
+}
+
+std::vector<std::string> ConflictDetector::getEquivalentResources(const std::string& resource_name) const {
+    std::vector<std::string> equivalent;
+    auto it = resource_groups.find(resource_name);
+    if (it == resource_groups.end()) return equivalent;
+    
+    for (const auto& entry : resource_groups) {
+        if (entry.second == it->second && entry.first != resource_name &&
+            available_resources.count(entry.first)) {
+            equivalent.push_back(entry.first);
+        }
+    }
+    return equivalent;
 }
 
 std::vector<std::string> ConflictDetector::getAvailableResources() const {
     return std::vector<std:: string>(available_resources.begin(), available_resources.end());
 }
 
+uint64_t ConflictDetector::getGeneration() const {
+    return generation.load();
+}
+
 // 预约管理
 
 int ConflictDetector::addReservation(const std::string& resource, const std::string& activity,
                                     const std::string& start_time, const std::string& end_time,
-                                    int priority, const std::string& contact) {
+                                    int priority, const std::string& contact, int demand) {
     
     TimeSlot slot(start_time, end_time);
-    Reservation reservation(next_reservation_id++, resource, activity, slot, priority, contact);
+    Reservation reservation(next_reservation_id++, resource, activity, slot, priority, contact, demand);
     
     return addReservation(reservation);
 }
 
 int ConflictDetector::addReservation(const Reservation& reservation) {
+    // 自动解决冲突时取消的预约与本次新增合并为一个撤销单元
+    OperationLog::Group group(operation_log);
+    
     // 检查资源是否存在
     if (available_resources.find(reservation.resource_name) == available_resources.end()) {
-        std::cerr << "资源不存在: " << reservation.resource_name << std::endl;
+        LOG_WARN("资源不存在: " << reservation.resource_name);
+        return -1;
+    }
+    
+    int capacity = getResourceCapacity(reservation.resource_name);
+    if (reservation.demand < 1 || reservation.demand > capacity) {
+        LOG_WARN("需求量 " << reservation.demand << " 超出资源容量: " << reservation.resource_name
+                 << " (容量 " << capacity << ")");
         return -1;
     }
     
-    // 检查冲突
-    if (hasConflict(reservation.resource_name, reservation.time_slot)) {
+    // 重复预约不参与按优先级自动解决，与其中任何一次冲突即拒绝
+    auto series_conflicts = seriesConflictsFor(reservation);
+    if (!series_conflicts.empty()) {
+        LOG_WARN("与重复预约冲突 - " << reservation.resource_name << " 在 "
+                 << reservation.time_slot.toString());
+        for (const auto& conflict : series_conflicts) {
+            LOG_WARN("  与活动冲突: " << conflict.reservation.activity_name << " ("
+                     << conflict.reservation.time_slot.toString() << ") [系列ID: " << conflict.series_id << "]");
+        }
+        return -1;
+    }
+    
+    // 检查冲突（容量是否足够；系列已在上面按日期核对）
+    if (exceedsCapacity(reservation.resource_name, reservation.time_slot, reservation.demand)) {
         if (auto_resolve_enabled) {
-            std::cout << "检测到冲突，尝试自动解决..." << std:: endl;
-            if (! resolveConflictByPriority(reservation. resource_name, reservation.time_slot)) {
-                std:: cerr << "无法自动解决冲突" << std::endl;
+            LOG_DEBUG("检测到冲突，尝试自动解决...");
+            if (! resolveConflictByPriority(reservation. resource_name, reservation.time_slot, reservation.priority,
+                                            reservation.demand)) {
+                LOG_WARN("无法自动解决冲突");
                 return -1;
             }
         } else {
             auto conflicts = findConflictingReservations(reservation.resource_name, reservation. time_slot);
-            std::cerr << "资源冲突 - " << reservation.resource_name << " 在 " 
-                     << reservation.time_slot. toString() << std::endl;
+            LOG_WARN("资源冲突 - " << reservation.resource_name << " 在 " 
+                     << reservation.time_slot. toString());
             for (const auto& conflict : conflicts) {
-                std::cerr << "  与活动冲突: " << conflict.activity_name 
-                         << " (" << conflict.time_slot.toString() << ")" << std::endl;
+                LOG_WARN("  与活动冲突: " << conflict.activity_name 
+                         << " (" << conflict.time_slot.toString() << ")");
             }
             return -1;
         }
@@ -140,63 +387,872 @@ int ConflictDetector::addReservation(const Reservation& reservation) {
     int reservation_id = reservation.id;
     reservations[reservation_id] = reservation;
     updateResourceTree(reservation.resource_name, reservation, true);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_RESERVATION_ADD, reservation_id, {}, reservationFields(reservation)));
+    }
     
-    std::cout << "预约成功:  " << reservation. activity_name << " @ " << reservation.resource_name
-             << " (" << reservation.time_slot.toString() << ") [ID: " << reservation_id << "]" << std::endl;
+    LOG_DEBUG("预约成功:  " << reservation. activity_name << " @ " << reservation.resource_name
+              << " (" << reservation.time_slot.toString() << ") [ID: " << reservation_id << "]");
     
     return reservation_id;
 }
 
-bool ConflictDetector:: removeReservation(int reservation_id) {
+bool ConflictDetector::removeReservation(int reservation_id) {
+    // 取消与因此补位的候补预约作为一个撤销单元
+    OperationLog::Group group(operation_log);
+    auto it = reservations.find(reservation_id);
+    std::string resource = it != reservations.end() ? it->second.resource_name : "";
+    if (!eraseReservation(reservation_id)) {
+        return false;
+    }
+    promoteWaitlist(resource);
+    return true;
+}
+
+bool ConflictDetector::eraseReservation(int reservation_id) {
     auto it = reservations.find(reservation_id);
     if (it == reservations.end()) {
-        std:: cerr << "预约不存在: ID=" << reservation_id << std::endl;
+        LOG_WARN("预约不存在: ID=" << reservation_id);
         return false;
     }
     
-    const Reservation& reservation = it->second;
+    Reservation reservation = it->second;  // 复制：erase 之后还要输出
     updateResourceTree(reservation. resource_name, reservation, false);
     reservations.erase(it);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_RESERVATION_REMOVE, reservation_id, reservationFields(reservation), {}));
+    }
     
-    std::cout << "预约已取消: " << reservation. activity_name << " [ID: " << reservation_id << "]" << std::endl;
+    LOG_DEBUG("预约已取消: " << reservation. activity_name << " [ID: " << reservation_id << "]");
     return true;
 }
 
 bool ConflictDetector::updateReservation(int reservation_id, const Reservation& new_reservation) {
-    if (removeReservation(reservation_id)) {
-        Reservation updated_reservation = new_reservation;
-        updated_reservation.id = reservation_id;
-        return addReservation(updated_reservation) != -1;
+    // 取消 + 重新预约作为一个撤销单元
+    OperationLog::Group group(operation_log);
+    auto it = reservations.find(reservation_id);
+    if (it == reservations.end()) {
+        LOG_WARN("预约不存在: ID=" << reservation_id);
+        return false;
     }
-    return false;
+    
+    // 原时段要等新预约落定后才能让给候补请求
+    std::string old_resource = it->second.resource_name;
+    eraseReservation(reservation_id);
+    Reservation updated_reservation = new_reservation;
+    updated_reservation.id = reservation_id;
+    bool updated = addReservation(updated_reservation) != -1;
+    promoteWaitlist(old_resource);
+    return updated;
+}
+
+BundleResult ConflictDetector::reserveAll(const std::vector<Reservation>& bundle) {
+    static Histogram& latency = indexOperationLatency("reserve_bundle");
+    ScopedTimer timer(latency);
+    BundleResult result;
+    
+    // 先确认涉及的资源都存在，再动线段树
+    for (size_t i = 0; i < bundle.size(); i++) {
+        if (!available_resources.count(bundle[i].resource_name)) {
+            LOG_WARN("资源不存在: " << bundle[i].resource_name);
+            result.failed_index = static_cast<int>(i);
+            return result;
+        }
+    }
+    
+    // 逐项先占用线段树（同批中相互重叠的请求也会被检查到），任何一项放不下就全部撤回
+    std::vector<Reservation> staged;
+    for (size_t i = 0; i < bundle.size(); i++) {
+        const Reservation& reservation = bundle[i];
+        bool fits = reservation.demand >= 1 &&
+                    reservation.demand <= getResourceCapacity(reservation.resource_name) &&
+                    reservation.time_slot.end_minutes > reservation.time_slot.start_minutes &&
+                    !exceedsCapacity(reservation.resource_name, reservation.time_slot, reservation.demand);
+        if (fits && !seriesConflictsFor(reservation, staged).empty()) {
+            fits = false;
+        }
+        if (!fits) {
+            result.failed_index = static_cast<int>(i);
+            result.conflicts = findConflictingReservations(reservation.resource_name, reservation.time_slot);
+            for (auto it = staged.rbegin(); it != staged.rend(); ++it) {
+                updateResourceTree(it->resource_name, *it, false);
+            }
+            LOG_WARN("多资源预约失败: 第 " << (i + 1) << " 项 " << reservation.resource_name << " ("
+                     << reservation.time_slot.toString() << ") 无法容纳，全部未生效");
+            return result;
+        }
+        updateResourceTree(reservation.resource_name, reservation, true);
+        staged.push_back(reservation);
+    }
+    
+    // 全部可容纳：分配编号并写入预约表，作为一个撤销单元记录
+    OperationLog::Group group(operation_log);
+    for (auto& reservation : staged) {
+        reservation.id = next_reservation_id++;
+        reservations[reservation.id] = reservation;
+        if (operation_log) {
+            operation_log->record(OperationRecord(OP_RESERVATION_ADD, reservation.id, {}, reservationFields(reservation)));
+        }
+        result.reservation_ids.push_back(reservation.id);
+    }
+    generation++;
+    result.success = true;
+    
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        LogLine line(LOG_LEVEL_DEBUG, __FILE__);
+        line << "多资源预约成功: " << staged.size() << " 项 [ID:";
+        for (int id : result.reservation_ids) line << ' ' << id;
+        line << ']';
+        line.commit();
+    }
+    return result;
+}
+
+std::vector<AdmissionResult> ConflictDetector::admitReservations(const std::vector<Reservation>& requests,
+                                                                 bool waitlist_rejected) {
+    // 整批作为一个撤销单元
+    OperationLog::Group group(operation_log);
+    std::vector<AdmissionResult> results(requests.size());
+    
+    PriorityQueue<size_t, AdmissionOrder> order(AdmissionOrder{&requests});
+    order.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        order.push(i);
+    }
+    
+    while (!order.isEmpty()) {
+        size_t index = order.pop();
+        Reservation reservation = requests[index];
+        bool assign_id = reservation.id <= 0;
+        if (assign_id) {
+            reservation.id = next_reservation_id;  // 只有准入成功才占用编号
+        }
+        results[index].reservation_id = addReservation(reservation);
+        if (assign_id && results[index].reservation_id != -1) {
+            next_reservation_id++;
+        }
+        if (results[index].reservation_id == -1 && waitlist_rejected) {
+            results[index].waitlist_ticket = addToWaitlist(requests[index]);
+        }
+    }
+    return results;
+}
+
+// 候补队列
+
+int ConflictDetector::addToWaitlist(const Reservation& reservation) {
+    if (available_resources.find(reservation.resource_name) == available_resources.end()) {
+        LOG_WARN("资源不存在: " << reservation.resource_name);
+        return -1;
+    }
+    
+    WaitlistEntry entry;
+    entry.ticket = next_waitlist_ticket++;
+    entry.sequence = next_waitlist_sequence++;
+    entry.reservation = reservation;
+    int ticket = enqueueWaitlist(std::move(entry));
+    
+    LOG_DEBUG("已加入候补: " << reservation.activity_name << " @ " << reservation.resource_name
+              << " (" << reservation.time_slot.toString() << ") [候补号: " << ticket << "]");
+    return ticket;
+}
+
+bool ConflictDetector::cancelWaitlist(int ticket) {
+    auto it = waitlist_tickets.find(ticket);
+    if (it == waitlist_tickets.end()) return false;
+    
+    waitlists[it->second.first].erase(it->second.second);
+    waitlist_tickets.erase(it);
+    return true;
+}
+
+bool ConflictDetector::updateWaitlistPriority(int ticket, int priority) {
+    auto it = waitlist_tickets.find(ticket);
+    if (it == waitlist_tickets.end()) return false;
+    
+    Waitlist& waitlist = waitlists[it->second.first];
+    WaitlistEntry entry = waitlist.get(it->second.second);
+    entry.reservation.priority = priority;
+    waitlist.update(it->second.second, std::move(entry));
+    return true;
+}
+
+int ConflictDetector::promoteWaitlist(const std::string& resource) {
+    auto waitlist_it = waitlists.find(resource);
+    if (waitlist_it == waitlists.end() || waitlist_it->second.isEmpty()) return 0;
+    
+    // 按出队顺序逐个尝试，放不下的保留原入队顺序重新入队
+    std::vector<WaitlistEntry> pending;
+    while (!waitlist_it->second.isEmpty()) {
+        pending.push_back(waitlist_it->second.pop());
+    }
+    
+    int promoted = 0;
+    for (auto& entry : pending) {
+        waitlist_tickets.erase(entry.ticket);
+        if (!hasConflict(resource, entry.reservation.time_slot, entry.reservation.demand)) {
+            Reservation reservation = entry.reservation;
+            reservation.id = next_reservation_id;
+            if (addReservation(reservation) != -1) {
+                next_reservation_id++;
+                LOG_DEBUG("候补补位成功 [候补号: " << entry.ticket << "]");
+                promoted++;
+                continue;
+            }
+        }
+        enqueueWaitlist(std::move(entry));
+    }
+    return promoted;
+}
+
+std::vector<WaitlistEntry> ConflictDetector::getWaitlist(const std::string& resource) const {
+    std::vector<WaitlistEntry> entries;
+    auto it = waitlists.find(resource);
+    if (it == waitlists.end()) return entries;
+    
+    Waitlist ordered = it->second;
+    while (!ordered.isEmpty()) {
+        entries.push_back(ordered.pop());
+    }
+    return entries;
+}
+
+int ConflictDetector::getWaitlistSize() const {
+    return waitlist_tickets.size();
+}
+
+int ConflictDetector::enqueueWaitlist(WaitlistEntry entry) {
+    int ticket = entry.ticket;
+    std::string resource = entry.reservation.resource_name;
+    Waitlist::Handle handle = waitlists[resource].push(std::move(entry));
+    waitlist_tickets[ticket] = std::make_pair(resource, handle);
+    return ticket;
+}
+
+// 重复预约
+
+int ConflictDetector::addRecurringReservation(const std::string& resource, const std::string& activity,
+                                              const std::string& start_time, const std::string& end_time,
+                                              const RecurrenceRule& rule, int priority, const std::string& contact,
+                                              int demand) {
+    TimeSlot slot(start_time, end_time);
+    RecurringSeries recurring;
+    recurring.id = next_series_id++;
+    recurring.resource_name = resource;
+    recurring.activity_name = activity;
+    recurring.time_slot = TimeSlot::fromMinutes(slot.start_minutes, slot.end_minutes);  // 只保留时刻
+    recurring.priority = priority;
+    recurring.contact_info = contact;
+    recurring.demand = demand;
+    recurring.rule = rule;
+    
+    return addRecurringReservation(recurring);
+}
+
+int ConflictDetector::addRecurringReservation(const RecurringSeries& recurring) {
+    if (available_resources.find(recurring.resource_name) == available_resources.end()) {
+        LOG_WARN("资源不存在: " << recurring.resource_name);
+        return -1;
+    }
+    if (series.count(recurring.id)) {
+        LOG_WARN("重复预约系列已存在: ID=" << recurring.id);
+        return -1;
+    }
+    if (recurring.time_slot.end_minutes <= recurring.time_slot.start_minutes) {
+        LOG_WARN("无效的时间段: " << recurring.time_slot.toString());
+        return -1;
+    }
+    if (recurring.demand < 1 || recurring.demand > getResourceCapacity(recurring.resource_name)) {
+        LOG_WARN("需求量 " << recurring.demand << " 超出资源容量: " << recurring.resource_name);
+        return -1;
+    }
+    
+    size_t occurrence_count = recurring.rule.occurrenceCount();
+    if (occurrence_count == 0 || recurring.rule.lastDay() - recurring.rule.firstDay() >= MAX_SERIES_DAYS) {
+        LOG_WARN("重复规则没有任何发生日期或跨度超过 " << MAX_SERIES_DAYS << " 天");
+        return -1;
+    }
+    
+    auto conflicts = findSeriesConflicts(recurring);
+    if (!conflicts.empty()) {
+        LOG_WARN("重复预约冲突 - " << recurring.resource_name << " 在 " << recurring.time_slot.toString()
+                 << "，共 " << conflicts.size() << " 处");
+        for (const auto& conflict : conflicts) {
+            LOG_WARN("  " << (conflict.date.empty() ? "每天" : conflict.date) << " 与活动冲突: "
+                     << conflict.reservation.activity_name << " (" << conflict.reservation.time_slot.toString() << ")");
+        }
+        return -1;
+    }
+    
+    series[recurring.id] = recurring;
+    indexSeries(recurring);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_SERIES_ADD, recurring.id, {}, seriesFields(recurring)));
+    }
+    
+    LOG_DEBUG("重复预约成功: " << recurring.activity_name << " @ " << recurring.resource_name
+              << " (" << recurring.time_slot.toString() << ", 共 " << occurrence_count << " 次) [系列ID: "
+              << recurring.id << "]");
+    return recurring.id;
+}
+
+bool ConflictDetector::removeRecurringReservation(int series_id) {
+    // 取消与因此补位的候补预约作为一个撤销单元
+    OperationLog::Group group(operation_log);
+    auto it = series.find(series_id);
+    std::string resource = it != series.end() ? it->second.resource_name : "";
+    if (!eraseSeries(series_id)) {
+        return false;
+    }
+    promoteWaitlist(resource);
+    return true;
+}
+
+bool ConflictDetector::addSeriesException(int series_id, const std::string& date) {
+    OperationLog::Group group(operation_log);
+    auto it = series.find(series_id);
+    if (it == series.end()) {
+        LOG_WARN("重复预约系列不存在: ID=" << series_id);
+        return false;
+    }
+    
+    int day = 0;
+    if (!parseDate(date, day) || !it->second.rule.occursOn(day)) {
+        LOG_WARN("系列在该日期没有预约: " << date);
+        return false;
+    }
+    
+    std::vector<std::string> before = seriesFields(it->second);
+    it->second.rule.addException(day);
+    generation++;
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_SERIES_UPDATE, series_id, before, seriesFields(it->second)));
+    }
+    
+    LOG_DEBUG("已取消重复预约中的一次: " << it->second.activity_name << " " << formatDate(day)
+              << " [系列ID: " << series_id << "]");
+    promoteWaitlist(it->second.resource_name);
+    return true;
+}
+
+std::vector<SeriesOccurrence> ConflictDetector::findSeriesConflicts(const RecurringSeries& recurring) const {
+    std::vector<SeriesOccurrence> conflicts;
+    const RecurrenceRule& rule = recurring.rule;
+    const TimeSlot& slot = recurring.time_slot;
+    int capacity = getResourceCapacity(recurring.resource_name);
+    
+    // 各次发生的时刻相同，单次预约先在线段树上查一次；时段内没有任何占用时不必逐个核对日期
+    std::vector<Reservation> undated;
+    std::map<int, std::vector<Reservation>> dated;    // 日期 -> 当天时段重叠的单次预约
+    if (getPeakOccupancy(recurring.resource_name, slot) > 0) {
+        for (const auto& reservation : findConflictingReservations(recurring.resource_name, slot)) {
+            int day = 0;
+            if (reservationDay(reservation, day)) {
+                dated[day].push_back(reservation);
+            } else {
+                undated.push_back(reservation);
+            }
+        }
+    }
+    
+    // 时刻重叠的其它系列
+    std::vector<const RecurringSeries*> overlapping;
+    auto index_it = series_by_resource.find(recurring.resource_name);
+    if (index_it != series_by_resource.end()) {
+        for (auto it = index_it->second.begin();
+             it != index_it->second.end() && it->first < slot.end_minutes; ++it) {
+            const RecurringSeries& other = series.at(it->second);
+            if (other.id != recurring.id && other.time_slot.overlaps(slot)) {
+                overlapping.push_back(&other);
+            }
+        }
+    }
+    if (undated.empty() && dated.empty() && overlapping.empty()) return conflicts;
+    
+    // 沿本系列的发生日期汇总当天的占用，峰值加上本系列需求超过容量即冲突
+    bool undated_reported = false;
+    rule.forEachOccurrence(rule.firstDay(), rule.lastDay(), [&](int day) {
+        std::vector<Load> loads;
+        std::vector<SeriesOccurrence> present;
+        for (const auto& reservation : undated) {
+            loads.push_back(loadOf(reservation));
+            if (!undated_reported) present.push_back({0, "", reservation});
+        }
+        auto dated_it = dated.find(day);
+        if (dated_it != dated.end()) {
+            for (const auto& reservation : dated_it->second) {
+                loads.push_back(loadOf(reservation));
+                present.push_back({0, formatDate(day), reservation});
+            }
+        }
+        for (const RecurringSeries* other : overlapping) {
+            if (!other->rule.occursOn(day)) continue;
+            SeriesOccurrence occurrence = makeOccurrence(*other, day);
+            loads.push_back(loadOf(occurrence.reservation));
+            present.push_back(std::move(occurrence));
+        }
+        
+        if (!loads.empty() && peakLoad(loads, slot.start_minutes, slot.end_minutes) + recurring.demand > capacity) {
+            undated_reported = undated_reported || !undated.empty();
+            conflicts.insert(conflicts.end(), present.begin(), present.end());
+        }
+        return true;
+    });
+    return conflicts;
+}
+
+std::vector<SeriesOccurrence> ConflictDetector::getOccurrences(const std::string& from_date,
+                                                               const std::string& to_date,
+                                                               const std::string& resource) const {
+    std::vector<SeriesOccurrence> occurrences;
+    int from_day = 0, to_day = 0;
+    if (!parseDate(from_date, from_day) || !parseDate(to_date, to_day)) {
+        LOG_WARN("无效的日期范围: " << from_date << " - " << to_date);
+        return occurrences;
+    }
+    
+    for (const auto& entry : series) {
+        const RecurringSeries& recurring = entry.second;
+        if (!resource.empty() && recurring.resource_name != resource) continue;
+        recurring.rule.forEachOccurrence(from_day, to_day, [&](int day) {
+            occurrences.push_back(makeOccurrence(recurring, day));
+            return true;
+        });
+    }
+    for (const auto& entry : reservations) {
+        const Reservation& reservation = entry.second;
+        int day = 0;
+        if ((!resource.empty() && reservation.resource_name != resource) ||
+            !reservationDay(reservation, day) || day < from_day || day > to_day) {
+            continue;
+        }
+        occurrences.push_back({0, formatDate(day), reservation});
+    }
+    
+    std::sort(occurrences.begin(), occurrences.end(), [](const SeriesOccurrence& a, const SeriesOccurrence& b) {
+        if (a.date != b.date) return a.date < b.date;
+        if (a.reservation.time_slot.start_minutes != b.reservation.time_slot.start_minutes) {
+            return a.reservation.time_slot.start_minutes < b.reservation.time_slot.start_minutes;
+        }
+        return a.reservation.resource_name < b.reservation.resource_name;
+    });
+    return occurrences;
+}
+
+std::vector<RecurringSeries> ConflictDetector::getAllSeries() const {
+    std::vector<RecurringSeries> all_series;
+    for (const auto& entry : series) {
+        all_series.push_back(entry.second);
+    }
+    return all_series;
+}
+
+std::vector<SeriesOccurrence> ConflictDetector::seriesConflictsFor(const Reservation& reservation,
+                                                                   const std::vector<Reservation>& pending) const {
+    std::vector<SeriesOccurrence> conflicts;
+    auto index_it = series_by_resource.find(reservation.resource_name);
+    if (index_it == series_by_resource.end()) return conflicts;
+    
+    std::vector<const RecurringSeries*> overlapping;
+    for (auto it = index_it->second.begin();
+         it != index_it->second.end() && it->first < reservation.time_slot.end_minutes; ++it) {
+        const RecurringSeries& recurring = series.at(it->second);
+        if (recurring.time_slot.overlaps(reservation.time_slot)) {
+            overlapping.push_back(&recurring);
+        }
+    }
+    if (overlapping.empty()) return conflicts;
+    
+    // 单次预约之间不区分日期（时间线只有一天），当天的系列发生叠加在其上
+    std::vector<Load> base;
+    for (const auto& other : findConflictingReservations(reservation.resource_name, reservation.time_slot)) {
+        base.push_back(loadOf(other));
+    }
+    for (const auto& other : pending) {
+        if (other.resource_name == reservation.resource_name && other.time_slot.overlaps(reservation.time_slot)) {
+            base.push_back(loadOf(other));
+        }
+    }
+    int capacity = getResourceCapacity(reservation.resource_name);
+    auto conflictsOn = [&](int day) {
+        std::vector<Load> loads = base;
+        std::vector<SeriesOccurrence> present;
+        for (const RecurringSeries* recurring : overlapping) {
+            if (!recurring->rule.occursOn(day)) continue;
+            present.push_back(makeOccurrence(*recurring, day));
+            loads.push_back(loadOf(present.back().reservation));
+        }
+        if (!present.empty() && peakLoad(loads, reservation.time_slot.start_minutes,
+                                         reservation.time_slot.end_minutes) + reservation.demand > capacity) {
+            conflicts = std::move(present);
+            return true;
+        }
+        return false;
+    };
+    
+    int day = 0;
+    if (reservationDay(reservation, day)) {
+        conflictsOn(day);
+        return conflicts;
+    }
+    
+    // 不带日期的预约每天都占用：检查重叠系列发生的每一天，报告第一个放不下的日期
+    std::set<int> days;
+    for (const RecurringSeries* recurring : overlapping) {
+        recurring->rule.forEachOccurrence(recurring->rule.firstDay(), recurring->rule.lastDay(), [&](int d) {
+            days.insert(d);
+            return true;
+        });
+    }
+    for (int d : days) {
+        if (conflictsOn(d)) break;
+    }
+    return conflicts;
+}
+
+bool ConflictDetector::eraseSeries(int series_id) {
+    auto it = series.find(series_id);
+    if (it == series.end()) {
+        LOG_WARN("重复预约系列不存在: ID=" << series_id);
+        return false;
+    }
+    
+    RecurringSeries recurring = it->second;  // 复制：erase 之后还要输出
+    auto& index = series_by_resource[recurring.resource_name];
+    auto range = index.equal_range(recurring.time_slot.start_minutes);
+    for (auto index_it = range.first; index_it != range.second; ++index_it) {
+        if (index_it->second == series_id) {
+            index.erase(index_it);
+            break;
+        }
+    }
+    series.erase(it);
+    updateSeriesOccupancy(recurring, false);
+    generation++;
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_SERIES_REMOVE, series_id, seriesFields(recurring), {}));
+    }
+    
+    LOG_DEBUG("重复预约已取消: " << recurring.activity_name << " [系列ID: " << series_id << "]");
+    return true;
+}
+
+void ConflictDetector::indexSeries(const RecurringSeries& recurring) {
+    series_by_resource[recurring.resource_name].emplace(recurring.time_slot.start_minutes, recurring.id);
+    updateSeriesOccupancy(recurring, true);
+    generation++;
 }
 
 // 冲突检测
 
-bool ConflictDetector::hasConflict(const std::string& resource, const TimeSlot& time_slot) const {
-    auto conflicts = findConflictingReservations(resource, time_slot);
-    return !conflicts.empty();
+void ConflictDetector::setOperationLog(OperationLog* log) {
+    operation_log = log;
+}
+
+bool ConflictDetector::replayOperation(const OperationRecord& record, bool inverse) {
+    // 撤销/重做只恢复记录中的状态，不触发候补补位
+    Reservation reservation;
+    RecurringSeries recurring;
+    switch (record.type) {
+        case OP_RESERVATION_ADD:
+            if (inverse) return eraseReservation(record.target_id);
+            return reservationFromFields(record.target_id, record.after, reservation) &&
+                   addReservation(reservation) != -1;
+        case OP_RESERVATION_REMOVE:
+            if (!inverse) return eraseReservation(record.target_id);
+            return reservationFromFields(record.target_id, record.before, reservation) &&
+                   addReservation(reservation) != -1;
+        case OP_SERIES_ADD:
+            if (inverse) return eraseSeries(record.target_id);
+            return seriesFromFields(record.target_id, record.after, recurring) &&
+                   addRecurringReservation(recurring) != -1;
+        case OP_SERIES_REMOVE:
+            if (!inverse) return eraseSeries(record.target_id);
+            return seriesFromFields(record.target_id, record.before, recurring) &&
+                   addRecurringReservation(recurring) != -1;
+        case OP_SERIES_UPDATE: {
+            auto it = series.find(record.target_id);
+            if (it == series.end() ||
+                !seriesFromFields(record.target_id, inverse ? record.before : record.after, recurring)) {
+                return false;
+            }
+            it->second.rule = recurring.rule;    // 只有例外日期会变
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void ConflictDetector::writeSnapshot(IndexSnapshotWriter& writer) const {
+    SnapshotBuffer buffer;
+    buffer.append(static_cast<int32_t>(next_reservation_id));
+    buffer.append(static_cast<uint32_t>(available_resources.size()));
+    for (const auto& resource : available_resources) {
+        buffer.appendString(resource);
+    }
+    
+    buffer.append(static_cast<uint32_t>(reservations.size()));
+    for (const auto& entry : reservations) {
+        const Reservation& reservation = entry.second;
+        buffer.append(static_cast<int32_t>(reservation.id));
+        buffer.appendString(reservation.resource_name);
+        buffer.appendString(reservation.activity_name);
+        buffer.appendString(reservation.time_slot.start_time);
+        buffer.appendString(reservation.time_slot.end_time);
+        buffer.append(static_cast<int32_t>(reservation.priority));
+        buffer.appendString(reservation.contact_info);
+    }
+    
+    // 候补队列（旧快照没有这一段）
+    buffer.append(static_cast<int32_t>(next_waitlist_ticket));
+    buffer.append(static_cast<uint32_t>(waitlist_tickets.size()));
+    for (const auto& entry : waitlist_tickets) {
+        const WaitlistEntry& waiting = waitlists.at(entry.second.first).get(entry.second.second);
+        const Reservation& reservation = waiting.reservation;
+        buffer.append(static_cast<int32_t>(waiting.ticket));
+        buffer.append(waiting.sequence);
+        buffer.appendString(reservation.resource_name);
+        buffer.appendString(reservation.activity_name);
+        buffer.appendString(reservation.time_slot.start_time);
+        buffer.appendString(reservation.time_slot.end_time);
+        buffer.append(static_cast<int32_t>(reservation.priority));
+        buffer.appendString(reservation.contact_info);
+    }
+    
+    // 重复预约系列（旧快照没有这一段）
+    buffer.append(static_cast<int32_t>(next_series_id));
+    buffer.append(static_cast<uint32_t>(series.size()));
+    for (const auto& entry : series) {
+        const RecurringSeries& recurring = entry.second;
+        buffer.append(static_cast<int32_t>(recurring.id));
+        std::vector<std::string> fields = seriesFields(recurring);
+        fields.pop_back();    // 需求量写在下面的容量段
+        for (const auto& field : fields) {
+            buffer.appendString(field);
+        }
+    }
+    
+    // 资源容量与需求量（旧快照没有这一段），只记录不为1的值
+    std::vector<std::pair<std::string, int>> capacities;
+    for (const auto& entry : resource_capacity) {
+        if (entry.second != 1) capacities.emplace_back(entry.first, entry.second);
+    }
+    buffer.append(static_cast<uint32_t>(capacities.size()));
+    for (const auto& entry : capacities) {
+        buffer.appendString(entry.first);
+        buffer.append(static_cast<int32_t>(entry.second));
+    }
+    std::vector<std::pair<int, int>> reservation_demands, waitlist_demands, series_demands;
+    for (const auto& entry : reservations) {
+        if (entry.second.demand != 1) reservation_demands.emplace_back(entry.first, entry.second.demand);
+    }
+    for (const auto& entry : waitlist_tickets) {
+        int demand = waitlists.at(entry.second.first).get(entry.second.second).reservation.demand;
+        if (demand != 1) waitlist_demands.emplace_back(entry.first, demand);
+    }
+    for (const auto& entry : series) {
+        if (entry.second.demand != 1) series_demands.emplace_back(entry.first, entry.second.demand);
+    }
+    appendDemands(buffer, reservation_demands);
+    appendDemands(buffer, waitlist_demands);
+    appendDemands(buffer, series_demands);
+    writer.addSection(SECTION_RESERVATIONS, std::move(buffer));
+}
+
+bool ConflictDetector::restoreSnapshot(const IndexSnapshotFile& snapshot) {
+    SnapshotView view;
+    if (!snapshot.section(SECTION_RESERVATIONS, view)) return false;
+    
+    size_t offset = 0;
+    int32_t next_id = 0;
+    uint32_t resource_count = 0;
+    if (!view.read(offset, next_id) || !view.read(offset, resource_count)) return false;
+    
+    std::set<std::string> resources;
+    for (uint32_t i = 0; i < resource_count; i++) {
+        std::string resource;
+        if (!view.readString(offset, resource)) return false;
+        resources.insert(resource);
+    }
+    
+    uint32_t reservation_count = 0;
+    if (!view.read(offset, reservation_count)) return false;
+    
+    std::vector<Reservation> restored;
+    for (uint32_t i = 0; i < reservation_count; i++) {
+        int32_t id = 0;
+        int32_t priority = 0;
+        std::string resource, activity, start_time, end_time, contact;
+        if (!view.read(offset, id) || !view.readString(offset, resource) ||
+            !view.readString(offset, activity) || !view.readString(offset, start_time) ||
+            !view.readString(offset, end_time) || !view.read(offset, priority) ||
+            !view.readString(offset, contact)) {
+            return false;
+        }
+        restored.emplace_back(id, resource, activity, TimeSlot(start_time, end_time), priority, contact);
+    }
+    
+    int32_t next_ticket = 1;
+    std::vector<WaitlistEntry> waiting;
+    if (offset < view.size()) {
+        uint32_t waiting_count = 0;
+        if (!view.read(offset, next_ticket) || !view.read(offset, waiting_count)) return false;
+        for (uint32_t i = 0; i < waiting_count; i++) {
+            WaitlistEntry entry;
+            int32_t ticket = 0;
+            int32_t priority = 0;
+            std::string resource, activity, start_time, end_time, contact;
+            if (!view.read(offset, ticket) || !view.read(offset, entry.sequence) ||
+                !view.readString(offset, resource) || !view.readString(offset, activity) ||
+                !view.readString(offset, start_time) || !view.readString(offset, end_time) ||
+                !view.read(offset, priority) || !view.readString(offset, contact)) {
+                return false;
+            }
+            entry.ticket = ticket;
+            entry.reservation = Reservation(0, resource, activity, TimeSlot(start_time, end_time), priority, contact);
+            waiting.push_back(std::move(entry));
+        }
+    }
+    
+    int32_t next_series = 1;
+    std::vector<RecurringSeries> restored_series;
+    if (offset < view.size()) {
+        uint32_t series_count = 0;
+        if (!view.read(offset, next_series) || !view.read(offset, series_count)) return false;
+        for (uint32_t i = 0; i < series_count; i++) {
+            int32_t id = 0;
+            std::vector<std::string> fields(7);
+            if (!view.read(offset, id)) return false;
+            for (auto& field : fields) {
+                if (!view.readString(offset, field)) return false;
+            }
+            RecurringSeries recurring;
+            if (!seriesFromFields(id, fields, recurring)) return false;
+            restored_series.push_back(std::move(recurring));
+        }
+    }
+    
+    std::map<std::string, int> capacities;
+    std::map<int, int> reservation_demands, waitlist_demands, series_demands;
+    if (offset < view.size()) {
+        uint32_t capacity_count = 0;
+        if (!view.read(offset, capacity_count)) return false;
+        for (uint32_t i = 0; i < capacity_count; i++) {
+            std::string resource;
+            int32_t capacity = 0;
+            if (!view.readString(offset, resource) || !view.read(offset, capacity)) return false;
+            capacities[resource] = capacity;
+        }
+        if (!readDemands(view, offset, reservation_demands) || !readDemands(view, offset, waitlist_demands) ||
+            !readDemands(view, offset, series_demands)) {
+            return false;
+        }
+    }
+    for (auto& reservation : restored) {
+        auto it = reservation_demands.find(reservation.id);
+        if (it != reservation_demands.end()) reservation.demand = it->second;
+    }
+    for (auto& entry : waiting) {
+        auto it = waitlist_demands.find(entry.ticket);
+        if (it != waitlist_demands.end()) entry.reservation.demand = it->second;
+    }
+    for (auto& recurring : restored_series) {
+        auto it = series_demands.find(recurring.id);
+        if (it != series_demands.end()) recurring.demand = it->second;
+    }
+    
+    // 全部解码成功后再替换现有状态；线段树按预约重新累加
+    available_resources = resources;
+    resource_trees.clear();
+    occupancy_trees.clear();
+    resource_capacity.clear();
+    gap_index.clear();
+    for (const auto& resource : available_resources) {
+        resource_trees[resource].reset(new SegmentTree(1440)); // 一天1440分钟
+        occupancy_trees[resource].reset(new SegmentTree(1440));
+        auto capacity_it = capacities.find(resource);
+        resource_capacity[resource] = capacity_it != capacities.end() ? std::max(1, capacity_it->second) : 1;
+        gap_index.addResource(resource);
+    }
+    reservations.clear();
+    for (const auto& reservation : restored) {
+        reservations[reservation.id] = reservation;
+        updateResourceTree(reservation.resource_name, reservation, true);
+    }
+    next_reservation_id = next_id;
+    
+    waitlists.clear();
+    waitlist_tickets.clear();
+    next_waitlist_ticket = next_ticket;
+    next_waitlist_sequence = 0;
+    for (auto& entry : waiting) {
+        if (available_resources.count(entry.reservation.resource_name) == 0) continue;
+        next_waitlist_sequence = std::max(next_waitlist_sequence, entry.sequence + 1);
+        enqueueWaitlist(std::move(entry));
+    }
+    
+    series.clear();
+    series_by_resource.clear();
+    next_series_id = next_series;
+    for (const auto& recurring : restored_series) {
+        if (available_resources.count(recurring.resource_name) == 0) continue;
+        series[recurring.id] = recurring;
+        indexSeries(recurring);
+    }
+    
+    generation++;
+    LOG_INFO("预约已从快照恢复: " << available_resources.size() << " 个资源, "
+             << reservations.size() << " 个预约, " << waitlist_tickets.size() << " 个候补, "
+             << series.size() << " 个重复预约系列");
+    return true;
+}
+
+bool ConflictDetector::hasConflict(const std::string& resource, const TimeSlot& time_slot, int demand) const {
+    static Histogram& latency = indexOperationLatency("conflict_check");
+    ScopedTimer timer(latency);
+    if (resource_trees.find(resource) == resource_trees.end()) return false;
+    if (exceedsCapacity(resource, time_slot, demand)) return true;
+    
+    Reservation probe(0, resource, "", time_slot, 5, "", demand);
+    return !seriesConflictsFor(probe).empty();
+}
+
+bool ConflictDetector::exceedsCapacity(const std::string& resource, const TimeSlot& time_slot, int demand) const {
+    // 一次区间最大值查询：峰值占用加上本次需求超过容量即冲突
+    return getPeakOccupancy(resource, time_slot) + demand > getResourceCapacity(resource);
+}
+
+int ConflictDetector::getPeakOccupancy(const std::string& resource, const TimeSlot& time_slot) const {
+    auto it = resource_trees.find(resource);
+    if (it == resource_trees.end() || time_slot.end_minutes <= time_slot.start_minutes) return 0;
+    return it->second->queryOccupancy(time_slot.start_minutes, time_slot.end_minutes - 1);  // 树上是闭区间
 }
 
 std::vector<ConflictInfo> ConflictDetector::detectAllConflicts() const {
     std::vector<ConflictInfo> all_conflicts;
     
     for (const auto& resource : available_resources) {
-        auto resource_reservations = getReservationsByResource(resource);
+        auto tree_it = resource_trees.find(resource);
+        if (tree_it == resource_trees.end()) continue;
         
-        // 检查该资源的所有预约间是否有冲突
-        for (size_t i = 0; i < resource_reservations.size(); ++i) {
-            for (size_t j = i + 1; j < resource_reservations.size(); ++j) {
-                const auto& res1 = resource_reservations[i];
-                const auto& res2 = resource_reservations[j];
-                
-                if (res1.time_slot.overlaps(res2.time_slot)) {
-                    ConflictInfo conflict(resource, res1.time_slot);
-                    conflict.conflicting_reservations = {res1, res2};
-                    conflict.suggestion = "建议重新安排其中一个活动的时间或更换场地";
-                    all_conflicts.push_back(conflict);
+        // 多容量资源上的重叠是允许的：只有占用超过容量的时段才算冲突，每段报告一次
+        int capacity = getResourceCapacity(resource);
+        auto overloaded = tree_it->second->findRangesAtLeast(0, 1439, capacity + 1);
+        if (overloaded.empty()) continue;
+        
+        auto resource_reservations = getReservationsByResource(resource);
+        for (const auto& range : overloaded) {
+            ConflictInfo conflict(resource, TimeSlot::fromMinutes(range.first, range.second + 1));
+            for (const auto& reservation : resource_reservations) {
+                if (reservation.time_slot.overlaps(conflict.conflict_period)) {
+                    conflict.conflicting_reservations.push_back(reservation);
                 }
             }
+            conflict.suggestion = capacity > 1
+                ? "占用超过容量 " + std::to_string(capacity) + "，建议把部分活动调整到其他时间或场地"
+                : "建议重新安排其中一个活动的时间或更换场地";
+            all_conflicts.push_back(conflict);
         }
     }
     
@@ -205,6 +1261,8 @@ std::vector<ConflictInfo> ConflictDetector::detectAllConflicts() const {
 
 std::vector<Reservation> ConflictDetector::findConflictingReservations(const std:: string& resource, 
                                                                       const TimeSlot& time_slot) const {
+    static Histogram& latency = indexOperationLatency("conflict_find");
+    ScopedTimer timer(latency);
     std:: vector<Reservation> conflicts;
     
     auto resource_reservations = getReservationsByResource(resource);
@@ -228,7 +1286,7 @@ std:: vector<std::string> ConflictDetector::findAvailableResources(const TimeSlo
         }
     }
     
-    std::cout << "时间段 " << time_slot.toString() << " 可用资源: " << available.size() << " 个" << std::endl;
+    LOG_DEBUG("时间段 " << time_slot.toString() << " 可用资源: " << available.size() << " 个");
     return available;
 }
 
@@ -237,51 +1295,141 @@ std::vector<TimeSlot> ConflictDetector:: suggestAlternativeSlots(const std:: str
                                                               int duration_minutes) const {
     std:: vector<TimeSlot> suggestions;
     
-    // 简化实现：建议前后各1小时的时间段
-    int original_start = preferred_slot. start_minutes;
-    int original_duration = preferred_slot. end_minutes - preferred_slot.start_minutes;
-    
-    // 向前建议
-    int new_start = original_start - 60; // 提前1小时
-    if (new_start >= 0) {
-        TimeSlot earlier_slot(minutesToTimeString(new_start), 
-                             minutesToTimeString(new_start + original_duration));
-        if (!hasConflict(resource, earlier_slot)) {
-            suggestions.push_back(earlier_slot);
-        }
+    // 保持原时长；期望时段无效时使用 duration_minutes
+    TimeSlot preferred = preferred_slot;
+    if (preferred.end_minutes <= preferred.start_minutes) {
+        preferred = TimeSlot::fromMinutes(preferred.start_minutes, preferred.start_minutes + duration_minutes);
     }
-    
-    // 向后建议
-    new_start = original_start + 60; // 推迟1小时
-    if (new_start + original_duration <= 1440) {
-        TimeSlot later_slot(minutesToTimeString(new_start),
-                           minutesToTimeString(new_start + original_duration));
-        if (!hasConflict(resource, later_slot)) {
-            suggestions.push_back(later_slot);
-        }
+    for (const auto& suggestion : suggestSlots(resource, preferred)) {
+        suggestions.push_back(TimeSlot::fromMinutes(suggestion.start_minutes, suggestion.end_minutes));
     }
     
-    std::cout << "为资源 " << resource << " 建议 " << suggestions.size() << " 个替代时间段" << std::endl;
+    LOG_DEBUG("为资源 " << resource << " 建议 " << suggestions.size() << " 个替代时间段");
     return suggestions;
 }
 
+std::vector<SlotSuggestion> ConflictDetector::suggestSlots(const std::string& resource, const TimeSlot& preferred_slot,
+                                                           size_t limit, bool across_equivalent) const {
+    std::vector<std::string> candidates = {resource};
+    if (across_equivalent) {
+        auto equivalent = getEquivalentResources(resource);
+        candidates.insert(candidates.end(), equivalent.begin(), equivalent.end());
+    }
+    
+    int duration = preferred_slot.end_minutes - preferred_slot.start_minutes;
+    return gap_index.suggest(candidates, preferred_slot.start_minutes, duration, limit);
+}
+
 std::string ConflictDetector::findBestResource(const TimeSlot& time_slot, int min_priority) const {
-    auto available = findAvailableResources(time_slot);
+    // 优先级低于 min_priority 的冲突预约视为可让出；一次遍历统计每个资源的
+    // 冲突情况和包住该时段的空闲间隙
+    struct Fit {
+        bool blocked = false;
+        int displaced_priority = 0;    // 需要让出的优先级之和
+        int gap_start = 0;             // 前一个预约的结束时间
+        int gap_end = 1440;            // 后一个预约的开始时间
+    };
+    std::map<std::string, Fit> fits;
+    for (const auto& resource : available_resources) {
+        fits[resource];
+    }
+    
+    for (const auto& pair : reservations) {
+        const Reservation& reservation = pair.second;
+        auto it = fits.find(reservation.resource_name);
+        if (it == fits.end()) continue;
+        Fit& fit = it->second;
+        if (reservation.time_slot.overlaps(time_slot)) {
+            if (reservation.priority >= min_priority) {
+                fit.blocked = true;
+            } else {
+                fit.displaced_priority += reservation.priority;
+            }
+        } else if (reservation.time_slot.end_minutes <= time_slot.start_minutes) {
+            fit.gap_start = std::max(fit.gap_start, reservation.time_slot.end_minutes);
+        } else {
+            fit.gap_end = std::min(fit.gap_end, reservation.time_slot.start_minutes);
+        }
+    }
     
-    if (available. empty()) {
+    // 多容量资源上的重叠预约不一定占满，容量仍够时无需让出；重复预约不能让出
+    for (auto& entry : fits) {
+        Fit& fit = entry.second;
+        if ((fit.blocked || fit.displaced_priority > 0) && !exceedsCapacity(entry.first, time_slot, 1)) {
+            fit.blocked = false;
+            fit.displaced_priority = 0;
+        }
+        if (!fit.blocked && !seriesConflictsFor(Reservation(0, entry.first, "", time_slot)).empty()) {
+            fit.blocked = true;
+        }
+    }
+    
+    // 先少让出，再选间隙最贴合的资源（best-fit），把大块空闲留给更长的活动
+    std::string best;
+    int best_displaced = 0;
+    int best_gap = 0;
+    for (const auto& entry : fits) {
+        const Fit& fit = entry.second;
+        if (fit.blocked) continue;
+        int gap = fit.gap_end - fit.gap_start;
+        if (best.empty() || fit.displaced_priority < best_displaced ||
+            (fit.displaced_priority == best_displaced && gap < best_gap)) {
+            best = entry.first;
+            best_displaced = fit.displaced_priority;
+            best_gap = gap;
+        }
+    }
+    
+    if (best.empty()) {
         return "";
     }
     
-    // 简化实现：返回第一个可用资源
-    std::cout << "🎯 推荐最佳资源: " << available[0] << std::endl;
-    return available[0];
+    LOG_DEBUG("🎯 推荐最佳资源: " << best);
+    return best;
+}
+
+ScheduleResult ConflictDetector::planReservations(const std::vector<ScheduleRequest>& requests,
+                                                  const OptimizerOptions& options, bool apply) {
+    ScheduleOptimizer optimizer(getAvailableResources());
+    for (const auto& entry : occupancy_trees) {
+        // 只有占满容量的时段对新请求不可用（重复预约的时段按每天都占用计）
+        for (const auto& range : entry.second->findRangesAtLeast(0, 1439, getResourceCapacity(entry.first))) {
+            optimizer.addBusyInterval(entry.first, range.first, range.second + 1);
+        }
+    }
+    
+    // 预约时间线只覆盖一天，窗口限制在 [0, 1440] 内
+    std::vector<ScheduleRequest> bounded = requests;
+    for (auto& request : bounded) {
+        request.window_start = std::max(0, request.window_start);
+        request.window_end = std::min(1440, request.window_end);
+    }
+    ScheduleResult result = optimizer.optimize(bounded, options);
+    
+    LOG_DEBUG("排课优化完成: 安排 " << result.assignments.size() << "/" << requests.size()
+              << " 个请求，优先级合计 " << result.total_priority << "/" << result.requested_priority
+              << " (" << result.elapsed_ms << " ms)");
+    if (!apply) return result;
+    
+    // 整批作为一个撤销单元
+    OperationLog::Group group(operation_log);
+    for (const auto& assignment : result.assignments) {
+        const ScheduleRequest& request = bounded[assignment.request_index];
+        Reservation reservation(next_reservation_id, assignment.resource_name, request.activity_name,
+                                TimeSlot::fromMinutes(assignment.start_minutes, assignment.end_minutes),
+                                request.priority, request.contact_info);
+        if (addReservation(reservation) != -1) {
+            next_reservation_id++;
+        }
+    }
+    return result;
 }
 
 // 冲突解决
 
 void ConflictDetector::enableAutoResolve(bool enable) {
     auto_resolve_enabled = enable;
-    std::cout << "自动冲突解决已" << (enable ? "启用" : "禁用") << std::endl;
+    LOG_INFO("自动冲突解决已" << (enable ? "启用" : "禁用"));
 }
 
 std::vector<std::string> ConflictDetector::generateResolutionSuggestions(const ConflictInfo& conflict) const {
@@ -295,28 +1443,64 @@ std::vector<std::string> ConflictDetector::generateResolutionSuggestions(const C
     return suggestions;
 }
 
-bool ConflictDetector::resolveConflictByPriority(const std::string& resource, const TimeSlot& time_slot) {
+bool ConflictDetector::resolveConflictByPriority(const std::string& resource, const TimeSlot& time_slot,
+                                                 int incoming_priority, int incoming_demand) {
     auto conflicts = findConflictingReservations(resource, time_slot);
     
     if (conflicts. empty()) return true;
-    
-    // 找到优先级最低的预约
-    int lowest_priority_id = -1;
-    int lowest_priority = 11; // 优先级1-10，11表示无效值
-    
-    for (const auto& conflict : conflicts) {
-        if (conflict. priority < lowest_priority) {
-            lowest_priority = conflict.priority;
-            lowest_priority_id = conflict.id;
+    int start = time_slot.start_minutes;
+    int end = time_slot.end_minutes;
+    if (end <= start) return false;
+    
+    // 时段内每分钟的占用；取消时只取消足以腾出容量的预约，不动其余重叠预约
+    int capacity = getResourceCapacity(resource);
+    std::vector<int> load(end - start, 0);
+    auto apply = [&](const Reservation& reservation, int sign) {
+        int from = std::max(start, reservation.time_slot.start_minutes);
+        int to = std::min(end, reservation.time_slot.end_minutes);
+        for (int minute = from; minute < to; minute++) {
+            load[minute - start] += sign * reservation.demand;
+        }
+    };
+    auto blocks = [&](const Reservation& reservation) {
+        int from = std::max(start, reservation.time_slot.start_minutes);
+        int to = std::min(end, reservation.time_slot.end_minutes);
+        for (int minute = from; minute < to; minute++) {
+            if (load[minute - start] + incoming_demand > capacity) return true;
         }
+        return false;
+    };
+    for (const auto& conflict : conflicts) {
+        apply(conflict, 1);
     }
     
-    if (lowest_priority_id != -1) {
-        std::cout << "根据优先级解决冲突，取消预约 ID:  " << lowest_priority_id << std:: endl;
-        return removeReservation(lowest_priority_id);
+    // 只能取消优先级低于新预约的；从优先级最低的开始，跳过不在超额时刻上的
+    std::vector<Reservation> candidates;
+    for (const auto& conflict : conflicts) {
+        if (conflict.priority < incoming_priority) candidates.push_back(conflict);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Reservation& a, const Reservation& b) {
+        return a.priority < b.priority;
+    });
+    
+    std::vector<int> evicted;
+    for (const auto& candidate : candidates) {
+        if (*std::max_element(load.begin(), load.end()) + incoming_demand <= capacity) break;
+        if (!blocks(candidate)) continue;
+        apply(candidate, -1);
+        evicted.push_back(candidate.id);
     }
     
-    return false;
+    // 取消全部可取消的预约仍放不下时一个都不动
+    if (*std::max_element(load.begin(), load.end()) + incoming_demand > capacity) {
+        LOG_DEBUG("优先级更低的冲突预约不足以腾出容量: " << resource << " " << time_slot.toString());
+        return false;
+    }
+    for (int id : evicted) {
+        LOG_INFO("根据优先级解决冲突，取消预约 ID:  " << id);
+        eraseReservation(id);
+    }
+    return true;
 }
 
 bool ConflictDetector::resolveConflictByRescheduling(int low_priority_reservation_id) {
@@ -333,7 +1517,7 @@ bool ConflictDetector::resolveConflictByRescheduling(int low_priority_reservatio
         Reservation new_reservation = reservation;
         new_reservation.time_slot = alternatives[0];
         
-        std::cout << "重新调度预约到: " << alternatives[0]. toString() << std::endl;
+        LOG_INFO("重新调度预约到: " << alternatives[0]. toString());
         return updateReservation(low_priority_reservation_id, new_reservation);
     }
     
@@ -487,29 +1671,49 @@ int ConflictDetector::parseTimeToMinutes(const std::string& time_str) const {
     return hours * 60 + minutes;
 }
 
-std::string ConflictDetector::minutesToTimeString(int minutes) const {
-    int hours = minutes / 60;
-    int mins = minutes % 60;
-    
-    std::ostringstream ss;
-    ss << std::setfill('0') << std::setw(2) << hours << ":"
-       << std::setfill('0') << std::setw(2) << mins;
-    
-    return ss.str();
-}
-
 void ConflictDetector::updateResourceTree(const std::string& resource, const Reservation& reservation, bool add) {
     auto it = resource_trees.find(resource);
     if (it == resource_trees. end()) return;
     
     int start = reservation.time_slot. start_minutes;
     int end = reservation.time_slot. end_minutes;
+    if (end <= start) return;
     
-    // 使用线段树进行区间更新
+    // 使用线段树进行区间更新（预约是 [start, end)，树上是闭区间），同时维护空闲间隙索引
+    SegmentTree& occupancy = *occupancy_trees.at(resource);
     if (add) {
-        it->second->addInterval(start, end);
+        it->second->addInterval(start, end - 1, reservation.demand);
+        occupancy.addInterval(start, end - 1, reservation.demand);
     } else {
-        it->second->removeInterval(start, end);
+        it->second->removeInterval(start, end - 1, reservation.demand);
+        occupancy.removeInterval(start, end - 1, reservation.demand);
+    }
+    refreshGapIndex(resource, start, end);
+    generation++;
+}
+
+void ConflictDetector::updateSeriesOccupancy(const RecurringSeries& recurring, bool add) {
+    auto it = occupancy_trees.find(recurring.resource_name);
+    int start = recurring.time_slot.start_minutes;
+    int end = recurring.time_slot.end_minutes;
+    if (it == occupancy_trees.end() || end <= start) return;
+    
+    if (add) {
+        it->second->addInterval(start, end - 1, recurring.demand);
+    } else {
+        it->second->removeInterval(start, end - 1, recurring.demand);
+    }
+    refreshGapIndex(recurring.resource_name, start, end);
+}
+
+void ConflictDetector::refreshGapIndex(const std::string& resource, int start_minutes, int end_minutes) {
+    auto it = occupancy_trees.find(resource);
+    if (it == occupancy_trees.end()) return;
+    
+    // 间隙索引只记录占满容量的时段；重复预约按每天都占用计，推荐的时段在任何一天都可用
+    gap_index.removeBusy(resource, start_minutes, end_minutes);
+    for (const auto& range : it->second->findRangesAtLeast(start_minutes, end_minutes - 1, getResourceCapacity(resource))) {
+        gap_index.addBusy(resource, range.first, range.second + 1);
     }
 }
 
@@ -531,8 +1735,7 @@ std::vector<TimeSlot> ConflictDetector::findFreeSlots(const std::string& resourc
         if (reservation.time_slot.start_minutes > current_time) {
             int free_duration = reservation.time_slot.start_minutes - current_time;
             if (free_duration >= duration_minutes) {
-                TimeSlot free_slot(minutesToTimeString(current_time),
-                                  minutesToTimeString(current_time + duration_minutes));
+                TimeSlot free_slot = TimeSlot::fromMinutes(current_time, current_time + duration_minutes);
                 free_slots.push_back(free_slot);
             }
         }
@@ -541,8 +1744,7 @@ std::vector<TimeSlot> ConflictDetector::findFreeSlots(const std::string& resourc
     
     // 检查最后一个预约后是否还有空闲时间
     if (work_end - current_time >= duration_minutes) {
-        TimeSlot free_slot(minutesToTimeString(current_time),
-                          minutesToTimeString(current_time + duration_minutes));
+        TimeSlot free_slot = TimeSlot::fromMinutes(current_time, current_time + duration_minutes);
         free_slots.push_back(free_slot);
     }
     
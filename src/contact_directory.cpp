@@ -0,0 +1,294 @@
+#include "../include/contact_directory.h"
+#include "../include/metrics.h"
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <charconv>
+
+namespace {
+
+template<typename T>
+T loadAt(const char* base, size_t index) {
+    T value;
+    std::memcpy(&value, base + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+// 字符串池：相同内容只存一份（院系等重复值很多）
+class StringPoolBuilder {
+public:
+    bool intern(const std::string& value, ContactDirectory::StringRef& ref) {
+        auto it = offsets.find(value);
+        if (it != offsets.end()) {
+            ref.offset = it->second;
+        } else {
+            if (buffer.size() + value.size() > UINT32_MAX) return false;
+            ref.offset = static_cast<uint32_t>(buffer.appendBytes(value.data(), value.size()));
+            offsets.emplace(value, ref.offset);
+        }
+        ref.length = static_cast<uint32_t>(value.size());
+        return true;
+    }
+
+    SnapshotBuffer buffer;
+
+private:
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+} // namespace
+
+ContactDirectory::ContactDirectory()
+    : ids(nullptr), refs(nullptr), name_order(nullptr), pool(nullptr), row_count(0), pool_size(0) {}
+
+bool ContactDirectory::build(const std::string& path,
+                             const std::vector<std::shared_ptr<Contact>>& contacts,
+                             uint64_t source_version) {
+    std::vector<const Contact*> rows;
+    rows.reserve(contacts.size());
+    for (const auto& contact : contacts) {
+        if (contact) rows.push_back(contact.get());
+    }
+    if (rows.size() > UINT32_MAX) return false;
+    std::sort(rows.begin(), rows.end(), [](const Contact* a, const Contact* b) {
+        return a->id < b->id;
+    });
+
+    SnapshotBuffer id_column;
+    for (const Contact* contact : rows) {
+        id_column.append(static_cast<int32_t>(contact->id));
+    }
+
+    // 各字段列依次排列，同一列内按行号连续
+    StringPoolBuilder pool_builder;
+    SnapshotBuffer field_columns;
+    for (uint32_t which = 0; which < FIELD_COUNT; which++) {
+        for (const Contact* contact : rows) {
+            const std::string* value = nullptr;
+            switch (which) {
+                case FIELD_NAME:       value = &contact->name; break;
+                case FIELD_STUDENT_ID: value = &contact->student_id; break;
+                case FIELD_PHONE:      value = &contact->phone; break;
+                case FIELD_EMAIL:      value = &contact->email; break;
+                default:               value = &contact->department; break;
+            }
+            StringRef ref;
+            if (!pool_builder.intern(*value, ref)) {
+                std::cerr << "通讯录字符串池超出上限" << std::endl;
+                return false;
+            }
+            field_columns.append(ref);
+        }
+    }
+
+    std::vector<uint32_t> order(rows.size());
+    for (uint32_t row = 0; row < order.size(); row++) {
+        order[row] = row;
+    }
+    std::sort(order.begin(), order.end(), [&rows](uint32_t a, uint32_t b) {
+        int compared = rows[a]->name.compare(rows[b]->name);
+        return compared != 0 ? compared < 0 : rows[a]->id < rows[b]->id;
+    });
+    SnapshotBuffer order_column;
+    order_column.appendBytes(order.data(), order.size() * sizeof(uint32_t));
+
+    IndexSnapshotWriter writer;
+    writer.addSection(SECTION_DIRECTORY_IDS, std::move(id_column));
+    writer.addSection(SECTION_DIRECTORY_FIELDS, std::move(field_columns));
+    writer.addSection(SECTION_DIRECTORY_NAME_ORDER, std::move(order_column));
+    writer.addSection(SECTION_DIRECTORY_POOL, std::move(pool_builder.buffer));
+    return writer.writeToFile(path, source_version, 0);
+}
+
+bool ContactDirectory::open(const std::string& path) {
+    ids = refs = name_order = pool = nullptr;
+    row_count = pool_size = 0;
+    if (!file.open(path)) return false;
+
+    SnapshotView id_view, field_view, order_view, pool_view;
+    if (!file.section(SECTION_DIRECTORY_IDS, id_view) ||
+        !file.section(SECTION_DIRECTORY_FIELDS, field_view) ||
+        !file.section(SECTION_DIRECTORY_NAME_ORDER, order_view) ||
+        !file.section(SECTION_DIRECTORY_POOL, pool_view)) {
+        file.close();
+        return false;
+    }
+
+    // 各列长度必须与行数一致
+    size_t rows = id_view.size() / sizeof(int32_t);
+    if (id_view.size() % sizeof(int32_t) != 0 || rows > UINT32_MAX ||
+        field_view.size() != rows * FIELD_COUNT * sizeof(StringRef) ||
+        order_view.size() != rows * sizeof(uint32_t) ||
+        pool_view.size() > UINT32_MAX) {
+        std::cerr << "通讯录文件列长度不一致: " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    // 一次性校验全部引用，之后的按行访问不再检查
+    for (size_t row = 0; row < rows; row++) {
+        if (row > 0 && loadAt<int32_t>(id_view.data(), row - 1) >= loadAt<int32_t>(id_view.data(), row)) {
+            file.close();
+            return false;
+        }
+        if (loadAt<uint32_t>(order_view.data(), row) >= rows) {
+            file.close();
+            return false;
+        }
+    }
+    for (size_t i = 0; i < rows * FIELD_COUNT; i++) {
+        StringRef ref = loadAt<StringRef>(field_view.data(), i);
+        if (ref.offset > pool_view.size() || pool_view.size() - ref.offset < ref.length) {
+            std::cerr << "通讯录文件字符串引用越界: " << path << std::endl;
+            file.close();
+            return false;
+        }
+    }
+
+    ids = id_view.data();
+    refs = field_view.data();
+    name_order = order_view.data();
+    pool = pool_view.data();
+    row_count = static_cast<uint32_t>(rows);
+    pool_size = static_cast<uint32_t>(pool_view.size());
+    return true;
+}
+
+bool ContactDirectory::isOpen() const {
+    return file.isOpen();
+}
+
+uint64_t ContactDirectory::sourceVersion() const {
+    return file.contactsSequence();
+}
+
+uint32_t ContactDirectory::size() const {
+    return row_count;
+}
+
+uint32_t ContactDirectory::rowAt(uint32_t position) const {
+    return loadAt<uint32_t>(name_order, position);
+}
+
+int ContactDirectory::id(uint32_t row) const {
+    return loadAt<int32_t>(ids, row);
+}
+
+std::string_view ContactDirectory::field(uint32_t row, Field which) const {
+    StringRef ref = loadAt<StringRef>(refs, static_cast<size_t>(which) * row_count + row);
+    return std::string_view(pool + ref.offset, ref.length);
+}
+
+std::vector<uint32_t> ContactDirectory::searchByNamePrefix(std::string_view prefix) const {
+    static Histogram& latency = indexOperationLatency("directory_prefix_search");
+    ScopedTimer timer(latency);
+    // 在姓名序上二分定位第一个不小于前缀的位置，再顺序收集
+    uint32_t low = 0;
+    uint32_t high = row_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (name(rowAt(middle)) < prefix) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // 以前缀开头的姓名在该位置之后连续排列，再二分出区间终点
+    uint32_t end = low;
+    high = row_count;
+    while (end < high) {
+        uint32_t middle = end + (high - end) / 2;
+        if (name(rowAt(middle)).substr(0, prefix.size()) == prefix) {
+            end = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    std::vector<uint32_t> results;
+    results.reserve(end - low);
+    for (uint32_t position = low; position < end; position++) {
+        results.push_back(rowAt(position));
+    }
+    return results;
+}
+
+bool ContactDirectory::findRow(int contact_id, uint32_t& row) const {
+    uint32_t low = 0;
+    uint32_t high = row_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        int middle_id = id(middle);
+        if (middle_id == contact_id) {
+            row = middle;
+            return true;
+        }
+        if (middle_id < contact_id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+void ContactDirectory::appendEscaped(std::string_view value, std::string& out) {
+    static const char HEX[] = "0123456789abcdef";
+    // 不需要转义的连续片段整段追加
+    size_t run_start = 0;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(value.data() + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 0xF];
+        }
+    }
+    out.append(value.data() + run_start, value.size() - run_start);
+}
+
+void ContactDirectory::appendJson(uint32_t row, std::string& out) const {
+    char number[16];
+    auto converted = std::to_chars(number, number + sizeof(number), id(row));
+
+    out += "{\"id\": ";
+    out.append(number, converted.ptr);
+    out += ",\"name\": \"";
+    appendEscaped(name(row), out);
+    out += "\",\"phone\": \"";
+    appendEscaped(phone(row), out);
+    out += "\",\"email\": \"";
+    appendEscaped(email(row), out);
+    out += "\"";
+    if (!department(row).empty()) {
+        out += ",\"department\": \"";
+        appendEscaped(department(row), out);
+        out += "\"";
+    }
+    if (!studentId(row).empty()) {
+        out += ",\"student_id\": \"";
+        appendEscaped(studentId(row), out);
+        out += "\"";
+    }
+    out += "}";
+}
+
+void ContactDirectory::appendJsonArray(const std::vector<uint32_t>& rows, std::string& out) const {
+    out += "[";
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (i > 0) out += ",";
+        appendJson(rows[i], out);
+    }
+    out += "]";
+}
@@ -0,0 +1,327 @@
+#include "../include/contact_index.h"
+#include "../include/parallel_for.h"
+#include <thread>
+#include <unordered_map>
+
+// ContactIndex
+
+ContactIndex::ContactIndex() : primary_index(64) {
+}
+
+void ContactIndex::addContact(const std::shared_ptr<Contact>& contact) {
+    if (!contact || contact->id <= 0) return;
+
+    name_index.insertContact(contact);
+    primary_index.insert(contact);
+    phone_lookup.insert(contact->phone, contact->id);
+    email_lookup.insert(contact->email, contact->id);
+}
+
+void ContactIndex::removeContact(const Contact& contact) {
+    name_index.deleteContact(contact.id);
+    primary_index.remove(contact.id);
+
+    // 仅当索引项仍指向该联系人时才移除，避免误删他人的映射
+    phone_lookup.removeIfMatches(contact.phone, contact.id);
+    email_lookup.removeIfMatches(contact.email, contact.id);
+}
+
+void ContactIndex::reserve(size_t expected_count) {
+    phone_lookup.reserve(expected_count);
+    email_lookup.reserve(expected_count);
+}
+
+void ContactIndex::clear() {
+    name_index.clear();
+    primary_index.clear();
+    phone_lookup.clear();
+    email_lookup.clear();
+}
+
+void ContactIndex::bulkLoad(const std::vector<std::shared_ptr<Contact>>& contacts, unsigned thread_count) {
+    clear();
+    
+    // 与 addContact 相同的过滤规则
+    std::vector<std::shared_ptr<Contact>> valid;
+    valid.reserve(contacts.size());
+    for (const auto& contact : contacts) {
+        if (contact && contact->id > 0) valid.push_back(contact);
+    }
+    
+    primary_index.reserve(valid.size());
+    reserve(valid.size());
+    
+    if (thread_count == 0) thread_count = defaultBuildThreads();
+    if (thread_count <= 1) {
+        for (const auto& contact : valid) {
+            addContact(contact);
+        }
+        return;
+    }
+    
+    // 三张哈希索引互不相关，各用一个线程加载
+    std::vector<std::thread> loaders;
+    loaders.emplace_back([this, &valid]() {
+        for (const auto& contact : valid) primary_index.insert(contact);
+    });
+    loaders.emplace_back([this, &valid]() {
+        for (const auto& contact : valid) phone_lookup.insert(contact->phone, contact->id);
+    });
+    loaders.emplace_back([this, &valid]() {
+        for (const auto& contact : valid) email_lookup.insert(contact->email, contact->id);
+    });
+    
+    // 姓名树：每个分片独立建树，最后按分片顺序合并
+    std::vector<Trie> shards(thread_count);
+    parallelForShards(valid.size(), thread_count, [&](unsigned shard, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            shards[shard].insertContact(valid[i]);
+        }
+    });
+    for (auto& shard : shards) {
+        name_index.merge(shard);
+    }
+    
+    for (auto& loader : loaders) {
+        loader.join();
+    }
+}
+
+void ContactIndex::writeSnapshot(IndexSnapshotWriter& writer) const {
+    // 联系人记录段：以主索引为准编号，其余索引通过记录编号引用联系人
+    std::vector<std::shared_ptr<Contact>> contacts = primary_index.getAllContacts();
+    std::unordered_map<const Contact*, uint32_t> refs;
+    refs.reserve(contacts.size());
+    
+    SnapshotBuffer records;
+    records.append(static_cast<uint32_t>(contacts.size()));
+    for (size_t i = 0; i < contacts.size(); i++) {
+        const Contact& contact = *contacts[i];
+        refs[&contact] = static_cast<uint32_t>(i);
+        records.append(static_cast<int32_t>(contact.id));
+        records.appendString(contact.name);
+        records.appendString(contact.student_id);
+        records.appendString(contact.phone);
+        records.appendString(contact.email);
+        records.appendString(contact.department);
+    }
+    
+    auto contact_ref = [&refs](const Contact* contact) {
+        auto it = refs.find(contact);
+        return it != refs.end() ? it->second : UINT32_MAX;  // 无效编号使恢复失败并回退重建
+    };
+    
+    SnapshotBuffer trie;
+    name_index.writeSnapshot(trie, contact_ref);
+    SnapshotBuffer primary;
+    primary_index.writeSnapshot(primary, contact_ref);
+    SnapshotBuffer phones;
+    phone_lookup.writeSnapshot(phones);
+    SnapshotBuffer emails;
+    email_lookup.writeSnapshot(emails);
+    
+    writer.addSection(SECTION_CONTACTS, std::move(records));
+    writer.addSection(SECTION_NAME_TRIE, std::move(trie));
+    writer.addSection(SECTION_PRIMARY_INDEX, std::move(primary));
+    writer.addSection(SECTION_PHONE_INDEX, std::move(phones));
+    writer.addSection(SECTION_EMAIL_INDEX, std::move(emails));
+}
+
+bool ContactIndex::readSnapshotContacts(const IndexSnapshotFile& file,
+                                        std::vector<std::shared_ptr<Contact>>& contacts) {
+    SnapshotView view;
+    if (!file.section(SECTION_CONTACTS, view)) return false;
+    
+    size_t offset = 0;
+    uint32_t count = 0;
+    if (!view.read(offset, count) || count > view.size()) return false;
+    
+    contacts.clear();
+    contacts.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t id = 0;
+        auto contact = std::make_shared<Contact>();
+        if (!view.read(offset, id) ||
+            !view.readString(offset, contact->name) ||
+            !view.readString(offset, contact->student_id) ||
+            !view.readString(offset, contact->phone) ||
+            !view.readString(offset, contact->email) ||
+            !view.readString(offset, contact->department)) {
+            contacts.clear();
+            return false;
+        }
+        contact->id = id;
+        contacts.push_back(std::move(contact));
+    }
+    return true;
+}
+
+bool ContactIndex::restoreSnapshot(const IndexSnapshotFile& file,
+                                   const std::vector<std::shared_ptr<Contact>>& contacts) {
+    SnapshotView trie, primary, phones, emails;
+    size_t trie_offset = 0, primary_offset = 0, phone_offset = 0, email_offset = 0;
+    
+    bool restored = file.section(SECTION_NAME_TRIE, trie) &&
+                    file.section(SECTION_PRIMARY_INDEX, primary) &&
+                    file.section(SECTION_PHONE_INDEX, phones) &&
+                    file.section(SECTION_EMAIL_INDEX, emails) &&
+                    name_index.restoreSnapshot(trie, trie_offset, contacts) &&
+                    primary_index.restoreSnapshot(primary, primary_offset, contacts) &&
+                    phone_lookup.restoreSnapshot(phones, phone_offset) &&
+                    email_lookup.restoreSnapshot(emails, email_offset);
+    if (!restored) {
+        clear();
+    }
+    return restored;
+}
+
+std::vector<std::shared_ptr<Contact>> ContactIndex::searchByName(const std::string& name_prefix) const {
+    return name_index.searchByNamePrefix(name_prefix);
+}
+
+std::shared_ptr<Contact> ContactIndex::findById(int id) const {
+    if (id < 0) return nullptr;
+    return primary_index.find(id);
+}
+
+std::shared_ptr<Contact> ContactIndex::findByPhone(const std::string& phone) const {
+    return findById(phone_lookup.find(phone));
+}
+
+std::shared_ptr<Contact> ContactIndex::findByEmail(const std::string& email) const {
+    return findById(email_lookup.find(email));
+}
+
+std::shared_ptr<Contact> ContactIndex::findByStudentId(const std::string& student_id) const {
+    if (student_id.empty()) return nullptr;
+    return primary_index.findByStudentId(student_id);
+}
+
+std::vector<std::shared_ptr<Contact>> ContactIndex::getAllContacts() const {
+    return primary_index.getAllContacts();
+}
+
+int ContactIndex::phoneOwner(const std::string& phone) const {
+    return phone_lookup.find(phone);
+}
+
+int ContactIndex::emailOwner(const std::string& email) const {
+    return email_lookup.find(email);
+}
+
+size_t ContactIndex::nameIndexSize() const {
+    return name_index.getContactCount();
+}
+
+size_t ContactIndex::primaryIndexSize() const {
+    return primary_index.size();
+}
+
+size_t ContactIndex::phoneIndexSize() const {
+    return phone_lookup.size();
+}
+
+size_t ContactIndex::emailIndexSize() const {
+    return email_lookup.size();
+}
+
+// VersionedContactIndex
+
+VersionedContactIndex::VersionedContactIndex()
+    : active(new ContactIndex()), standby(new ContactIndex()), published_version(0) {
+    publish(active.get());
+}
+
+std::shared_ptr<const ContactIndex> VersionedContactIndex::snapshot() const {
+    return std::atomic_load(&published);
+}
+
+void VersionedContactIndex::publish(ContactIndex* index) {
+    // 句柄不拥有副本，释放时只发出“无读者”信号
+    auto released = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<const ContactIndex> handle(index, [released](const ContactIndex*) {
+        released->store(true, std::memory_order_release);
+    });
+
+    std::atomic_store(&published, handle);
+    published_released = released;
+}
+
+void VersionedContactIndex::apply(const Mutation& mutation) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+
+    // 1. 修改备用副本（此时没有读者能看到它）
+    mutation(*standby);
+
+    // 2. 原子发布：之后的 snapshot() 都会拿到新版本，旧句柄只剩存量读者持有
+    std::shared_ptr<std::atomic<bool>> retired_released = published_released;
+    publish(standby.get());
+    std::swap(active, standby);
+    published_version.fetch_add(1, std::memory_order_release);
+
+    // 3. 等待仍持有旧版本快照的读者退出，再把同一修改重放到旧版本
+    waitForReaders(*retired_released);
+    mutation(*standby);
+}
+
+void VersionedContactIndex::waitForReaders(const std::atomic<bool>& released) {
+    // 旧句柄已不可能被新的 snapshot() 取到，最后一个读者释放时置位
+    while (!released.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void VersionedContactIndex::addContact(const Contact& contact) {
+    // 两个副本共享同一个联系人对象
+    auto contactPtr = std::make_shared<Contact>(contact);
+    apply([contactPtr](ContactIndex& index) {
+        index.addContact(contactPtr);
+    });
+}
+
+void VersionedContactIndex::removeContact(const Contact& contact) {
+    apply([contact](ContactIndex& index) {
+        index.removeContact(contact);
+    });
+}
+
+void VersionedContactIndex::replaceContact(const Contact& old_contact, const Contact& new_contact) {
+    auto contactPtr = std::make_shared<Contact>(new_contact);
+    apply([old_contact, contactPtr](ContactIndex& index) {
+        index.removeContact(old_contact);
+        index.addContact(contactPtr);
+    });
+}
+
+void VersionedContactIndex::rebuild(const std::vector<Contact>& contacts) {
+    std::vector<std::shared_ptr<Contact>> contactPtrs;
+    contactPtrs.reserve(contacts.size());
+    for (const auto& contact : contacts) {
+        contactPtrs.push_back(std::make_shared<Contact>(contact));
+    }
+    rebuild(contactPtrs);
+}
+
+void VersionedContactIndex::rebuild(const std::vector<std::shared_ptr<Contact>>& contacts, unsigned thread_count) {
+    apply([&contacts, thread_count](ContactIndex& index) {
+        index.bulkLoad(contacts, thread_count);
+    });
+}
+
+bool VersionedContactIndex::restoreSnapshot(const IndexSnapshotFile& file) {
+    // 联系人记录只解码一次，两个副本共享
+    std::vector<std::shared_ptr<Contact>> contacts;
+    if (!ContactIndex::readSnapshotContacts(file, contacts)) {
+        return false;
+    }
+    
+    bool restored = true;
+    apply([&file, &contacts, &restored](ContactIndex& index) {
+        restored = index.restoreSnapshot(file, contacts) && restored;
+    });
+    return restored;
+}
+
+size_t VersionedContactIndex::version() const {
+    return published_version.load(std::memory_order_acquire);
+}
@@ -1,57 +1,112 @@
 #include "../include/contact_manager.h"
+#include "../include/metrics.h"
+#include "../include/logger.h"
 #include <iostream>
 #include <algorithm>
 #include <unordered_map>
 
+namespace {
+
+// 操作日志只保存可变字段，ID 单独记录
+std::vector<std::string> contactFields(const Contact& contact) {
+    return {contact.name, contact.student_id, contact.phone, contact.email, contact.department};
+}
+
+bool contactFromFields(int id, const std::vector<std::string>& fields, Contact& contact) {
+    if (fields.size() != 5) return false;
+    contact = Contact(id, fields[0], fields[1], fields[2], fields[3], fields[4]);
+    return true;
+}
+
+// 前缀缓存项的字节数：键、ID列表，加上节点与列表头的固定开销
+size_t prefixEntryBytes(const std::string& prefix, const std::shared_ptr<const std::vector<int>>& ids) {
+    return prefix.size() + ids->size() * sizeof(int) + 96;
+}
+
+} // namespace
+
+// 静态常量定义
+const size_t ContactManager::PREFIX_CACHE_BYTES = 4 * 1024 * 1024;
+const size_t ContactManager::PREFIX_CACHE_SHARDS = 8;
+const size_t ContactManager::PREFIX_FILTER_LIMIT = 512;
+
 //新的构造函数：接收外部注入的DataManager
 ContactManager::ContactManager(DataManager* dm, const std::string& backup_dir) 
-    : data_manager(dm), indices_built(false) {
+    : data_manager(dm), operation_log(nullptr), indices_built(false), prefix_epoch(0) {
     
     if (data_manager == nullptr) {
-        std::cerr << "错误: DataManager不能为nullptr!" << std::endl;
+        LOG_ERROR("DataManager不能为nullptr!");
     }
-    name_index.reset(new Trie());
-    phone_index.reset(new HashTable(64));
+    indices.reset(new VersionedContactIndex());
+    prefix_cache.reset(new LRUCache<std::string, IdList>(PREFIX_CACHE_BYTES, PREFIX_CACHE_SHARDS, prefixEntryBytes));
 }
 
 // 向后兼容的构造函数（不推荐使用，但保留）
 ContactManager::ContactManager(const std::string& db_path, const std::string& backup_dir) 
-    : indices_built(false) {
+    : operation_log(nullptr), indices_built(false), prefix_epoch(0) {
     
     // 创建新的DataManager（旧方式，应该用新构造函数）
-    std::cerr << "警告: 使用已弃用的ContactManager构造函数！建议改用依赖注入。" << std::endl;
-    data_manager = new DataManager(db_path, backup_dir, 100);
-    name_index.reset(new Trie());
-    phone_index.reset(new HashTable(64));
+    LOG_WARN("使用已弃用的ContactManager构造函数！建议改用依赖注入。");
+    owned_data_manager.reset(new DataManager(db_path, backup_dir, 100));
+    data_manager = owned_data_manager.get();
+    indices.reset(new VersionedContactIndex());
+    prefix_cache.reset(new LRUCache<std::string, IdList>(PREFIX_CACHE_BYTES, PREFIX_CACHE_SHARDS, prefixEntryBytes));
 }
 
 ContactManager::~ContactManager() {
-    // 注意: 不释放data_manager，因为是外部注入的
+    // 注意: 外部注入的data_manager不在这里释放；旧构造函数创建的由 owned_data_manager 释放
 }
 
 bool ContactManager::initialize() {
-    std::cout << "初始化联系人管理器..." << std::endl;
+    LOG_INFO("初始化联系人管理器...");
     
     // 初始化数据管理器
     if (!data_manager->initialize()) {
-        std::cerr << "数据管理器初始化失败" << std::endl;
+        LOG_ERROR("数据管理器初始化失败");
         return false;
     }
     
     // 构建索引
     if (!rebuildIndices()) {
-        std::cerr << "索引构建失败" << std::endl;
+        LOG_ERROR("索引构建失败");
         return false;
     }
     
-    std::cout << "联系人管理器初始化成功" << std::endl;
+    LOG_INFO("联系人管理器初始化成功");
     return true;
 }
 
+bool ContactManager::initializeFromSnapshot(const IndexSnapshotFile& snapshot) {
+    LOG_INFO("从快照初始化联系人管理器...");
+    
+    if (!data_manager->initialize()) {
+        LOG_ERROR("数据管理器初始化失败");
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        if (indices->restoreSnapshot(snapshot)) {
+            clearPrefixCache();
+            indices_built = true;
+            LOG_INFO("联系人索引已从快照恢复，共 " << indices->snapshot()->primaryIndexSize()
+                     << " 个联系人");
+            return true;
+        }
+    }
+    
+    LOG_WARN("联系人索引快照无效，回退为重建");
+    return rebuildIndices();
+}
+
 bool ContactManager::isReady() const {
     return data_manager && data_manager->isReady() && indices_built;
 }
 
+uint64_t ContactManager::getGeneration() const {
+    return indices->version();
+}
+
 // 基本操作
 
 bool ContactManager::addContact(const std::string& name, const std::string& phone, const std:: string& email) {
@@ -61,7 +116,7 @@ bool ContactManager::addContact(const std::string& name, const std::string& phon
 
 bool ContactManager::addContact(const Contact& contact) {
     if (!isReady()) {
-        std::cerr << "联系人管理器未就绪" << std::endl;
+        LOG_WARN("联系人管理器未就绪");
         return false;
     }
     
@@ -69,29 +124,33 @@ bool ContactManager::addContact(const Contact& contact) {
         return false;
     }
     
+    std::lock_guard<std::mutex> lock(write_mutex);
+    
     // 检查重复
     if (hasDuplicatePhone(contact.phone)) {
-        std::cerr << "电话号码已存在:  " << contact.phone << std:: endl;
+        LOG_WARN("电话号码已存在:  " << contact.phone);
         return false;
     }
     
     if (hasDuplicateEmail(contact.email)) {
-        std::cerr << "邮箱地址已存在: " << contact.email << std::endl;
+        LOG_WARN("邮箱地址已存在: " << contact.email);
         return false;
     }
     
-    // 添加到数据存储
-    if (!data_manager->addContact(contact)) {
+    // 添加到数据存储，取回自动生成的ID（不再重新读取全表）
+    int new_id = 0;
+    if (!data_manager->addContact(contact, new_id)) {
         return false;
     }
     
-    // 获取插入后的联系人（含自动生成的ID）
-    auto contacts = data_manager->getAllContacts();
-    if (! contacts.empty()) {
-        const Contact& newContact = contacts. back();
-        updateIndices(newContact);
-        std::cout << "联系人已添加: " << newContact. name << " (ID: " << newContact.id << ")" << std::endl;
+    Contact newContact = contact;
+    newContact.id = new_id;
+    indices->addContact(newContact);
+    invalidatePrefixes(newContact.name);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_CONTACT_ADD, newContact.id, {}, contactFields(newContact)));
     }
+    LOG_DEBUG("联系人已添加: " << newContact.name << " (ID: " << newContact.id << ")");
     
     return true;
 }
@@ -99,10 +158,12 @@ bool ContactManager::addContact(const Contact& contact) {
 bool ContactManager::removeContact(int id) {
     if (!isReady()) return false;
     
+    std::lock_guard<std::mutex> lock(write_mutex);
+    
     // 先获取联系人信息（用于从索引中移除）
     Contact* contact = data_manager->getContact(id);
     if (!contact) {
-        std::cerr << "联系人不存在: ID=" << id << std::endl;
+        LOG_WARN("联系人不存在: ID=" << id);
         return false;
     }
     
@@ -115,69 +176,214 @@ bool ContactManager::removeContact(int id) {
     }
     
     // 从索引中移除
-    removeFromIndices(contactCopy);
+    indices->removeContact(contactCopy);
+    invalidatePrefixes(contactCopy.name);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_CONTACT_REMOVE, id, contactFields(contactCopy), {}));
+    }
     
-    std::cout << "联系人已删除: " << contactCopy.name << std::endl;
+    LOG_DEBUG("联系人已删除: " << contactCopy.name);
     return true;
 }
 
 bool ContactManager::updateContact(const Contact& contact) {
     if (!isReady() || !validateContact(contact)) return false;
     
+    std::lock_guard<std::mutex> lock(write_mutex);
+    auto snapshot = indices->snapshot();
+    
+    // 电话/邮箱不能与其他联系人重复
+    int phoneOwner = snapshot->phoneOwner(contact.phone);
+    if (phoneOwner >= 0 && phoneOwner != contact.id) {
+        LOG_WARN("电话号码已存在:  " << contact.phone);
+        return false;
+    }
+    
+    int emailOwner = snapshot->emailOwner(contact.email);
+    if (emailOwner >= 0 && emailOwner != contact.id) {
+        LOG_WARN("邮箱地址已存在: " << contact.email);
+        return false;
+    }
+    
+    // 修改前的值（写锁内快照即最新版本）；索引中没有时从存储读取，撤销记录才完整
+    auto oldContact = snapshot->findById(contact.id);
+    snapshot.reset();  // 释放快照，否则发布新版本时会等待自己
+    bool indexed = oldContact != nullptr;
+    if (!indexed) {
+        Contact* stored = data_manager->getContact(contact.id);
+        if (!stored) {
+            LOG_WARN("联系人不存在: ID=" << contact.id);
+            return false;
+        }
+        oldContact.reset(stored);
+        LOG_WARN("联系人不在索引中，按存储中的值更新: ID=" << contact.id);
+    }
+    
     // 更新数据存储
     if (!data_manager->updateContact(contact)) {
         return false;
     }
     
-    // 更新索引
-    updateIndices(contact);
+    // 更新索引：先移除旧值的索引项，再加入新值
+    if (indexed) {
+        indices->replaceContact(*oldContact, contact);
+    } else {
+        indices->addContact(contact);
+    }
+    invalidatePrefixes(oldContact->name);
+    invalidatePrefixes(contact.name);
+    if (operation_log) {
+        operation_log->record(OperationRecord(OP_CONTACT_UPDATE, contact.id,
+                                              contactFields(*oldContact), contactFields(contact)));
+    }
+    
+    LOG_DEBUG("联系人已更新: " << contact.name);
+    return true;
+}
+
+bool ContactManager::restoreContact(const Contact& contact) {
+    if (!isReady() || !validateContact(contact)) return false;
+    
+    std::lock_guard<std::mutex> lock(write_mutex);
+    auto snapshot = indices->snapshot();
+    
+    // 被恢复的ID与电话/邮箱在此期间可能已被占用
+    if (snapshot->findById(contact.id) || snapshot->phoneOwner(contact.phone) >= 0 ||
+        snapshot->emailOwner(contact.email) >= 0) {
+        LOG_WARN("无法恢复联系人，ID或联系方式已被占用: " << contact.name);
+        return false;
+    }
+    snapshot.reset();
+    
+    if (!data_manager->restoreContact(contact)) {
+        return false;
+    }
+    indices->addContact(contact);
+    invalidatePrefixes(contact.name);
     
-    std::cout << "联系人已更新: " << contact.name << std::endl;
+    LOG_DEBUG("联系人已恢复: " << contact.name << " (ID: " << contact.id << ")");
     return true;
 }
 
+// 撤销/重做
+
+void ContactManager::setOperationLog(OperationLog* log) {
+    operation_log = log;
+}
+
+bool ContactManager::replayOperation(const OperationRecord& record, bool inverse) {
+    Contact contact;
+    switch (record.type) {
+        case OP_CONTACT_ADD:
+            if (inverse) return removeContact(record.target_id);
+            return contactFromFields(record.target_id, record.after, contact) && restoreContact(contact);
+        case OP_CONTACT_REMOVE:
+            if (!inverse) return removeContact(record.target_id);
+            return contactFromFields(record.target_id, record.before, contact) && restoreContact(contact);
+        case OP_CONTACT_UPDATE:
+            return contactFromFields(record.target_id, inverse ? record.before : record.after, contact) &&
+                   updateContact(contact);
+        default:
+            return false;
+    }
+}
+
 // 高级查询
 
 std::vector<Contact> ContactManager::searchByName(const std:: string& name_prefix) {
     if (!isReady()) return {};
     
-    auto results = name_index->searchByNamePrefix(name_prefix);
-    std::cout << "按姓名前缀 '" << name_prefix << "' 搜索到 " << results.size() << " 个结果" << std::endl;
+    auto ids = searchIdsByName(name_prefix);
+    LOG_DEBUG("按姓名前缀 '" << name_prefix << "' 搜索到 " << ids.size() << " 个结果");
     
     std::vector<Contact> contacts;
-    for (const auto& contactPtr : results) {
-        contacts.push_back(*contactPtr);
+    auto snapshot = indices->snapshot();
+    for (int id : ids) {
+        auto contactPtr = snapshot->findById(id);
+        if (contactPtr) contacts.push_back(*contactPtr);
     }
     return contacts;
 }
 
-Contact* ContactManager::findByPhone(const std::string& phone) {
-    if (!isReady()) return nullptr;
+std::vector<int> ContactManager::searchIdsByName(const std::string& name_prefix) {
+    if (!isReady()) return {};
+    static Histogram& latency = indexOperationLatency("contact_prefix_search");
+    ScopedTimer timer(latency);
+    
+    auto cached = prefix_cache->get(name_prefix);
+    if (cached) return **cached;
+    
+    // 写者先发布新版本再失效前缀，两步之间读到的较短前缀结果可能还是旧的；
+    // 只比较版本挡不住这种情况，所以同时记下失效计数，期间有失效就不写回
+    uint64_t epoch;
+    {
+        std::lock_guard<std::mutex> lock(prefix_cache_mutex);
+        epoch = prefix_epoch;
+    }
+    
+    // 先取版本再取快照：两者之间有写入时版本偏旧，结果不会写回缓存
+    size_t version = indices->version();
+    auto snapshot = indices->snapshot();
+    
+    // 已缓存较短前缀且结果不多时，过滤它比重新遍历 Trie 子树便宜
+    IdList shorter;
+    for (size_t length = name_prefix.size(); length-- > 0 && !shorter;) {
+        std::string prefix = name_prefix.substr(0, length);
+        if (prefix_cache->contains(prefix)) {
+            shorter = prefix_cache->get(prefix).value_or(nullptr);
+        }
+    }
+    
+    std::vector<int> ids;
+    if (shorter && shorter->size() <= PREFIX_FILTER_LIMIT) {
+        for (int id : *shorter) {
+            auto contact = snapshot->findById(id);
+            if (contact && contact->name.compare(0, name_prefix.size(), name_prefix) == 0) {
+                ids.push_back(id);
+            }
+        }
+    } else {
+        for (const auto& contact : snapshot->searchByName(name_prefix)) {
+            ids.push_back(contact->id);
+        }
+    }
+    snapshot.reset();
     
-    // 在所有联系人中查找（简化实现）
-    auto contacts = data_manager->getAllContacts();
-    for (const auto& contact :  contacts) {
-        if (contact.phone == phone) {
-            std::cout << "通过电话找到联系人: " << contact.name << std::endl;
-            return new Contact(contact);
+    IdList result = std::make_shared<const std::vector<int>>(std::move(ids));
+    {
+        std::lock_guard<std::mutex> lock(prefix_cache_mutex);
+        if (prefix_epoch == epoch && indices->version() == version) {
+            prefix_cache->put(name_prefix, result);
         }
     }
+    return *result;
+}
+
+Contact* ContactManager::findByPhone(const std::string& phone) {
+    if (!isReady()) return nullptr;
     
-    return nullptr;
+    // 电话索引O(1)定位ID，再从主索引取出联系人
+    Contact* contact = copyIndexedContact(indices->snapshot()->findByPhone(phone));
+    if (contact) {
+        LOG_DEBUG("通过电话找到联系人: " << contact->name);
+    }
+    return contact;
 }
 
 Contact* ContactManager::findByEmail(const std:: string& email) {
     if (!isReady()) return nullptr;
     
-    auto contacts = data_manager->getAllContacts();
-    for (const auto& contact : contacts) {
-        if (contact.email == email) {
-            std::cout << "通过邮箱找到联系人: " << contact.name << std::endl;
-            return new Contact(contact);
-        }
+    Contact* contact = copyIndexedContact(indices->snapshot()->findByEmail(email));
+    if (contact) {
+        LOG_DEBUG("通过邮箱找到联系人: " << contact->name);
     }
+    return contact;
+}
+
+Contact* ContactManager::findByStudentId(const std::string& student_id) {
+    if (!isReady()) return nullptr;
     
-    return nullptr;
+    return copyIndexedContact(indices->snapshot()->findByStudentId(student_id));
 }
 
 Contact* ContactManager::findById(int id) {
@@ -225,17 +431,15 @@ std::vector<std::string> ContactManager::getPopularNames(int limit) {
 }
 
 bool ContactManager::hasDuplicatePhone(const std:: string& phone) {
-    Contact* existing = findByPhone(phone);
-    bool hasDuplicate = (existing != nullptr);
-    if (existing) delete existing;
-    return hasDuplicate;
+    return indices->snapshot()->phoneOwner(phone) >= 0;
 }
 
 bool ContactManager::hasDuplicateEmail(const std::string& email) {
-    Contact* existing = findByEmail(email);
-    bool hasDuplicate = (existing != nullptr);
-    if (existing) delete existing;
-    return hasDuplicate;
+    return indices->snapshot()->emailOwner(email) >= 0;
+}
+
+bool ContactManager::hasDuplicateStudentId(const std::string& student_id) {
+    return indices->snapshot()->findByStudentId(student_id) != nullptr;
 }
 
 // 批量操作
@@ -254,7 +458,7 @@ bool ContactManager::importContacts(const std::vector<Contact>& contacts) {
         }
     }
     
-    std::cout << "联系人导入完成: 成功 " << successCount << " 个, 失败 " << errorCount << " 个" << std:: endl;
+    LOG_INFO("联系人导入完成: 成功 " << successCount << " 个, 失败 " << errorCount << " 个");
     return errorCount == 0;
 }
 
@@ -266,25 +470,27 @@ bool ContactManager::exportContacts(const std::string& filename) {
 // 索引管理
 
 bool ContactManager::rebuildIndices() {
-    std::cout << "重建联系人索引..." << std:: endl;
+    LOG_INFO("重建联系人索引...");
     
-    // 清空现有索引
-    name_index->clear();
-    phone_index->clear();
+    std::lock_guard<std::mutex> lock(write_mutex);
     
-    // 获取所有联系人
-    auto contacts = data_manager->getAllContacts();
-    
-    // 重建索引
-    for (const auto& contact : contacts) {
-        updateIndices(contact);
+    // 获取所有联系人并并行重建索引（重建期间查询仍读取旧版本）
+    std::vector<std::shared_ptr<Contact>> contacts;
+    for (auto& contact : data_manager->getAllContacts()) {
+        contacts.push_back(std::make_shared<Contact>(std::move(contact)));
     }
+    indices->rebuild(contacts);
+    clearPrefixCache();
     
     indices_built = true;
-    std::cout << "索引重建完成，共处理 " << contacts.size() << " 个联系人" << std::endl;
+    LOG_INFO("索引重建完成，共处理 " << contacts.size() << " 个联系人");
     return true;
 }
 
+void ContactManager::writeSnapshot(IndexSnapshotWriter& writer) {
+    indices->snapshot()->writeSnapshot(writer);
+}
+
 void ContactManager::printIndexStats() {
     if (!isReady()) {
         std::cout << "联系人管理器未就绪" << std::endl;
@@ -293,47 +499,98 @@ void ContactManager::printIndexStats() {
     
     std::cout << "=== 联系人索引统计 ===" << std::endl;
     std::cout << "总联系人数: " << getTotalCount() << std::endl;
-    std::cout << "姓名索引: " << name_index->getContactCount() << " 条记录" << std::endl;
-    std::cout << "电话索引: " << phone_index->size() << " 条记录" << std::endl;
+    auto snapshot = indices->snapshot();
+    std::cout << "索引版本: " << indices->version() << std::endl;
+    std::cout << "姓名索引: " << snapshot->nameIndexSize() << " 条记录" << std::endl;
+    std::cout << "主索引: " << snapshot->primaryIndexSize() << " 条记录" << std::endl;
+    std::cout << "电话索引: " << snapshot->phoneIndexSize() << " 条记录" << std::endl;
+    std::cout << "邮箱索引: " << snapshot->emailIndexSize() << " 条记录" << std::endl;
+    prefix_cache->printStats();
 }
 
-// 私有辅助方法
+size_t ContactManager::getPrefixCacheSize() const {
+    return prefix_cache->size();
+}
+
+// 只读通讯录
 
-void ContactManager::updateIndices(const Contact& contact) {
-    if (contact.id <= 0) return;
+bool ContactManager::refreshDirectory(const std::string& path) {
+    if (!isReady()) return false;
+    
+    std::lock_guard<std::mutex> lock(directory_mutex);
+    
+    // 先读版本再取快照：快照内容不会比记录的版本旧，过期判断偏保守
+    size_t version = indices->version();
+    auto current = std::atomic_load(&directory);
+    if (current && current->sourceVersion() == version) {
+        return true;
+    }
     
-    // 更新姓名索引
-    auto contactPtr = std::make_shared<Contact>(contact);
-    name_index->insertContact(contactPtr);
+    auto snapshot = indices->snapshot();
+    if (!ContactDirectory::build(path, snapshot->getAllContacts(), version)) {
+        LOG_ERROR("通讯录生成失败: " << path);
+        return false;
+    }
     
-    // 更新电话索引（简化实现：这里应该用专门的电话索引）
-    phone_index->insert(contactPtr);
+    // 覆盖写入是先写临时文件再重命名，旧映射在最后一个读者释放前保持有效
+    std::shared_ptr<ContactDirectory> fresh(new ContactDirectory());
+    if (!fresh->open(path)) {
+        LOG_ERROR("通讯录映射失败: " << path);
+        return false;
+    }
+    std::atomic_store(&directory, std::shared_ptr<const ContactDirectory>(fresh));
+    LOG_INFO("通讯录已生成，共 " << fresh->size() << " 个联系人 (索引版本 " << version << ")");
+    return true;
+}
+
+std::shared_ptr<const ContactDirectory> ContactManager::currentDirectory() const {
+    auto current = std::atomic_load(&directory);
+    if (!current || current->sourceVersion() != indices->version()) {
+        return nullptr;
+    }
+    return current;
+}
+
+// 私有辅助方法
+
+void ContactManager::invalidatePrefixes(const std::string& name) {
+    // 只有 name 的前缀（含空串）的搜索结果会包含这个联系人
+    std::lock_guard<std::mutex> lock(prefix_cache_mutex);
+    prefix_epoch++;
+    for (size_t length = 0; length <= name.size(); length++) {
+        prefix_cache->remove(name.substr(0, length));
+    }
+}
+
+void ContactManager::clearPrefixCache() {
+    std::lock_guard<std::mutex> lock(prefix_cache_mutex);
+    prefix_epoch++;
+    prefix_cache->clear();
 }
 
-void ContactManager::removeFromIndices(const Contact& contact) {
-    // 简化实现：实际项目中需要从索引中精确移除
-    std::cout << "从索引中移除联系人:  " << contact.name << std:: endl;
+Contact* ContactManager::copyIndexedContact(const std::shared_ptr<Contact>& contact) {
+    return contact ? new Contact(*contact) : nullptr;
 }
 
 bool ContactManager::validateContact(const Contact& contact) {
     if (contact.name.empty()) {
-        std::cerr << "联系人姓名不能为空" << std::endl;
+        LOG_WARN("联系人姓名不能为空");
         return false;
     }
     
     if (contact.phone.empty()) {
-        std::cerr << "联系人电话不能为空" << std::endl;
+        LOG_WARN("联系人电话不能为空");
         return false;
     }
     
     if (contact.email.empty()) {
-        std::cerr << "联系人邮箱不能为空" << std::endl;
+        LOG_WARN("联系人邮箱不能为空");
         return false;
     }
     
     // 简单的邮箱格式验证
     if (contact.email.find('@') == std::string::npos) {
-        std::cerr << "邮箱格式不正确" << std::endl;
+        LOG_WARN("邮箱格式不正确");
         return false;
     }
     
@@ -0,0 +1,148 @@
+#include "../include/data_manager.h"
+#include "../include/logger.h"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+DataManager::DataManager(const std::string& db_path, const std::string& backup_dir, int max_backups)
+    : db_path(db_path), backup_dir(backup_dir), max_backups(max_backups), ready(false) {
+    db_manager.reset(new SQLiteManager(db_path));
+}
+
+DataManager::~DataManager() = default;
+
+bool DataManager::initialize() {
+    if (ready) return true;     // 同一个 DataManager 可能被多个管理器共享
+
+    std::error_code ec;
+    fs::path parent = fs::path(db_path).parent_path();
+    if (!parent.empty()) {
+        fs::create_directories(parent, ec);
+    }
+    if (!backup_dir.empty()) {
+        fs::create_directories(backup_dir, ec);
+    }
+
+    if (!db_manager->init()) {
+        LOG_ERROR("数据库初始化失败: " << db_path);
+        return false;
+    }
+    ready = true;
+    return true;
+}
+
+bool DataManager::isReady() const {
+    return ready;
+}
+
+// === 联系人 ===
+
+bool DataManager::addContact(const Contact& contact, int& new_id) {
+    return db_manager->addContact(contact, new_id);
+}
+
+bool DataManager::restoreContact(const Contact& contact) {
+    return db_manager->restoreContact(contact);
+}
+
+std::vector<Contact> DataManager::getAllContacts() {
+    return db_manager->getAllContacts();
+}
+
+Contact* DataManager::getContact(int id) {
+    Contact contact;
+    if (!db_manager->getContact(id, contact)) {
+        return nullptr;
+    }
+    return new Contact(contact);
+}
+
+bool DataManager::updateContact(const Contact& contact) {
+    return db_manager->updateContact(contact);
+}
+
+bool DataManager::deleteContact(int id) {
+    return db_manager->deleteContact(id);
+}
+
+int DataManager::getContactCount() {
+    return db_manager->getContactCount();
+}
+
+// === 活动 ===
+
+bool DataManager::addActivity(const Activity& activity) {
+    return db_manager->addActivity(activity);
+}
+
+bool DataManager::restoreActivity(const Activity& activity) {
+    return db_manager->restoreActivity(activity);
+}
+
+std::vector<Activity> DataManager::getAllActivities() {
+    return db_manager->getAllActivities();
+}
+
+Activity* DataManager::getActivity(int id) {
+    Activity activity;
+    if (!db_manager->getActivity(id, activity)) {
+        return nullptr;
+    }
+    return new Activity(activity);
+}
+
+bool DataManager::updateActivity(const Activity& activity) {
+    return db_manager->updateActivity(activity);
+}
+
+bool DataManager::deleteActivity(int id) {
+    return db_manager->deleteActivity(id);
+}
+
+int DataManager::getActivityCount() {
+    return db_manager->getActivityCount();
+}
+
+// === 备份 ===
+
+bool DataManager::backupAllData() {
+    if (!ready) return false;
+
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+    fs::path target = fs::path(backup_dir) / (fs::path(db_path).stem().string() + "_" + stamp + ".db");
+    if (!db_manager->backupTo(target.string())) {
+        return false;
+    }
+    LOG_INFO("数据已备份到 " << target.string());
+    pruneBackups();
+    return true;
+}
+
+void DataManager::pruneBackups() {
+    if (max_backups <= 0) return;
+
+    // 文件名带时间戳，按名字排序即按时间排序
+    std::string prefix = fs::path(db_path).stem().string() + "_";
+    std::vector<fs::path> backups;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(backup_dir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) == 0 && entry.path().extension() == ".db") {
+            backups.push_back(entry.path());
+        }
+    }
+    if (backups.size() <= static_cast<size_t>(max_backups)) return;
+
+    std::sort(backups.begin(), backups.end());
+    for (size_t i = 0; i + max_backups < backups.size(); i++) {
+        fs::remove(backups[i], ec);
+    }
+}
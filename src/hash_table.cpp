@@ -1,121 +1,307 @@
 #include "../include/hash_table.h"
+#include "../include/index_snapshot.h"
 #include <iostream>
 #include <algorithm>
 #include <unordered_set>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 
 // 静态常量定义
 const double HashTable::MAX_LOAD_FACTOR = 0.75;
 const size_t HashTable::MIN_CAPACITY = 16;
+const size_t HashTable::MIGRATE_STEP = 64;
+
+namespace {
+
+// 向上取整到2的幂
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
 
 HashTable::HashTable(size_t initial_capacity) 
-    : table_size(std::max(initial_capacity, MIN_CAPACITY)), element_count(0) {
-    table.resize(table_size, nullptr);
+    : element_count(0), migrate_cursor(0), incremental_resize(false),
+      student_id_index(initial_capacity), shared_student_ids(0) {
+    allocateTable(table, roundUpPowerOfTwo(std::max(initial_capacity, MIN_CAPACITY)));
 }
 
 HashTable::~HashTable() {
-    clear();
+    releaseTable(old_table);
+    releaseTable(table);
+}
+
+void HashTable::allocateTable(Table& target, size_t capacity) {
+    // calloc 对大块内存直接映射零页，清零开销分摊到后续首次写入，不会集中在扩容那一次插入上
+    target.control = static_cast<uint8_t*>(std::calloc(capacity, sizeof(uint8_t)));
+    target.keys = static_cast<int*>(std::malloc(capacity * sizeof(int)));
+    target.values = static_cast<std::shared_ptr<Contact>*>(
+        std::malloc(capacity * sizeof(std::shared_ptr<Contact>)));
+    if (!target.control || !target.keys || !target.values) {
+        std::free(target.control);
+        std::free(target.keys);
+        std::free(target.values);
+        target = Table();
+        throw std::bad_alloc();
+    }
+    target.size = capacity;
+    
+    // 计算 log2(size)，散列取乘积的高位
+    unsigned bits = 0;
+    while ((size_t(1) << bits) < capacity) bits++;
+    target.shift = 64 - bits;
 }
 
-size_t HashTable::hashFunction(int key) const {
-    // 使用简单但有效的哈希函数
-    return static_cast<size_t>(key * 2654435761U) % table_size;
+void HashTable::releaseTable(Table& target) {
+    if (target.size == 0) return;
+    
+    // 值只在占用槽位上构造过
+    for (size_t i = 0; i < target.size; i++) {
+        if (target.control[i] != EMPTY_SLOT) {
+            target.values[i].~shared_ptr();
+        }
+    }
+    std::free(target.control);
+    std::free(target.keys);
+    std::free(target.values);
+    target = Table();
 }
 
-size_t HashTable::getIndex(int key) const {
-    return hashFunction(key);
+size_t HashTable::hashFunction(int key, unsigned shift) {
+    // Fibonacci 散列：乘以 2^64/φ 后取高位，连续ID也能均匀分布，且无需取模
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 11400714819323198485ULL;
+    return static_cast<size_t>(h >> shift);
+}
+
+size_t HashTable::findSlot(const Table& target, int key) {
+    if (target.size == 0) return target.size;
+    
+    size_t mask = target.size - 1;
+    size_t index = hashFunction(key, target.shift);
+    
+    // Robin Hood 不变式：若槽位上元素的探测距离小于当前距离，目标键不可能在更后面
+    for (unsigned dist = 1; dist <= MAX_DISTANCE; dist++) {
+        uint8_t ctrl = target.control[index];
+        if (ctrl < dist) {
+            return target.size;
+        }
+        if (target.keys[index] == key) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return target.size;
+}
+
+bool HashTable::insertHelper(int& key, std::shared_ptr<Contact>& contact) {
+    size_t mask = table.size - 1;
+    size_t index = hashFunction(key, table.shift);
+    unsigned dist = 1;
+    
+    while (true) {
+        if (table.control[index] == EMPTY_SLOT) {
+            table.control[index] = static_cast<uint8_t>(dist);
+            table.keys[index] = key;
+            new (&table.values[index]) std::shared_ptr<Contact>(std::move(contact));
+            return true;
+        }
+        
+        // “劫富济贫”：探测距离更短的元素让位，继续为被换出的元素找位置
+        if (table.control[index] < dist) {
+            unsigned displaced = table.control[index];
+            table.control[index] = static_cast<uint8_t>(dist);
+            dist = displaced;
+            std::swap(table.keys[index], key);
+            std::swap(table.values[index], contact);
+        }
+        
+        if (dist >= MAX_DISTANCE) {
+            return false;  // 探测过长，由调用方扩容后重新插入key/contact
+        }
+        index = (index + 1) & mask;
+        dist++;
+    }
 }
 
 bool HashTable::insert(std::shared_ptr<Contact> contact) {
     if (! contact) return false;
     
-    // 检查负载因子是否需要扩容
-    if (loadFactor() > MAX_LOAD_FACTOR) {
-        resize();
+    // 渐进式迁移：每次写操作顺带搬运一小批旧表槽位
+    migrateStep(MIGRATE_STEP);
+    
+    // 检查是否已存在
+    size_t slot = findSlot(table, contact->id);
+    if (slot != table.size) {
+        // ID已存在，更新联系人信息（同步学号索引）
+        std::shared_ptr<Contact> old_contact = table.values[slot];
+        table.values[slot] = contact;
+        unindexStudentId(*old_contact);
+        indexStudentId(*contact);
+        return true;
     }
     
-    size_t index = getIndex(contact->id);
+    size_t old_slot = findOldSlot(contact->id);
+    if (old_slot != old_table.size) {
+        // 仍在旧表中：移出旧表，新值直接写入新表
+        std::shared_ptr<Contact> old_contact = std::move(old_table.values[old_slot]);
+        placeEntry(contact->id, contact);
+        unindexStudentId(*old_contact);
+        indexStudentId(*contact);
+        return true;
+    }
     
-    // 检查是否已存在
-    HashNode* current = table[index];
-    while (current != nullptr) {
-        if (current->contact->id == contact->id) {
-            // ID已存在，更新联系人信息
-            current->contact = contact;
-            return true;
+    // 检查负载因子是否需要扩容
+    if (static_cast<double>(element_count + 1) > table.size * MAX_LOAD_FACTOR) {
+        if (incremental_resize) {
+            beginMigration();
+        } else {
+            resize(table.size * 2);
         }
-        current = current->next;
     }
     
-    // 不存在，插入新节点（头插法）
-    HashNode* newNode = new HashNode(contact);
-    newNode->next = table[index];
-    table[index] = newNode;
+    placeEntry(contact->id, contact);
     element_count++;
+    indexStudentId(*contact);
     
     return true;
 }
 
-std::shared_ptr<Contact> HashTable::find(int key) {
-    HashNode* node = findNode(key);
-    return node ? node->contact : nullptr;
+void HashTable::placeEntry(int key, std::shared_ptr<Contact> contact) {
+    // 探测距离溢出时只扩容新表；迁移中的旧表不受影响
+    while (!insertHelper(key, contact)) {
+        resize(table.size * 2);
+    }
 }
 
-std::shared_ptr<Contact> HashTable::findByStudentId(const std::string& student_id) {
-    // 遍历所有桶查找学号（效率较低，但功能完整）
-    for (size_t i = 0; i < table_size; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            if (current->contact->student_id == student_id) {
-                return current->contact;
-            }
-            current = current->next;
-        }
-    }
-    return nullptr;
+std::shared_ptr<Contact> HashTable::find(int key) const {
+    size_t slot = findSlot(table, key);
+    if (slot != table.size) return table.values[slot];
+    
+    // 迁移期间未搬走的元素仍在旧表
+    size_t old_slot = findOldSlot(key);
+    return old_slot != old_table.size ? old_table.values[old_slot] : nullptr;
+}
+
+std::shared_ptr<Contact> HashTable::findByStudentId(const std::string& student_id) const {
+    // 通过学号二级索引定位ID，再按ID查找
+    int id = student_id_index.find(student_id);
+    if (id < 0) return nullptr;
+    return find(id);
 }
 
-HashTable::HashNode* HashTable:: findNode(int key) {
-    size_t index = getIndex(key);
-    HashNode* current = table[index];
+void HashTable::eraseSlot(size_t index) {
+    size_t mask = table.size - 1;
+    size_t next = (index + 1) & mask;
     
-    while (current != nullptr) {
-        if (current->contact->id == key) {
-            return current;
-        }
-        current = current->next;
+    // 后移删除：把后续探测距离大于1的元素逐个前移，无需墓碑
+    while (table.control[next] > 1) {
+        table.control[index] = table.control[next] - 1;
+        table.keys[index] = table.keys[next];
+        table.values[index] = std::move(table.values[next]);
+        index = next;
+        next = (next + 1) & mask;
     }
     
-    return nullptr;
+    table.control[index] = EMPTY_SLOT;
+    table.values[index].~shared_ptr();
 }
 
 bool HashTable::remove(int key) {
-    size_t index = getIndex(key);
-    HashNode* current = table[index];
-    HashNode* prev = nullptr;
-    
-    while (current != nullptr) {
-        if (current->contact->id == key) {
-            // 找到要删除的节点
-            if (prev == nullptr) {
-                // 删除头节点
-                table[index] = current->next;
-            } else {
-                // 删除中间或尾节点
-                prev->next = current->next;
-            }
-            delete current;
-            element_count--;
-            return true;
+    migrateStep(MIGRATE_STEP);
+    
+    std::shared_ptr<Contact> removed;
+    size_t slot = findSlot(table, key);
+    if (slot != table.size) {
+        removed = std::move(table.values[slot]);
+        eraseSlot(slot);
+    } else {
+        // 旧表不做后移，只置空值，避免元素越过迁移游标而被漏迁
+        size_t old_slot = findOldSlot(key);
+        if (old_slot == old_table.size) {
+            return false; // 未找到
         }
-        prev = current;
-        current = current->next;
+        removed = std::move(old_table.values[old_slot]);
     }
     
-    return false; // 未找到
+    element_count--;
+    unindexStudentId(*removed);
+    return true;
 }
 
-bool HashTable::contains(int key) {
-    return findNode(key) != nullptr;
+size_t HashTable::findOldSlot(int key) const {
+    // 已迁移/已删除的槽位保留探测距离，Robin Hood 提前终止条件依然成立；值为空即视为不存在
+    size_t slot = findSlot(old_table, key);
+    if (slot != old_table.size && !old_table.values[slot]) {
+        return old_table.size;
+    }
+    return slot;
+}
+
+void HashTable::beginMigration() {
+    // 上一轮迁移尚未完成时先收尾，保证任意时刻至多两张表
+    finishMigration();
+    
+    Table fresh;
+    allocateTable(fresh, table.size * 2);
+    old_table = table;
+    table = fresh;
+    migrate_cursor = 0;
+}
+
+void HashTable::migrateStep(size_t max_slots) {
+    if (old_table.size == 0) return;
+    
+    size_t end = std::min(old_table.size, migrate_cursor + max_slots);
+    for (; migrate_cursor < end; migrate_cursor++) {
+        if (old_table.control[migrate_cursor] == EMPTY_SLOT) continue;
+        std::shared_ptr<Contact>& value = old_table.values[migrate_cursor];
+        if (!value) continue;
+        placeEntry(old_table.keys[migrate_cursor], std::move(value));
+    }
+    
+    if (migrate_cursor == old_table.size) {
+        // 迁移完成，释放旧表
+        releaseTable(old_table);
+        migrate_cursor = 0;
+    }
+}
+
+void HashTable::finishMigration() {
+    migrateStep(old_table.size);
+}
+
+void HashTable::setIncrementalResize(bool enable) {
+    incremental_resize = enable;
+    if (!enable) {
+        finishMigration();
+    }
+}
+
+bool HashTable::isIncrementalResizeEnabled() const {
+    return incremental_resize;
+}
+
+bool HashTable::isMigrating() const {
+    return old_table.size != 0;
+}
+
+bool HashTable::forEachContact(const std::function<bool(const std::shared_ptr<Contact>&)>& visitor) const {
+    for (size_t i = 0; i < table.size; i++) {
+        if (table.control[i] != EMPTY_SLOT && !visitor(table.values[i])) return false;
+    }
+    for (size_t i = migrate_cursor; i < old_table.size; i++) {
+        if (old_table.control[i] != EMPTY_SLOT && old_table.values[i] && !visitor(old_table.values[i])) return false;
+    }
+    return true;
+}
+
+bool HashTable::contains(int key) const {
+    return findSlot(table, key) != table.size || findOldSlot(key) != old_table.size;
 }
 
 bool HashTable::isDuplicate(const Contact& contact) {
@@ -124,8 +310,8 @@ bool HashTable::isDuplicate(const Contact& contact) {
         return true;
     }
     
-    // 检查学号是否重复
-    if (findByStudentId(contact. student_id) != nullptr) {
+    // 检查学号是否重复（学号索引O(1)查找）
+    if (!contact.student_id.empty() && student_id_index.contains(contact.student_id)) {
         return true;
     }
     
@@ -137,32 +323,28 @@ std:: vector<std::shared_ptr<Contact>> HashTable::findDuplicates() {
     std::unordered_set<std::string> seen_student_ids;
     std::unordered_set<int> seen_ids;
     
-    for (size_t i = 0; i < table_size; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            bool is_duplicate = false;
-            
-            // 检查ID重复
-            if (seen_ids.count(current->contact->id) > 0) {
-                is_duplicate = true;
-            } else {
-                seen_ids.insert(current->contact->id);
-            }
-            
-            // 检查学号重复
-            if (seen_student_ids.count(current->contact->student_id) > 0) {
-                is_duplicate = true;
-            } else {
-                seen_student_ids.insert(current->contact->student_id);
-            }
-            
-            if (is_duplicate) {
-                duplicates. push_back(current->contact);
-            }
-            
-            current = current->next;
+    forEachContact([&](const std::shared_ptr<Contact>& contact) {
+        bool is_duplicate = false;
+        
+        // 检查ID重复
+        if (seen_ids.count(contact->id) > 0) {
+            is_duplicate = true;
+        } else {
+            seen_ids.insert(contact->id);
         }
-    }
+        
+        // 检查学号重复
+        if (seen_student_ids.count(contact->student_id) > 0) {
+            is_duplicate = true;
+        } else {
+            seen_student_ids.insert(contact->student_id);
+        }
+        
+        if (is_duplicate) {
+            duplicates. push_back(contact);
+        }
+        return true;
+    });
     
     return duplicates;
 }
@@ -180,38 +362,66 @@ size_t HashTable::removeDuplicates() {
     return removed_count;
 }
 
-void HashTable::resize() {
-    size_t old_size = table_size;
-    std::vector<HashNode*> old_table = std::move(table);
-    
-    // 扩容为原来的2倍
-    table_size = old_size * 2;
-    table.assign(table_size, nullptr);
-    element_count = 0; // 重新计数
-    
-    // 重新插入所有元素
-    for (size_t i = 0; i < old_size; i++) {
-        HashNode* current = old_table[i];
-        while (current != nullptr) {
-            HashNode* next = current->next;
-            
-            // 重新计算哈希值并插入
-            insertHelper(current->contact, table);
-            delete current; // 删除旧节点
-            
-            current = next;
+void HashTable::resize(size_t new_capacity) {
+    Table previous = table;
+    allocateTable(table, roundUpPowerOfTwo(std::max(new_capacity, MIN_CAPACITY)));
+    
+    // 重新插入所有元素（移动 shared_ptr，不增加引用计数）
+    std::vector<std::pair<int, std::shared_ptr<Contact>>> overflow;
+    for (size_t i = 0; i < previous.size; i++) {
+        if (previous.control[i] == EMPTY_SLOT) continue;
+        
+        int key = previous.keys[i];
+        std::shared_ptr<Contact> contact = std::move(previous.values[i]);
+        if (!insertHelper(key, contact)) {
+            overflow.emplace_back(key, std::move(contact));
+        }
+    }
+    releaseTable(previous);
+    
+    // 极端情况下探测距离溢出，继续扩容后补插
+    for (auto& entry : overflow) {
+        while (!insertHelper(entry.first, entry.second)) {
+            resize(table.size * 2);
         }
     }
 }
 
-void HashTable::insertHelper(std::shared_ptr<Contact> contact, 
-                           std::vector<HashNode*>& target_table) {
-    size_t index = getIndex(contact->id);
+void HashTable::indexStudentId(const Contact& contact) {
+    if (contact.student_id.empty()) return;
     
-    HashNode* newNode = new HashNode(contact);
-    newNode->next = target_table[index];
-    target_table[index] = newNode;
-    element_count++;
+    int existing = student_id_index.find(contact.student_id);
+    if (existing < 0) {
+        student_id_index.insert(contact.student_id, contact.id);
+    } else if (existing != contact.id) {
+        // 学号已被其他联系人占用，保留先插入者，记录共用次数
+        shared_student_ids++;
+    }
+}
+
+void HashTable::unindexStudentId(const Contact& contact) {
+    if (contact.student_id.empty()) return;
+    
+    if (!student_id_index.removeIfMatches(contact.student_id, contact.id)) {
+        // 该联系人未被索引（学号与他人共用），只需减少共用计数
+        int existing = student_id_index.find(contact.student_id);
+        if (existing >= 0 && existing != contact.id && shared_student_ids > 0) {
+            shared_student_ids--;
+        }
+        return;
+    }
+    
+    if (shared_student_ids == 0) return;
+    
+    // 罕见情况：被移除的是学号共用者中被索引的那个，需找出接替者
+    forEachContact([&](const std::shared_ptr<Contact>& other) {
+        if (other->student_id == contact.student_id && other->id != contact.id) {
+            student_id_index.insert(contact.student_id, other->id);
+            shared_student_ids--;
+            return false;
+        }
+        return true;
+    });
 }
 
 size_t HashTable::size() const {
@@ -219,73 +429,169 @@ size_t HashTable::size() const {
 }
 
 size_t HashTable::capacity() const {
-    return table_size;
+    return table.size;
 }
 
 double HashTable::loadFactor() const {
-    return table_size > 0 ? static_cast<double>(element_count) / table_size : 0.0;
+    return table.size > 0 ? static_cast<double>(element_count) / table.size : 0.0;
+}
+
+void HashTable::reserve(size_t expected_count) {
+    size_t required = roundUpPowerOfTwo(static_cast<size_t>(expected_count / MAX_LOAD_FACTOR) + 1);
+    if (required > table.size) {
+        finishMigration();
+        resize(required);
+    }
+    student_id_index.reserve(expected_count);
 }
 
 void HashTable::clear() {
-    for (size_t i = 0; i < table_size; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            HashNode* next = current->next;
-            delete current;
-            current = next;
+    // 丢弃迁移中的旧表
+    releaseTable(old_table);
+    migrate_cursor = 0;
+    
+    for (size_t i = 0; i < table.size; i++) {
+        if (table.control[i] != EMPTY_SLOT) {
+            table.values[i].~shared_ptr();
         }
-        table[i] = nullptr;
     }
+    std::memset(table.control, EMPTY_SLOT, table.size);
     element_count = 0;
+    student_id_index.clear();
+    shared_student_ids = 0;
 }
 
-std::vector<std::shared_ptr<Contact>> HashTable::getAllContacts() {
-    std::vector<std::shared_ptr<Contact>> all_contacts;
-    all_contacts.reserve(element_count);
+void HashTable::writeSnapshot(SnapshotBuffer& out,
+                              const std::function<uint32_t(const Contact*)>& contact_ref) const {
+    // 迁移中的表没有单一布局，退化为保存元素列表
+    uint8_t mode = isMigrating() ? 1 : 0;
+    out.append(mode);
+    out.append(static_cast<uint64_t>(element_count));
     
-    for (size_t i = 0; i < table_size; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            all_contacts.push_back(current->contact);
-            current = current->next;
-        }
+    if (mode == 1) {
+        forEachContact([&](const std::shared_ptr<Contact>& contact) {
+            out.append(contact_ref(contact.get()));
+            return true;
+        });
+        return;
     }
     
-    return all_contacts;
+    out.append(static_cast<uint64_t>(table.size));
+    out.appendBytes(table.control, table.size);
+    for (size_t i = 0; i < table.size; i++) {
+        if (table.control[i] == EMPTY_SLOT) continue;
+        out.append(static_cast<int32_t>(table.keys[i]));
+        out.append(contact_ref(table.values[i].get()));
+    }
+    out.append(static_cast<uint64_t>(shared_student_ids));
+    student_id_index.writeSnapshot(out);
 }
 
-size_t HashTable::getChainLength(size_t index) const {
-    if (index >= table_size) return 0;
+bool HashTable::restoreSnapshot(const SnapshotView& in, size_t& offset,
+                                const std::vector<std::shared_ptr<Contact>>& contacts) {
+    uint8_t mode = 0;
+    uint64_t count = 0;
+    if (!in.read(offset, mode) || !in.read(offset, count) || count > contacts.size()) {
+        return false;
+    }
+    
+    if (mode == 1) {
+        std::vector<uint32_t> refs(count);
+        for (auto& ref : refs) {
+            if (!in.read(offset, ref) || ref >= contacts.size()) return false;
+        }
+        clear();
+        reserve(count);
+        for (uint32_t ref : refs) {
+            insert(contacts[ref]);
+        }
+        return true;
+    }
+    if (mode != 0) return false;
+    
+    uint64_t capacity = 0;
+    if (!in.read(offset, capacity) || capacity < MIN_CAPACITY || (capacity & (capacity - 1)) != 0 ||
+        capacity > in.size()) {
+        return false;
+    }
+    
+    Table restored;
+    allocateTable(restored, capacity);
+    size_t restored_count = 0;
+    bool valid = in.readBytes(offset, restored.control, capacity);
+    size_t i = 0;
+    for (; valid && i < capacity; i++) {
+        if (restored.control[i] == EMPTY_SLOT) continue;
+        
+        int32_t key = 0;
+        uint32_t ref = 0;
+        if (!in.read(offset, key) || !in.read(offset, ref) || ref >= contacts.size() ||
+            !contacts[ref] || contacts[ref]->id != key) {
+            valid = false;
+            break;
+        }
+        restored.keys[i] = key;
+        new (&restored.values[i]) std::shared_ptr<Contact>(contacts[ref]);
+        restored_count++;
+    }
     
-    size_t length = 0;
-    HashNode* current = table[index];
-    while (current != nullptr) {
-        length++;
-        current = current->next;
+    uint64_t shared = 0;
+    StringIndex restored_student_index;
+    valid = valid && restored_count == count && in.read(offset, shared) &&
+            restored_student_index.restoreSnapshot(in, offset);
+    if (!valid) {
+        // 未构造值的槽位不能交给 releaseTable 析构
+        if (i < capacity) {
+            std::memset(restored.control + i, EMPTY_SLOT, capacity - i);
+        }
+        releaseTable(restored);
+        return false;
     }
-    return length;
+    
+    releaseTable(old_table);
+    releaseTable(table);
+    table = restored;
+    migrate_cursor = 0;
+    element_count = restored_count;
+    shared_student_ids = shared;
+    student_id_index = std::move(restored_student_index);
+    return true;
 }
 
-size_t HashTable::getMaxChainLength() const {
+std::vector<std::shared_ptr<Contact>> HashTable::getAllContacts() const {
+    std::vector<std::shared_ptr<Contact>> all_contacts;
+    all_contacts.reserve(element_count);
+    
+    forEachContact([&](const std::shared_ptr<Contact>& contact) {
+        all_contacts.push_back(contact);
+        return true;
+    });
+    
+    return all_contacts;
+}
+
+size_t HashTable::getProbeLength(size_t index) const {
+    if (index >= table.size || table.control[index] == EMPTY_SLOT) return 0;
+    return table.control[index] - 1;
+}
+
+size_t HashTable::getMaxProbeLength() const {
     size_t max_length = 0;
-    for (size_t i = 0; i < table_size; i++) {
-        max_length = std::max(max_length, getChainLength(i));
+    for (size_t i = 0; i < table.size; i++) {
+        max_length = std::max(max_length, getProbeLength(i));
     }
     return max_length;
 }
 
-double HashTable::getAverageChainLength() const {
+double HashTable::getAverageProbeLength() const {
     if (element_count == 0) return 0.0;
     
-    size_t non_empty_buckets = 0;
-    for (size_t i = 0; i < table_size; i++) {
-        if (table[i] != nullptr) {
-            non_empty_buckets++;
-        }
+    size_t total_length = 0;
+    for (size_t i = 0; i < table.size; i++) {
+        total_length += getProbeLength(i);
     }
     
-    return non_empty_buckets > 0 ? 
-           static_cast<double>(element_count) / non_empty_buckets : 0.0;
+    return static_cast<double>(total_length) / element_count;
 }
 
 void HashTable:: printStatistics() const {
@@ -293,48 +599,41 @@ void HashTable:: printStatistics() const {
     std:: cout << "容量: " << capacity() << "\n";
     std::cout << "元素数量: " << size() << "\n";
     std::cout << "负载因子: " << loadFactor() << "\n";
-    std::cout << "最大链长度:  " << getMaxChainLength() << "\n";
-    std:: cout << "平均链长度: " << getAverageChainLength() << "\n";
-    
-    // 计算空桶数量
-    size_t empty_buckets = 0;
-    for (size_t i = 0; i < table_size; i++) {
-        if (table[i] == nullptr) {
-            empty_buckets++;
+    std::cout << "最大探测距离:  " << getMaxProbeLength() << "\n";
+    std:: cout << "平均探测距离: " << getAverageProbeLength() << "\n";
+    
+    // 计算空槽数量
+    size_t empty_slots = 0;
+    for (size_t i = 0; i < table.size; i++) {
+        if (table.control[i] == EMPTY_SLOT) {
+            empty_slots++;
         }
     }
-    std::cout << "空桶数量:  " << empty_buckets << " (" 
-              << (static_cast<double>(empty_buckets) / table_size * 100) << "%)\n";
+    std::cout << "空槽数量:  " << empty_slots << " (" 
+              << (static_cast<double>(empty_slots) / table.size * 100) << "%)\n";
+    if (isMigrating()) {
+        std::cout << "渐进式迁移中: 旧表容量 " << old_table.size << ", 已迁移 " << migrate_cursor << " 个槽位\n";
+    }
     std::cout << "========================\n\n";
 }
 
 void HashTable::printDistribution() const {
     std::cout << "=== 哈希表分布情况 ===\n";
     
-    for (size_t i = 0; i < std::min(table_size, size_t(20)); i++) { // 只显示前20个桶
-        size_t chain_length = getChainLength(i);
-        std::cout << "桶 " << i << ": ";
+    for (size_t i = 0; i < std::min(table.size, size_t(20)); i++) { // 只显示前20个槽
+        std::cout << "槽 " << i << ": ";
         
-        if (chain_length == 0) {
+        if (table.control[i] == EMPTY_SLOT) {
             std:: cout << "[空]";
         } else {
-            std::cout << "[" << chain_length << " 个元素] ";
-            HashNode* current = table[i];
-            int count = 0;
-            while (current != nullptr && count < 3) { // 只显示前3个元素
-                std::cout << current->contact->name << "(" << current->contact->id << ") ";
-                current = current->next;
-                count++;
-            }
-            if (chain_length > 3) {
-                std::cout << "...  ";
-            }
+            std::cout << table.values[i]->name << "(" << table.values[i]->id << ") "
+                      << "[探测距离 " << getProbeLength(i) << "]";
         }
         std::cout << "\n";
     }
     
-    if (table_size > 20) {
-        std::cout << "... (还有 " << (table_size - 20) << " 个桶)\n";
+    if (table.size > 20) {
+        std::cout << "... (还有 " << (table.size - 20) << " 个槽)\n";
     }
     std::cout << "====================\n\n";
-}
\ No newline at end of file
+}
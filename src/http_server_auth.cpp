@@ -1,10 +1,18 @@
 #include "../include/http_server_auth.h"
+#include "../include/logger.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <regex>
+#include <algorithm>
+#include <cctype>
 #include <memory>
+#include <charconv>
+#include <climits>
+#include <csignal>
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <unistd.h>
 
@@ -102,13 +110,13 @@ void AuthMiddleware::recordLoginFailure(const std::string& client_ip) {
     
     login_attempts[client_ip]++;
     
-    std::cout << "登录失败记录: IP=" << client_ip 
-              << " 失败次数=" << login_attempts[client_ip] << std::endl;
+    LOG_INFO("登录失败记录: IP=" << client_ip 
+             << " 失败次数=" << login_attempts[client_ip]);
     
     // 达到最大失败次数，进行锁定
     if (login_attempts[client_ip] >= MAX_LOGIN_ATTEMPTS) {
         lockout_time[client_ip] = std::chrono::system_clock::now();
-        std::cout << "警告: IP " << client_ip << " 已被锁定 " << LOCKOUT_DURATION_SECONDS << " 秒" << std::endl;
+        LOG_WARN("IP " << client_ip << " 已被锁定 " << LOCKOUT_DURATION_SECONDS << " 秒");
     }
 }
 
@@ -290,19 +298,149 @@ HttpResponse AuthRoutes:: handleRefreshToken(const HttpRequest& request) {
 
 // === AuthenticatedHttpServer 实现 ===
 
+const int AuthenticatedHttpServer::SNAPSHOT_INTERVAL_SECONDS = 300;  // 5分钟
+const int AuthenticatedHttpServer::DIRECTORY_REFRESH_SECONDS = 2;
+const size_t AuthenticatedHttpServer::SUGGESTION_LIMIT = 3;
+const size_t AuthenticatedHttpServer::MAX_SUGGESTION_LIMIT = 20;
+const size_t AuthenticatedHttpServer::SEARCH_CACHE_CAPACITY = 4096;
+const size_t AuthenticatedHttpServer::SEARCH_CACHE_SHARDS = 8;
+
+namespace {
+
+const char* CONTACTS_DB_PATH = "data/contacts.db";
+const char* ACTIVITIES_DB_PATH = "data/activities.db";
+const char* FRONTEND_ROOT = "frontend";
+const char* INDEX_PAGE = "/v8.1.html";
+
+// 请求路径对应的静态资源（相对前端目录），非静态资源返回空
+std::string staticAssetPath(const std::string& path) {
+    if (path == "/" || path == "/index.html") {
+        return INDEX_PAGE;
+    }
+    if (path.find("/css/") == 0 || path.find("/js/") == 0) {
+        return path;
+    }
+    return "";
+}
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n <= 0) return false;
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 读取数据库变更序号，失败返回-1
+int64_t readChangeSequence(const std::string& path) {
+    SQLiteManager db(path);
+    if (!db.init()) return -1;
+    return db.getChangeSequence();
+}
+
+// 冲突时的替代安排：[{"location": ..., "start_time": ..., "end_time": ...}, ...]
+void appendSuggestionsJson(std::ostringstream& json, const std::vector<Activity>& suggestions) {
+    json << "[";
+    for (size_t i = 0; i < suggestions.size(); ++i) {
+        json << "{"
+             << "\"location\": \"" << suggestions[i].location << "\","
+             << "\"start_time\": \"" << suggestions[i].start_time << "\","
+             << "\"end_time\": \"" << suggestions[i].end_time << "\""
+             << "}";
+        if (i < suggestions.size() - 1) json << ",";
+    }
+    json << "]";
+}
+
+Histogram& routeLatency(const std::string& route) {
+    return MetricsRegistry::global().histogram("http_request_duration_seconds", "HTTP request handling latency by route",
+                                               MetricsRegistry::label("route", route));
+}
+
+// 请求体中的可选字段："field": "value"，存在时写入 value
+bool readStringField(const std::string& body, const std::string& field, std::string& value) {
+    std::regex pattern("\"" + field + "\"\\s*:\\s*\"([^\"]*)\"");
+    std::smatch matches;
+    if (!std::regex_search(body, matches, pattern)) return false;
+    value = matches[1].str();
+    return true;
+}
+
+// 解析请求体中的十进制数字串，超出 max 时返回 false（正则只保证是数字，位数不限）
+bool parseBounded(const std::string& digits, unsigned long long max, unsigned long long& value) {
+    auto parsed = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    return parsed.ec == std::errc() && parsed.ptr == digits.data() + digits.size() && value <= max;
+}
+
+// 整数字段不存在时保持 value 不变；存在但超出 int 范围时返回 false，由调用方返回 400
+bool readIntField(const std::string& body, const std::string& field, int& value) {
+    std::regex pattern("\"" + field + "\"\\s*:\\s*(\\d+)");
+    std::smatch matches;
+    if (!std::regex_search(body, matches, pattern)) return true;
+    unsigned long long parsed = 0;
+    if (!parseBounded(matches[1].str(), INT_MAX, parsed)) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// 路径参数 {id:int} 最多 18 位，超出 int 范围的值不能截断成另一个ID，按不存在处理
+bool readIdParam(const AuthenticatedRequest& request, int& id) {
+    int64_t number = request.params.getInt("id");
+    if (number < 1 || number > INT_MAX) return false;
+    id = static_cast<int>(number);
+    return true;
+}
+
+// 请求头名称不区分大小写
+const std::string* findHeader(const HttpRequest& request, const std::string& name) {
+    for (const auto& header : request.headers) {
+        if (header.first.size() == name.size() &&
+            std::equal(name.begin(), name.end(), header.first.begin(),
+                       [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
 AuthenticatedHttpServer::AuthenticatedHttpServer(int server_port) 
-    : port(server_port), running(false) {
+    : port(server_port), running(false), listen_fd(-1),
+      snapshot_path("data/index.snapshot"), last_snapshot_time(std::chrono::steady_clock::now()),
+      directory_path("data/contacts.dir"), last_directory_refresh(std::chrono::steady_clock::now()) {
     
     // 初始化所有管理器
         auth_manager.reset(new AuthManager("data/auth.db"));
     auth_middleware.reset(new AuthMiddleware(auth_manager.get()));
     auth_routes.reset(new AuthRoutes(auth_manager.get()));
-    contact_manager.reset(new ContactManager("data/contacts.db"));
-    activity_manager.reset(new ActivityManager("data/activities.db"));
+    contact_manager.reset(new ContactManager(CONTACTS_DB_PATH));
+    activity_manager.reset(new ActivityManager(ACTIVITIES_DB_PATH));
+    search_cache.reset(new LRUCache<std::string, std::string>(SEARCH_CACHE_CAPACITY, SEARCH_CACHE_SHARDS));
+    response_cache.reset(new ResponseCache());
+    static_assets.reset(new StaticAssetStore(FRONTEND_ROOT));
+    
+    static_latency = &routeLatency("static");
+    unmatched_latency = &routeLatency("unmatched");
+    for (int i = 0; i < 5; i++) {
+        responses_by_class[i] = &MetricsRegistry::global().counter(
+            "http_responses_total", "HTTP responses by status class",
+            MetricsRegistry::label("code", std::to_string(i + 1) + "xx"));
+    }
     
     std::vector<std::string> resources = {"报告厅", "体育馆", "实验室", "大礼堂", "会议室A", "会议室B"};
         conflict_detector.reset(new ConflictDetector());
     conflict_detector->initialize(resources);
+    conflict_detector->setResourceCapacity("体育馆", 3);    // 3 块场地
+    conflict_detector->setResourceCapacity("实验室", 40);   // 40 个座位
+    
+    // 操作日志：各管理器的修改统一记录，支持撤销/重做
+    operation_log.reset(new OperationLog("data/operations.log"));
+    contact_manager->setOperationLog(operation_log.get());
+    activity_manager->setOperationLog(operation_log.get());
+    conflict_detector->setOperationLog(operation_log.get());
 }
 
 AuthenticatedHttpServer::~AuthenticatedHttpServer() {
@@ -318,25 +456,101 @@ bool AuthenticatedHttpServer::initialize() {
         return false;
     }
     
-    // 初始化联系人管理器
-    if (!contact_manager->initialize()) {
+    // 打开操作日志（失败时撤销/重做仍在内存中可用）
+    operation_log->open();
+    
+    // 初始化联系人与活动管理器（优先从快照恢复索引）
+    if (!initializeIndexes()) {
+        return false;
+    }
+    
+    // 设置路由
+    setupRoutes();
+    
+    std::cout << "✅ 认证HTTP服务器初始化成功" << std::endl;
+    return true;
+}
+
+bool AuthenticatedHttpServer::initializeIndexes() {
+    IndexSnapshotFile snapshot;
+    bool snapshot_valid = snapshot.open(snapshot_path);
+    
+    // 快照记录的变更序号与数据库一致才可直接使用，否则视为过期
+    bool snapshot_fresh = false;
+    if (snapshot_valid) {
+        int64_t contacts_seq = readChangeSequence(CONTACTS_DB_PATH);
+        int64_t activities_seq = readChangeSequence(ACTIVITIES_DB_PATH);
+        snapshot_fresh = contacts_seq >= 0 && activities_seq >= 0 &&
+                         static_cast<uint64_t>(contacts_seq) == snapshot.contactsSequence() &&
+                         static_cast<uint64_t>(activities_seq) == snapshot.activitiesSequence();
+        if (!snapshot_fresh) {
+            std::cout << "索引快照已过期，从数据库重建" << std::endl;
+        }
+    }
+    
+    bool contacts_ready = snapshot_fresh ? contact_manager->initializeFromSnapshot(snapshot)
+                                         : contact_manager->initialize();
+    if (!contacts_ready) {
         std:: cerr << "❌ 联系人管理器初始化失败" << std::endl;
         return false;
     }
     
-    // 初始化活动管理器
-    if (!activity_manager->initialize()) {
+    bool activities_ready = snapshot_fresh ? activity_manager->initializeFromSnapshot(snapshot)
+                                           : activity_manager->initialize();
+    if (!activities_ready) {
         std::cerr << "❌ 活动管理器初始化失败" << std::endl;
         return false;
     }
     
-    // 设置路由
-    setupRoutes();
+    // 预约只存在于内存，校验通过的快照无论新旧都用于恢复预约
+    if (snapshot_valid) {
+        conflict_detector->restoreSnapshot(snapshot);
+    }
     
-    std::cout << "✅ 认证HTTP服务器初始化成功" << std::endl;
+    last_snapshot_time = std::chrono::steady_clock::now();
+    
+    // 通讯录生成失败不影响启动，搜索回退到索引路径
+    contact_manager->refreshDirectory(directory_path);
+    last_directory_refresh = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool AuthenticatedHttpServer::saveSnapshot() {
+    int64_t contacts_seq = readChangeSequence(CONTACTS_DB_PATH);
+    int64_t activities_seq = readChangeSequence(ACTIVITIES_DB_PATH);
+    if (contacts_seq < 0 || activities_seq < 0) {
+        std::cerr << "无法读取数据库变更序号，跳过快照" << std::endl;
+        return false;
+    }
+    
+    IndexSnapshotWriter writer;
+    contact_manager->writeSnapshot(writer);
+    activity_manager->writeSnapshot(writer);
+    conflict_detector->writeSnapshot(writer);
+    
+    last_snapshot_time = std::chrono::steady_clock::now();
+    if (!writer.writeToFile(snapshot_path, contacts_seq, activities_seq)) {
+        return false;
+    }
+    std::cout << "💾 索引快照已保存: " << snapshot_path << std::endl;
     return true;
 }
 
+void AuthenticatedHttpServer::runMaintenance() {
+    auto now = std::chrono::steady_clock::now();
+    
+    // 通讯录过期时限频重新生成，避免连续写入时每个请求都重写文件
+    if (!contact_manager->currentDirectory() &&
+        now - last_directory_refresh >= std::chrono::seconds(DIRECTORY_REFRESH_SECONDS)) {
+        contact_manager->refreshDirectory(directory_path);
+        last_directory_refresh = now;
+    }
+    
+    if (now - last_snapshot_time >= std::chrono::seconds(SNAPSHOT_INTERVAL_SECONDS)) {
+        saveSnapshot();
+    }
+}
+
 void AuthenticatedHttpServer::setupRoutes() {
     std::cout << "设置API路由..." << std::endl;
     
@@ -350,11 +564,11 @@ void AuthenticatedHttpServer::setupRoutes() {
     });
     
     registerPublicRoute("GET /", [this](const HttpRequest& req) {
-        return serveStaticFile("frontend/v8.1.html");
+        return serveStaticFile(req, INDEX_PAGE);
     });
     
     registerPublicRoute("GET /index.html", [this](const HttpRequest& req) {
-        return serveStaticFile("frontend/v8.1.html");
+        return serveStaticFile(req, INDEX_PAGE);
     });
     
     // === 受保护路由（需要认证）===
@@ -386,11 +600,11 @@ void AuthenticatedHttpServer::setupRoutes() {
         return handleCreateContact(req);
     });
     
-    registerProtectedRoute("PUT /api/contacts", [this](const AuthenticatedRequest& req) {
+    registerProtectedRoute("PUT /api/contacts/{id:int}", [this](const AuthenticatedRequest& req) {
         return handleUpdateContact(req);
     });
     
-    registerProtectedRoute("DELETE /api/contacts", [this](const AuthenticatedRequest& req) {
+    registerProtectedRoute("DELETE /api/contacts/{id:int}", [this](const AuthenticatedRequest& req) {
         return handleDeleteContact(req);
     });
     
@@ -407,11 +621,11 @@ void AuthenticatedHttpServer::setupRoutes() {
         return handleCreateActivity(req);
     });
     
-    registerProtectedRoute("PUT /api/activities", [this](const AuthenticatedRequest& req) {
+    registerProtectedRoute("PUT /api/activities/{id:int}", [this](const AuthenticatedRequest& req) {
         return handleUpdateActivity(req);
     });
     
-    registerProtectedRoute("DELETE /api/activities", [this](const AuthenticatedRequest& req) {
+    registerProtectedRoute("DELETE /api/activities/{id:int}", [this](const AuthenticatedRequest& req) {
         return handleDeleteActivity(req);
     });
     
@@ -425,6 +639,19 @@ void AuthenticatedHttpServer::setupRoutes() {
         return handleGetSchedule(req);
     });
     
+    registerProtectedRoute("POST /api/reservations", [this](const AuthenticatedRequest& req) {
+        if (!auth_middleware->authorize(req, UserRole::ADMIN)) {
+            HttpResponse response(403, "Forbidden");
+            response.setJson(buildErrorResponse("Admin access required"));
+            return response;
+        }
+        return handleCreateReservation(req);
+    });
+    
+    registerProtectedRoute("POST /api/schedule/suggest", [this](const AuthenticatedRequest& req) {
+        return handleSuggestSlots(req);
+    });
+    
     registerProtectedRoute("POST /api/schedule/check-conflict", [this](const AuthenticatedRequest& req) {
         if (!auth_middleware->authorize(req, UserRole::ADMIN)) {
             HttpResponse response(403, "Forbidden");
@@ -434,6 +661,35 @@ void AuthenticatedHttpServer::setupRoutes() {
         return handleCheckConflict(req);
     });
     
+    // 撤销/重做API（操作日志是全局的，会撤销其他用户的修改，管理员专用）
+    registerProtectedRoute("POST /api/undo", [this](const AuthenticatedRequest& req) {
+        if (!auth_middleware->authorize(req, UserRole::ADMIN)) {
+            HttpResponse response(403, "Forbidden");
+            response.setJson(buildErrorResponse("Admin access required"));
+            return response;
+        }
+        return handleUndo(req);
+    });
+    
+    registerProtectedRoute("POST /api/redo", [this](const AuthenticatedRequest& req) {
+        if (!auth_middleware->authorize(req, UserRole::ADMIN)) {
+            HttpResponse response(403, "Forbidden");
+            response.setJson(buildErrorResponse("Admin access required"));
+            return response;
+        }
+        return handleRedo(req);
+    });
+    
+    // 运行指标（管理员专用）
+    registerProtectedRoute("GET /api/metrics", [this](const AuthenticatedRequest& req) {
+        if (!auth_middleware->authorize(req, UserRole::ADMIN)) {
+            HttpResponse response(403, "Forbidden");
+            response.setJson(buildErrorResponse("Admin access required"));
+            return response;
+        }
+        return handleGetMetrics(req);
+    });
+    
     std::cout << "✅ 路由设置完成" << std::endl;
 }
 
@@ -443,6 +699,10 @@ bool AuthenticatedHttpServer::start() {
         return true;
     }
     
+    // 客户端提前断开时 sendfile/writev 会触发 SIGPIPE，默认处理是终止进程；
+    // 忽略后这些调用返回 EPIPE，按普通写失败关闭连接（嵌入进程的压测工具同样受保护）
+    std::signal(SIGPIPE, SIG_IGN);
+    
     running = true;
     server_thread.reset(new std::thread(&AuthenticatedHttpServer::serverLoop, this));
     
@@ -460,10 +720,26 @@ void AuthenticatedHttpServer::stop() {
     if (!running) return;
     
     running = false;
+    
+    // 关闭监听套接字使阻塞中的 accept 返回
+    int fd = listen_fd.exchange(-1);
+    if (fd >= 0) {
+        shutdown(fd, SHUT_RDWR);
+    }
     if (server_thread && server_thread->joinable()) {
         server_thread->join();
     }
+    if (fd >= 0) {
+        close(fd);
+    }
     
+    // 正常关闭时保存快照，下次启动直接加载
+    saveSnapshot();
+    search_cache->printStats();
+    response_cache->printStats();
+    
+    // 异步日志写完后再打印停止信息，避免输出交错
+    Logger::instance().flush();
     std:: cout << "⏹️ 认证HTTP服务器已停止" << std::endl;
 }
 
@@ -473,12 +749,22 @@ bool AuthenticatedHttpServer::isRunning() const {
 
 void AuthenticatedHttpServer::registerPublicRoute(const std::string& route, 
                                                  std::function<HttpResponse(const HttpRequest&)> handler) {
-    public_routes[route] = handler;
+    Route entry;
+    entry.public_handler = handler;
+    entry.latency = &routeLatency(route);
+    if (!router.add(route, std::move(entry))) {
+        std::cerr << "❌ 路由注册失败: " << route << std::endl;
+    }
 }
 
 void AuthenticatedHttpServer::registerProtectedRoute(const std::string& route, 
                                                     std:: function<HttpResponse(const AuthenticatedRequest&)> handler) {
-    protected_routes[route] = handler;
+    Route entry;
+    entry.protected_handler = handler;
+    entry.latency = &routeLatency(route);
+    if (!router.add(route, std::move(entry))) {
+        std::cerr << "❌ 路由注册失败: " << route << std::endl;
+    }
 }
 
 void AuthenticatedHttpServer::serverLoop() {
@@ -503,11 +789,13 @@ void AuthenticatedHttpServer::serverLoop() {
         return;
     }
     
-    if (listen(server_fd, 10) < 0) {
+    // 连接队列太短时突发连接的 SYN 被内核丢弃，客户端 1 秒后才重传
+    if (listen(server_fd, SOMAXCONN) < 0) {
         std:: cerr << "❌ 监听失败" << std::endl;
         close(server_fd);
         return;
     }
+    listen_fd = server_fd;
     
     while (running) {
         struct sockaddr_in client_addr;
@@ -525,18 +813,29 @@ void AuthenticatedHttpServer::serverLoop() {
             // 解析HTTP请求
             HttpRequest request = parseHttpRequest(std::string(buffer, bytes_read));
             
-            // 处理请求
-            HttpResponse response = handleRequest(request);
-            
-            // 发送响应
-            std::string response_str = buildHttpResponse(response);
-            write(client_fd, response_str.c_str(), response_str.length());
+            // 静态资源直接从内存或文件描述符发送，不经过 HttpResponse 拷贝
+            if (!sendStaticFile(client_fd, request)) {
+                // 处理请求
+                HttpResponse response = handleRequest(request);
+                
+                // 发送响应
+                countResponse(response.status_code);
+                std::string response_str = buildHttpResponse(response);
+                write(client_fd, response_str.c_str(), response_str.length());
+            }
         }
         
         close(client_fd);
+        
+        // 请求间隙执行维护（管理器均在本线程访问）
+        runMaintenance();
     }
     
-    close(server_fd);
+    // 由 stop() 关闭时套接字已被接管
+    int fd = listen_fd.exchange(-1);
+    if (fd >= 0) {
+        close(fd);
+    }
 }
 
 HttpResponse AuthenticatedHttpServer::handleRequest(const HttpRequest& request) {
@@ -547,19 +846,21 @@ HttpResponse AuthenticatedHttpServer::handleRequest(const HttpRequest& request)
         return response;
     }
     
-    std::string route_key = request.method + " " + request.path;
+    RouteParams params;
+    RadixRouter<Route>::MatchStatus status;
+    const Route* route = router.match(parseHttpMethod(request.method), request.path, params, &status);
+    ScopedTimer timer(route ? *route->latency : *unmatched_latency);
     
-    // 检查公开路由
-    auto public_it = public_routes. find(route_key);
-    if (public_it != public_routes.end()) {
-        return public_it->second(request);
+    // 公开路由
+    if (route && route->public_handler) {
+        return route->public_handler(request);
     }
     
-    // 检查受保护路由
-    auto protected_it = protected_routes.find(route_key);
-    if (protected_it != protected_routes.end()) {
-        // 创建认证请求
+    // 受保护路由
+    if (route) {
+        // 创建认证请求（路径参数仍指向 request.path，处理期间有效）
         AuthenticatedRequest auth_request(request);
+        auth_request.params = params;
         
         // 验证认证
         if (! auth_middleware->authenticate(auth_request)) {
@@ -568,19 +869,20 @@ HttpResponse AuthenticatedHttpServer::handleRequest(const HttpRequest& request)
             return response;
         }
         
-        return protected_it->second(auth_request);
+        return route->protected_handler(auth_request);
+    }
+    
+    if (status == RadixRouter<Route>::METHOD_NOT_ALLOWED) {
+        HttpResponse response(405, "Method Not Allowed");
+        response.setJson(buildErrorResponse("Method not allowed", 405));
+        return response;
     }
     
     // 尝试静态文件服务
     if (request.method == "GET") {
-        if (request.path == "/" || request.path == "/index.html") {
-            return serveStaticFile("frontend/index-modern.html");
-        }
-        if (request.path.find("/css/") == 0) {
-            return serveStaticFile("frontend" + request.path);
-        }
-        if (request.path.find("/js/") == 0) {
-            return serveStaticFile("frontend" + request.path);
+        std::string asset_path = staticAssetPath(request.path);
+        if (!asset_path.empty()) {
+            return serveStaticFile(request, asset_path);
         }
     }
     
@@ -593,52 +895,51 @@ HttpResponse AuthenticatedHttpServer::handleRequest(const HttpRequest& request)
 // API处理器实现
 
 HttpResponse AuthenticatedHttpServer::handleGetContacts(const AuthenticatedRequest& request) {
-    auto contacts = contact_manager->getAllContacts();
-    
-    std::ostringstream json;
-    json << "[";
-    for (size_t i = 0; i < contacts.size(); ++i) {
-        json << "{"
-             << "\"id\": " << contacts[i].id << ","
-             << "\"name\": \"" << contacts[i].name << "\","
-             << "\"phone\": \"" << contacts[i].phone << "\","
-             << "\"email\": \"" << contacts[i].email << "\"";
-        if (!contacts[i].department.empty()) {
-            json << ",\"department\": \"" << contacts[i].department << "\"";
-        }
-        if (!contacts[i].student_id.empty()) {
-            json << ",\"student_id\": \"" << contacts[i].student_id << "\"";
+    return serveCached(request, "c" + std::to_string(contact_manager->getGeneration()), [this]() {
+        auto contacts = contact_manager->getAllContacts();
+        
+        std::ostringstream json;
+        json << "[";
+        for (size_t i = 0; i < contacts.size(); ++i) {
+            json << "{"
+                 << "\"id\": " << contacts[i].id << ","
+                 << "\"name\": \"" << contacts[i].name << "\","
+                 << "\"phone\": \"" << contacts[i].phone << "\","
+                 << "\"email\": \"" << contacts[i].email << "\"";
+            if (!contacts[i].department.empty()) {
+                json << ",\"department\": \"" << contacts[i].department << "\"";
+            }
+            if (!contacts[i].student_id.empty()) {
+                json << ",\"student_id\": \"" << contacts[i].student_id << "\"";
+            }
+            json << "}";
+            if (i < contacts. size() - 1) json << ",";
         }
-        json << "}";
-        if (i < contacts. size() - 1) json << ",";
-    }
-    json << "]";
-    
-    HttpResponse response;
-    response.setJson(json.str());
-    return response;
+        json << "]";
+        return json.str();
+    });
 }
 
 HttpResponse AuthenticatedHttpServer::handleGetActivities(const AuthenticatedRequest& request) {
-    auto activities = activity_manager->getAllActivities();
-    
-    std::ostringstream json;
-    json << "[";
-    for (size_t i = 0; i < activities.size(); ++i) {
-        json << "{"
-             << "\"id\": " << activities[i].id << ","
-             << "\"name\": \"" << activities[i].name << "\","
-             << "\"location\": \"" << activities[i].location << "\","
-             << "\"start_time\": \"" << activities[i].start_time << "\","
-             << "\"end_time\": \"" << activities[i].end_time << "\""
-             << "}";
-        if (i < activities.size() - 1) json << ",";
-    }
-    json << "]";
-    
-    HttpResponse response;
-    response.setJson(json.str());
-    return response;
+    return serveCached(request, "a" + std::to_string(activity_manager->getGeneration()), [this]() {
+        auto activities = activity_manager->getAllActivities();
+        
+        std::ostringstream json;
+        json << "[";
+        for (size_t i = 0; i < activities.size(); ++i) {
+            json << "{"
+                 << "\"id\": " << activities[i].id << ","
+                 << "\"name\": \"" << activities[i].name << "\","
+                 << "\"location\": \"" << activities[i].location << "\","
+                 << "\"start_time\": \"" << activities[i].start_time << "\","
+                 << "\"end_time\": \"" << activities[i].end_time << "\","
+                 << "\"max_participants\": " << activities[i].max_participants
+                 << "}";
+            if (i < activities.size() - 1) json << ",";
+        }
+        json << "]";
+        return json.str();
+    });
 }
 
 HttpResponse AuthenticatedHttpServer::handleCreateContact(const AuthenticatedRequest& request) {
@@ -749,11 +1050,17 @@ HttpResponse AuthenticatedHttpServer::handleCreateActivity(const AuthenticatedRe
     end_time = matches[1].str();
     
     if (std::regex_search(request.body, matches, max_participants_regex)) {
-        max_participants = std::stoi(matches[1].str());
+        unsigned long long requested = 0;
+        if (!parseBounded(matches[1].str(), INT_MAX, requested)) {
+            HttpResponse response(400, "Bad Request");
+            response.setJson(buildErrorResponse("Invalid max_participants field"));
+            return response;
+        }
+        max_participants = static_cast<int>(requested);
     }
     
     // 创建活动对象
-    Activity activity(0, name, location, start_time, end_time);
+    Activity activity(0, name, location, start_time, end_time, max_participants);
     
     // 检查冲突
     if (activity_manager->hasTimeConflict(activity)) {
@@ -771,7 +1078,9 @@ HttpResponse AuthenticatedHttpServer::handleCreateActivity(const AuthenticatedRe
                  << "}";
             if (i < conflicts.size() - 1) json << ",";
         }
-        json << "]}";
+        json << "],\"suggestions\": ";
+        appendSuggestionsJson(json, activity_manager->suggestAlternatives(activity, SUGGESTION_LIMIT, true));
+        json << "}";
         
         HttpResponse response(409, "Conflict");
         response.setJson(json.str());
@@ -799,8 +1108,8 @@ HttpResponse AuthenticatedHttpServer::handleCheckConflict(const AuthenticatedReq
     
     // 解析JSON请求体（使用自定义原始字符串分隔符）
     std::regex location_regex(R"REGEX("location"\s*:\s*"([^"]+)")REGEX");
-    std::regex start_time_regex(R"REGEX("start_time"\s*:\s*"([^"]+)" )REGEX");
-    std::regex end_time_regex(R"REGEX("end_time"\s*:\s*"([^"]+)" )REGEX");
+    std::regex start_time_regex(R"REGEX("start_time"\s*:\s*"([^"]+)")REGEX");
+    std::regex end_time_regex(R"REGEX("end_time"\s*:\s*"([^"]+)")REGEX");
     
     std::smatch matches;
     std::string location, start_time, end_time;
@@ -859,40 +1168,230 @@ HttpResponse AuthenticatedHttpServer::handleCheckConflict(const AuthenticatedReq
     return response;
 }
 
-HttpResponse AuthenticatedHttpServer::handleGetSchedule(const AuthenticatedRequest& request) {
-    // 获取资源调度信息
-    auto resources = conflict_detector->getAvailableResources();
+HttpResponse AuthenticatedHttpServer::handleSuggestSlots(const AuthenticatedRequest& request) {
+    if (request.method != "POST") {
+        HttpResponse response(405, "Method Not Allowed");
+        response.setJson(buildErrorResponse("Only POST method allowed"));
+        return response;
+    }
     
-    std::ostringstream json;
-    json << "{"
-         << "\"success\": true,"
-         << "\"resources\": [";
+    std::regex location_regex(R"REGEX("location"\s*:\s*"([^"]+)")REGEX");
+    std::regex start_time_regex(R"REGEX("start_time"\s*:\s*"([^"]+)")REGEX");
+    std::regex end_time_regex(R"REGEX("end_time"\s*:\s*"([^"]+)")REGEX");
+    std::regex limit_regex(R"REGEX("limit"\s*:\s*(\d+))REGEX");
+    std::regex any_location_regex(R"REGEX("any_location"\s*:\s*true)REGEX");
     
-    for (size_t i = 0; i < resources. size(); ++i) {
-        json << "\"" << resources[i] << "\"";
-        if (i < resources. size() - 1) json << ",";
+    std::smatch location_match, start_match, end_match, matches;
+    if (!std::regex_search(request.body, location_match, location_regex) ||
+        !std::regex_search(request.body, start_match, start_time_regex) ||
+        !std::regex_search(request.body, end_match, end_time_regex)) {
+        HttpResponse response(400, "Bad Request");
+        response.setJson(buildErrorResponse("Missing location, start_time or end_time field"));
+        return response;
     }
     
-    json << "],"
-         << "\"total_reservations\": " << conflict_detector->getTotalReservations()
-         << "}";
+    size_t limit = SUGGESTION_LIMIT;
+    if (std::regex_search(request.body, matches, limit_regex)) {
+        unsigned long long requested = 0;
+        if (!parseBounded(matches[1].str(), ULLONG_MAX, requested)) {
+            HttpResponse response(400, "Bad Request");
+            response.setJson(buildErrorResponse("Invalid limit field"));
+            return response;
+        }
+        limit = static_cast<size_t>(std::min<unsigned long long>(requested, MAX_SUGGESTION_LIMIT));
+    }
+    bool any_location = std::regex_search(request.body, any_location_regex);
+    
+    Activity wanted(0, "", location_match[1].str(), start_match[1].str(), end_match[1].str());
+    auto suggestions = activity_manager->suggestAlternatives(wanted, limit, any_location);
+    
+    std::ostringstream json;
+    json << "{\"success\": true,\"suggestions\": ";
+    appendSuggestionsJson(json, suggestions);
+    json << ",\"total\": " << suggestions.size() << "}";
     
     HttpResponse response;
     response.setJson(json.str());
     return response;
 }
 
+HttpResponse AuthenticatedHttpServer::handleCreateReservation(const AuthenticatedRequest& request) {
+    if (request.method != "POST") {
+        HttpResponse response(405, "Method Not Allowed");
+        response.setJson(buildErrorResponse("Only POST method allowed"));
+        return response;
+    }
+    
+    // {"activity": ..., "priority": 5, "contact": ..., "items": [{"resource": ..., "start_time": ..., "end_time": ..., "demand": 1}, ...]}
+    std::regex activity_regex(R"REGEX("activity"\s*:\s*"([^"]+)")REGEX");
+    std::regex priority_regex(R"REGEX("priority"\s*:\s*(\d+))REGEX");
+    std::regex contact_regex(R"REGEX("contact"\s*:\s*"([^"]*)")REGEX");
+    std::regex item_regex(R"REGEX(\{[^{}]*\})REGEX");
+    std::regex resource_regex(R"REGEX("resource"\s*:\s*"([^"]+)")REGEX");
+    std::regex start_time_regex(R"REGEX("start_time"\s*:\s*"([^"]+)")REGEX");
+    std::regex end_time_regex(R"REGEX("end_time"\s*:\s*"([^"]+)")REGEX");
+    std::regex demand_regex(R"REGEX("demand"\s*:\s*(\d+))REGEX");
+    
+    std::smatch matches;
+    if (!std::regex_search(request.body, matches, activity_regex)) {
+        HttpResponse response(400, "Bad Request");
+        response.setJson(buildErrorResponse("Missing activity field"));
+        return response;
+    }
+    std::string activity = matches[1].str();
+    int priority = 5;
+    if (std::regex_search(request.body, matches, priority_regex)) {
+        unsigned long long requested = 0;
+        if (!parseBounded(matches[1].str(), 10, requested) || requested < 1) {
+            HttpResponse response(400, "Bad Request");
+            response.setJson(buildErrorResponse("Invalid priority field, expected 1-10"));
+            return response;
+        }
+        priority = static_cast<int>(requested);
+    }
+    std::string contact;
+    if (std::regex_search(request.body, matches, contact_regex)) {
+        contact = matches[1].str();
+    }
+    
+    std::vector<Reservation> bundle;
+    for (std::sregex_iterator it(request.body.begin(), request.body.end(), item_regex), end; it != end; ++it) {
+        std::string item = it->str();
+        std::smatch resource_match, start_match, end_match;
+        if (!std::regex_search(item, resource_match, resource_regex) ||
+            !std::regex_search(item, start_match, start_time_regex) ||
+            !std::regex_search(item, end_match, end_time_regex)) {
+            HttpResponse response(400, "Bad Request");
+            response.setJson(buildErrorResponse("Each item needs resource, start_time and end_time"));
+            return response;
+        }
+        int demand = 1;
+        if (std::regex_search(item, matches, demand_regex)) {
+            unsigned long long requested = 0;
+            if (!parseBounded(matches[1].str(), INT_MAX, requested) || requested < 1) {
+                HttpResponse response(400, "Bad Request");
+                response.setJson(buildErrorResponse("Invalid demand field"));
+                return response;
+            }
+            demand = static_cast<int>(requested);
+        }
+        bundle.emplace_back(0, resource_match[1].str(), activity,
+                            TimeSlot(start_match[1].str(), end_match[1].str()), priority, contact, demand);
+    }
+    if (bundle.empty()) {
+        HttpResponse response(400, "Bad Request");
+        response.setJson(buildErrorResponse("Missing items field"));
+        return response;
+    }
+    
+    BundleResult result = conflict_detector->reserveAll(bundle);
+    std::ostringstream json;
+    if (!result.success) {
+        json << "{\"success\": false,"
+             << "\"error\": \"Reservation bundle rejected, nothing was reserved\","
+             << "\"failed_index\": " << result.failed_index << ","
+             << "\"conflicts\": [";
+        for (size_t i = 0; i < result.conflicts.size(); ++i) {
+            json << "{"
+                 << "\"id\": " << result.conflicts[i].id << ","
+                 << "\"activity\": \"" << result.conflicts[i].activity_name << "\","
+                 << "\"start_time\": \"" << result.conflicts[i].time_slot.start_time << "\","
+                 << "\"end_time\": \"" << result.conflicts[i].time_slot.end_time << "\""
+                 << "}";
+            if (i < result.conflicts.size() - 1) json << ",";
+        }
+        json << "]}";
+        
+        HttpResponse response(409, "Conflict");
+        response.setJson(json.str());
+        return response;
+    }
+    
+    json << "{\"success\": true,\"reservation_ids\": [";
+    for (size_t i = 0; i < result.reservation_ids.size(); ++i) {
+        json << result.reservation_ids[i];
+        if (i < result.reservation_ids.size() - 1) json << ",";
+    }
+    json << "]}";
+    
+    HttpResponse response(201, "Created");
+    response.setJson(json.str());
+    return response;
+}
+
+HttpResponse AuthenticatedHttpServer::handleGetSchedule(const AuthenticatedRequest& request) {
+    // 获取资源调度信息
+    return serveCached(request, "s" + std::to_string(conflict_detector->getGeneration()), [this]() {
+        auto resources = conflict_detector->getAvailableResources();
+        
+        std::ostringstream json;
+        json << "{"
+             << "\"success\": true,"
+             << "\"resources\": [";
+        
+        for (size_t i = 0; i < resources. size(); ++i) {
+            json << "\"" << resources[i] << "\"";
+            if (i < resources. size() - 1) json << ",";
+        }
+        
+        json << "],"
+             << "\"total_reservations\": " << conflict_detector->getTotalReservations()
+             << "}";
+        return json.str();
+    });
+}
+
 HttpResponse AuthenticatedHttpServer::handleUpdateContact(const AuthenticatedRequest& request) {
-    // 从路径中提取ID（简化实现，实际应该从路径参数中提取）
-    HttpResponse response(501, "Not Implemented");
-    response.setJson(buildErrorResponse("Update contact not fully implemented yet"));
+    // PUT /api/contacts/{id}：请求体中出现的字段覆盖原值
+    int id = 0;
+    std::unique_ptr<Contact> existing;
+    if (readIdParam(request, id)) existing.reset(contact_manager->findById(id));
+    if (!existing) {
+        HttpResponse response(404, "Not Found");
+        response.setJson(buildErrorResponse("Contact not found", 404));
+        return response;
+    }
+    
+    Contact contact = *existing;
+    readStringField(request.body, "name", contact.name);
+    readStringField(request.body, "student_id", contact.student_id);
+    readStringField(request.body, "phone", contact.phone);
+    readStringField(request.body, "email", contact.email);
+    readStringField(request.body, "department", contact.department);
+    
+    if (!contact_manager->updateContact(contact)) {
+        // 校验失败或电话/邮箱与其他联系人重复
+        HttpResponse response(409, "Conflict");
+        response.setJson(buildErrorResponse("Failed to update contact: invalid or duplicate fields", 409));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"message\": \"Contact updated successfully\", \"id\": " +
+                     std::to_string(id) + "}");
     return response;
 }
 
 HttpResponse AuthenticatedHttpServer::handleDeleteContact(const AuthenticatedRequest& request) {
-    // 从查询参数或路径中提取ID
-    HttpResponse response(501, "Not Implemented");
-    response.setJson(buildErrorResponse("Delete contact not fully implemented yet"));
+    // DELETE /api/contacts/{id}
+    int id = 0;
+    std::unique_ptr<Contact> existing;
+    if (readIdParam(request, id)) existing.reset(contact_manager->findById(id));
+    if (!existing) {
+        HttpResponse response(404, "Not Found");
+        response.setJson(buildErrorResponse("Contact not found", 404));
+        return response;
+    }
+    
+    if (!contact_manager->removeContact(id)) {
+        HttpResponse response(500, "Internal Server Error");
+        response.setJson(buildErrorResponse("Failed to delete contact", 500));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"message\": \"Contact deleted successfully\", \"id\": " +
+                     std::to_string(id) + "}");
     return response;
 }
 
@@ -913,7 +1412,32 @@ HttpResponse AuthenticatedHttpServer::handleSearchContacts(const AuthenticatedRe
         search_term = search_term.substr(0, amp_pos);
     }
     
-    // 使用Trie树搜索
+    // 通讯录与索引一致时直接从映射区输出，无需复制联系人对象
+    auto directory = contact_manager->currentDirectory();
+    if (directory) {
+        // 同一通讯录版本下相同搜索词的响应不变，直接复用序列化结果
+        std::string cache_key = std::to_string(directory->sourceVersion()) + "\n" + search_term;
+        std::optional<std::string> cached = search_cache->get(cache_key);
+        if (cached) {
+            HttpResponse response;
+            response.setJson(*cached);
+            return response;
+        }
+        
+        std::vector<uint32_t> rows = directory->searchByNamePrefix(search_term);
+        std::string body = "{\"success\": true,\"data\": ";
+        body.reserve(body.size() + rows.size() * 160);
+        directory->appendJsonArray(rows, body);
+        body += ",\"total\": " + std::to_string(rows.size()) + "}";
+        search_cache->put(cache_key, body);
+        
+        HttpResponse response;
+        response.setJson(body);
+        return response;
+    }
+    
+    // 通讯录过期时（写入之后、下次重新生成之前）响应缓存整体失效，改走带前缀缓存的索引搜索：
+    // 写入只清除改动姓名的各个前缀，其余输入的ID列表仍可复用
     auto contacts = contact_manager->searchByName(search_term);
     
     std::ostringstream json;
@@ -939,15 +1463,146 @@ HttpResponse AuthenticatedHttpServer::handleSearchContacts(const AuthenticatedRe
 }
 
 HttpResponse AuthenticatedHttpServer::handleUpdateActivity(const AuthenticatedRequest& request) {
-    HttpResponse response(501, "Not Implemented");
-    response.setJson(buildErrorResponse("Update activity not fully implemented yet"));
+    // PUT /api/activities/{id}：请求体中出现的字段覆盖原值
+    int id = 0;
+    std::unique_ptr<Activity> existing;
+    if (readIdParam(request, id)) existing.reset(activity_manager->findById(id));
+    if (!existing) {
+        HttpResponse response(404, "Not Found");
+        response.setJson(buildErrorResponse("Activity not found", 404));
+        return response;
+    }
+    
+    Activity activity = *existing;
+    readStringField(request.body, "name", activity.name);
+    readStringField(request.body, "location", activity.location);
+    readStringField(request.body, "start_time", activity.start_time);
+    readStringField(request.body, "end_time", activity.end_time);
+    if (!readIntField(request.body, "max_participants", activity.max_participants)) {
+        HttpResponse response(400, "Bad Request");
+        response.setJson(buildErrorResponse("Invalid max_participants field"));
+        return response;
+    }
+    
+    // 冲突检查时排除活动自身的原时间段
+    std::vector<Activity> conflicts;
+    if (activity_manager->hasTimeConflict(activity)) {
+        conflicts = activity_manager->findConflictingActivities(activity);
+        conflicts.erase(std::remove_if(conflicts.begin(), conflicts.end(),
+                                       [id](const Activity& other) { return other.id == id; }),
+                        conflicts.end());
+    }
+    if (!conflicts.empty()) {
+        std::ostringstream json;
+        json << "{"
+             << "\"success\": false,"
+             << "\"error\": \"Time conflict detected for the specified location\","
+             << "\"code\": 409,"
+             << "\"conflicts\": [";
+        for (size_t i = 0; i < conflicts.size(); ++i) {
+            json << "{"
+                 << "\"id\": " << conflicts[i].id << ","
+                 << "\"name\": \"" << conflicts[i].name << "\""
+                 << "}";
+            if (i < conflicts.size() - 1) json << ",";
+        }
+        json << "]}";
+        
+        HttpResponse response(409, "Conflict");
+        response.setJson(json.str());
+        return response;
+    }
+    
+    if (!activity_manager->updateActivity(activity)) {
+        HttpResponse response(400, "Bad Request");
+        response.setJson(buildErrorResponse("Failed to update activity"));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"message\": \"Activity updated successfully\", \"id\": " +
+                     std::to_string(id) + "}");
     return response;
 }
 
 HttpResponse AuthenticatedHttpServer::handleDeleteActivity(const AuthenticatedRequest& request) {
-    // 从查询参数或路径中提取ID
-    HttpResponse response(501, "Not Implemented");
-    response.setJson(buildErrorResponse("Delete activity not fully implemented yet"));
+    // DELETE /api/activities/{id}
+    int id = 0;
+    std::unique_ptr<Activity> existing;
+    if (readIdParam(request, id)) existing.reset(activity_manager->findById(id));
+    if (!existing) {
+        HttpResponse response(404, "Not Found");
+        response.setJson(buildErrorResponse("Activity not found", 404));
+        return response;
+    }
+    
+    if (!activity_manager->removeActivity(id)) {
+        HttpResponse response(500, "Internal Server Error");
+        response.setJson(buildErrorResponse("Failed to delete activity", 500));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"message\": \"Activity deleted successfully\", \"id\": " +
+                     std::to_string(id) + "}");
+    return response;
+}
+
+// 撤销/重做API
+
+bool AuthenticatedHttpServer::replayOperation(const OperationRecord& record, bool inverse) {
+    switch (record.type) {
+        case OP_CONTACT_ADD:
+        case OP_CONTACT_REMOVE:
+        case OP_CONTACT_UPDATE:
+            return contact_manager->replayOperation(record, inverse);
+        case OP_ACTIVITY_ADD:
+        case OP_ACTIVITY_REMOVE:
+        case OP_ACTIVITY_UPDATE:
+            return activity_manager->replayOperation(record, inverse);
+        case OP_RESERVATION_ADD:
+        case OP_RESERVATION_REMOVE:
+        case OP_SERIES_ADD:
+        case OP_SERIES_REMOVE:
+        case OP_SERIES_UPDATE:
+            return conflict_detector->replayOperation(record, inverse);
+    }
+    return false;
+}
+
+HttpResponse AuthenticatedHttpServer::handleUndo(const AuthenticatedRequest& request) {
+    auto replay = [this](const OperationRecord& record, bool inverse) {
+        return replayOperation(record, inverse);
+    };
+    bool available = operation_log->undoDepth() > 0;
+    if (!available || !operation_log->undo(replay)) {
+        HttpResponse response(409, "Conflict");
+        response.setJson(buildErrorResponse(available ? "Cannot undo: data has changed since"
+                                                      : "Nothing to undo", 409));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"undo_depth\": " + std::to_string(operation_log->undoDepth()) +
+                     ", \"redo_depth\": " + std::to_string(operation_log->redoDepth()) + "}");
+    return response;
+}
+
+HttpResponse AuthenticatedHttpServer::handleRedo(const AuthenticatedRequest& request) {
+    auto replay = [this](const OperationRecord& record, bool inverse) {
+        return replayOperation(record, inverse);
+    };
+    bool available = operation_log->redoDepth() > 0;
+    if (!available || !operation_log->redo(replay)) {
+        HttpResponse response(409, "Conflict");
+        response.setJson(buildErrorResponse(available ? "Cannot redo: data has changed since"
+                                                      : "Nothing to redo", 409));
+        return response;
+    }
+    
+    HttpResponse response;
+    response.setJson("{\"success\": true, \"undo_depth\": " + std::to_string(operation_log->undoDepth()) +
+                     ", \"redo_depth\": " + std::to_string(operation_log->redoDepth()) + "}");
     return response;
 }
 
@@ -963,32 +1618,72 @@ std::string AuthenticatedHttpServer::buildErrorResponse(const std:: string& erro
     return json.str();
 }
 
-HttpResponse AuthenticatedHttpServer::serveStaticFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.good()) {
+HttpResponse AuthenticatedHttpServer::serveStaticFile(const HttpRequest& request, const std::string& relative_path) {
+    auto asset = static_assets->find(relative_path);
+    if (!asset) {
         HttpResponse response(404, "Not Found");
         response.setJson(buildErrorResponse("File not found"));
         return response;
     }
     
-    std::ostringstream content;
-    content << file.rdbuf();
-    
-    HttpResponse response;
-    response.body = content.str();
-    
-    // 设置Content-Type
-    if (path.find(". html") != std::string::npos) {
-        response. headers["Content-Type"] = "text/html";
-    } else if (path.find(".css") != std::string::npos) {
-        response.headers["Content-Type"] = "text/css";
-    } else if (path.find(".js") != std::string:: npos) {
-        response.headers["Content-Type"] = "application/javascript";
+    StaticReply reply = StaticAssetStore::reply(asset, request.headers);
+    HttpResponse response(reply.status_code, reply.status_text);
+    response.headers = reply.headers;
+    if (reply.body) {
+        response.body = *reply.body;
     }
-    
     return response;
 }
 
+bool AuthenticatedHttpServer::sendStaticFile(int client_fd, const HttpRequest& request) {
+    if (request.method != "GET") return false;
+    std::string asset_path = staticAssetPath(request.path);
+    if (asset_path.empty()) return false;
+    ScopedTimer timer(*static_latency);
+    auto asset = static_assets->find(asset_path);
+    if (!asset) return false;           // 交给常规路径返回 404
+    
+    StaticReply reply = StaticAssetStore::reply(asset, request.headers);
+    countResponse(reply.status_code);
+    std::ostringstream head;
+    head << "HTTP/1.1 " << reply.status_code << " " << reply.status_text << "\r\n";
+    for (const auto& header : reply.headers) {
+        head << header.first << ": " << header.second << "\r\n";
+    }
+    head << "Content-Length: " << (reply.body ? reply.body->size() : 0) << "\r\n\r\n";
+    std::string head_str = head.str();
+    
+    if (!reply.body) {
+        writeAll(client_fd, head_str.data(), head_str.size());
+    } else if (reply.from_file) {
+        // 响应头先发出（MSG_MORE 让内核与文件内容合并成满包），文件内容由内核直接拷贝到套接字
+        send(client_fd, head_str.data(), head_str.size(), MSG_MORE | MSG_NOSIGNAL);
+        off_t offset = 0;
+        while (offset < asset->size) {
+            ssize_t sent = sendfile(client_fd, asset->fd, &offset, static_cast<size_t>(asset->size - offset));
+            if (sent <= 0) break;
+        }
+    } else {
+        // 预压缩版本在内存中，响应头和响应体一次 writev 发出
+        struct iovec parts[2];
+        parts[0].iov_base = const_cast<char*>(head_str.data());
+        parts[0].iov_len = head_str.size();
+        parts[1].iov_base = const_cast<char*>(reply.body->data());
+        parts[1].iov_len = reply.body->size();
+        ssize_t sent = writev(client_fd, parts, 2);
+        size_t total = head_str.size() + reply.body->size();
+        if (sent >= 0 && static_cast<size_t>(sent) < total) {
+            size_t done = static_cast<size_t>(sent);
+            if (done < head_str.size()) {
+                writeAll(client_fd, head_str.data() + done, head_str.size() - done);
+                done = head_str.size();
+            }
+            writeAll(client_fd, reply.body->data() + (done - head_str.size()), total - done);
+        }
+    }
+    return true;
+}
+
 // 需要实现的辅助函数
 HttpRequest AuthenticatedHttpServer::parseHttpRequest(const std::string& raw_request) {
     // 简化的HTTP请求解析
@@ -1059,15 +1754,61 @@ std::string AuthenticatedHttpServer::buildHttpResponse(const HttpResponse& respo
     return oss.str();
 }
 
-// 简单的路由模式匹配（支持 /api/contacts/{id} 这样的模式）
-bool AuthenticatedHttpServer::matchRoutePattern(const std::string& pattern, const std::string& path) {
-    // 简化实现：检查路径前缀是否匹配
-    // 例如：pattern = "GET /api/contacts", path = "GET /api/contacts/1"
-    if (path.find(pattern) == 0) {
-        // 检查是否是完全匹配或者是路径参数的扩展
-        if (path.length() == pattern.length() || path[pattern.length()] == '/') {
-            return true;
-        }
+HttpResponse AuthenticatedHttpServer::serveCached(const AuthenticatedRequest& request, const std::string& generation,
+                                                 const std::function<std::string()>& build) {
+    std::string role = !request.current_user ? "guest"
+                     : request.current_user->role == UserRole::ADMIN ? "admin" : "student";
+    auto cached = response_cache->fetch(
+        ResponseCache::makeKey(request.method + " " + request.path, request.query_string, role), generation, build);
+    
+    HttpResponse response;
+    response.headers["ETag"] = cached->etag;
+    response.headers["Cache-Control"] = "no-cache";     // 客户端每次都带 If-None-Match 重新验证
+    response.headers["Vary"] = "Accept-Encoding";       // 304 也要带上，缓存才知道按编码区分变体
+    
+    const std::string* if_none_match = findHeader(request, "If-None-Match");
+    if (if_none_match && ResponseCache::matchesETag(*if_none_match, cached->etag)) {
+        response.status_code = 304;
+        response.status_text = "Not Modified";
+        return response;
     }
-    return false;
-}
\ No newline at end of file
+    
+    const std::string* accept_encoding = findHeader(request, "Accept-Encoding");
+    if (!cached->gzip_body.empty() && accept_encoding && accept_encoding->find("gzip") != std::string::npos) {
+        response.setJson(cached->gzip_body);
+        response.headers["Content-Encoding"] = "gzip";
+    } else {
+        response.setJson(cached->body);
+    }
+    return response;
+}
+
+void AuthenticatedHttpServer::countResponse(int status_code) {
+    int status_class = status_code / 100;
+    if (status_class >= 1 && status_class <= 5) {
+        responses_by_class[status_class - 1]->inc();
+    }
+}
+
+HttpResponse AuthenticatedHttpServer::handleGetMetrics(const AuthenticatedRequest& request) {
+    // 瞬时值在抓取时采样
+    MetricsRegistry& registry = MetricsRegistry::global();
+    const char* cache_help = "Entries held by each in-process cache";
+    registry.gauge("cache_entries", cache_help, MetricsRegistry::label("cache", "response"))
+        .set(static_cast<int64_t>(response_cache->getStats().size));
+    registry.gauge("cache_entries", cache_help, MetricsRegistry::label("cache", "search"))
+        .set(static_cast<int64_t>(search_cache->size()));
+    registry.gauge("cache_entries", cache_help, MetricsRegistry::label("cache", "contact_prefix"))
+        .set(static_cast<int64_t>(contact_manager->getPrefixCacheSize()));
+    registry.gauge("cache_entries", cache_help, MetricsRegistry::label("cache", "static_assets"))
+        .set(static_cast<int64_t>(static_assets->size()));
+    registry.gauge("static_asset_bytes", "Bytes of static assets and precompressed variants held in memory")
+        .set(static_cast<int64_t>(static_assets->getMemoryUsage()));
+    registry.gauge("scheduled_reservations", "Reservations currently held by the conflict detector")
+        .set(conflict_detector->getTotalReservations());
+    
+    HttpResponse response;
+    response.headers["Content-Type"] = "text/plain; version=0.0.4; charset=utf-8";
+    response.body = registry.renderPrometheus();
+    return response;
+}
@@ -0,0 +1,228 @@
+#include "../include/index_snapshot.h"
+#include <iostream>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 静态常量定义
+const uint32_t IndexSnapshotFile::FORMAT_VERSION = 1;
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'C', 'A', 'R', 'S', 'S', 'N', 'A', 'P'};
+
+} // namespace
+
+// SnapshotBuffer
+
+size_t SnapshotBuffer::appendBytes(const void* data, size_t length) {
+    size_t offset = bytes.size();
+    const char* source = static_cast<const char*>(data);
+    bytes.insert(bytes.end(), source, source + length);
+    return offset;
+}
+
+size_t SnapshotBuffer::appendString(const std::string& value) {
+    size_t offset = append(static_cast<uint32_t>(value.size()));
+    appendBytes(value.data(), value.size());
+    return offset;
+}
+
+void SnapshotBuffer::appendBuffer(const SnapshotBuffer& other) {
+    bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+}
+
+// SnapshotView
+
+bool SnapshotView::readBytes(size_t& offset, void* out, size_t count) const {
+    if (offset > length || length - offset < count) return false;
+    std::memcpy(out, base + offset, count);
+    offset += count;
+    return true;
+}
+
+bool SnapshotView::readString(size_t& offset, std::string& value) const {
+    uint32_t string_length = 0;
+    size_t cursor = offset;
+    if (!read(cursor, string_length)) return false;
+    if (cursor > length || length - cursor < string_length) return false;
+
+    value.assign(base + cursor, string_length);
+    offset = cursor + string_length;
+    return true;
+}
+
+bool SnapshotView::stringAt(size_t offset, std::string& value) const {
+    return readString(offset, value);
+}
+
+// IndexSnapshotWriter
+
+void IndexSnapshotWriter::addSection(SnapshotSectionType type, SnapshotBuffer&& buffer) {
+    sections.emplace_back(type, std::move(buffer));
+}
+
+bool IndexSnapshotWriter::writeToFile(const std::string& path, uint64_t contacts_seq, uint64_t activities_seq) const {
+    // 段表紧跟头部，各段按8字节对齐依次排列
+    std::vector<SnapshotSectionEntry> entries;
+    uint64_t offset = sizeof(SnapshotHeader) + sections.size() * sizeof(SnapshotSectionEntry);
+    for (const auto& section : sections) {
+        offset = (offset + 7) & ~uint64_t(7);
+        SnapshotSectionEntry entry;
+        entry.type = section.first;
+        entry.reserved = 0;
+        entry.offset = offset;
+        entry.size = section.second.size();
+        entries.push_back(entry);
+        offset += entry.size;
+    }
+
+    std::vector<char> payload(offset - sizeof(SnapshotHeader), 0);
+    std::memcpy(payload.data(), entries.data(), entries.size() * sizeof(SnapshotSectionEntry));
+    for (size_t i = 0; i < sections.size(); i++) {
+        if (sections[i].second.size() == 0) continue;   // 空段的 data() 可能为空指针
+        std::memcpy(payload.data() + (entries[i].offset - sizeof(SnapshotHeader)),
+                    sections[i].second.data(), sections[i].second.size());
+    }
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = IndexSnapshotFile::FORMAT_VERSION;
+    header.section_count = static_cast<uint32_t>(sections.size());
+    header.contacts_seq = contacts_seq;
+    header.activities_seq = activities_seq;
+    header.payload_size = payload.size();
+    header.checksum = IndexSnapshotFile::checksum(payload.data(), payload.size());
+
+    // 先写临时文件再重命名，崩溃时不会留下半个快照
+    std::string temp_path = path + ".tmp";
+    FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "无法创建快照文件: " << temp_path << std::endl;
+        return false;
+    }
+
+    bool success = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (payload.empty() || std::fwrite(payload.data(), payload.size(), 1, file) == 1);
+    success = (std::fflush(file) == 0) && success;
+    success = (fsync(fileno(file)) == 0) && success;
+    std::fclose(file);
+
+    if (!success || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "写入快照文件失败: " << path << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// IndexSnapshotFile
+
+IndexSnapshotFile::IndexSnapshotFile() : mapped(nullptr), mapped_size(0) {
+    std::memset(&header, 0, sizeof(header));
+}
+
+IndexSnapshotFile::~IndexSnapshotFile() {
+    close();
+}
+
+uint64_t IndexSnapshotFile::checksum(const char* data, size_t length) {
+    // 按8字节分组的乘法散列，速度接近内存带宽
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+    for (; i < length; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001B3ULL;
+    }
+    return hash ^ (hash >> 29);
+}
+
+bool IndexSnapshotFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapped = static_cast<const char*>(address);
+    mapped_size = size;
+
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.payload_size != mapped_size - sizeof(SnapshotHeader)) {
+        std::cerr << "快照文件格式不匹配: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (checksum(mapped + sizeof(SnapshotHeader), header.payload_size) != header.checksum) {
+        std::cerr << "快照文件校验失败: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    // 段表与各段范围检查
+    SnapshotView payload(mapped, mapped_size);
+    size_t cursor = sizeof(SnapshotHeader);
+    entries.resize(header.section_count);
+    for (auto& entry : entries) {
+        if (!payload.read(cursor, entry) ||
+            entry.offset > mapped_size || mapped_size - entry.offset < entry.size) {
+            std::cerr << "快照段表损坏: " << path << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void IndexSnapshotFile::close() {
+    if (mapped) {
+        munmap(const_cast<char*>(mapped), mapped_size);
+    }
+    mapped = nullptr;
+    mapped_size = 0;
+    entries.clear();
+    std::memset(&header, 0, sizeof(header));
+}
+
+bool IndexSnapshotFile::isOpen() const {
+    return mapped != nullptr;
+}
+
+uint64_t IndexSnapshotFile::contactsSequence() const {
+    return header.contacts_seq;
+}
+
+uint64_t IndexSnapshotFile::activitiesSequence() const {
+    return header.activities_seq;
+}
+
+bool IndexSnapshotFile::section(SnapshotSectionType type, SnapshotView& view) const {
+    for (const auto& entry : entries) {
+        if (entry.type == type) {
+            view = SnapshotView(mapped + entry.offset, entry.size);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,201 @@
+#include "../include/logger.h"
+#include <chrono>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+const char* LEVEL_NAMES[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+
+std::atomic<uint32_t> next_thread_id(1);
+
+// 日志中的线程编号：按首次写日志的顺序从 1 开始
+uint32_t currentThreadId() {
+    thread_local uint32_t id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+// "src/conflict_detector.cpp" -> "conflict_detector"
+std::string_view componentName(const char* file) {
+    std::string_view path(file ? file : "");
+    size_t slash = path.find_last_of("/\\");
+    if (slash != std::string_view::npos) path.remove_prefix(slash + 1);
+    size_t dot = path.rfind('.');
+    if (dot != std::string_view::npos) path = path.substr(0, dot);
+    return path;
+}
+
+} // namespace
+
+// 静态常量定义
+const size_t Logger::CAPACITY;
+const size_t Logger::TEXT_CAPACITY;
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : slots(new Slot[CAPACITY]), write_pos(0), read_pos(0), dropped(0),
+      runtime_level(LOG_LEVEL_INFO), running(true) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+    delete[] slots;
+}
+
+void Logger::submit(int level, const char* file, const char* text, size_t length) {
+    // 有界多生产者队列：每个槽位的序号表示它能否写入，抢到位置后再填充，不需要锁
+    uint64_t pos = write_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & (CAPACITY - 1)];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);    // 写出线程跟不上，丢弃而不是等待
+            return;
+        } else {
+            pos = write_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    slot->file = file;
+    slot->thread = currentThreadId();
+    slot->level = static_cast<uint8_t>(level);
+    slot->length = static_cast<uint16_t>(length < TEXT_CAPACITY ? length : TEXT_CAPACITY);
+    std::memcpy(slot->text, text, slot->length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Logger::flush() {
+    uint64_t target = write_pos.load(std::memory_order_acquire);
+    while (read_pos.load(std::memory_order_acquire) < target && writer.joinable()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+void Logger::writerLoop() {
+    uint64_t reported_drops = 0;
+    int idle_rounds = 0;
+    for (;;) {
+        size_t written = drain();
+
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            std::fprintf(stderr, "⚠️ 日志缓冲区已满，累计丢弃 %llu 条\n", static_cast<unsigned long long>(drops));
+            std::fflush(stderr);
+            reported_drops = drops;
+        }
+
+        if (written > 0) {
+            idle_rounds = 0;
+            continue;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            if (drain() == 0) break;        // 退出前写完剩余日志
+            continue;
+        }
+        // 空闲时逐步放慢轮询，刚有日志时响应快
+        std::this_thread::sleep_for(std::chrono::microseconds(idle_rounds < 20 ? 50 : 1000));
+        idle_rounds++;
+    }
+}
+
+size_t Logger::drain() {
+    std::string out;
+    std::string err;
+    time_t cached_second = -1;
+    char time_prefix[32] = {0};
+
+    size_t count = 0;
+    uint64_t pos = read_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+        // 同一秒内的日志复用格式化好的日期
+        time_t second = static_cast<time_t>(slot.timestamp_ns / 1000000000);
+        if (second != cached_second) {
+            struct tm local;
+            localtime_r(&second, &local);
+            std::strftime(time_prefix, sizeof(time_prefix), "%Y-%m-%d %H:%M:%S", &local);
+            cached_second = second;
+        }
+        char line_prefix[64];
+        int prefix_length = std::snprintf(line_prefix, sizeof(line_prefix), "%s.%03d %s [t%u ",
+                                          time_prefix, static_cast<int>(slot.timestamp_ns / 1000000 % 1000),
+                                          LEVEL_NAMES[slot.level < 4 ? slot.level : 3], slot.thread);
+
+        std::string& target = slot.level >= LOG_LEVEL_WARN ? err : out;
+        target.append(line_prefix, static_cast<size_t>(prefix_length));
+        target.append(componentName(slot.file));
+        target.append("] ");
+        target.append(slot.text, slot.length);
+        target.push_back('\n');
+
+        slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+        pos++;
+        count++;
+        read_pos.store(pos, std::memory_order_release);
+    }
+
+    if (!out.empty()) {
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+    }
+    if (!err.empty()) {
+        std::fwrite(err.data(), 1, err.size(), stderr);
+        std::fflush(stderr);
+    }
+    return count;
+}
+
+void LogLine::append(const char* data, size_t size) {
+    size_t room = Logger::TEXT_CAPACITY - length;
+    if (size > room) {
+        size = room;
+        // 不截断在 UTF-8 多字节字符中间
+        while (size > 0 && (static_cast<unsigned char>(data[size]) & 0xC0) == 0x80) {
+            size--;
+        }
+    }
+    std::memcpy(buffer + length, data, size);
+    length += size;
+}
+
+LogLine& LogLine::appendSigned(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, static_cast<size_t>(result.ptr - digits));
+    return *this;
+}
+
+LogLine& LogLine::appendUnsigned(unsigned long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, static_cast<size_t>(result.ptr - digits));
+    return *this;
+}
+
+LogLine& LogLine::operator<<(double value) {
+    char digits[32];
+    int written = std::snprintf(digits, sizeof(digits), "%g", value);
+    append(digits, static_cast<size_t>(written));
+    return *this;
+}
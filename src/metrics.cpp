@@ -0,0 +1,172 @@
+#include "../include/metrics.h"
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+// 导出的累计桶边界：2^10 ns (约1微秒) 起每次乘 4，到 2^34 ns (约17秒)
+const int EXPORT_MIN_EXPONENT = 10;
+const int EXPORT_MAX_EXPONENT = 34;
+const int EXPORT_EXPONENT_STEP = 2;
+
+std::string formatSeconds(uint64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", nanos / 1e9);
+    return buffer;
+}
+
+// 在已有标签后追加一个标签
+std::string joinLabels(const std::string& labels, const std::string& extra) {
+    return labels.empty() ? extra : labels + "," + extra;
+}
+
+std::string braced(const std::string& labels) {
+    return labels.empty() ? "" : "{" + labels + "}";
+}
+
+} // namespace
+
+Histogram::Histogram() : sum_nanos(0) {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Histogram::count() const {
+    uint64_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t Histogram::percentile(double fraction) const {
+    uint64_t total = count();
+    if (total == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(fraction * total);
+    if (rank >= total) rank = total - 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += bucketCount(i);
+        if (seen > rank) {
+            uint64_t lower = bucketLowerBound(i);
+            uint64_t upper = i + 1 < BUCKET_COUNT ? bucketLowerBound(i + 1) : lower * 2;
+            return lower + (upper - lower) / 2;
+        }
+    }
+    return bucketLowerBound(BUCKET_COUNT - 1);
+}
+
+uint64_t Histogram::bucketLowerBound(int index) {
+    if (index < SUB_BUCKETS) return static_cast<uint64_t>(index);
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS);
+    return (static_cast<uint64_t>(SUB_BUCKETS) + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, MetricType type) {
+    auto it = families.find(name);
+    if (it == families.end()) {
+        Family& created = families[name];
+        created.type = type;
+        created.help = help;
+        return created;
+    }
+    if (it->second.type != type) {
+        std::cerr << "⚠️ 指标类型不一致: " << name << std::endl;
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, METRIC_COUNTER).counters[labels];
+    if (!slot) slot.reset(new Counter());
+    return *slot;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, METRIC_GAUGE).gauges[labels];
+    if (!slot) slot.reset(new Gauge());
+    return *slot;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, METRIC_HISTOGRAM).histograms[labels];
+    if (!slot) slot.reset(new Histogram());
+    return *slot;
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string out;
+    out.reserve(families.size() * 1024);
+
+    for (const auto& entry : families) {
+        const std::string& name = entry.first;
+        const Family& metric = entry.second;
+        out += "# HELP " + name + " " + metric.help + "\n";
+        out += "# TYPE " + name + (metric.type == METRIC_COUNTER ? " counter\n"
+                                 : metric.type == METRIC_GAUGE ? " gauge\n" : " histogram\n");
+
+        for (const auto& counter : metric.counters) {
+            out += name + braced(counter.first) + " " + std::to_string(counter.second->get()) + "\n";
+        }
+        for (const auto& gauge : metric.gauges) {
+            out += name + braced(gauge.first) + " " + std::to_string(gauge.second->get()) + "\n";
+        }
+        for (const auto& histogram : metric.histograms) {
+            const Histogram& h = *histogram.second;
+            // 一次遍历得到各边界的累计值；+Inf 与 _count 取同一个总数，保证一致
+            uint64_t cumulative = 0;
+            int bucket = 0;
+            for (int exponent = EXPORT_MIN_EXPONENT; exponent <= EXPORT_MAX_EXPONENT;
+                 exponent += EXPORT_EXPONENT_STEP) {
+                int end = (exponent - Histogram::SUB_BUCKET_BITS + 1) * Histogram::SUB_BUCKETS;
+                for (; bucket < end; bucket++) {
+                    cumulative += h.bucketCount(bucket);
+                }
+                out += name + "_bucket" +
+                       braced(joinLabels(histogram.first, "le=\"" + formatSeconds(1ULL << exponent) + "\"")) +
+                       " " + std::to_string(cumulative) + "\n";
+            }
+            for (; bucket < Histogram::BUCKET_COUNT; bucket++) {
+                cumulative += h.bucketCount(bucket);
+            }
+            out += name + "_bucket" + braced(joinLabels(histogram.first, "le=\"+Inf\"")) + " " +
+                   std::to_string(cumulative) + "\n";
+            out += name + "_sum" + braced(histogram.first) + " " + formatSeconds(h.sumNanos()) + "\n";
+            out += name + "_count" + braced(histogram.first) + " " + std::to_string(cumulative) + "\n";
+        }
+    }
+    return out;
+}
+
+Histogram& indexOperationLatency(const char* operation) {
+    return MetricsRegistry::global().histogram("index_operation_duration_seconds", "In-memory index operation latency",
+                                               MetricsRegistry::label("operation", operation));
+}
+
+std::string MetricsRegistry::label(const std::string& key, const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return key + "=\"" + escaped + "\"";
+}
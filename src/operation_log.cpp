@@ -0,0 +1,242 @@
+#include "../include/operation_log.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+// 静态常量定义
+const size_t OperationLog::DEFAULT_UNDO_WINDOW = 100;
+
+namespace {
+
+const uint8_t ACTION_APPLY = 0;
+const uint8_t ACTION_UNDO = 1;
+const uint8_t ACTION_REDO = 2;
+
+template<typename T>
+void appendValue(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(const std::string& data, size_t& offset, T& value) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) return false;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+void appendFields(std::string& out, const std::vector<std::string>& fields) {
+    for (const auto& field : fields) {
+        uint32_t length = static_cast<uint32_t>(field.size());
+        appendValue(out, length);
+        out.append(field.data(), field.size());
+    }
+}
+
+bool readFields(const std::string& data, size_t& offset, uint8_t count, std::vector<std::string>& fields) {
+    fields.clear();
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t length = 0;
+        if (!readValue(data, offset, length) || data.size() - offset < length) return false;
+        fields.emplace_back(data, offset, length);
+        offset += length;
+    }
+    return true;
+}
+
+} // namespace
+
+// Group
+
+OperationLog::Group::Group(OperationLog* operation_log) : log(operation_log) {
+    if (log) log->beginGroup();
+}
+
+OperationLog::Group::~Group() {
+    if (log) log->endGroup();
+}
+
+// OperationLog
+
+OperationLog::OperationLog(const std::string& log_path, size_t undo_window)
+    : path(log_path), file(nullptr), window(std::max<size_t>(1, undo_window)),
+      undo_available(0), group_depth(0), replaying(false) {}
+
+OperationLog::~OperationLog() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool OperationLog::open() {
+    if (path.empty() || file) return true;
+
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        std::cerr << "无法打开操作日志: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void OperationLog::encode(const OperationRecord& record, std::string& out) {
+    appendValue(out, static_cast<uint8_t>(record.type));
+    appendValue(out, record.target_id);
+    appendValue(out, static_cast<uint8_t>(record.before.size()));
+    appendValue(out, static_cast<uint8_t>(record.after.size()));
+    appendFields(out, record.before);
+    appendFields(out, record.after);
+}
+
+bool OperationLog::decode(const std::string& data, size_t& offset, OperationRecord& record) {
+    uint8_t type = 0;
+    uint8_t before_count = 0;
+    uint8_t after_count = 0;
+    if (!readValue(data, offset, type) || !readValue(data, offset, record.target_id) ||
+        !readValue(data, offset, before_count) || !readValue(data, offset, after_count)) {
+        return false;
+    }
+    if (type < OP_CONTACT_ADD || type > OP_SERIES_UPDATE) return false;
+    record.type = static_cast<OperationType>(type);
+    return readFields(data, offset, before_count, record.before) &&
+           readFields(data, offset, after_count, record.after);
+}
+
+void OperationLog::record(const OperationRecord& record) {
+    if (replaying) return;
+
+    if (group_depth > 0) {
+        encode(record, pending);
+        return;
+    }
+
+    std::string unit;
+    encode(record, unit);
+    commitUnit(unit);
+}
+
+void OperationLog::beginGroup() {
+    group_depth++;
+}
+
+void OperationLog::endGroup() {
+    if (group_depth == 0) return;
+    if (--group_depth == 0 && !pending.empty()) {
+        commitUnit(pending);
+        pending.clear();
+    }
+}
+
+void OperationLog::commitUnit(const std::string& unit) {
+    appendToFile(ACTION_APPLY, unit);
+
+    undo_stack.push(unit);
+    undo_available = std::min(undo_available + 1, window);
+    redo_stack.clear();  // 新操作之后原重做分支失效
+    trimUndoStack();
+}
+
+void OperationLog::appendToFile(uint8_t action, const std::string& unit) {
+    if (!file) return;
+
+    uint32_t length = static_cast<uint32_t>(unit.size());
+    bool written = std::fwrite(&length, sizeof(length), 1, file) == 1 &&
+                   std::fwrite(&action, sizeof(action), 1, file) == 1 &&
+                   std::fwrite(unit.data(), 1, unit.size(), file) == unit.size() &&
+                   std::fflush(file) == 0;
+    if (!written) {
+        std::cerr << "写入操作日志失败: " << path << std::endl;
+    }
+}
+
+void OperationLog::trimUndoStack() {
+    // 栈只能从栈顶操作：超过两倍窗口时整体保留栈顶 window 个，均摊 O(1)
+    if (undo_stack.size() <= window * 2) return;
+
+    ArrayStack<std::string> kept;
+    kept.reserve(window);
+    for (size_t i = 0; i < window; i++) {
+        kept.push(std::move(undo_stack.top()));
+        undo_stack.pop();
+    }
+    undo_stack.clear();
+    while (!kept.empty()) {
+        undo_stack.push(std::move(kept.top()));
+        kept.pop();
+    }
+}
+
+bool OperationLog::replayUnit(const std::string& unit, bool inverse, const Replayer& replay) {
+    std::vector<OperationRecord> records;
+    size_t offset = 0;
+    while (offset < unit.size()) {
+        OperationRecord record;
+        if (!decode(unit, offset, record)) {
+            std::cerr << "操作记录损坏，无法重放" << std::endl;
+            return false;
+        }
+        records.push_back(std::move(record));
+    }
+
+    // 撤销按相反顺序执行逆操作
+    if (inverse) {
+        std::reverse(records.begin(), records.end());
+    }
+
+    replaying = true;
+    size_t applied = 0;
+    while (applied < records.size() && replay(records[applied], inverse)) {
+        applied++;
+    }
+
+    // 中途失败时把已执行的部分反向恢复
+    bool success = applied == records.size();
+    while (!success && applied > 0) {
+        applied--;
+        replay(records[applied], !inverse);
+    }
+    replaying = false;
+    return success;
+}
+
+bool OperationLog::undo(const Replayer& replay) {
+    if (replaying || group_depth > 0 || undo_available == 0) return false;
+
+    std::string unit = undo_stack.top();
+    if (!replayUnit(unit, true, replay)) {
+        return false;
+    }
+
+    undo_stack.pop();
+    undo_available--;
+    appendToFile(ACTION_UNDO, unit);
+    redo_stack.push(std::move(unit));
+    return true;
+}
+
+bool OperationLog::redo(const Replayer& replay) {
+    if (replaying || group_depth > 0 || redo_stack.empty()) return false;
+
+    std::string unit = redo_stack.top();
+    if (!replayUnit(unit, false, replay)) {
+        return false;
+    }
+
+    redo_stack.pop();
+    appendToFile(ACTION_REDO, unit);
+    undo_stack.push(std::move(unit));
+    undo_available = std::min(undo_available + 1, window);
+    return true;
+}
+
+bool OperationLog::isReplaying() const {
+    return replaying;
+}
+
+size_t OperationLog::undoDepth() const {
+    return undo_available;
+}
+
+size_t OperationLog::redoDepth() const {
+    return redo_stack.size();
+}
@@ -0,0 +1,339 @@
+#include "../include/recurrence.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+const char* const WEEKDAY_CODES[] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+const int64_t MAX_COUNT_SPAN_DAYS = 100 * 366;    // 只有 COUNT 时最多向后找 100 年
+
+// 公历日期与 1970-01-01 起天数的互相换算（对 4 位年份均有效）
+int daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+void civilFromDays(int days, int& year, int& month, int& day) {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int day_of_era = days - era * 146097;
+    int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = year_of_era + era * 400 + (month <= 2);
+}
+
+int daysInMonth(int year, int month) {
+    static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+std::vector<std::string> split(const std::string& text, char delimiter) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, delimiter)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+std::string toUpper(std::string text) {
+    for (auto& c : text) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return text;
+}
+
+bool parsePositive(const std::string& text, int& value) {
+    if (text.empty() || text.size() > 6) return false;
+    value = 0;
+    for (char c : text) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+        value = value * 10 + (c - '0');
+    }
+    return value > 0;
+}
+
+bool parseDateList(const std::string& text, std::vector<int>& days) {
+    for (const auto& item : split(text, ',')) {
+        int day;
+        if (!parseDate(item, day)) return false;
+        days.push_back(day);
+    }
+    return !days.empty();
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+bool parseDate(const std::string& text, int& day) {
+    std::string digits;
+    if (text.size() == 10 && text[4] == '-' && text[7] == '-') {
+        digits = text.substr(0, 4) + text.substr(5, 2) + text.substr(8, 2);
+    } else if (text.size() == 8) {
+        digits = text;
+    } else {
+        return false;
+    }
+    for (char c : digits) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+    }
+
+    int year = std::stoi(digits.substr(0, 4));
+    int month = std::stoi(digits.substr(4, 2));
+    int day_of_month = std::stoi(digits.substr(6, 2));
+    if (month < 1 || month > 12 || day_of_month < 1 || day_of_month > daysInMonth(year, month)) {
+        return false;
+    }
+    day = daysFromCivil(year, month, day_of_month);
+    return true;
+}
+
+std::string formatDate(int day) {
+    int year, month, day_of_month;
+    civilFromDays(day, year, month, day_of_month);
+    char buffer[32];    // 按 int 的取值范围留足，避免截断
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day_of_month);
+    return buffer;
+}
+
+int weekdayOf(int day) {
+    // 1970-01-01 是周四
+    return ((day % 7) + 7 + 3) % 7;
+}
+
+RecurrenceRule::RecurrenceRule()
+    : freq(DAILY), interval(1), weekday_mask(0), start_day(0), end_day(-1) {}
+
+bool RecurrenceRule::parse(const std::string& text, RecurrenceRule& rule, std::string* error) {
+    RecurrenceRule result;
+    bool has_freq = false, has_start = false, has_until = false;
+    int count = 0;
+    std::vector<int> exdates;
+
+    for (const auto& field : split(text, ';')) {
+        size_t eq = field.find('=');
+        if (eq == std::string::npos) return fail(error, "无法识别的字段: " + field);
+        std::string key = toUpper(field.substr(0, eq));
+        std::string value = toUpper(field.substr(eq + 1));
+
+        if (key == "FREQ") {
+            if (value == "DAILY") result.freq = DAILY;
+            else if (value == "WEEKLY") result.freq = WEEKLY;
+            else return fail(error, "不支持的重复频率: " + value);
+            has_freq = true;
+        } else if (key == "INTERVAL") {
+            if (!parsePositive(value, result.interval)) return fail(error, "无效的 INTERVAL: " + value);
+        } else if (key == "BYDAY") {
+            for (const auto& code : split(value, ',')) {
+                auto it = std::find_if(std::begin(WEEKDAY_CODES), std::end(WEEKDAY_CODES),
+                                       [&](const char* c) { return code == c; });
+                if (it == std::end(WEEKDAY_CODES)) return fail(error, "无效的星期: " + code);
+                result.weekday_mask |= static_cast<uint8_t>(1u << (it - std::begin(WEEKDAY_CODES)));
+            }
+        } else if (key == "DTSTART") {
+            if (!parseDate(value, result.start_day)) return fail(error, "无效的 DTSTART: " + value);
+            has_start = true;
+        } else if (key == "UNTIL") {
+            if (!parseDate(value, result.end_day)) return fail(error, "无效的 UNTIL: " + value);
+            has_until = true;
+        } else if (key == "COUNT") {
+            if (!parsePositive(value, count)) return fail(error, "无效的 COUNT: " + value);
+        } else if (key == "EXDATE") {
+            if (!parseDateList(value, exdates)) return fail(error, "无效的 EXDATE: " + value);
+        } else if (key == "RDATE") {
+            if (!parseDateList(value, result.dates)) return fail(error, "无效的 RDATE: " + value);
+        } else {
+            return fail(error, "不支持的字段: " + key);
+        }
+    }
+
+    if (!result.dates.empty()) {
+        if (has_freq) return fail(error, "RDATE 不能与 FREQ 同时使用");
+        result = custom(result.dates);
+    } else {
+        if (!has_freq) return fail(error, "缺少 FREQ 或 RDATE");
+        if (!has_start) return fail(error, "缺少 DTSTART");
+        if (!has_until && count == 0) return fail(error, "重复规则必须有 UNTIL 或 COUNT");
+        if (result.freq == WEEKLY && result.weekday_mask == 0) {
+            result.weekday_mask = static_cast<uint8_t>(1u << weekdayOf(result.start_day));
+        }
+        if (!has_until) {
+            // COUNT 与 INTERVAL 最多各 6 位，乘积按 64 位计算并限制搜索范围
+            int64_t span = static_cast<int64_t>(count) * 7 * result.interval + 7;
+            result.end_day = result.start_day + static_cast<int>(std::min<int64_t>(span, MAX_COUNT_SPAN_DAYS));
+        }
+        if (count > 0) result.applyCount(count);    // 同时有 UNTIL 时以先到者为准
+        if (result.end_day < result.start_day) return fail(error, "UNTIL 早于 DTSTART");
+    }
+
+    for (int day : exdates) result.addException(day);
+    rule = result;
+    return true;
+}
+
+RecurrenceRule RecurrenceRule::daily(int start_day, int until_day, int interval) {
+    RecurrenceRule rule;
+    rule.freq = DAILY;
+    rule.interval = std::max(1, interval);
+    rule.start_day = start_day;
+    rule.end_day = until_day;
+    return rule;
+}
+
+RecurrenceRule RecurrenceRule::weekly(int start_day, int until_day, uint8_t weekday_mask, int interval) {
+    RecurrenceRule rule;
+    rule.freq = WEEKLY;
+    rule.interval = std::max(1, interval);
+    rule.weekday_mask = weekday_mask & 0x7F ? weekday_mask & 0x7F
+                                            : static_cast<uint8_t>(1u << weekdayOf(start_day));
+    rule.start_day = start_day;
+    rule.end_day = until_day;
+    return rule;
+}
+
+RecurrenceRule RecurrenceRule::custom(const std::vector<int>& days) {
+    RecurrenceRule rule;
+    rule.freq = CUSTOM;
+    rule.dates = days;
+    std::sort(rule.dates.begin(), rule.dates.end());
+    rule.dates.erase(std::unique(rule.dates.begin(), rule.dates.end()), rule.dates.end());
+    if (!rule.dates.empty()) {
+        rule.start_day = rule.dates.front();
+        rule.end_day = rule.dates.back();
+    }
+    return rule;
+}
+
+std::string RecurrenceRule::toString() const {
+    std::string text;
+    if (freq == CUSTOM) {
+        text = "RDATE=";
+        for (size_t i = 0; i < dates.size(); i++) {
+            if (i > 0) text += ",";
+            text += formatDate(dates[i]);
+        }
+    } else {
+        text = "DTSTART=" + formatDate(start_day) + ";FREQ=" + (freq == DAILY ? "DAILY" : "WEEKLY");
+        if (interval > 1) text += ";INTERVAL=" + std::to_string(interval);
+        if (freq == WEEKLY) {
+            text += ";BYDAY=";
+            bool first = true;
+            for (int i = 0; i < 7; i++) {
+                if (!(weekday_mask & (1u << i))) continue;
+                if (!first) text += ",";
+                text += WEEKDAY_CODES[i];
+                first = false;
+            }
+        }
+        text += ";UNTIL=" + formatDate(end_day);
+    }
+
+    if (!excluded.empty()) {
+        text += ";EXDATE=";
+        bool first = true;
+        for (int day : excluded) {
+            if (!first) text += ",";
+            text += formatDate(day);
+            first = false;
+        }
+    }
+    return text;
+}
+
+bool RecurrenceRule::matchesPattern(int day) const {
+    switch (freq) {
+        case DAILY:
+            return (day - start_day) % interval == 0;
+        case WEEKLY: {
+            if (!(weekday_mask & (1u << weekdayOf(day)))) return false;
+            // 以周一为一周的开始，按整周数判断间隔
+            int weeks = ((day - weekdayOf(day)) - (start_day - weekdayOf(start_day))) / 7;
+            return weeks % interval == 0;
+        }
+        case CUSTOM:
+            return std::binary_search(dates.begin(), dates.end(), day);
+    }
+    return false;
+}
+
+void RecurrenceRule::applyCount(int count) {
+    int counted = 0;
+    for (int day = start_day; day <= end_day; day++) {
+        if (matchesPattern(day) && ++counted == count) {
+            end_day = day;
+            return;
+        }
+    }
+}
+
+bool RecurrenceRule::occursOn(int day) const {
+    if (day < start_day || day > end_day || excluded.count(day)) return false;
+    return matchesPattern(day);
+}
+
+int RecurrenceRule::firstDay() const {
+    return start_day;
+}
+
+int RecurrenceRule::lastDay() const {
+    return end_day;
+}
+
+size_t RecurrenceRule::occurrenceCount() const {
+    size_t count = 0;
+    forEachOccurrence(start_day, end_day, [&](int) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+void RecurrenceRule::forEachOccurrence(int from_day, int to_day, const std::function<bool(int day)>& fn) const {
+    from_day = std::max(from_day, start_day);
+    to_day = std::min(to_day, end_day);
+    if (from_day > to_day) return;
+
+    if (freq == CUSTOM) {
+        for (auto it = std::lower_bound(dates.begin(), dates.end(), from_day);
+             it != dates.end() && *it <= to_day; ++it) {
+            if (!excluded.count(*it) && !fn(*it)) return;
+        }
+        return;
+    }
+
+    // DAILY 直接对齐到间隔上按步长前进，WEEKLY 逐天检查星期
+    int step = 1;
+    if (freq == DAILY) {
+        int offset = (from_day - start_day) % interval;
+        if (offset != 0) from_day += interval - offset;
+        step = interval;
+    }
+    for (int day = from_day; day <= to_day; day += step) {
+        if (matchesPattern(day) && !excluded.count(day) && !fn(day)) return;
+    }
+}
+
+void RecurrenceRule::addException(int day) {
+    excluded.insert(day);
+}
+
+const std::set<int>& RecurrenceRule::exceptions() const {
+    return excluded;
+}
+
+RecurrenceRule::Frequency RecurrenceRule::frequency() const {
+    return freq;
+}
@@ -0,0 +1,123 @@
+#include "../include/response_cache.h"
+#include <zlib.h>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+// FNV-1a，用于由响应体生成 ETag
+uint64_t fnv1a(const std::string& data) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+// 弱比较只看引号内的值
+std::string opaqueTag(const std::string& tag) {
+    return tag.compare(0, 2, "W/") == 0 ? tag.substr(2) : tag;
+}
+
+} // namespace
+
+// 静态常量定义
+const size_t ResponseCache::DEFAULT_CAPACITY = 256;
+const size_t ResponseCache::MIN_GZIP_BYTES = 1024;
+
+ResponseCache::ResponseCache(size_t capacity, size_t shard_count)
+    : entries(capacity, shard_count), stale_hits(0) {}
+
+std::shared_ptr<const CachedResponse> ResponseCache::fetch(const std::string& key, const std::string& generation,
+                                                           const std::function<std::string()>& build) {
+    auto cached = entries.get(key);
+    if (cached && (*cached)->generation == generation) {
+        return *cached;
+    }
+    if (cached) {
+        stale_hits++;
+    }
+
+    auto response = std::make_shared<CachedResponse>();
+    response->generation = generation;
+    response->body = build();
+
+    char hash[20];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(fnv1a(response->body)));
+    response->etag = "W/\"" + generation + "-" + hash + "\"";
+
+    if (response->body.size() >= MIN_GZIP_BYTES) {
+        std::string compressed;
+        if (gzipCompress(response->body, compressed) && compressed.size() < response->body.size()) {
+            response->gzip_body = std::move(compressed);
+        }
+    }
+
+    entries.put(key, response);
+    return response;
+}
+
+void ResponseCache::clear() {
+    entries.clear();
+}
+
+LRUCache<std::string, std::shared_ptr<const CachedResponse>>::Stats ResponseCache::getStats() const {
+    return entries.getStats();
+}
+
+void ResponseCache::printStats() const {
+    auto stats = entries.getStats();
+    uint64_t stale = stale_hits.load();
+    uint64_t fresh = stats.hits - stale;
+    std::cout << "响应缓存: " << stats.size << " 项, 命中 " << fresh << ", 过期重建 " << stale
+              << ", 未命中 " << stats.misses << " (命中率 "
+              << (stats.hits + stats.misses ? fresh * 100.0 / (stats.hits + stats.misses) : 0.0) << "%)" << std::endl;
+}
+
+std::string ResponseCache::makeKey(const std::string& route, const std::string& query, const std::string& role) {
+    return route + "?" + query + "#" + role;
+}
+
+bool ResponseCache::matchesETag(const std::string& if_none_match, const std::string& etag) {
+    if (trim(if_none_match) == "*") return true;
+
+    std::string expected = opaqueTag(etag);
+    size_t begin = 0;
+    while (begin <= if_none_match.size()) {
+        size_t comma = if_none_match.find(',', begin);
+        if (comma == std::string::npos) comma = if_none_match.size();
+        if (opaqueTag(trim(if_none_match.substr(begin, comma - begin))) == expected) {
+            return true;
+        }
+        begin = comma + 1;
+    }
+    return false;
+}
+
+bool ResponseCache::gzipCompress(const std::string& input, std::string& output) {
+    z_stream stream = {};
+    // windowBits 15 + 16 输出 gzip 格式（带头和 CRC）
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    output.resize(deflateBound(&stream, input.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
@@ -0,0 +1,371 @@
+#include "../include/schedule_optimizer.h"
+#include "../include/parallel_for.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int FIXED_OWNER = -1;            // 已有预约占用，不可挤出
+const double PERTURB_FRACTION = 0.05;  // 每次扰动移除的已安排比例
+const size_t DEADLINE_CHECK_INTERVAL = 64;
+
+// 资源时间线上的一段占用，按开始时间有序且互不重叠
+struct Block {
+    int start;
+    int end;
+    int owner;    // 请求下标或 FIXED_OWNER
+};
+
+// 预处理后的请求
+struct Candidate {
+    int priority;
+    int duration;
+    int window_start;
+    int window_end;
+    std::vector<int> resources;
+};
+
+// 一个完整解
+struct Solution {
+    std::vector<std::vector<Block>> timelines;
+    std::vector<int> resource;      // 每个请求所在资源，-1 表示未安排
+    std::vector<int> start;
+    long long total;
+
+    Solution() : total(0) {}
+};
+
+// 第一个结束时间晚于 time 的占用（有序且不重叠，结束时间同样有序）
+size_t firstEndingAfter(const std::vector<Block>& line, int time) {
+    return std::upper_bound(line.begin(), line.end(), time, [](int value, const Block& block) {
+        return value < block.end;
+    }) - line.begin();
+}
+
+class Solver {
+public:
+    Solver(const std::vector<Candidate>& candidates, const std::vector<std::vector<Block>>& fixed,
+           uint32_t seed, Clock::time_point deadline)
+        : candidates(candidates), rng(seed), deadline(deadline), iterations(0), checks(0) {
+        current.timelines = fixed;
+        current.resource.assign(candidates.size(), -1);
+        current.start.assign(candidates.size(), 0);
+    }
+
+    // randomized 为 false 时是确定性的贪心 + 局部搜索
+    void run(bool randomized) {
+        greedy(densityOrder(randomized));
+        localSearch();
+        best = current;
+
+        while (!expired()) {
+            current = best;
+            perturb();
+            if (current.total > best.total) {
+                best = current;
+            }
+        }
+    }
+
+    const Solution& result() const { return best; }
+    size_t iterationCount() const { return iterations; }
+
+private:
+    const std::vector<Candidate>& candidates;
+    std::mt19937 rng;
+    Clock::time_point deadline;
+    Solution current;
+    Solution best;
+    size_t iterations;
+    size_t checks;
+
+    bool expired() {
+        return Clock::now() >= deadline;
+    }
+
+    // 截止时间每隔若干次检查一次，避免频繁读时钟
+    bool expiredSampled() {
+        return ++checks % DEADLINE_CHECK_INTERVAL == 0 && expired();
+    }
+
+    // 单位时长优先级从高到低；随机化时乘以扰动系数
+    // 无效请求（没有可用资源，时长可能为 0）不参与，否则键值为 inf/NaN，破坏排序的严格弱序
+    std::vector<int> densityOrder(bool randomized) {
+        std::vector<std::pair<double, int>> keyed;
+        std::uniform_real_distribution<double> noise(0.8, 1.2);
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (current.resource[i] != -1 || candidates[i].resources.empty()) continue;
+            double key = static_cast<double>(candidates[i].priority) / candidates[i].duration;
+            keyed.emplace_back(randomized ? key * noise(rng) : key, static_cast<int>(i));
+        }
+        std::sort(keyed.begin(), keyed.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+
+        std::vector<int> order;
+        order.reserve(keyed.size());
+        for (const auto& entry : keyed) {
+            order.push_back(entry.second);
+        }
+        return order;
+    }
+
+    // 在允许的资源中找能放下且剩余间隙最小的位置，放在间隙左端
+    bool findPlacement(int request, int& resource, int& start) const {
+        const Candidate& candidate = candidates[request];
+        int best_slack = INT_MAX;
+
+        for (int res : candidate.resources) {
+            const std::vector<Block>& line = current.timelines[res];
+            size_t index = firstEndingAfter(line, candidate.window_start);
+            int gap_start = candidate.window_start;
+
+            for (size_t i = index; i <= line.size(); i++) {
+                int gap_end = i < line.size() ? std::min(line[i].start, candidate.window_end) : candidate.window_end;
+                int slack = gap_end - gap_start - candidate.duration;
+                if (slack >= 0 && slack < best_slack) {
+                    best_slack = slack;
+                    resource = res;
+                    start = gap_start;
+                }
+                if (i == line.size()) break;
+                gap_start = std::max(gap_start, line[i].end);
+                if (gap_start >= candidate.window_end) break;
+            }
+        }
+        return best_slack != INT_MAX;
+    }
+
+    void place(int request, int resource, int start) {
+        std::vector<Block>& line = current.timelines[resource];
+        Block block = {start, start + candidates[request].duration, request};
+        auto position = std::upper_bound(line.begin(), line.end(), start, [](int value, const Block& other) {
+            return value < other.start;
+        });
+        line.insert(position, block);
+        current.resource[request] = resource;
+        current.start[request] = start;
+        current.total += candidates[request].priority;
+    }
+
+    void unplace(int request) {
+        std::vector<Block>& line = current.timelines[current.resource[request]];
+        int start = current.start[request];
+        auto position = std::lower_bound(line.begin(), line.end(), start, [](const Block& other, int value) {
+            return other.start < value;
+        });
+        line.erase(position);
+        current.resource[request] = -1;
+        current.total -= candidates[request].priority;
+    }
+
+    void greedy(const std::vector<int>& order) {
+        for (int request : order) {
+            int resource = 0;
+            int start = 0;
+            if (current.resource[request] == -1 && findPlacement(request, resource, start)) {
+                place(request, resource, start);
+            }
+        }
+    }
+
+    // 在 [start, start + duration) 放下请求需要挤出的优先级之和；碰到固定占用或不低于 limit 时返回 -1
+    int ejectionCost(const std::vector<Block>& line, int start, int end, int limit) const {
+        int cost = 0;
+        for (size_t i = firstEndingAfter(line, start); i < line.size() && line[i].start < end; i++) {
+            if (line[i].owner == FIXED_OWNER) return -1;
+            cost += candidates[line[i].owner].priority;
+            if (cost >= limit) return -1;
+        }
+        return cost;
+    }
+
+    // 挤出优先级之和更低的已安排请求来放下 request，被挤出者再尝试重新安排
+    // 候选开始时间为窗口起点和窗口内各占用的结束时间
+    bool tryEject(int request) {
+        const Candidate& candidate = candidates[request];
+        int best_cost = candidate.priority;
+        int best_resource = -1;
+        int best_start = 0;
+
+        for (int res : candidate.resources) {
+            const std::vector<Block>& line = current.timelines[res];
+            int start = candidate.window_start;
+            size_t index = firstEndingAfter(line, candidate.window_start);
+            while (start + candidate.duration <= candidate.window_end) {
+                int cost = ejectionCost(line, start, start + candidate.duration, best_cost);
+                if (cost >= 0 && cost < best_cost) {
+                    best_cost = cost;
+                    best_resource = res;
+                    best_start = start;
+                }
+                if (index >= line.size()) break;
+                start = std::max(start, line[index++].end);
+            }
+        }
+        if (best_resource == -1) return false;
+
+        std::vector<int> ejected;
+        const std::vector<Block>& line = current.timelines[best_resource];
+        int best_end = best_start + candidate.duration;
+        for (size_t i = firstEndingAfter(line, best_start); i < line.size() && line[i].start < best_end; i++) {
+            ejected.push_back(line[i].owner);
+        }
+        for (int owner : ejected) {
+            unplace(owner);
+        }
+        place(request, best_resource, best_start);
+
+        std::sort(ejected.begin(), ejected.end(), [this](int a, int b) {
+            return candidates[a].priority * candidates[b].duration > candidates[b].priority * candidates[a].duration;
+        });
+        greedy(ejected);
+        iterations++;
+        return true;
+    }
+
+    // 反复尝试安排未安排的请求，直到一整轮没有改进或超时
+    void localSearch() {
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (int request : densityOrder(false)) {
+                if (expiredSampled()) return;
+                if (current.resource[request] != -1) continue;
+
+                int resource = 0;
+                int start = 0;
+                if (findPlacement(request, resource, start)) {
+                    place(request, resource, start);
+                    improved = true;
+                } else if (tryEject(request)) {
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    void perturb() {
+        std::vector<int> placed;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (current.resource[i] != -1) placed.push_back(static_cast<int>(i));
+        }
+        if (placed.empty()) {
+            localSearch();
+            return;
+        }
+
+        std::shuffle(placed.begin(), placed.end(), rng);
+        size_t removal = std::max<size_t>(1, static_cast<size_t>(placed.size() * PERTURB_FRACTION));
+        for (size_t i = 0; i < removal && i < placed.size(); i++) {
+            unplace(placed[i]);
+        }
+        greedy(densityOrder(true));
+        localSearch();
+    }
+};
+
+} // namespace
+
+ScheduleOptimizer::ScheduleOptimizer(const std::vector<std::string>& resources) {
+    for (const auto& resource : resources) {
+        if (resource_ids.count(resource)) continue;
+        resource_ids[resource] = static_cast<int>(resource_names.size());
+        resource_names.push_back(resource);
+    }
+    busy.resize(resource_names.size());
+}
+
+void ScheduleOptimizer::addBusyInterval(const std::string& resource, int start_minutes, int end_minutes) {
+    auto it = resource_ids.find(resource);
+    if (it == resource_ids.end() || end_minutes <= start_minutes) return;
+    busy[it->second].emplace_back(start_minutes, end_minutes);
+}
+
+ScheduleResult ScheduleOptimizer::optimize(const std::vector<ScheduleRequest>& requests,
+                                           const OptimizerOptions& options) const {
+    auto started = Clock::now();
+    auto deadline = started + std::chrono::milliseconds(std::max(0, options.time_budget_ms));
+
+    // 固定占用合并为有序不重叠的时间线
+    std::vector<std::vector<Block>> fixed(resource_names.size());
+    for (size_t res = 0; res < busy.size(); res++) {
+        std::vector<std::pair<int, int>> intervals = busy[res];
+        std::sort(intervals.begin(), intervals.end());
+        for (const auto& interval : intervals) {
+            if (!fixed[res].empty() && interval.first <= fixed[res].back().end) {
+                fixed[res].back().end = std::max(fixed[res].back().end, interval.second);
+            } else {
+                fixed[res].push_back({interval.first, interval.second, FIXED_OWNER});
+            }
+        }
+    }
+
+    ScheduleResult result;
+    std::vector<Candidate> candidates(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        const ScheduleRequest& request = requests[i];
+        Candidate& candidate = candidates[i];
+        candidate.priority = std::max(0, request.priority);
+        candidate.duration = request.duration_minutes;
+        candidate.window_start = request.window_start;
+        candidate.window_end = request.window_end;
+        result.requested_priority += candidate.priority;
+
+        // 未指定资源时可使用全部资源；无效请求的 resources 留空，求解时跳过，保持未安排
+        if (request.duration_minutes <= 0 || request.window_end - request.window_start < request.duration_minutes) {
+            continue;
+        }
+        if (request.allowed_resources.empty()) {
+            for (size_t res = 0; res < resource_names.size(); res++) {
+                candidate.resources.push_back(static_cast<int>(res));
+            }
+        }
+        for (const auto& name : request.allowed_resources) {
+            auto it = resource_ids.find(name);
+            if (it != resource_ids.end()) candidate.resources.push_back(it->second);
+        }
+    }
+
+    unsigned restarts = options.restarts > 0 ? options.restarts : defaultBuildThreads();
+    std::vector<Solution> solutions(restarts);
+    std::vector<size_t> iterations(restarts, 0);
+    parallelForShards(restarts, restarts, [&](unsigned, size_t begin, size_t end) {
+        for (size_t run = begin; run < end; run++) {
+            Solver solver(candidates, fixed, options.seed + static_cast<uint32_t>(run) * 7919u, deadline);
+            solver.run(run != 0);
+            solutions[run] = solver.result();
+            iterations[run] = solver.iterationCount();
+        }
+    });
+
+    size_t chosen = 0;
+    for (size_t run = 1; run < restarts; run++) {
+        if (solutions[run].total > solutions[chosen].total) chosen = run;
+    }
+    const Solution& best = solutions[chosen];
+
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (best.resource[i] == -1) {
+            result.unassigned.push_back(requests[i].id);
+            continue;
+        }
+        ScheduleAssignment assignment;
+        assignment.request_id = requests[i].id;
+        assignment.request_index = i;
+        assignment.resource_name = resource_names[best.resource[i]];
+        assignment.start_minutes = best.start[i];
+        assignment.end_minutes = best.start[i] + candidates[i].duration;
+        result.assignments.push_back(assignment);
+    }
+    result.total_priority = best.total;
+    for (size_t count : iterations) {
+        result.iterations += count;
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+    return result;
+}
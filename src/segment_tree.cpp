@@ -60,13 +60,12 @@ void SegmentTree::updateRange(int node, int start, int end, int l, int r, int va
     tree[node] = std::max(tree[2 * node + 1], tree[2 * node + 2]);
 }
 
-int SegmentTree:: queryRange(int node, int start, int end, int l, int r) {
+// 查询不下推懒标记：节点的实际最大值为 tree + lazy，沿路径累加即可，查询因此是只读的
+int SegmentTree:: queryRange(int node, int start, int end, int l, int r) const {
     if (start > r || end < l) return 0;  // 完全不重叠
     
-    pushDown(node, start, end);
-    
     if (start >= l && end <= r) {  // 完全包含
-        return tree[node];
+        return tree[node] + lazy[node];
     }
     
     // 部分重叠，递归查询
@@ -74,29 +73,59 @@ int SegmentTree:: queryRange(int node, int start, int end, int l, int r) {
     int leftMax = queryRange(2 * node + 1, start, mid, l, r);
     int rightMax = queryRange(2 * node + 2, mid + 1, end, l, r);
     
-    return std::max(leftMax, rightMax);
+    return lazy[node] + std::max(leftMax, rightMax);
 }
 
-void SegmentTree::addInterval(int start, int end) {
+void SegmentTree::collectRanges(int node, int start, int end, int l, int r, int threshold, int pending,
+                                std::vector<std::pair<int, int>>& ranges) const {
+    if (start > r || end < l) return;
+    pending += lazy[node];
+    if (tree[node] + pending < threshold) return;  // 整个子树都达不到阈值
+    
+    if (start == end) {
+        // 与上一个区间相接时合并
+        if (!ranges.empty() && ranges.back().second + 1 == start) {
+            ranges.back().second = start;
+        } else {
+            ranges.emplace_back(start, start);
+        }
+        return;
+    }
+    
+    int mid = (start + end) / 2;
+    collectRanges(2 * node + 1, start, mid, l, r, threshold, pending, ranges);
+    collectRanges(2 * node + 2, mid + 1, end, l, r, threshold, pending, ranges);
+}
+
+void SegmentTree::addInterval(int start, int end, int amount) {
     if (start < 0 || end >= size || start > end) return;
-    updateRange(0, 0, size - 1, start, end, 1);
+    updateRange(0, 0, size - 1, start, end, amount);
 }
 
-void SegmentTree::removeInterval(int start, int end) {
+void SegmentTree::removeInterval(int start, int end, int amount) {
     if (start < 0 || end >= size || start > end) return;
-    updateRange(0, 0, size - 1, start, end, -1);
+    updateRange(0, 0, size - 1, start, end, -amount);
 }
 
-bool SegmentTree::isConflict(int start, int end) {
+bool SegmentTree::isConflict(int start, int end) const {
     if (start < 0 || end >= size || start > end) return false;
     return queryRange(0, 0, size - 1, start, end) > 0;
 }
 
-int SegmentTree:: queryOccupancy(int start, int end) {
+int SegmentTree:: queryOccupancy(int start, int end) const {
     if (start < 0 || end >= size || start > end) return 0;
     return queryRange(0, 0, size - 1, start, end);
 }
 
+std::vector<std::pair<int, int>> SegmentTree::findRangesAtLeast(int start, int end, int threshold) const {
+    std::vector<std::pair<int, int>> ranges;
+    start = std::max(start, 0);
+    end = std::min(end, size - 1);
+    if (start > end) return ranges;
+    collectRanges(0, 0, size - 1, start, end, threshold, 0, ranges);
+    return ranges;
+}
+
 void SegmentTree::clear() {
     std::fill(tree. begin(), tree.end(), 0);
     std::fill(lazy. begin(), lazy.end(), 0);
@@ -122,6 +151,12 @@ void SegmentTree::printNode(int node, int start, int end, int depth) const {
 // VenueConflictDetector 实现
 VenueConflictDetector::VenueConflictDetector(int timeRange) : timeRange(timeRange) {}
 
+VenueConflictDetector::~VenueConflictDetector() {
+    for (auto& entry : venueToTree) {
+        delete entry.second;
+    }
+}
+
 bool VenueConflictDetector::addActivity(const std:: string& venue, int startTime, int endTime, int activityId) {
     // 检查时间合法性
     if (startTime < 0 || endTime >= timeRange || startTime >= endTime) {
@@ -0,0 +1,149 @@
+#include "../include/slot_suggester.h"
+#include "../include/priority_queue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace {
+
+// 一个资源在一个方向上的间隙游标；next 是间隙右侧的占用（end 表示最后一个间隙）
+struct GapCursor {
+    size_t rank;                          // 资源在请求中的顺序
+    bool forward;                         // 向后（时间增大）还是向前走
+    const std::map<int, int>* line;
+    std::map<int, int>::const_iterator next;
+    int start;                            // 当前间隙内离期望时间最近的开始时间
+    int distance;
+};
+
+struct NearestFirst {
+    bool operator()(const GapCursor& a, const GapCursor& b) const {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.rank != b.rank) return a.rank < b.rank;
+        return a.start < b.start;
+    }
+};
+
+} // namespace
+
+SlotSuggester::SlotSuggester(int horizon_start, int horizon_end)
+    : horizon_start(horizon_start), horizon_end(horizon_end) {}
+
+void SlotSuggester::addResource(const std::string& resource) {
+    lines[resource];
+}
+
+void SlotSuggester::removeResource(const std::string& resource) {
+    lines.erase(resource);
+}
+
+void SlotSuggester::clear() {
+    lines.clear();
+}
+
+void SlotSuggester::addBusy(const std::string& resource, int start_minutes, int end_minutes) {
+    if (end_minutes <= start_minutes) return;
+    BusyLine& line = lines[resource];
+
+    // 与前一个占用相接或重叠时从它开始合并
+    auto it = line.upper_bound(start_minutes);
+    if (it != line.begin() && std::prev(it)->second >= start_minutes) {
+        --it;
+    }
+    while (it != line.end() && it->first <= end_minutes) {
+        start_minutes = std::min(start_minutes, it->first);
+        end_minutes = std::max(end_minutes, it->second);
+        it = line.erase(it);
+    }
+    line[start_minutes] = end_minutes;
+}
+
+void SlotSuggester::removeBusy(const std::string& resource, int start_minutes, int end_minutes) {
+    auto line_it = lines.find(resource);
+    if (line_it == lines.end() || end_minutes <= start_minutes) return;
+    BusyLine& line = line_it->second;
+
+    auto it = line.upper_bound(start_minutes);
+    if (it != line.begin() && std::prev(it)->second > start_minutes) {
+        --it;
+    }
+    // 被覆盖的占用删掉，跨出 [start, end) 的部分保留
+    while (it != line.end() && it->first < end_minutes) {
+        int busy_start = it->first;
+        int busy_end = it->second;
+        it = line.erase(it);
+        if (busy_start < start_minutes) line[busy_start] = start_minutes;
+        if (busy_end > end_minutes) line[end_minutes] = busy_end;
+    }
+}
+
+bool SlotSuggester::isFree(const std::string& resource, int start_minutes, int end_minutes) const {
+    auto line_it = lines.find(resource);
+    if (line_it == lines.end() || start_minutes < horizon_start || end_minutes > horizon_end) return false;
+    const BusyLine& line = line_it->second;
+
+    auto it = line.upper_bound(start_minutes);
+    if (it != line.begin() && std::prev(it)->second > start_minutes) return false;
+    return it == line.end() || it->first >= end_minutes;
+}
+
+std::vector<SlotSuggestion> SlotSuggester::suggest(const std::vector<std::string>& resources,
+                                                   int preferred_start, int duration_minutes,
+                                                   size_t limit) const {
+    std::vector<SlotSuggestion> suggestions;
+    if (duration_minutes <= 0 || limit == 0) return suggestions;
+
+    // 从游标当前位置起找到第一个放得下的间隙
+    auto settle = [&](GapCursor& cursor) {
+        const BusyLine& line = *cursor.line;
+        while (true) {
+            int gap_start = cursor.next == line.begin() ? horizon_start
+                                                        : std::max(horizon_start, std::prev(cursor.next)->second);
+            int gap_end = cursor.next == line.end() ? horizon_end : std::min(horizon_end, cursor.next->first);
+            if (gap_end - gap_start >= duration_minutes) {
+                cursor.start = std::min(std::max(preferred_start, gap_start), gap_end - duration_minutes);
+                cursor.distance = std::abs(cursor.start - preferred_start);
+                return true;
+            }
+            if (cursor.forward) {
+                if (cursor.next == line.end() || gap_start >= horizon_end) return false;
+                ++cursor.next;
+            } else {
+                if (cursor.next == line.begin() || gap_end <= horizon_start) return false;
+                --cursor.next;
+            }
+        }
+    };
+
+    PriorityQueue<GapCursor, NearestFirst> frontier;
+    for (size_t rank = 0; rank < resources.size(); rank++) {
+        auto line_it = lines.find(resources[rank]);
+        if (line_it == lines.end()) continue;
+        const BusyLine& line = line_it->second;
+
+        // 期望时间所在（或其后第一个）间隙向后走，它之前的间隙向前走
+        auto after = line.upper_bound(preferred_start);
+        GapCursor forward = {rank, true, &line, after, 0, 0};
+        if (settle(forward)) frontier.push(forward);
+        if (after != line.begin()) {
+            GapCursor backward = {rank, false, &line, std::prev(after), 0, 0};
+            if (settle(backward)) frontier.push(backward);
+        }
+    }
+
+    while (!frontier.isEmpty() && suggestions.size() < limit) {
+        GapCursor cursor = frontier.pop();
+        suggestions.push_back({resources[cursor.rank], cursor.start,
+                               cursor.start + duration_minutes, cursor.distance});
+
+        if (cursor.forward) {
+            if (cursor.next == cursor.line->end()) continue;
+            ++cursor.next;
+        } else {
+            if (cursor.next == cursor.line->begin()) continue;
+            --cursor.next;
+        }
+        if (settle(cursor)) frontier.push(cursor);
+    }
+    return suggestions;
+}
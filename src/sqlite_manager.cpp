@@ -1,5 +1,17 @@
 #include "../include/sqlite_manager.h"
-#include <iostream>
+#include "../include/metrics.h"
+#include "../include/logger.h"
+
+namespace {
+
+// 每条语句一个直方图（含准备、绑定、执行和逐行读取），首次执行时注册
+Histogram& statementLatency(const char* statement) {
+    return MetricsRegistry::global().histogram(
+        "sqlite_statement_duration_seconds", "SQLite statement latency including row iteration",
+        MetricsRegistry::label("statement", statement));
+}
+
+} // namespace
 
 SQLiteManager::SQLiteManager(const std:: string& path) : db(nullptr), db_path(path) {}
 
@@ -12,7 +24,7 @@ SQLiteManager::~SQLiteManager() {
 bool SQLiteManager::init() {
     // 打开数据库
     if (sqlite3_open(db_path. c_str(), &db) != SQLITE_OK) {
-        std::cerr << "无法打开数据库: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("无法打开数据库: " << sqlite3_errmsg(db));
         return false;
     }
     
@@ -47,22 +59,49 @@ bool SQLiteManager::init() {
         );
     )";
     
+    // 变更序号：由触发器在每次增删改后递增，用于判断索引快照是否过期
+    const char* createMeta = R"(
+        CREATE TABLE IF NOT EXISTS meta (
+            key TEXT PRIMARY KEY,
+            value INTEGER NOT NULL
+        );
+        INSERT OR IGNORE INTO meta (key, value) VALUES ('change_seq', 0);
+        CREATE TRIGGER IF NOT EXISTS contacts_insert_seq AFTER INSERT ON contacts
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+        CREATE TRIGGER IF NOT EXISTS contacts_update_seq AFTER UPDATE ON contacts
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+        CREATE TRIGGER IF NOT EXISTS contacts_delete_seq AFTER DELETE ON contacts
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+        CREATE TRIGGER IF NOT EXISTS activities_insert_seq AFTER INSERT ON activities
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+        CREATE TRIGGER IF NOT EXISTS activities_update_seq AFTER UPDATE ON activities
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+        CREATE TRIGGER IF NOT EXISTS activities_delete_seq AFTER DELETE ON activities
+            BEGIN UPDATE meta SET value = value + 1 WHERE key = 'change_seq'; END;
+    )";
+    
     char* errMsg = nullptr;
     
     // 执行建表语句
     if (sqlite3_exec(db, createContacts, nullptr, nullptr, &errMsg) != SQLITE_OK) {
-        std::cerr << "创建联系人表失败: " << errMsg << std:: endl;
+        LOG_ERROR("创建联系人表失败: " << errMsg);
         sqlite3_free(errMsg);
         return false;
     }
     
     if (sqlite3_exec(db, createActivities, nullptr, nullptr, &errMsg) != SQLITE_OK) {
-        std::cerr << "创建活动表失败: " << errMsg << std:: endl;
+        LOG_ERROR("创建活动表失败: " << errMsg);
+        sqlite3_free(errMsg);
+        return false;
+    }
+    
+    if (sqlite3_exec(db, createMeta, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        LOG_ERROR("创建变更序号表失败: " << errMsg);
         sqlite3_free(errMsg);
         return false;
     }
     
-    std::cout << "数据库初始化成功" << std::endl;
+    LOG_INFO("数据库初始化成功");
     return true;
 }
 
@@ -74,20 +113,42 @@ const std::string& SQLiteManager::getDbPath() const {
     return db_path;
 }
 
-bool SQLiteManager::addContact(const Contact& contact) {
+int64_t SQLiteManager::getChangeSequence() {
+    if (!isOpen()) return -1;
+    
+    const char* sql = "SELECT value FROM meta WHERE key = 'change_seq';";
+    static Histogram& latency = statementLatency("meta_select_change_seq");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return -1;
+    }
+    
+    int64_t sequence = -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        sequence = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return sequence;
+}
+
+bool SQLiteManager::addContact(const Contact& contact, int& new_id) {
     if (!isOpen()) return false;
     
     // 简单验证
     if (contact.name.empty() || contact.phone.empty() || contact.email.empty()) {
-        std:: cerr << "联系人信息不完整" << std::endl;
+        LOG_WARN("联系人信息不完整");
         return false;
     }
     
     const char* sql = "INSERT INTO contacts (name, student_id, phone, email, department) VALUES (?, ?, ?, ?, ?);";
+    static Histogram& latency = statementLatency("contacts_insert");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "准备语句失败: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
         return false;
     }
     
@@ -101,22 +162,98 @@ bool SQLiteManager::addContact(const Contact& contact) {
     sqlite3_finalize(stmt);
     
     if (!success) {
-        std::cerr << "插入联系人失败: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("插入联系人失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    new_id = static_cast<int>(sqlite3_last_insert_rowid(db));
+    return true;
+}
+
+bool SQLiteManager::getContact(int id, Contact& contact) {
+    if (!isOpen()) return false;
+    
+    const char* sql = "SELECT id, name, student_id, phone, email, department FROM contacts WHERE id = ?;";
+    static Histogram& latency = statementLatency("contacts_select_one");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, id);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    if (found) {
+        const char* student_id = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+        const char* department = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
+        contact = Contact(
+            sqlite3_column_int(stmt, 0),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
+            student_id ? student_id : "",
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4)),
+            department ? department : ""
+        );
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool SQLiteManager::updateContact(const Contact& contact) {
+    if (!isOpen()) return false;
+    
+    const char* sql = "UPDATE contacts SET name = ?, student_id = ?, phone = ?, email = ?, department = ? WHERE id = ?;";
+    static Histogram& latency = statementLatency("contacts_update");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_text(stmt, 1, contact.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, contact.student_id.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, contact.phone.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, contact.email.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, contact.department.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 6, contact.id);
+    
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE) && sqlite3_changes(db) > 0;
+    sqlite3_finalize(stmt);
+    
+    if (!success) {
+        LOG_WARN("更新联系人失败: ID=" << contact.id << " " << sqlite3_errmsg(db));
     }
     
     return success;
 }
 
+int SQLiteManager::getContactCount() {
+    return countRows("SELECT COUNT(*) FROM contacts;", "contacts_count");
+}
+
 std::vector<Contact> SQLiteManager::getAllContacts() {
     std::vector<Contact> contacts;
-    if (!isOpen()) return contacts;
+    forEachContact([&contacts](Contact&& contact) {
+        contacts.push_back(std::move(contact));
+    });
+    return contacts;
+}
+
+bool SQLiteManager::forEachContact(const std::function<void(Contact&&)>& visitor) {
+    if (!isOpen()) return false;
     
     const char* sql = "SELECT id, name, student_id, phone, email, department FROM contacts;";
+    static Histogram& latency = statementLatency("contacts_select_all");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std:: cerr << "查询联系人失败:  " << sqlite3_errmsg(db) << std::endl;
-        return contacts;
+        LOG_ERROR("查询联系人失败:  " << sqlite3_errmsg(db));
+        return false;
     }
     
     while (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -130,17 +267,19 @@ std::vector<Contact> SQLiteManager::getAllContacts() {
             reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4)),
             department ? department : ""
         );
-        contacts.push_back(contact);
+        visitor(std::move(contact));
     }
     
     sqlite3_finalize(stmt);
-    return contacts;
+    return true;
 }
 
 bool SQLiteManager::deleteContact(int id) {
     if (!isOpen()) return false;
     
     const char* sql = "DELETE FROM contacts WHERE id = ?;";
+    static Histogram& latency = statementLatency("contacts_delete");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
@@ -154,20 +293,52 @@ bool SQLiteManager::deleteContact(int id) {
     return success;
 }
 
+bool SQLiteManager::restoreContact(const Contact& contact) {
+    if (!isOpen() || contact.id <= 0) return false;
+    
+    const char* sql = "INSERT INTO contacts (id, name, student_id, phone, email, department) VALUES (?, ?, ?, ?, ?, ?);";
+    static Histogram& latency = statementLatency("contacts_restore");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, contact.id);
+    sqlite3_bind_text(stmt, 2, contact.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, contact.student_id.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, contact.phone.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, contact.email.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 6, contact.department.c_str(), -1, SQLITE_STATIC);
+    
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    sqlite3_finalize(stmt);
+    
+    if (!success) {
+        LOG_ERROR("恢复联系人失败: " << sqlite3_errmsg(db));
+    }
+    
+    return success;
+}
+
 bool SQLiteManager::addActivity(const Activity& activity) {
     if (! isOpen()) return false;
     
     // 简单验证
     if (activity.name.empty() || activity.location. empty()) {
-        std:: cerr << "活动信息不完整" << std:: endl;
+        LOG_WARN("活动信息不完整");
         return false;
     }
     
     const char* sql = "INSERT INTO activities (name, description, location, start_time, end_time, max_participants, current_participants, category, status, created_by) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+    static Histogram& latency = statementLatency("activities_insert");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "准备语句失败: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
         return false;
     }
     
@@ -176,7 +347,7 @@ bool SQLiteManager::addActivity(const Activity& activity) {
     sqlite3_bind_text(stmt, 3, activity.location.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 4, activity.start_time.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 5, activity. end_time.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 6, 0); // max_participants - 默认0
+    sqlite3_bind_int(stmt, 6, activity.max_participants);
     sqlite3_bind_int(stmt, 7, 0); // current_participants - 默认0
     sqlite3_bind_text(stmt, 8, "", -1, SQLITE_STATIC); // category - 暂时为空
     sqlite3_bind_text(stmt, 9, "upcoming", -1, SQLITE_STATIC); // status
@@ -186,22 +357,124 @@ bool SQLiteManager::addActivity(const Activity& activity) {
     sqlite3_finalize(stmt);
     
     if (!success) {
-        std::cerr << "插入活动失败: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("插入活动失败: " << sqlite3_errmsg(db));
     }
     
     return success;
 }
 
+bool SQLiteManager::restoreActivity(const Activity& activity) {
+    if (!isOpen() || activity.id <= 0) return false;
+    
+    const char* sql = "INSERT INTO activities (id, name, description, location, start_time, end_time, max_participants, current_participants, category, status, created_by) VALUES (?, ?, '', ?, ?, ?, ?, 0, '', 'upcoming', 'system');";
+    static Histogram& latency = statementLatency("activities_restore");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, activity.id);
+    sqlite3_bind_text(stmt, 2, activity.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, activity.location.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, activity.start_time.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, activity.end_time.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 6, activity.max_participants);
+    
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    sqlite3_finalize(stmt);
+    
+    if (!success) {
+        LOG_ERROR("恢复活动失败: " << sqlite3_errmsg(db));
+    }
+    
+    return success;
+}
+
+bool SQLiteManager::getActivity(int id, Activity& activity) {
+    if (!isOpen()) return false;
+    
+    const char* sql = "SELECT id, name, location, start_time, end_time, max_participants FROM activities WHERE id = ?;";
+    static Histogram& latency = statementLatency("activities_select_one");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, id);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    if (found) {
+        activity = Activity(
+            sqlite3_column_int(stmt, 0),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)),
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4)),
+            sqlite3_column_int(stmt, 5)
+        );
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool SQLiteManager::updateActivity(const Activity& activity) {
+    if (!isOpen()) return false;
+    
+    const char* sql = "UPDATE activities SET name = ?, location = ?, start_time = ?, end_time = ?, max_participants = ?, updated_at = datetime('now') WHERE id = ?;";
+    static Histogram& latency = statementLatency("activities_update");
+    ScopedTimer timer(latency);
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("准备语句失败: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_text(stmt, 1, activity.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, activity.location.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, activity.start_time.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, activity.end_time.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 5, activity.max_participants);
+    sqlite3_bind_int(stmt, 6, activity.id);
+    
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE) && sqlite3_changes(db) > 0;
+    sqlite3_finalize(stmt);
+    
+    if (!success) {
+        LOG_WARN("更新活动失败: ID=" << activity.id << " " << sqlite3_errmsg(db));
+    }
+    
+    return success;
+}
+
+int SQLiteManager::getActivityCount() {
+    return countRows("SELECT COUNT(*) FROM activities;", "activities_count");
+}
+
 std:: vector<Activity> SQLiteManager::getAllActivities() {
     std::vector<Activity> activities;
-    if (!isOpen()) return activities;
+    forEachActivity([&activities](Activity&& activity) {
+        activities.push_back(std::move(activity));
+    });
+    return activities;
+}
+
+bool SQLiteManager::forEachActivity(const std::function<void(Activity&&)>& visitor) {
+    if (!isOpen()) return false;
     
     const char* sql = "SELECT id, name, location, start_time, end_time, max_participants, current_participants, category, status FROM activities;";
+    static Histogram& latency = statementLatency("activities_select_all");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "查询活动失败: " << sqlite3_errmsg(db) << std::endl;
-        return activities;
+        LOG_ERROR("查询活动失败: " << sqlite3_errmsg(db));
+        return false;
     }
     
     while (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -210,20 +483,23 @@ std:: vector<Activity> SQLiteManager::getAllActivities() {
             reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
             reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)),
             reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)),
-            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4))
+            reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4)),
+            sqlite3_column_int(stmt, 5)
         );
         // 注意：Activity结构体可能需要扩展以支持更多字段
-        activities.push_back(activity);
+        visitor(std::move(activity));
     }
     
     sqlite3_finalize(stmt);
-    return activities;
+    return true;
 }
 
 bool SQLiteManager::deleteActivity(int id) {
     if (!isOpen()) return false;
     
     const char* sql = "DELETE FROM activities WHERE id = ?;";
+    static Histogram& latency = statementLatency("activities_delete");
+    ScopedTimer timer(latency);
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
@@ -242,4 +518,48 @@ void SQLiteManager::clearAll() {
     
     sqlite3_exec(db, "DELETE FROM contacts", nullptr, nullptr, nullptr);
     sqlite3_exec(db, "DELETE FROM activities", nullptr, nullptr, nullptr);
-}
\ No newline at end of file
+}
+
+bool SQLiteManager::backupTo(const std::string& path) {
+    if (!isOpen()) return false;
+    
+    static Histogram& latency = statementLatency("backup");
+    ScopedTimer timer(latency);
+    
+    sqlite3* target = nullptr;
+    if (sqlite3_open(path.c_str(), &target) != SQLITE_OK) {
+        LOG_ERROR("无法创建备份文件: " << path);
+        sqlite3_close(target);
+        return false;
+    }
+    
+    sqlite3_backup* backup = sqlite3_backup_init(target, "main", db, "main");
+    bool success = backup != nullptr;
+    if (backup) {
+        success = sqlite3_backup_step(backup, -1) == SQLITE_DONE;
+        sqlite3_backup_finish(backup);
+    }
+    if (!success) {
+        LOG_ERROR("备份数据库失败: " << sqlite3_errmsg(target));
+    }
+    sqlite3_close(target);
+    return success;
+}
+
+int SQLiteManager::countRows(const char* sql, const char* statement) {
+    if (!isOpen()) return 0;
+    
+    ScopedTimer timer(statementLatency(statement));
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return 0;
+    }
+    
+    int count = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return count;
+}
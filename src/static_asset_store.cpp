@@ -0,0 +1,268 @@
+#include "../include/static_asset_store.h"
+#include "../include/response_cache.h"
+#include <brotli/encode.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::string lowercase(const std::string& text) {
+    std::string result = text;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+const std::string* findHeader(const std::map<std::string, std::string>& headers, const std::string& name) {
+    for (const auto& header : headers) {
+        if (lowercase(header.first) == name) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+// Accept-Encoding 中是否接受指定编码（忽略 q=0 的项）
+bool acceptsEncoding(const std::string& accept_encoding, const std::string& coding) {
+    size_t begin = 0;
+    while (begin <= accept_encoding.size()) {
+        size_t comma = accept_encoding.find(',', begin);
+        if (comma == std::string::npos) comma = accept_encoding.size();
+        std::string item = accept_encoding.substr(begin, comma - begin);
+        begin = comma + 1;
+
+        size_t semicolon = item.find(';');
+        std::string name = lowercase(trim(item.substr(0, semicolon)));
+        if (name != coding && name != "*") continue;
+        if (semicolon == std::string::npos) return true;
+
+        std::string params = item.substr(semicolon + 1);
+        size_t q = params.find("q=");
+        if (q == std::string::npos || std::atof(params.c_str() + q + 2) > 0.0) return true;
+    }
+    return false;
+}
+
+bool parseHttpDate(const std::string& text, time_t& result) {
+    struct tm parsed;
+    std::memset(&parsed, 0, sizeof(parsed));
+    const char* end = strptime(text.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &parsed);
+    if (!end) return false;
+    result = timegm(&parsed);
+    return true;
+}
+
+bool readAll(int fd, std::string& output, size_t size) {
+    output.resize(size);
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(fd, &output[done], size - done, static_cast<off_t>(done));
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+// 静态常量定义
+const size_t StaticAssetStore::MIN_COMPRESS_BYTES = 1024;
+
+StaticAsset::~StaticAsset() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+StaticAssetStore::StaticAssetStore(const std::string& root_dir) : root(root_dir) {}
+
+std::shared_ptr<const StaticAsset> StaticAssetStore::find(const std::string& relative_path) {
+    if (relative_path.empty() || relative_path[0] != '/' || relative_path.find("..") != std::string::npos) {
+        return nullptr;
+    }
+
+    std::string path = root + relative_path;
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = assets.find(relative_path);
+        if (it != assets.end() && it->second->mtime == info.st_mtime && it->second->size == info.st_size) {
+            return it->second;
+        }
+    }
+
+    // 首次访问或文件已修改：在锁外读取和压缩，完成后替换
+    auto asset = load(path, info.st_mtime, info.st_size);
+    if (!asset) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    assets[relative_path] = asset;
+    return asset;
+}
+
+std::shared_ptr<const StaticAsset> StaticAssetStore::load(const std::string& path, time_t mtime, off_t size) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    auto asset = std::make_shared<StaticAsset>();
+    asset->fd = fd;
+    asset->path = path;
+    asset->mtime = mtime;
+    asset->size = size;
+    if (!readAll(fd, asset->body, static_cast<size_t>(size))) {
+        std::cerr << "❌ 读取静态文件失败: " << path << std::endl;
+        return nullptr;
+    }
+
+    asset->content_type = contentTypeFor(path);
+    asset->last_modified = httpDate(mtime);
+    asset->etag = "W/\"" + std::to_string(static_cast<long long>(size)) + "-" +
+                  std::to_string(static_cast<long long>(mtime)) + "\"";
+    // 页面需要及时拿到新版本，每次重新验证；样式、脚本和图片允许短期缓存
+    asset->cache_control = asset->content_type.compare(0, 9, "text/html") == 0
+                               ? "no-cache" : "public, max-age=3600";
+
+    bool compressible = asset->content_type.compare(0, 5, "text/") == 0 ||
+                        asset->content_type.find("javascript") != std::string::npos ||
+                        asset->content_type.find("json") != std::string::npos ||
+                        asset->content_type.find("svg") != std::string::npos;
+    if (compressible && asset->body.size() >= MIN_COMPRESS_BYTES) {
+        std::string compressed;
+        if (ResponseCache::gzipCompress(asset->body, compressed) && compressed.size() < asset->body.size()) {
+            asset->gzip_body = std::move(compressed);
+        }
+        compressed.clear();
+        if (brotliCompress(asset->body, compressed) && compressed.size() < asset->body.size()) {
+            asset->brotli_body = std::move(compressed);
+        }
+    }
+    return asset;
+}
+
+StaticReply StaticAssetStore::reply(const std::shared_ptr<const StaticAsset>& asset,
+                                    const std::map<std::string, std::string>& request_headers) {
+    StaticReply result;
+    result.asset = asset;
+    result.headers["ETag"] = asset->etag;
+    result.headers["Last-Modified"] = asset->last_modified;
+    result.headers["Cache-Control"] = asset->cache_control;
+    result.headers["Vary"] = "Accept-Encoding";
+
+    // If-None-Match 存在时忽略 If-Modified-Since（RFC 7232）
+    bool not_modified = false;
+    const std::string* if_none_match = findHeader(request_headers, "if-none-match");
+    if (if_none_match) {
+        not_modified = ResponseCache::matchesETag(*if_none_match, asset->etag);
+    } else if (const std::string* if_modified_since = findHeader(request_headers, "if-modified-since")) {
+        time_t since;
+        not_modified = parseHttpDate(*if_modified_since, since) && asset->mtime <= since;
+    }
+    if (not_modified) {
+        result.status_code = 304;
+        result.status_text = "Not Modified";
+        return result;
+    }
+
+    result.headers["Content-Type"] = asset->content_type;
+    const std::string* accept_encoding = findHeader(request_headers, "accept-encoding");
+    if (accept_encoding && !asset->brotli_body.empty() && acceptsEncoding(*accept_encoding, "br")) {
+        result.headers["Content-Encoding"] = "br";
+        result.body = &asset->brotli_body;
+    } else if (accept_encoding && !asset->gzip_body.empty() && acceptsEncoding(*accept_encoding, "gzip")) {
+        result.headers["Content-Encoding"] = "gzip";
+        result.body = &asset->gzip_body;
+    } else {
+        result.body = &asset->body;
+        result.from_file = true;
+    }
+    return result;
+}
+
+void StaticAssetStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    assets.clear();
+}
+
+size_t StaticAssetStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return assets.size();
+}
+
+size_t StaticAssetStore::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t total = 0;
+    for (const auto& entry : assets) {
+        total += entry.second->body.size() + entry.second->gzip_body.size() + entry.second->brotli_body.size();
+    }
+    return total;
+}
+
+std::string StaticAssetStore::contentTypeFor(const std::string& path) {
+    static const std::map<std::string, std::string> TYPES = {
+        {".html", "text/html; charset=utf-8"},
+        {".htm", "text/html; charset=utf-8"},
+        {".css", "text/css; charset=utf-8"},
+        {".js", "application/javascript; charset=utf-8"},
+        {".json", "application/json"},
+        {".svg", "image/svg+xml"},
+        {".png", "image/png"},
+        {".jpg", "image/jpeg"},
+        {".jpeg", "image/jpeg"},
+        {".gif", "image/gif"},
+        {".ico", "image/x-icon"},
+        {".woff2", "font/woff2"},
+        {".txt", "text/plain; charset=utf-8"},
+    };
+
+    size_t dot = path.rfind('.');
+    size_t slash = path.rfind('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return "application/octet-stream";
+    }
+    auto it = TYPES.find(lowercase(path.substr(dot)));
+    return it != TYPES.end() ? it->second : "application/octet-stream";
+}
+
+std::string StaticAssetStore::httpDate(time_t time) {
+    struct tm gmt;
+    gmtime_r(&time, &gmt);
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &gmt);
+    return buffer;
+}
+
+bool StaticAssetStore::brotliCompress(const std::string& input, std::string& output) {
+    size_t output_size = BrotliEncoderMaxCompressedSize(input.size());
+    if (output_size == 0) {
+        return false;
+    }
+    output.resize(output_size);
+    // 资源只压缩一次，使用最高质量
+    if (!BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                               input.size(), reinterpret_cast<const uint8_t*>(input.data()),
+                               &output_size, reinterpret_cast<uint8_t*>(&output[0]))) {
+        return false;
+    }
+    output.resize(output_size);
+    return true;
+}
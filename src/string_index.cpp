@@ -0,0 +1,227 @@
+#include "../include/string_index.h"
+#include "../include/index_snapshot.h"
+#include <algorithm>
+
+// 静态常量定义
+const double StringIndex::MAX_LOAD_FACTOR = 0.7;
+const size_t StringIndex::MIN_CAPACITY = 16;
+
+namespace {
+
+// 向上取整到2的幂
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+StringIndex::StringIndex(size_t initial_capacity)
+    : element_count(0), tombstone_count(0) {
+    slots.resize(roundUpPowerOfTwo(std::max(initial_capacity, MIN_CAPACITY)));
+}
+
+uint64_t StringIndex::hashKey(const std::string& key) {
+    // FNV-1a 64位，对短字符串（电话、邮箱、学号）分布良好
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t StringIndex::findSlot(const std::string& key, uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t index = hash & mask;
+
+    // 线性探测：遇到空槽即可确定不存在，墓碑需要继续向后探测
+    for (size_t probes = 0; probes < slots.size(); probes++) {
+        const Slot& slot = slots[index];
+        if (slot.state == EMPTY) {
+            return npos;
+        }
+        if (slot.state == OCCUPIED && slot.hash == hash && slot.key == key) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return npos;
+}
+
+bool StringIndex::insert(const std::string& key, int id) {
+    // 负载因子包含墓碑，否则长探测链会拖慢查找
+    if (static_cast<double>(element_count + tombstone_count + 1) > slots.size() * MAX_LOAD_FACTOR) {
+        // 墓碑较多时原地整理即可，否则扩容为2倍
+        size_t new_capacity = (element_count + 1) * 2 > slots.size() ? slots.size() * 2 : slots.size();
+        rehash(new_capacity);
+    }
+
+    uint64_t hash = hashKey(key);
+    size_t mask = slots.size() - 1;
+    size_t index = hash & mask;
+    size_t first_tombstone = npos;
+
+    while (true) {
+        Slot& slot = slots[index];
+        if (slot.state == EMPTY) {
+            break;
+        }
+        if (slot.state == DELETED) {
+            if (first_tombstone == npos) first_tombstone = index;
+        } else if (slot.hash == hash && slot.key == key) {
+            // 键已存在，覆盖ID
+            slot.id = id;
+            return true;
+        }
+        index = (index + 1) & mask;
+    }
+
+    // 优先复用探测路径上的第一个墓碑
+    if (first_tombstone != npos) {
+        index = first_tombstone;
+        tombstone_count--;
+    }
+
+    Slot& target = slots[index];
+    target.key = key;
+    target.hash = hash;
+    target.id = id;
+    target.state = OCCUPIED;
+    element_count++;
+    return true;
+}
+
+int StringIndex::find(const std::string& key) const {
+    size_t index = findSlot(key, hashKey(key));
+    return index == npos ? -1 : slots[index].id;
+}
+
+bool StringIndex::contains(const std::string& key) const {
+    return findSlot(key, hashKey(key)) != npos;
+}
+
+bool StringIndex::remove(const std::string& key) {
+    size_t index = findSlot(key, hashKey(key));
+    if (index == npos) return false;
+
+    Slot& slot = slots[index];
+    slot.key.clear();
+    slot.id = -1;
+    slot.state = DELETED;
+    element_count--;
+    tombstone_count++;
+    return true;
+}
+
+bool StringIndex::removeIfMatches(const std::string& key, int id) {
+    size_t index = findSlot(key, hashKey(key));
+    if (index == npos || slots[index].id != id) return false;
+    return remove(key);
+}
+
+size_t StringIndex::size() const {
+    return element_count;
+}
+
+size_t StringIndex::capacity() const {
+    return slots.size();
+}
+
+void StringIndex::reserve(size_t expected_count) {
+    size_t required = roundUpPowerOfTwo(static_cast<size_t>(expected_count / MAX_LOAD_FACTOR) + 1);
+    if (required > slots.size()) {
+        rehash(required);
+    }
+}
+
+void StringIndex::clear() {
+    for (auto& slot : slots) {
+        slot = Slot();
+    }
+    element_count = 0;
+    tombstone_count = 0;
+}
+
+void StringIndex::rehash(size_t new_capacity) {
+    std::vector<Slot> old_slots(roundUpPowerOfTwo(std::max(new_capacity, MIN_CAPACITY)));
+    old_slots.swap(slots);
+
+    size_t mask = slots.size() - 1;
+    for (auto& old_slot : old_slots) {
+        if (old_slot.state != OCCUPIED) continue;
+
+        size_t index = old_slot.hash & mask;
+        while (slots[index].state != EMPTY) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = std::move(old_slot);
+    }
+    tombstone_count = 0;
+}
+
+void StringIndex::writeSnapshot(SnapshotBuffer& out) const {
+    uint64_t used = 0;
+    for (const auto& slot : slots) {
+        if (slot.state != EMPTY) used++;
+    }
+
+    out.append(static_cast<uint64_t>(slots.size()));
+    out.append(static_cast<uint64_t>(element_count));
+    out.append(static_cast<uint64_t>(tombstone_count));
+    out.append(used);
+
+    // 只写非空槽位：[u32 槽位][u8 状态]，占用槽位再写 [u64 哈希][i32 ID][键]
+    for (size_t i = 0; i < slots.size(); i++) {
+        const Slot& slot = slots[i];
+        if (slot.state == EMPTY) continue;
+        out.append(static_cast<uint32_t>(i));
+        out.append(static_cast<uint8_t>(slot.state));
+        if (slot.state == OCCUPIED) {
+            out.append(slot.hash);
+            out.append(static_cast<int32_t>(slot.id));
+            out.appendString(slot.key);
+        }
+    }
+}
+
+bool StringIndex::restoreSnapshot(const SnapshotView& in, size_t& offset) {
+    uint64_t capacity = 0, elements = 0, tombstones = 0, used = 0;
+    if (!in.read(offset, capacity) || !in.read(offset, elements) ||
+        !in.read(offset, tombstones) || !in.read(offset, used)) {
+        return false;
+    }
+    // 容量必须是2的幂，且计数自洽
+    if (capacity < MIN_CAPACITY || (capacity & (capacity - 1)) != 0 ||
+        used != elements + tombstones || used > capacity) {
+        return false;
+    }
+
+    std::vector<Slot> restored(capacity);
+    for (uint64_t n = 0; n < used; n++) {
+        uint32_t index = 0;
+        uint8_t state = 0;
+        if (!in.read(offset, index) || !in.read(offset, state) || index >= capacity ||
+            restored[index].state != EMPTY || (state != OCCUPIED && state != DELETED)) {
+            return false;
+        }
+
+        Slot& slot = restored[index];
+        slot.state = static_cast<SlotState>(state);
+        if (slot.state == OCCUPIED) {
+            int32_t id = 0;
+            if (!in.read(offset, slot.hash) || !in.read(offset, id) || !in.readString(offset, slot.key)) {
+                return false;
+            }
+            slot.id = id;
+        }
+    }
+
+    slots.swap(restored);
+    element_count = elements;
+    tombstone_count = tombstones;
+    return true;
+}
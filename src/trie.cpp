@@ -1,4 +1,5 @@
 #include "trie.h"
+#include "index_snapshot.h"
 #include <iostream>
 #include <algorithm>
 #include <set>
@@ -86,7 +87,7 @@ void Trie::insertContact(std::shared_ptr<Contact> contact) {
     contactCount++;
 }
 
-std::vector<std::shared_ptr<Contact>> Trie::searchByNamePrefix(const std::string& prefix) {
+std::vector<std::shared_ptr<Contact>> Trie::searchByNamePrefix(const std::string& prefix) const {
     std::vector<std::shared_ptr<Contact>> result;
     
     auto chars = splitUTF8Characters(prefix);
@@ -115,7 +116,7 @@ std::vector<std::shared_ptr<Contact>> Trie::searchByNamePrefix(const std::string
     return removeDuplicates(filtered);
 }
 
-std::vector<std::shared_ptr<Contact>> Trie::searchByStudentIdPrefix(const std::string& prefix) {
+std::vector<std::shared_ptr<Contact>> Trie::searchByStudentIdPrefix(const std::string& prefix) const {
     std:: vector<std::shared_ptr<Contact>> result;
     
     auto chars = splitUTF8Characters(prefix);
@@ -231,29 +232,167 @@ void Trie::insertString(const std:: string& str, std::shared_ptr<Contact> contac
     current->isEndOfWord = true;
 }
 
-bool Trie::search(const std::string& key) {
+bool Trie::search(const std::string& key) const {
     auto chars = splitUTF8Characters(key);
     TrieNode* current = root;
     
     for (const auto& ch :  chars) {
-        if (current->children.find(ch) == current->children. end()) {
+        auto it = current->children.find(ch);
+        if (it == current->children. end()) {
             return false;
         }
-        current = current->children[ch];
+        current = it->second;
     }
     return current->isEndOfWord;
 }
 
-bool Trie:: startsWith(const std::string& prefix) {
+bool Trie:: startsWith(const std::string& prefix) const {
     auto chars = splitUTF8Characters(prefix);
     TrieNode* current = root;
     
     for (const auto& ch : chars) {
-        if (current->children.find(ch) == current->children.end()) {
+        auto it = current->children.find(ch);
+        if (it == current->children.end()) {
             return false;
         }
-        current = current->children[ch];
+        current = it->second;
+    }
+    return true;
+}
+
+void Trie::merge(Trie& other) {
+    if (&other == this) return;
+    
+    mergeNode(root, other.root);
+    contactCount += other.contactCount;
+    
+    // other的节点已全部转移或释放
+    other.root = new TrieNode();
+    other.contactCount = 0;
+}
+
+void Trie::mergeNode(TrieNode* target, TrieNode* source) {
+    // 联系人追加在后，按分片顺序合并时结果与串行插入一致
+    target->contacts.insert(target->contacts.end(),
+                            std::make_move_iterator(source->contacts.begin()),
+                            std::make_move_iterator(source->contacts.end()));
+    target->isEndOfWord = target->isEndOfWord || source->isEndOfWord;
+    
+    for (auto& child : source->children) {
+        auto it = target->children.find(child.first);
+        if (it == target->children.end()) {
+            // 目标中没有该分支，整棵子树直接接入
+            target->children.emplace(child.first, child.second);
+        } else {
+            mergeNode(it->second, child.second);
+        }
+    }
+    
+    // 子节点已转移或递归释放，只删除source本身
+    source->children.clear();
+    delete source;
+}
+
+void Trie::writeSnapshot(SnapshotBuffer& out,
+                         const std::function<uint32_t(const Contact*)>& contact_ref) const {
+    // 广度优先编号：子节点编号总是大于父节点，恢复时可据此校验结构
+    std::vector<const TrieNode*> order;
+    order.push_back(root);
+    for (size_t i = 0; i < order.size(); i++) {
+        for (const auto& child : order[i]->children) {
+            order.push_back(child.second);
+        }
+    }
+    
+    out.append(static_cast<uint64_t>(contactCount));
+    out.append(static_cast<uint32_t>(order.size()));
+    
+    uint32_t next_child = 1;
+    for (const TrieNode* node : order) {
+        out.append(static_cast<uint8_t>(node->isEndOfWord ? 1 : 0));
+        out.append(static_cast<uint32_t>(node->children.size()));
+        out.append(static_cast<uint32_t>(node->contacts.size()));
+        
+        // 边：[u8 字符长度][UTF-8 字节][u32 子节点编号]，顺序与上面的编号一致
+        for (const auto& child : node->children) {
+            out.append(static_cast<uint8_t>(child.first.size()));
+            out.appendBytes(child.first.data(), child.first.size());
+            out.append(next_child++);
+        }
+        for (const auto& contact : node->contacts) {
+            out.append(contact_ref(contact.get()));
+        }
+    }
+}
+
+bool Trie::restoreSnapshot(const SnapshotView& in, size_t& offset,
+                           const std::vector<std::shared_ptr<Contact>>& contacts) {
+    uint64_t count = 0;
+    uint32_t node_count = 0;
+    if (!in.read(offset, count) || !in.read(offset, node_count) ||
+        node_count == 0 || node_count > in.size()) {
+        return false;
     }
+    
+    std::vector<TrieNode*> nodes(node_count);
+    for (auto& node : nodes) {
+        node = new TrieNode();
+    }
+    std::vector<bool> has_parent(node_count, false);
+    
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < node_count; i++) {
+        TrieNode* node = nodes[i];
+        uint8_t is_end = 0;
+        uint32_t edge_count = 0;
+        uint32_t ref_count = 0;
+        if (!in.read(offset, is_end) || !in.read(offset, edge_count) || !in.read(offset, ref_count) ||
+            edge_count > node_count || ref_count > contacts.size()) {
+            valid = false;
+            break;
+        }
+        node->isEndOfWord = is_end != 0;
+        
+        node->children.reserve(edge_count);
+        for (uint32_t e = 0; valid && e < edge_count; e++) {
+            uint8_t length = 0;
+            char label[4];
+            uint32_t child = 0;
+            valid = in.read(offset, length) && length >= 1 && length <= sizeof(label) &&
+                    in.readBytes(offset, label, length) && in.read(offset, child) &&
+                    child > i && child < node_count && !has_parent[child];
+            if (valid) {
+                has_parent[child] = true;
+                valid = node->children.emplace(std::string(label, length), nodes[child]).second;
+            }
+        }
+        
+        node->contacts.reserve(ref_count);
+        for (uint32_t r = 0; valid && r < ref_count; r++) {
+            uint32_t ref = 0;
+            valid = in.read(offset, ref) && ref < contacts.size() && contacts[ref];
+            if (valid) {
+                node->contacts.push_back(contacts[ref]);
+            }
+        }
+    }
+    
+    // 除根以外每个节点都必须恰好有一个父节点
+    for (uint32_t i = 1; valid && i < node_count; i++) {
+        valid = has_parent[i];
+    }
+    
+    if (!valid) {
+        // 逐个释放（节点析构不递归子节点）
+        for (TrieNode* node : nodes) {
+            delete node;
+        }
+        return false;
+    }
+    
+    deleteNode(root);
+    root = nodes[0];
+    contactCount = count;
     return true;
 }
 
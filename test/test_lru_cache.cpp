@@ -0,0 +1,96 @@
+#include "../include/lru_cache.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void testBasicOperations() {
+    std::cout << "=== 测试1: 基础操作 ===\n";
+
+    LRUCache<int, std::string> cache(3);
+    cache.put(1, "一");
+    cache.put(2, "二");
+    cache.put(3, "三");
+    cache.printCache();  // 应该显示: 3 2 1
+
+    std::cout << "1. 访问 1 后插入 4（应淘汰 2）:\n";
+    cache.get(1);
+    cache.put(4, "四");
+    cache.printCache();  // 应该显示: 4 1 3
+
+    std::cout << "2. 未命中与默认值区分:\n";
+    LRUCache<std::string, int> counts(2);
+    counts.put("零", 0);
+    auto zero = counts.get("零");
+    auto missing = counts.get("无");
+    std::cout << "   零: " << (zero ? std::to_string(*zero) : "未命中") << "\n";   // 应该是0
+    std::cout << "   无: " << (missing ? std::to_string(*missing) : "未命中") << "\n";
+
+    std::cout << "3. 删除与更新:\n";
+    cache.remove(1);
+    cache.put(3, "叁");
+    cache.put(5, "五");
+    cache.printCache();  // 应该显示: 5 3 4
+    cache.printStats();
+}
+
+void testShardedConcurrency() {
+    std::cout << "\n=== 测试2: 分片并发访问 ===\n";
+
+    LRUCache<int, int> cache(1000, 8);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([&cache, t]() {
+            for (int i = 0; i < 20000; i++) {
+                int key = (i * 7 + t) % 1500;   // 键空间大于容量，会持续淘汰
+                auto value = cache.get(key);
+                if (!value) {
+                    cache.put(key, key * 2);
+                } else if (*value != key * 2) {
+                    std::cout << "   错误: 键 " << key << " 的值为 " << *value << "\n";
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto stats = cache.getStats();
+    std::cout << "大小: " << stats.size << " (不超过 " << stats.capacity << ")\n";
+    std::cout << "命中 + 未命中: " << stats.hits + stats.misses << " (应该是 80000)\n";
+    std::cout << "淘汰: " << stats.evictions << ", 插入 - 淘汰: " << stats.insertions - stats.evictions
+              << " (应该等于大小)\n";
+
+    size_t removed = cache.removeIf([](const int& key, const int&) { return key % 2 == 0; });
+    std::cout << "删除偶数键 " << removed << " 个，剩余 " << cache.size() << "\n";
+    cache.clear();
+    std::cout << "清空后: " << (cache.empty() ? "空" : "非空") << "\n";
+}
+
+void testByteBudget() {
+    std::cout << "\n=== 测试3: 按字节预算淘汰 ===\n";
+
+    // 容量按值的字节数计：预算 10 字节
+    LRUCache<int, std::string> cache(10, 1, [](const int&, const std::string& value) { return value.size(); });
+    cache.put(1, "aaaa");
+    cache.put(2, "bbbb");
+    cache.put(3, "cc");        // 共 10 字节，恰好放下
+    cache.printCache();        // 应该显示: 3 2 1
+
+    cache.put(4, "dddddd");    // 需要淘汰 1 和 2
+    cache.printCache();        // 应该显示: 4 3
+
+    cache.put(5, "eeeeeeeeeeee");  // 超过预算，不缓存
+    std::cout << "超过预算的项: " << (cache.contains(5) ? "已缓存" : "未缓存") << "\n";
+    cache.printStats();
+}
+
+int main() {
+    testBasicOperations();
+    testShardedConcurrency();
+    testByteBudget();
+
+    std::cout << "\n=== LRU 缓存测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "../include/priority_queue.h"
+#include <iostream>
+#include <string>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+void testBasicOperations() {
+    std::cout << "=== 测试1: 基础操作（最小堆） ===\n";
+
+    PriorityQueue<int> queue;
+    for (int value : {5, 3, 8, 1, 9, 2}) {
+        queue.push(value);
+    }
+    std::cout << "1. 队首元素: " << queue.top() << "\n";  // 应该是1
+
+    std::cout << "2. 依次出队: ";
+    while (!queue.isEmpty()) {
+        std::cout << queue.pop() << " ";  // 应该是: 1 2 3 5 8 9
+    }
+    std::cout << "\n";
+
+    std::cout << "3. 空队列出队:\n";
+    try {
+        queue.pop();  // 应该抛出异常
+    } catch (const std::underflow_error& e) {
+        std::cout << "   异常捕获: " << e.what() << "\n";
+    }
+}
+
+void testCustomComparator() {
+    std::cout << "\n=== 测试2: 自定义比较器（优先级高的先出队） ===\n";
+
+    struct Request {
+        std::string name;
+        int priority;
+    };
+    struct HigherPriority {
+        bool operator()(const Request& a, const Request& b) const {
+            return a.priority > b.priority;
+        }
+    };
+
+    PriorityQueue<Request, HigherPriority, 2> queue;
+    queue.push({"社团例会", 3});
+    queue.push({"学术讲座", 9});
+    queue.push({"迎新晚会", 6});
+
+    std::cout << "出队顺序: ";
+    while (!queue.isEmpty()) {
+        Request request = queue.pop();
+        std::cout << request.name << "(" << request.priority << ") ";  // 应该是: 学术讲座 迎新晚会 社团例会
+    }
+    std::cout << "\n";
+}
+
+void testMoveOnly() {
+    std::cout << "\n=== 测试3: 仅可移动的元素 ===\n";
+
+    struct PointerLess {
+        bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const {
+            return *a < *b;
+        }
+    };
+
+    PriorityQueue<std::unique_ptr<int>, PointerLess> queue;
+    queue.push(std::unique_ptr<int>(new int(30)));
+    queue.emplace(new int(10));
+    queue.push(std::unique_ptr<int>(new int(20)));
+
+    std::cout << "出队顺序: ";
+    while (!queue.isEmpty()) {
+        std::unique_ptr<int> value = queue.pop();
+        std::cout << *value << " ";  // 应该是: 10 20 30
+    }
+    std::cout << "\n";
+}
+
+void testHandles() {
+    std::cout << "\n=== 测试4: 按句柄修改和删除 ===\n";
+
+    PriorityQueue<int, std::less<int>, 8> queue;
+    auto a = queue.push(50);
+    auto b = queue.push(40);
+    auto c = queue.push(30);
+    queue.push(20);
+
+    std::cout << "1. 降低键值 50 -> 5 后队首: ";
+    queue.decreaseKey(a, 5);
+    std::cout << queue.top() << "\n";  // 应该是5
+
+    std::cout << "2. 删除 30 后队列大小: ";
+    std::cout << queue.erase(c) << " 已删除，剩余 " << queue.size() << "\n";  // 剩余3
+
+    std::cout << "3. 40 改为 1 后队首: ";
+    queue.update(b, 1);
+    std::cout << queue.top() << "\n";  // 应该是1
+
+    std::cout << "4. 已删除句柄: " << (queue.contains(c) ? "仍在队列" : "已失效") << "\n";
+    try {
+        queue.decreaseKey(a, 100);  // 比原值大，应该抛出异常
+    } catch (const std::invalid_argument& e) {
+        std::cout << "   异常捕获: " << e.what() << "\n";
+    }
+}
+
+void testRandomOrder() {
+    std::cout << "\n=== 测试5: 随机数据与排序结果一致 ===\n";
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 100000);
+    std::vector<int> values(10000);
+    for (auto& value : values) value = dist(gen);
+
+    PriorityQueue<int, std::less<int>, 2> binary;
+    PriorityQueue<int, std::less<int>, 4> quaternary;
+    PriorityQueue<int, std::less<int>, 8> octonary;
+    std::vector<PriorityQueue<int>::Handle> handles;
+    for (int value : values) {
+        binary.push(value);
+        handles.push_back(quaternary.push(value));
+        octonary.push(value);
+    }
+
+    // 四叉堆再删除一半元素
+    std::vector<int> expected_after_erase;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i % 2 == 0) {
+            quaternary.erase(handles[i]);
+        } else {
+            expected_after_erase.push_back(values[i]);
+        }
+    }
+
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(expected_after_erase.begin(), expected_after_erase.end());
+
+    bool binary_ok = true, octonary_ok = true, erase_ok = true;
+    for (int value : sorted) {
+        binary_ok = binary_ok && binary.pop() == value;
+        octonary_ok = octonary_ok && octonary.pop() == value;
+    }
+    for (int value : expected_after_erase) {
+        erase_ok = erase_ok && quaternary.pop() == value;
+    }
+    std::cout << "   二叉堆: " << (binary_ok ? "通过" : "失败") << "\n";
+    std::cout << "   八叉堆: " << (octonary_ok ? "通过" : "失败") << "\n";
+    std::cout << "   四叉堆删除后: " << (erase_ok && quaternary.isEmpty() ? "通过" : "失败") << "\n";
+}
+
+int main() {
+    testBasicOperations();
+    testCustomComparator();
+    testMoveOnly();
+    testHandles();
+    testRandomOrder();
+
+    std::cout << "\n=== 优先队列测试完成 ===\n";
+    return 0;
+}
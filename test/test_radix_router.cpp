@@ -0,0 +1,54 @@
+#include "../include/radix_router.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+const char* STATUS_NAMES[] = {"匹配", "不存在", "方法不允许"};
+
+void show(const RadixRouter<std::string>& router, HttpMethod method, const std::string& path) {
+    RouteParams params;
+    RadixRouter<std::string>::MatchStatus status;
+    const std::string* handler = router.match(method, path, params, &status);
+
+    std::cout << "   " << path << " -> " << STATUS_NAMES[status];
+    if (handler) {
+        std::cout << " [" << *handler << "]";
+    }
+    for (size_t i = 0; i < params.count; i++) {
+        std::cout << " " << params.items[i].name << "=" << params.items[i].value;
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main() {
+    RadixRouter<std::string> router;
+    router.add("GET /api/contacts", "列出联系人");
+    router.add("POST /api/contacts", "创建联系人");
+    router.add("GET /api/contacts/search", "搜索联系人");
+    router.add("PUT /api/contacts/{id:int}", "更新联系人");
+    router.add("DELETE /api/contacts/{id:int}", "删除联系人");
+    router.add("GET /api/activities", "列出活动");
+    router.add("GET /api/resources/{name}/reservations/{id:int}", "查看预约");
+    router.add("GET /api/resources/{name}", "查看资源");
+
+    std::cout << "=== 测试1: 注册 ===\n";
+    std::cout << "路由 " << router.size() << " 条, 节点 " << router.nodeCount() << " 个\n";
+    std::cout << "重复注册: " << (router.add("GET /api/contacts", "重复") ? "成功" : "拒绝") << "\n";    // 应该拒绝
+    std::cout << "参数不占满路径段: " << (router.add("GET /api/x{id}", "非法") ? "成功" : "拒绝") << "\n";  // 应该拒绝
+
+    std::cout << "\n=== 测试2: 匹配 ===\n";
+    show(router, METHOD_GET, "/api/contacts");
+    show(router, METHOD_GET, "/api/contacts/search");           // 静态段优先于参数
+    show(router, METHOD_PUT, "/api/contacts/42");
+    show(router, METHOD_PUT, "/api/contacts/abc");              // 非数字不匹配 {id:int}
+    show(router, METHOD_GET, "/api/contacts/42");               // 路径存在但没有 GET
+    show(router, METHOD_GET, "/api/resources/体育馆");
+    show(router, METHOD_GET, "/api/resources/体育馆/reservations/7");
+    show(router, METHOD_GET, "/api/activity");
+
+    std::cout << "\n=== 基数树路由测试完成 ===\n";
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "../include/recurrence.h"
+#include "../include/conflict_detector.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printDays(const RecurrenceRule& rule, const std::string& from, const std::string& to) {
+    int from_day = 0, to_day = 0;
+    parseDate(from, from_day);
+    parseDate(to, to_day);
+    std::cout << "  ";
+    rule.forEachOccurrence(from_day, to_day, [](int day) {
+        std::cout << " " << formatDate(day);
+        return true;
+    });
+    std::cout << "\n";
+}
+
+} // namespace
+
+void testRuleExpansion() {
+    std::cout << "=== 测试1: 重复规则展开 ===\n";
+
+    RecurrenceRule rule;
+    std::string error;
+
+    // 2025-02-25 是周二，每周二共 16 次
+    RecurrenceRule::parse("DTSTART=2025-02-25;FREQ=WEEKLY;BYDAY=TU;COUNT=16", rule, &error);
+    std::cout << "1. 每周二 16 次: 共 " << rule.occurrenceCount() << " 次, 最后一次 "
+              << formatDate(rule.lastDay()) << " (预期 2025-06-10)\n";
+    std::cout << "   规则: " << rule.toString() << "\n";
+
+    std::cout << "2. 每两周的周一、周三，三月内:\n";
+    RecurrenceRule::parse("DTSTART=2025-03-03;FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE;UNTIL=20250331", rule);
+    printDays(rule, "2025-03-01", "2025-03-31");
+
+    std::cout << "3. 每三天，排除 03-07:\n";
+    RecurrenceRule::parse("DTSTART=2025-03-01;FREQ=DAILY;INTERVAL=3;UNTIL=2025-03-13;EXDATE=2025-03-07", rule);
+    printDays(rule, "2025-03-01", "2025-03-31");
+
+    std::cout << "4. 自定义日期（跨闰日）:\n";
+    RecurrenceRule::parse("RDATE=2024-03-01,2024-02-28,2024-02-29", rule);
+    printDays(rule, "2024-01-01", "2024-12-31");
+
+    std::cout << "5. 无效规则:\n";
+    const char* invalid[] = {"FREQ=WEEKLY;BYDAY=TU;COUNT=3", "DTSTART=2025-02-25;FREQ=WEEKLY",
+                             "DTSTART=2025-02-30;FREQ=DAILY;COUNT=3", "DTSTART=2025-02-25;FREQ=MONTHLY;COUNT=3"};
+    for (const char* text : invalid) {
+        bool ok = RecurrenceRule::parse(text, rule, &error);
+        std::cout << "   " << text << " -> " << (ok ? "接受" : error) << "\n";
+    }
+
+    // COUNT × INTERVAL 超出 int 时不能溢出，搜索范围有上限
+    RecurrenceRule::parse("DTSTART=2025-02-25;FREQ=DAILY;INTERVAL=999999;COUNT=999999", rule);
+    std::cout << "6. INTERVAL 与 COUNT 都是 6 位: 第一次 " << formatDate(rule.firstDay())
+              << ", 共 " << rule.occurrenceCount() << " 次\n";
+}
+
+void testSeriesConflicts() {
+    std::cout << "\n=== 测试2: 重复预约冲突检测 ===\n";
+
+    ConflictDetector detector;
+    detector.addResource("会议室A");
+
+    RecurrenceRule tuesdays, thursdays, daily;
+    RecurrenceRule::parse("DTSTART=2025-02-25;FREQ=WEEKLY;BYDAY=TU;COUNT=16", tuesdays);
+    RecurrenceRule::parse("DTSTART=2025-02-27;FREQ=WEEKLY;BYDAY=TH;COUNT=16", thursdays);
+    RecurrenceRule::parse("DTSTART=2025-03-10;FREQ=DAILY;UNTIL=2025-03-14", daily);
+
+    int club = detector.addRecurringReservation("会议室A", "围棋社", "18:00", "20:00", tuesdays, 5);
+    int choir = detector.addRecurringReservation("会议室A", "合唱团", "18:00", "20:00", thursdays, 5);
+    std::cout << "1. 周二、周四同一时段两个系列: " << (club > 0 && choir > 0 ? "都成功" : "失败") << "\n";
+
+    int overlap = detector.addRecurringReservation("会议室A", "考前辅导", "19:00", "21:00", daily, 5);
+    std::cout << "2. 3/10-3/14 每天 19:00-21:00: " << (overlap > 0 ? "成功" : "失败") << " (预期失败)\n";
+
+    int single = detector.addReservation("会议室A", "讲座", "2025-03-11 18:00", "2025-03-11 19:00");
+    std::cout << "3. 3/11（周二）的单次预约: " << (single > 0 ? "成功" : "失败") << " (预期失败)\n";
+    single = detector.addReservation("会议室A", "讲座", "2025-03-12 19:00", "2025-03-12 20:00");
+    std::cout << "4. 3/12（周三）的单次预约: " << (single > 0 ? "成功" : "失败") << "\n";
+
+    detector.addSeriesException(club, "2025-03-11");
+    single = detector.addReservation("会议室A", "讲座", "2025-03-11 18:00", "2025-03-11 19:00");
+    std::cout << "5. 围棋社 3/11 停一次后再预约: " << (single > 0 ? "成功" : "失败") << "\n";
+
+    std::cout << "6. 3/10-3/16 的预约:\n";
+    for (const auto& occurrence : detector.getOccurrences("2025-03-10", "2025-03-16", "会议室A")) {
+        std::cout << "   " << occurrence.reservation.time_slot.toString() << " "
+                  << occurrence.reservation.activity_name
+                  << (occurrence.series_id ? " [系列 " + std::to_string(occurrence.series_id) + "]" : "") << "\n";
+    }
+
+    detector.removeRecurringReservation(choir);
+    overlap = detector.addRecurringReservation("会议室A", "考前辅导", "20:00", "21:00", daily, 5);
+    std::cout << "7. 改到 20:00-21:00: " << (overlap > 0 ? "成功" : "失败") << "\n";
+}
+
+void testSeriesAvailability() {
+    std::cout << "\n=== 测试3: 重复预约参与可用性查询 ===\n";
+
+    ConflictDetector detector;
+    detector.addResource("会议室A");
+    detector.addResource("会议室B");
+
+    RecurrenceRule tuesdays;
+    RecurrenceRule::parse("DTSTART=2025-02-25;FREQ=WEEKLY;BYDAY=TU;COUNT=16", tuesdays);
+    int club = detector.addRecurringReservation("会议室A", "围棋社", "18:00", "20:00", tuesdays, 5);
+
+    TimeSlot tuesday("2025-03-11 18:30", "2025-03-11 19:30");
+    TimeSlot wednesday("2025-03-12 18:30", "2025-03-12 19:30");
+    TimeSlot undated("18:30", "19:30");
+    std::cout << "1. 会议室A 18:30-19:30 是否冲突: 周二 " << (detector.hasConflict("会议室A", tuesday) ? "是" : "否")
+              << " (预期 是), 周三 " << (detector.hasConflict("会议室A", wednesday) ? "是" : "否")
+              << " (预期 否), 不带日期 " << (detector.hasConflict("会议室A", undated) ? "是" : "否") << " (预期 是)\n";
+
+    std::cout << "2. 周二 18:30-19:30 可用资源:";
+    for (const auto& resource : detector.findAvailableResources(tuesday)) {
+        std::cout << " " << resource;
+    }
+    std::cout << " (预期 会议室B)\n";
+
+    std::cout << "3. 会议室A 推荐时段:";
+    for (const auto& slot : detector.suggestSlots("会议室A", undated, 2)) {
+        std::cout << " " << TimeSlot::fromMinutes(slot.start_minutes, slot.end_minutes).toString() << ";";
+    }
+    std::cout << " (预期 17:00 - 18:00; 20:00 - 21:00)\n";
+
+    detector.removeRecurringReservation(club);
+    std::cout << "4. 取消系列后推荐时段:";
+    for (const auto& slot : detector.suggestSlots("会议室A", undated, 1)) {
+        std::cout << " " << TimeSlot::fromMinutes(slot.start_minutes, slot.end_minutes).toString();
+    }
+    std::cout << " (预期 18:30 - 19:30)\n";
+}
+
+int main() {
+    testRuleExpansion();
+    testSeriesConflicts();
+    testSeriesAvailability();
+
+    std::cout << "\n=== 重复预约测试完成 ===\n";
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "../include/segment_tree.h"
+#include "../include/conflict_detector.h"
 #include <iostream>
 
 void testBasicSegmentTree() {
@@ -28,6 +29,38 @@ void testBasicSegmentTree() {
     std::cout << "\n";
 }
 
+void testCapacity() {
+    std::cout << "=== 测试容量（区间加 / 区间最大值） ===\n";
+    
+    // 体育馆有3块场地，按分钟计：9:00-11:00 用1块，10:00-12:00 用2块
+    const int capacity = 3;
+    SegmentTree gym(24 * 60);
+    gym.addInterval(540, 659, 1);
+    gym.addInterval(600, 719, 2);
+    
+    std::cout << "1. 峰值占用:\n";
+    std::cout << "   9:00-10:00: " << gym.queryOccupancy(540, 599) << "\n";
+    std::cout << "   10:00-11:00: " << gym.queryOccupancy(600, 659) << " (预期3)\n";
+    std::cout << "   11:00-12:00: " << gym.queryOccupancy(660, 719) << "\n";
+    
+    std::cout << "2. 再订1块场地:\n";
+    std::cout << "   10:30-11:30: " << (gym.queryOccupancy(630, 689) + 1 <= capacity ? "可以" : "容量不足") << " (预期容量不足)\n";
+    std::cout << "   11:00-12:00: " << (gym.queryOccupancy(660, 719) + 1 <= capacity ? "可以" : "容量不足") << "\n";
+    
+    std::cout << "3. 占满的时段:\n";
+    for (const auto& range : gym.findRangesAtLeast(0, 24 * 60 - 1, capacity)) {
+        std::cout << "   [" << range.first << ", " << range.second << "]\n";
+    }
+    
+    gym.removeInterval(600, 719, 2);
+    std::cout << "4. 取消2块场地后占满的时段数: " << gym.findRangesAtLeast(0, 24 * 60 - 1, capacity).size() << "\n";
+    std::cout << "   占用不少于1的时段:";
+    for (const auto& range : gym.findRangesAtLeast(0, 24 * 60 - 1, 1)) {
+        std::cout << " [" << range.first << ", " << range.second << "]";
+    }
+    std::cout << "\n\n";
+}
+
 void testVenueConflictDetector() {
     std::cout << "=== 测试场地冲突检测器 ===\n";
     
@@ -63,9 +96,36 @@ void testVenueConflictDetector() {
     std::cout << "\n";
 }
 
+void testDetectorCapacity() {
+    std::cout << "=== 测试冲突检测器按容量判断 ===\n";
+    
+    ConflictDetector detector;
+    detector.addResource("体育馆", 3);
+    detector.addReservation("体育馆", "篮球", "09:00", "11:00", 3);
+    detector.addReservation("体育馆", "羽毛球", "10:00", "12:00", 2);
+    detector.addReservation("体育馆", "排球", "10:30", "11:30", 5);
+    std::cout << "1. 三个重叠预约各占1块场地，冲突数: " << detector.detectAllConflicts().size() << " (预期0)\n";
+    
+    // 10:30-11:00 三块场地都占用，再要1块只需取消优先级最低的一个
+    detector.enableAutoResolve(true);
+    int id = detector.addReservation("体育馆", "校队训练", "10:30", "11:00", 8);
+    std::cout << "2. 按优先级再订1块场地: " << (id > 0 ? "成功" : "失败") << "，剩余:";
+    for (const auto& reservation : detector.getReservationsByResource("体育馆")) {
+        std::cout << " " << reservation.activity_name;
+    }
+    std::cout << " (预期只取消羽毛球)\n";
+    
+    id = detector.addReservation("体育馆", "比赛", "10:30", "11:00", 4, "", 3);
+    std::cout << "3. 优先级4要3块场地: " << (id > 0 ? "成功" : "失败") << "，剩余 "
+              << detector.getReservationsByResource("体育馆").size() << " 个 (预期失败，剩余3个)\n";
+    std::cout << "\n";
+}
+
 int main() {
     testBasicSegmentTree();
+    testCapacity();
     testVenueConflictDetector();
+    testDetectorCapacity();
     
     std::cout << "=== 线段树测试完成 ===\n";
     return 0;
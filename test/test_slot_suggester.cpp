@@ -0,0 +1,86 @@
+#include "../include/slot_suggester.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+std::string clock(int minutes) {
+    std::string text = std::to_string(minutes / 60) + ":";
+    if (minutes % 60 < 10) text += "0";
+    return text + std::to_string(minutes % 60);
+}
+
+void printSuggestions(const std::vector<SlotSuggestion>& suggestions) {
+    for (const auto& slot : suggestions) {
+        std::cout << "   " << slot.resource_name << " " << clock(slot.start_minutes) << "-"
+                  << clock(slot.end_minutes) << " (相差 " << slot.distance_minutes << " 分钟)\n";
+    }
+    if (suggestions.empty()) {
+        std::cout << "   无可用时间段\n";
+    }
+}
+
+} // namespace
+
+void testNearestGaps() {
+    std::cout << "=== 测试1: 单个资源的最近空闲时间段 ===\n";
+
+    SlotSuggester suggester(8 * 60, 18 * 60);  // 8:00-18:00
+    suggester.addResource("会议室A");
+    suggester.addBusy("会议室A", 9 * 60, 10 * 60);
+    suggester.addBusy("会议室A", 10 * 60 + 30, 12 * 60);
+    suggester.addBusy("会议室A", 13 * 60, 15 * 60);
+
+    // 期望 10:00-11:00：10:00-10:30 的间隙放不下，应依次给出 8:00、12:00（距离相同时较早的在前）、15:00
+    std::cout << "期望 10:00 开始，时长 60 分钟:\n";
+    printSuggestions(suggester.suggest({"会议室A"}, 10 * 60, 60, 3));
+
+    std::cout << "期望 10:00 开始，时长 30 分钟:\n";  // 10:00 本身可行
+    printSuggestions(suggester.suggest({"会议室A"}, 10 * 60, 30, 2));
+}
+
+void testEquivalentResources() {
+    std::cout << "\n=== 测试2: 跨同类资源 ===\n";
+
+    SlotSuggester suggester(8 * 60, 18 * 60);
+    suggester.addBusy("会议室A", 8 * 60, 12 * 60);
+    suggester.addBusy("会议室B", 9 * 60, 11 * 60);
+    suggester.addResource("会议室C");
+
+    // 会议室C 全天空闲，距离为0；距离相同时按资源顺序
+    std::cout << "期望 9:30 开始，时长 60 分钟:\n";
+    printSuggestions(suggester.suggest({"会议室A", "会议室B", "会议室C"}, 9 * 60 + 30, 60, 4));
+}
+
+void testMergeAndRelease() {
+    std::cout << "\n=== 测试3: 占用合并与释放 ===\n";
+
+    SlotSuggester suggester;
+    suggester.addBusy("大礼堂", 9 * 60, 10 * 60);
+    suggester.addBusy("大礼堂", 10 * 60, 11 * 60);   // 相接，合并为 9:00-11:00
+    suggester.addBusy("大礼堂", 9 * 60 + 30, 12 * 60);  // 重叠，合并为 9:00-12:00
+    std::cout << "1. 10:00-11:00 空闲: " << (suggester.isFree("大礼堂", 10 * 60, 11 * 60) ? "是" : "否") << "\n";
+
+    suggester.removeBusy("大礼堂", 10 * 60, 11 * 60);
+    std::cout << "2. 释放 10:00-11:00 后:\n";
+    std::cout << "   10:00-11:00 空闲: " << (suggester.isFree("大礼堂", 10 * 60, 11 * 60) ? "是" : "否") << "\n";
+    std::cout << "   9:00-10:00 空闲: " << (suggester.isFree("大礼堂", 9 * 60, 10 * 60) ? "是" : "否") << "\n";
+    std::cout << "   11:00-12:00 空闲: " << (suggester.isFree("大礼堂", 11 * 60, 12 * 60) ? "是" : "否") << "\n";
+
+    std::cout << "3. 期望 9:00 开始，时长 60 分钟:\n";  // 8:00 与 10:00 距离相同，取较早的 8:00
+    printSuggestions(suggester.suggest({"大礼堂"}, 9 * 60, 60, 1));
+
+    std::cout << "4. 时长超过所有间隙:\n";
+    SlotSuggester full(8 * 60, 10 * 60);
+    full.addBusy("小礼堂", 8 * 60 + 30, 9 * 60 + 30);
+    printSuggestions(full.suggest({"小礼堂"}, 8 * 60, 60, 3));
+}
+
+int main() {
+    testNearestGaps();
+    testEquivalentResources();
+    testMergeAndRelease();
+
+    std::cout << "\n=== 时间段建议测试完成 ===\n";
+    return 0;
+}
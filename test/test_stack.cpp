@@ -1,4 +1,5 @@
 #include "../include/stack.h"
+#include "../include/array_stack.h"
 #include <iostream>
 #include <string>
 
@@ -76,10 +77,75 @@ void testUndoRedo() {
     historyStack.print();  // 应该是: 操作3 操作2 操作1
 }
 
+void testCopySemantics() {
+    std::cout << "\n=== 测试4: 拷贝保持顺序 ===\n";
+
+    Stack<int> original;
+    for (int i = 1; i <= 5; i++) {
+        original.push(i);
+    }
+    Stack<int> copied(original);
+    std::cout << "1. 原栈:\n";
+    original.print();  // 应该是: 5 4 3 2 1
+    std::cout << "2. 拷贝:\n";
+    copied.print();    // 应该相同
+
+    Stack<int> assigned;
+    assigned.push(100);
+    assigned = original;
+    std::cout << "3. 赋值:\n";
+    assigned.print();  // 应该相同
+}
+
+void testArrayStack() {
+    std::cout << "\n=== 测试5: 连续存储栈 ArrayStack ===\n";
+
+    ArrayStack<std::string, 4> stack;
+    stack.push("操作1");
+    stack.push(std::string("操作2"));
+    stack.emplace(3, '*');
+    std::cout << "1. 内联存储: " << (stack.isInline() ? "是" : "否")
+              << "，容量 " << stack.capacity() << "\n";
+    stack.print();  // 应该是: *** 操作2 操作1
+
+    // 超出内联容量后转到堆上
+    for (int i = 4; i <= 10; i++) {
+        stack.push("操作" + std::to_string(i));
+    }
+    std::cout << "2. 扩容后: 大小 " << stack.size() << "，内联存储: "
+              << (stack.isInline() ? "是" : "否") << "，容量 " << stack.capacity() << "\n";
+    std::cout << "   栈顶元素: " << stack.top() << "\n";  // 应该是操作10
+
+    // 拷贝与移动
+    ArrayStack<std::string, 4> copied(stack);
+    ArrayStack<std::string, 4> moved(std::move(stack));
+    std::cout << "3. 拷贝后栈顶: " << copied.top() << "，大小 " << copied.size() << "\n";
+    std::cout << "   移动后栈顶: " << moved.top() << "，原栈大小 " << stack.size() << "\n";
+
+    // 内联状态下的移动逐个转移元素
+    ArrayStack<int, 4> small;
+    small.push(1);
+    small.push(2);
+    ArrayStack<int, 4> small_moved;
+    small_moved = std::move(small);
+    std::cout << "4. 内联移动: ";
+    small_moved.print();  // 应该是: 2 1
+
+    std::cout << "5. 清空后出栈:\n";
+    moved.clear();
+    try {
+        moved.pop();  // 应该抛出异常
+    } catch (const std::underflow_error& e) {
+        std::cout << "   异常捕获: " << e.what() << "\n";
+    }
+}
+
 int main() {
     testBasicOperations();
     testAdvancedOperations();
     testUndoRedo();
+    testCopySemantics();
+    testArrayStack();
     
     std::cout << "\n=== 栈测试完成 ===\n";
     return 0;